@@ -758,14 +758,17 @@ void encodeVertex(const Mesh& mesh, const char* pvn)
 	    (double(result.size() * sizeof(PV)) / (1 << 30)) / (end - middle));
 }
 
-void stripify(const Mesh& mesh, bool use_restart, char desc)
+void stripify(const Mesh& mesh, bool use_restart, bool use_adjacency, char desc)
 {
 	unsigned int restart_index = use_restart ? ~0u : 0;
 
 	// note: input mesh is assumed to be optimized for vertex cache and vertex fetch
 	double start = timestamp();
 	std::vector<unsigned int> strip(meshopt_stripifyBound(mesh.indices.size()));
-	strip.resize(meshopt_stripify(&strip[0], &mesh.indices[0], mesh.indices.size(), mesh.vertices.size(), restart_index));
+	if (use_adjacency)
+		strip.resize(meshopt_stripifyAdjacency(&strip[0], &mesh.indices[0], mesh.indices.size(), mesh.vertices.size(), restart_index));
+	else
+		strip.resize(meshopt_stripify(&strip[0], &mesh.indices[0], mesh.indices.size(), mesh.vertices.size(), restart_index));
 	double end = timestamp();
 
 	Mesh copy = mesh;
@@ -946,6 +949,46 @@ void meshlets(const Mesh& mesh, bool scan)
 	    int(rejected_alt_s8), double(rejected_alt_s8) / double(meshlets.size()) * 100,
 	    int(accepted_s8), double(accepted_s8) / double(meshlets.size()) * 100,
 	    (endc - startc) * 1000);
+
+	std::vector<unsigned char> mbuf;
+	std::vector<size_t> mbuf_offsets(meshlets.size() + 1);
+
+	double starte = timestamp();
+	for (size_t i = 0; i < meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+
+		size_t offset = mbuf.size();
+		mbuf.resize(offset + meshopt_encodeMeshletBound(m.vertex_count, m.triangle_count));
+		mbuf.resize(offset + meshopt_encodeMeshlet(&mbuf[offset], mbuf.size() - offset, &meshlet_vertices[m.vertex_offset], m.vertex_count, &meshlet_triangles[m.triangle_offset], m.triangle_count));
+		mbuf_offsets[i + 1] = mbuf.size();
+	}
+	double ende = timestamp();
+
+	std::vector<unsigned int> dvertices(meshlet_vertices.size());
+	std::vector<unsigned char> dtriangles(meshlet_triangles.size());
+
+	double startd = timestamp();
+	for (size_t i = 0; i < meshlets.size(); ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+
+		int res = meshopt_decodeMeshlet(&dvertices[m.vertex_offset], m.vertex_count, &dtriangles[m.triangle_offset], m.triangle_count, &mbuf[mbuf_offsets[i]], mbuf_offsets[i + 1] - mbuf_offsets[i]);
+		assert(res == 0);
+		(void)res;
+	}
+	double endd = timestamp();
+
+	size_t msize = meshlet_vertices.size() * sizeof(unsigned int) + meshlet_triangles.size();
+	size_t csize = compress(mbuf);
+
+	printf("MeshletCodec: %.1f bits/triangle (post-deflate %.1f bits/triangle, raw %.1f bits/triangle); encode %.2f msec, decode %.2f msec (%.2f GB/s)\n",
+	    double(mbuf.size() * 8) / double(mesh.indices.size() / 3),
+	    double(csize * 8) / double(mesh.indices.size() / 3),
+	    double(msize * 8) / double(mesh.indices.size() / 3),
+	    (ende - starte) * 1000,
+	    (endd - startd) * 1000,
+	    (double(msize) / (1 << 30)) / (endd - startd));
 }
 
 void spatialSort(const Mesh& mesh)
@@ -1128,10 +1171,16 @@ void processDeinterleaved(const char* path)
 
 	meshopt_optimizeVertexCache(&indices[0], &indices[0], total_indices, total_vertices);
 
-	meshopt_optimizeVertexFetchRemap(&remap[0], &indices[0], total_indices, total_vertices);
-	meshopt_remapVertexBuffer(&pos[0], &pos[0], total_vertices, sizeof(float) * 3, &remap[0]);
-	meshopt_remapVertexBuffer(&nrm[0], &nrm[0], total_vertices, sizeof(float) * 3, &remap[0]);
-	meshopt_remapVertexBuffer(&uv[0], &uv[0], total_vertices, sizeof(float) * 2, &remap[0]);
+	// all streams are reordered in a single pass; this is equivalent to meshopt_optimizeVertexFetchRemap + meshopt_remapVertexBuffer for each stream
+	meshopt_Stream indexed_streams[] = {
+	    {&pos[0], sizeof(float) * 3, sizeof(float) * 3},
+	    {&nrm[0], sizeof(float) * 3, sizeof(float) * 3},
+	    {&uv[0], sizeof(float) * 2, sizeof(float) * 2},
+	};
+
+	void* indexed_data[] = {&pos[0], &nrm[0], &uv[0]};
+
+	meshopt_optimizeVertexFetchMulti(indexed_data, &indices[0], total_indices, total_vertices, indexed_streams, sizeof(indexed_streams) / sizeof(indexed_streams[0]));
 
 	double optimize = timestamp();
 
@@ -1173,9 +1222,10 @@ void process(const char* path)
 	meshopt_optimizeVertexCacheStrip(&copystrip.indices[0], &copystrip.indices[0], copystrip.indices.size(), copystrip.vertices.size());
 	meshopt_optimizeVertexFetch(&copystrip.vertices[0], &copystrip.indices[0], copystrip.indices.size(), &copystrip.vertices[0], copystrip.vertices.size(), sizeof(Vertex));
 
-	stripify(copy, false, ' ');
-	stripify(copy, true, 'R');
-	stripify(copystrip, true, 'S');
+	stripify(copy, false, false, ' ');
+	stripify(copy, true, false, 'R');
+	stripify(copystrip, true, false, 'S');
+	stripify(copy, true, true, 'A');
 
 	meshlets(copy, false);
 	meshlets(copy, true);
@@ -1195,6 +1245,10 @@ void process(const char* path)
 	encodeVertex<PackedVertex>(copy, "");
 	encodeVertex<PackedVertexOct>(copy, "O");
 
+	meshopt_encodeVertexVersion(2);
+	encodeVertex<PackedVertex>(copy, "2");
+	meshopt_encodeVertexVersion(0);
+
 	simplify(mesh);
 	simplifySloppy(mesh);
 	simplifyComplete(mesh);
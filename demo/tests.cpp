@@ -1,10 +1,13 @@
 #include "../src/meshoptimizer.h"
 
 #include <assert.h>
+#include <float.h>
 #include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <vector>
 
 // This file uses assert() to verify algorithm correctness
@@ -213,6 +216,47 @@ static void roundtripIndexTricky()
 	assert(memcmp(decoded, kIndexBufferTricky, sizeof(kIndexBufferTricky)) == 0);
 }
 
+static void roundtripIndexLong()
+{
+	const size_t N = 40;
+
+	// long grid ensures that the decoder needs to move FIFO history many times
+	std::vector<unsigned int> indices;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			indices.push_back(v);
+			indices.push_back(v + 1);
+			indices.push_back(v + unsigned(N) + 1);
+			indices.push_back(v + 1);
+			indices.push_back(v + unsigned(N) + 2);
+			indices.push_back(v + unsigned(N) + 1);
+		}
+
+	std::vector<unsigned char> buffer(meshopt_encodeIndexBufferBound(indices.size(), (N + 1) * (N + 1)));
+	buffer.resize(meshopt_encodeIndexBuffer(&buffer[0], buffer.size(), &indices[0], indices.size()));
+
+	std::vector<unsigned int> decoded(indices.size());
+	assert(meshopt_decodeIndexBuffer(&decoded[0], indices.size(), &buffer[0], buffer.size()) == 0);
+
+	std::vector<unsigned short> decoded16(indices.size());
+	assert(meshopt_decodeIndexBuffer(&decoded16[0], indices.size(), &buffer[0], buffer.size()) == 0);
+
+	// encoder may rotate triangles to improve compression
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		unsigned int a = decoded[i + 0], b = decoded[i + 1], c = decoded[i + 2];
+
+		assert((a == indices[i + 0] && b == indices[i + 1] && c == indices[i + 2]) ||
+		       (a == indices[i + 1] && b == indices[i + 2] && c == indices[i + 0]) ||
+		       (a == indices[i + 2] && b == indices[i + 0] && c == indices[i + 1]));
+
+		assert(decoded16[i + 0] == a && decoded16[i + 1] == b && decoded16[i + 2] == c);
+	}
+}
+
 static void encodeIndexEmpty()
 {
 	std::vector<unsigned char> buffer(meshopt_encodeIndexBufferBound(0, 0));
@@ -347,6 +391,188 @@ static void encodeIndexSequenceEmpty()
 	assert(meshopt_decodeIndexSequence(static_cast<unsigned int*>(NULL), 0, &buffer[0], buffer.size()) == 0);
 }
 
+static const unsigned int kMeshletVertices[] = {100, 101, 102, 103, 50, 51, 1000000, 7};
+static const unsigned char kMeshletTriangles[] = {
+    0, 1, 2, 2, 1, 3, 3, 1, 4, 5, 6, 7, 4, 2, 3, 7, 6, 0, 1, 1, 1, 0, 4, 6, // clang-format :-/
+};
+
+static bool isTriangleRotation(const unsigned char* lhs, const unsigned char* rhs)
+{
+	return (lhs[0] == rhs[0] && lhs[1] == rhs[1] && lhs[2] == rhs[2]) ||
+	       (lhs[0] == rhs[1] && lhs[1] == rhs[2] && lhs[2] == rhs[0]) ||
+	       (lhs[0] == rhs[2] && lhs[1] == rhs[0] && lhs[2] == rhs[1]);
+}
+
+static void roundtripMeshlet()
+{
+	const size_t vertex_count = sizeof(kMeshletVertices) / sizeof(kMeshletVertices[0]);
+	const size_t triangle_count = sizeof(kMeshletTriangles) / 3;
+
+	std::vector<unsigned char> buffer(meshopt_encodeMeshletBound(vertex_count, triangle_count));
+	buffer.resize(meshopt_encodeMeshlet(&buffer[0], buffer.size(), kMeshletVertices, vertex_count, kMeshletTriangles, triangle_count));
+	assert(buffer.size() > 0);
+
+	unsigned int vertices[vertex_count];
+	unsigned char triangles[triangle_count * 3];
+	assert(meshopt_decodeMeshlet(vertices, vertex_count, triangles, triangle_count, &buffer[0], buffer.size()) == 0);
+
+	assert(memcmp(vertices, kMeshletVertices, sizeof(kMeshletVertices)) == 0);
+
+	for (size_t i = 0; i < triangle_count; ++i)
+		assert(isTriangleRotation(&triangles[i * 3], &kMeshletTriangles[i * 3]));
+}
+
+static void roundtripMeshletLarge()
+{
+	// a 6x35 grid makes a meshlet with 252 vertices and 420 triangles, which is larger than the decoder window
+	const size_t W = 6, H = 35;
+
+	std::vector<unsigned int> vertices;
+	for (size_t i = 0; i < (W + 1) * (H + 1); ++i)
+		vertices.push_back(unsigned(i * 3));
+
+	std::vector<unsigned char> triangles;
+	for (size_t y = 0; y < H; ++y)
+		for (size_t x = 0; x < W; ++x)
+		{
+			unsigned char v = (unsigned char)(y * (W + 1) + x);
+
+			triangles.push_back(v), triangles.push_back((unsigned char)(v + 1)), triangles.push_back((unsigned char)(v + W + 1));
+			triangles.push_back((unsigned char)(v + 1)), triangles.push_back((unsigned char)(v + W + 2)), triangles.push_back((unsigned char)(v + W + 1));
+		}
+
+	size_t triangle_count = triangles.size() / 3;
+
+	// renumber local vertices in the order of first use, matching meshopt_buildMeshlets output
+	unsigned char remap[256];
+	memset(remap, 0, sizeof(remap));
+
+	unsigned int next = 0;
+	for (size_t i = 0; i < triangles.size(); ++i)
+	{
+		if (remap[triangles[i]] == 0)
+			remap[triangles[i]] = (unsigned char)(++next);
+
+		triangles[i] = (unsigned char)(remap[triangles[i]] - 1);
+	}
+
+	std::vector<unsigned char> buffer(meshopt_encodeMeshletBound(vertices.size(), triangle_count));
+	buffer.resize(meshopt_encodeMeshlet(&buffer[0], buffer.size(), &vertices[0], vertices.size(), &triangles[0], triangle_count));
+	assert(buffer.size() > 0);
+
+	// edges are shared by consecutive triangles and new vertices are used in order, so most triangles should take a single byte
+	assert(buffer.size() < vertices.size() + triangle_count * 5 / 4);
+
+	std::vector<unsigned int> dvertices(vertices.size());
+	std::vector<unsigned char> dtriangles(triangles.size());
+	assert(meshopt_decodeMeshlet(&dvertices[0], vertices.size(), &dtriangles[0], triangle_count, &buffer[0], buffer.size()) == 0);
+
+	assert(dvertices == vertices);
+
+	for (size_t i = 0; i < triangle_count; ++i)
+		assert(isTriangleRotation(&dtriangles[i * 3], &triangles[i * 3]));
+}
+
+static void encodeMeshletMemorySafe()
+{
+	const size_t vertex_count = sizeof(kMeshletVertices) / sizeof(kMeshletVertices[0]);
+	const size_t triangle_count = sizeof(kMeshletTriangles) / 3;
+
+	std::vector<unsigned char> buffer(meshopt_encodeMeshletBound(vertex_count, triangle_count));
+	buffer.resize(meshopt_encodeMeshlet(&buffer[0], buffer.size(), kMeshletVertices, vertex_count, kMeshletTriangles, triangle_count));
+
+	// check that encode is memory-safe; note that we reallocate the buffer for each try to make sure ASAN can verify buffer access
+	for (size_t i = 0; i <= buffer.size(); ++i)
+	{
+		std::vector<unsigned char> shortbuffer(i);
+		size_t result = meshopt_encodeMeshlet(i == 0 ? NULL : &shortbuffer[0], i, kMeshletVertices, vertex_count, kMeshletTriangles, triangle_count);
+
+		if (i == buffer.size())
+			assert(result == buffer.size());
+		else
+			assert(result == 0);
+	}
+}
+
+static void encodeMeshletWorstCase()
+{
+	const size_t vertex_count = 256;
+	const size_t triangle_count = 512;
+
+	// alternating vertex indices make every delta take 5 bytes
+	std::vector<unsigned int> vertices(vertex_count);
+	for (size_t i = 0; i < vertex_count; ++i)
+		vertices[i] = unsigned(i) + (i & 1 ? 0x80000000 : 0);
+
+	// disjoint triangles that are reused after a long delay don't share edges or vertices with the fifos, so every index is explicit
+	std::vector<unsigned char> triangles(triangle_count * 3);
+	for (size_t i = 0; i < triangle_count; ++i)
+		for (int k = 0; k < 3; ++k)
+			triangles[i * 3 + k] = (unsigned char)((i % 85) * 3 + k);
+
+	size_t bound = meshopt_encodeMeshletBound(vertex_count, triangle_count);
+
+	std::vector<unsigned char> buffer(bound);
+	size_t size = meshopt_encodeMeshlet(&buffer[0], buffer.size(), &vertices[0], vertex_count, &triangles[0], triangle_count);
+	assert(size > 0 && size <= bound);
+
+	std::vector<unsigned int> dvertices(vertex_count);
+	std::vector<unsigned char> dtriangles(triangle_count * 3);
+	assert(meshopt_decodeMeshlet(&dvertices[0], vertex_count, &dtriangles[0], triangle_count, &buffer[0], size) == 0);
+
+	assert(dvertices == vertices);
+
+	for (size_t i = 0; i < triangle_count; ++i)
+		assert(isTriangleRotation(&dtriangles[i * 3], &triangles[i * 3]));
+}
+
+static void decodeMeshletMemorySafe()
+{
+	const size_t vertex_count = sizeof(kMeshletVertices) / sizeof(kMeshletVertices[0]);
+	const size_t triangle_count = sizeof(kMeshletTriangles) / 3;
+
+	std::vector<unsigned char> buffer(meshopt_encodeMeshletBound(vertex_count, triangle_count));
+	buffer.resize(meshopt_encodeMeshlet(&buffer[0], buffer.size(), kMeshletVertices, vertex_count, kMeshletTriangles, triangle_count));
+
+	unsigned int vertices[vertex_count];
+	unsigned char triangles[triangle_count * 3];
+
+	// check that decode is memory-safe; note that we reallocate the buffer for each try to make sure ASAN can verify buffer access
+	for (size_t i = 0; i <= buffer.size(); ++i)
+	{
+		std::vector<unsigned char> shortbuffer(buffer.begin(), buffer.begin() + i);
+		int result = meshopt_decodeMeshlet(vertices, vertex_count, triangles, triangle_count, i == 0 ? NULL : &shortbuffer[0], i);
+
+		if (i == buffer.size())
+			assert(result == 0);
+		else
+			assert(result < 0);
+	}
+}
+
+static void decodeMeshletRejectExtraBytes()
+{
+	const size_t vertex_count = sizeof(kMeshletVertices) / sizeof(kMeshletVertices[0]);
+	const size_t triangle_count = sizeof(kMeshletTriangles) / 3;
+
+	std::vector<unsigned char> buffer(meshopt_encodeMeshletBound(vertex_count, triangle_count));
+	buffer.resize(meshopt_encodeMeshlet(&buffer[0], buffer.size(), kMeshletVertices, vertex_count, kMeshletTriangles, triangle_count));
+
+	// check that decoder doesn't accept extra bytes after a valid stream
+	std::vector<unsigned char> largebuffer(buffer);
+	largebuffer.push_back(0);
+
+	unsigned int vertices[vertex_count];
+	unsigned char triangles[triangle_count * 3];
+	assert(meshopt_decodeMeshlet(vertices, vertex_count, triangles, triangle_count, &largebuffer[0], largebuffer.size()) < 0);
+
+	// check that decoder doesn't accept malformed headers
+	std::vector<unsigned char> brokenbuffer(buffer);
+	brokenbuffer[0] = 0;
+
+	assert(meshopt_decodeMeshlet(vertices, vertex_count, triangles, triangle_count, &brokenbuffer[0], brokenbuffer.size()) < 0);
+}
+
 static void decodeVertexV0()
 {
 	const size_t vertex_count = sizeof(kVertexBuffer) / sizeof(kVertexBuffer[0]);
@@ -512,280 +738,1728 @@ static void encodeVertexEmpty()
 	assert(meshopt_decodeVertexBuffer(NULL, 0, 16, &buffer[0], buffer.size()) == 0);
 }
 
-static void decodeFilterOct8()
+static void dispatchReverse(void* context, void (*task)(void*, size_t), void* task_context, size_t task_count)
 {
-	const unsigned char data[4 * 4] = {
-	    0, 1, 127, 0,
-	    0, 187, 127, 1,
-	    255, 1, 127, 0,
-	    14, 130, 127, 1, // clang-format :-/
-	};
-
-	const unsigned char expected[4 * 4] = {
-	    0, 1, 127, 0,
-	    0, 159, 82, 1,
-	    255, 1, 127, 0,
-	    1, 130, 241, 1, // clang-format :-/
-	};
-
-	// Aligned by 4
-	unsigned char full[4 * 4];
-	memcpy(full, data, sizeof(full));
-	meshopt_decodeFilterOct(full, 4, 4);
-	assert(memcmp(full, expected, sizeof(full)) == 0);
+	// reverse order makes sure tasks don't depend on being executed sequentially
+	for (size_t i = task_count; i > 0; --i)
+		task(task_context, i - 1);
 
-	// Tail processing for unaligned data
-	unsigned char tail[3 * 4];
-	memcpy(tail, data, sizeof(tail));
-	meshopt_decodeFilterOct(tail, 3, 4);
-	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+	*static_cast<size_t*>(context) += task_count;
 }
 
-static void decodeFilterOct12()
+static void encodeVertexWithVersion(std::vector<unsigned char>& buffer, const void* vertices, size_t vertex_count, size_t vertex_size, int version)
 {
-	const unsigned short data[4 * 4] = {
-	    0, 1, 2047, 0,
-	    0, 1870, 2047, 1,
-	    2017, 1, 2047, 0,
-	    14, 1300, 2047, 1, // clang-format :-/
-	};
+	meshopt_encodeVertexVersion(version);
 
-	const unsigned short expected[4 * 4] = {
-	    0, 16, 32767, 0,
-	    0, 32621, 3088, 1,
-	    32764, 16, 471, 0,
-	    307, 28541, 16093, 1, // clang-format :-/
-	};
+	buffer.resize(meshopt_encodeVertexBufferBound(vertex_count, vertex_size));
+	buffer.resize(meshopt_encodeVertexBuffer(&buffer[0], buffer.size(), vertices, vertex_count, vertex_size));
 
-	// Aligned by 4
-	unsigned short full[4 * 4];
-	memcpy(full, data, sizeof(full));
-	meshopt_decodeFilterOct(full, 4, 8);
-	assert(memcmp(full, expected, sizeof(full)) == 0);
+	meshopt_encodeVertexVersion(0);
+}
 
-	// Tail processing for unaligned data
-	unsigned short tail[3 * 4];
-	memcpy(tail, data, sizeof(tail));
-	meshopt_decodeFilterOct(tail, 3, 8);
-	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+static void encodeVertexV1(std::vector<unsigned char>& buffer, const void* vertices, size_t vertex_count, size_t vertex_size)
+{
+	encodeVertexWithVersion(buffer, vertices, vertex_count, vertex_size, 1);
 }
 
-static void decodeFilterQuat12()
+static void decodeVertexV1()
 {
-	const unsigned short data[4 * 4] = {
-	    0, 1, 0, 0x7fc,
-	    0, 1870, 0, 0x7fd,
-	    2017, 1, 0, 0x7fe,
-	    14, 1300, 0, 0x7ff, // clang-format :-/
-	};
+	const size_t vertex_count = 10000;
 
-	const unsigned short expected[4 * 4] = {
-	    32767, 0, 11, 0,
-	    0, 25013, 0, 21166,
-	    11, 0, 23504, 22830,
-	    158, 14715, 0, 29277, // clang-format :-/
-	};
+	std::vector<unsigned int> data(vertex_count * 2);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		data[i * 2 + 0] = unsigned(i * 3);
+		data[i * 2 + 1] = unsigned(i * i);
+	}
 
-	// Aligned by 4
-	unsigned short full[4 * 4];
-	memcpy(full, data, sizeof(full));
-	meshopt_decodeFilterQuat(full, 4, 8);
-	assert(memcmp(full, expected, sizeof(full)) == 0);
+	std::vector<unsigned char> buffer;
+	encodeVertexV1(buffer, &data[0], vertex_count, 8);
 
-	// Tail processing for unaligned data
-	unsigned short tail[3 * 4];
-	memcpy(tail, data, sizeof(tail));
-	meshopt_decodeFilterQuat(tail, 3, 8);
-	assert(memcmp(tail, expected, sizeof(tail)) == 0);
-}
+	assert(buffer[0] == 0xa1);
 
-static void decodeFilterExp()
-{
-	const unsigned int data[4] = {
-	    0,
-	    0xff000003,
-	    0x02fffff7,
-	    0xfe7fffff, // clang-format :-/
-	};
+	std::vector<unsigned int> decoded(vertex_count * 2);
+	assert(meshopt_decodeVertexBuffer(&decoded[0], vertex_count, 8, &buffer[0], buffer.size()) == 0);
+	assert(decoded == data);
 
-	const unsigned int expected[4] = {
-	    0,
-	    0x3fc00000,
-	    0xc2100000,
-	    0x49fffffe, // clang-format :-/
-	};
+	// check that decoder doesn't accept extra bytes or corrupted chunk offsets
+	std::vector<unsigned char> largebuffer(buffer);
+	largebuffer.push_back(0);
 
-	// Aligned by 4
-	unsigned int full[4];
-	memcpy(full, data, sizeof(full));
-	meshopt_decodeFilterExp(full, 4, 4);
-	assert(memcmp(full, expected, sizeof(full)) == 0);
+	assert(meshopt_decodeVertexBuffer(&decoded[0], vertex_count, 8, &largebuffer[0], largebuffer.size()) < 0);
 
-	// Tail processing for unaligned data
-	unsigned int tail[3];
-	memcpy(tail, data, sizeof(tail));
-	meshopt_decodeFilterExp(tail, 3, 4);
-	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+	std::vector<unsigned char> brokenbuffer(buffer);
+	brokenbuffer[5] ^= 1;
+
+	assert(meshopt_decodeVertexBuffer(&decoded[0], vertex_count, 8, &brokenbuffer[0], brokenbuffer.size()) < 0);
 }
 
-void encodeFilterOct8()
+static void decodeVertexV1MemorySafe()
 {
-	const float data[4 * 4] = {
-	    1, 0, 0, 0,
-	    0, -1, 0, 0,
-	    0.7071068f, 0, 0.707168f, 1,
-	    -0.7071068f, 0, -0.707168f, 1, // clang-format :-/
-	};
+	const size_t vertex_count = 5000;
 
-	const unsigned char expected[4 * 4] = {
-	    0x7f, 0, 0x7f, 0,
-	    0, 0x81, 0x7f, 0,
-	    0x3f, 0, 0x7f, 0x7f,
-	    0x81, 0x40, 0x7f, 0x7f, // clang-format :-/
-	};
+	std::vector<unsigned int> data(vertex_count);
+	for (size_t i = 0; i < vertex_count; ++i)
+		data[i] = unsigned(i * 7);
 
-	unsigned char encoded[4 * 4];
-	meshopt_encodeFilterOct(encoded, 4, 4, 8, data);
+	std::vector<unsigned char> buffer;
+	encodeVertexV1(buffer, &data[0], vertex_count, 4);
 
-	assert(memcmp(encoded, expected, sizeof(expected)) == 0);
+	// check that decode is memory-safe; note that we reallocate the buffer for each try to make sure ASAN can verify buffer access
+	std::vector<unsigned int> decoded(vertex_count);
 
-	signed char decoded[4 * 4];
-	memcpy(decoded, encoded, sizeof(decoded));
-	meshopt_decodeFilterOct(decoded, 4, 4);
+	for (size_t i = 0; i <= buffer.size(); ++i)
+	{
+		std::vector<unsigned char> shortbuffer(buffer.begin(), buffer.begin() + i);
+		int result = meshopt_decodeVertexBuffer(&decoded[0], vertex_count, 4, i == 0 ? 0 : &shortbuffer[0], i);
+		(void)result;
 
-	for (size_t i = 0; i < 4 * 4; ++i)
-		assert(fabsf(decoded[i] / 127.f - data[i]) < 1e-2f);
+		if (i == buffer.size())
+			assert(result == 0);
+		else
+			assert(result < 0);
+	}
 }
 
-void encodeFilterOct12()
+static void decodeVertexV2()
 {
-	const float data[4 * 4] = {
-	    1, 0, 0, 0,
-	    0, -1, 0, 0,
-	    0.7071068f, 0, 0.707168f, 1,
-	    -0.7071068f, 0, -0.707168f, 1, // clang-format :-/
-	};
+	const size_t vertex_count = 10000;
 
-	const unsigned short expected[4 * 4] = {
-	    0x7ff, 0, 0x7ff, 0,
-	    0x0, 0xf801, 0x7ff, 0,
-	    0x3ff, 0, 0x7ff, 0x7fff,
-	    0xf801, 0x400, 0x7ff, 0x7fff, // clang-format :-/
-	};
+	// smooth 16-bit data benefits from word-wide and second order prediction, while the last channel is random bytes
+	std::vector<unsigned short> data(vertex_count * 6);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		data[i * 6 + 0] = (unsigned short)(i * 37);
+		data[i * 6 + 1] = (unsigned short)(i * i / 16);
+		data[i * 6 + 2] = (unsigned short)(i % 100 * 600);
+		data[i * 6 + 3] = 0;
+		data[i * 6 + 4] = (unsigned short)(i * 2654435761u >> 16);
+		data[i * 6 + 5] = (unsigned short)(i * 2246822519u >> 16);
+	}
 
-	unsigned short encoded[4 * 4];
-	meshopt_encodeFilterOct(encoded, 4, 8, 12, data);
+	std::vector<unsigned char> buffer1, buffer2;
+	encodeVertexV1(buffer1, &data[0], vertex_count, 12);
+	encodeVertexWithVersion(buffer2, &data[0], vertex_count, 12, 2);
 
-	assert(memcmp(encoded, expected, sizeof(expected)) == 0);
+	assert(buffer2[0] == 0xa2);
+	assert(buffer2.size() < buffer1.size() / 2);
 
-	short decoded[4 * 4];
-	memcpy(decoded, encoded, sizeof(decoded));
-	meshopt_decodeFilterOct(decoded, 4, 8);
+	std::vector<unsigned short> decoded(vertex_count * 6);
+	assert(meshopt_decodeVertexBuffer(&decoded[0], vertex_count, 12, &buffer2[0], buffer2.size()) == 0);
+	assert(decoded == data);
 
-	for (size_t i = 0; i < 4 * 4; ++i)
-		assert(fabsf(decoded[i] / 32767.f - data[i]) < 1e-3f);
+	// parallel encoding and range decoding use the same chunk layout as version 1
+	size_t tasks = 0;
+
+	meshopt_encodeVertexVersion(2);
+
+	std::vector<unsigned char> pbuffer(meshopt_encodeVertexBufferBound(vertex_count, 12));
+	pbuffer.resize(meshopt_encodeVertexBufferParallel(&pbuffer[0], pbuffer.size(), &data[0], vertex_count, 12, dispatchReverse, &tasks));
+
+	meshopt_encodeVertexVersion(0);
+
+	assert(pbuffer == buffer2);
+
+	std::vector<unsigned short> range(500 * 6);
+	assert(meshopt_decodeVertexRange(&range[0], 4321, 500, vertex_count, 12, &buffer2[0], buffer2.size()) == 0);
+	assert(memcmp(&range[0], &data[4321 * 6], 500 * 12) == 0);
+
+	// check that decode is memory-safe on a shorter stream
+	std::vector<unsigned char> buffer;
+	encodeVertexWithVersion(buffer, &data[0], 300, 12, 2);
+
+	for (size_t i = 0; i <= buffer.size(); ++i)
+	{
+		std::vector<unsigned char> shortbuffer(buffer.begin(), buffer.begin() + i);
+		int result = meshopt_decodeVertexBuffer(&decoded[0], 300, 12, i == 0 ? 0 : &shortbuffer[0], i);
+		(void)result;
+
+		if (i == buffer.size())
+			assert(result == 0);
+		else
+			assert(result < 0);
+	}
 }
 
-void encodeFilterQuat12()
+static void decodeVertexParallel()
 {
-	const float data[4 * 4] = {
-	    1, 0, 0, 0,
-	    0, -1, 0, 0,
-	    0.7071068f, 0, 0, 0.707168f,
-	    -0.7071068f, 0, 0, -0.707168f, // clang-format :-/
+	const size_t vertex_count = 20000;
+
+	std::vector<unsigned int> data(vertex_count * 4);
+	for (size_t i = 0; i < vertex_count * 4; ++i)
+		data[i] = unsigned(i * i);
+
+	std::vector<unsigned char> buffer;
+	encodeVertexV1(buffer, &data[0], vertex_count, 16);
+
+	// parallel encoding must produce the same bytes as serial encoding
+	size_t tasks = 0;
+
+	meshopt_encodeVertexVersion(1);
+
+	std::vector<unsigned char> pbuffer(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	pbuffer.resize(meshopt_encodeVertexBufferParallel(&pbuffer[0], pbuffer.size(), &data[0], vertex_count, 16, dispatchReverse, &tasks));
+
+	meshopt_encodeVertexVersion(0);
+
+	assert(pbuffer == buffer);
+	assert(tasks > 1);
+
+	std::vector<unsigned int> decoded(vertex_count * 4);
+	assert(meshopt_decodeVertexBufferParallel(&decoded[0], vertex_count, 16, &buffer[0], buffer.size(), dispatchReverse, &tasks) == 0);
+	assert(decoded == data);
+
+	// version 0 data is decoded serially
+	std::vector<unsigned char> buffer0(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	buffer0.resize(meshopt_encodeVertexBuffer(&buffer0[0], buffer0.size(), &data[0], vertex_count, 16));
+
+	std::vector<unsigned int> decoded0(vertex_count * 4);
+	assert(meshopt_decodeVertexBufferParallel(&decoded0[0], vertex_count, 16, &buffer0[0], buffer0.size(), dispatchReverse, &tasks) == 0);
+	assert(decoded0 == data);
+}
+
+static void decodeVertexRange()
+{
+	const size_t vertex_count = 20000;
+
+	std::vector<unsigned int> data(vertex_count * 4);
+	for (size_t i = 0; i < vertex_count * 4; ++i)
+		data[i] = unsigned(i * i);
+
+	std::vector<unsigned char> buffer0(meshopt_encodeVertexBufferBound(vertex_count, 16));
+	buffer0.resize(meshopt_encodeVertexBuffer(&buffer0[0], buffer0.size(), &data[0], vertex_count, 16));
+
+	std::vector<unsigned char> buffer1;
+	encodeVertexV1(buffer1, &data[0], vertex_count, 16);
+
+	// ranges cover block and chunk boundaries as well as partial blocks
+	const size_t ranges[][2] = {
+	    {0, vertex_count},
+	    {0, 0},
+	    {100, 50},
+	    {256, 256},
+	    {4000, 200},
+	    {4095, 1},
+	    {12345, 5000},
+	    {19990, 10},
+	    {vertex_count, 0},
 	};
 
-	const unsigned short expected[4 * 4] = {
-	    0, 0, 0, 0x7fc,
-	    0, 0, 0, 0x7fd,
-	    0x7ff, 0, 0, 0x7ff,
-	    0x7ff, 0, 0, 0x7ff, // clang-format :-/
+	for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); ++i)
+	{
+		size_t offset = ranges[i][0], range = ranges[i][1];
+
+		std::vector<unsigned int> decoded(range * 4 + 1);
+
+		assert(meshopt_decodeVertexRange(&decoded[0], offset, range, vertex_count, 16, &buffer0[0], buffer0.size()) == 0);
+		assert(memcmp(&decoded[0], &data[offset * 4], range * 16) == 0);
+
+		assert(meshopt_decodeVertexRange(&decoded[0], offset, range, vertex_count, 16, &buffer1[0], buffer1.size()) == 0);
+		assert(memcmp(&decoded[0], &data[offset * 4], range * 16) == 0);
+	}
+
+	// version 1 ranges only need the chunks that contain them, so a corrupted chunk doesn't affect other ranges
+	std::vector<unsigned char> corrupt = buffer1;
+	corrupt[corrupt.size() - 64] ^= 0xff;
+
+	std::vector<unsigned int> decoded(100 * 4);
+	assert(meshopt_decodeVertexRange(&decoded[0], 100, 100, vertex_count, 16, &corrupt[0], corrupt.size()) == 0);
+	assert(memcmp(&decoded[0], &data[100 * 4], 100 * 16) == 0);
+}
+
+static void encodeIndexGrid(std::vector<unsigned int>& indices, size_t N)
+{
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			indices.push_back(v);
+			indices.push_back(v + 1);
+			indices.push_back(v + unsigned(N) + 1);
+			indices.push_back(v + 1);
+			indices.push_back(v + unsigned(N) + 2);
+			indices.push_back(v + unsigned(N) + 1);
+		}
+}
+
+static void decodeIndexParallel()
+{
+	const size_t N = 120;
+
+	std::vector<unsigned int> indices;
+	encodeIndexGrid(indices, N);
+
+	std::vector<unsigned char> buffer1(meshopt_encodeIndexBufferBound(indices.size(), (N + 1) * (N + 1)));
+	meshopt_encodeIndexVersion(1);
+	buffer1.resize(meshopt_encodeIndexBuffer(&buffer1[0], buffer1.size(), &indices[0], indices.size()));
+
+	std::vector<unsigned char> buffer2(meshopt_encodeIndexBufferBound(indices.size(), (N + 1) * (N + 1)));
+	meshopt_encodeIndexVersion(2);
+	buffer2.resize(meshopt_encodeIndexBuffer(&buffer2[0], buffer2.size(), &indices[0], indices.size()));
+	meshopt_encodeIndexVersion(0);
+
+	assert(buffer2[0] == 0xe2);
+
+	std::vector<unsigned int> expected(indices.size());
+	assert(meshopt_decodeIndexBuffer(&expected[0], indices.size(), &buffer1[0], buffer1.size()) == 0);
+
+	// version 2 resets encoder state at block boundaries but the decoded triangles are equivalent
+	std::vector<unsigned int> decoded(indices.size());
+	assert(meshopt_decodeIndexBuffer(&decoded[0], indices.size(), &buffer2[0], buffer2.size()) == 0);
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		unsigned int a = decoded[i + 0], b = decoded[i + 1], c = decoded[i + 2];
+
+		assert((a == indices[i + 0] && b == indices[i + 1] && c == indices[i + 2]) ||
+		       (a == indices[i + 1] && b == indices[i + 2] && c == indices[i + 0]) ||
+		       (a == indices[i + 2] && b == indices[i + 0] && c == indices[i + 1]));
+	}
+
+	size_t tasks = 0;
+
+	std::vector<unsigned int> pdecoded(indices.size());
+	assert(meshopt_decodeIndexBufferParallel(&pdecoded[0], indices.size(), 4, &buffer2[0], buffer2.size(), dispatchReverse, &tasks) == 0);
+	assert(pdecoded == decoded);
+	assert(tasks == (indices.size() / 3 + 4095) / 4096);
+
+	std::vector<unsigned short> pdecoded16(indices.size());
+	assert(meshopt_decodeIndexBufferParallel(&pdecoded16[0], indices.size(), 2, &buffer2[0], buffer2.size(), dispatchReverse, &tasks) == 0);
+
+	for (size_t i = 0; i < indices.size(); ++i)
+		assert(pdecoded16[i] == decoded[i]);
+
+	// version 1 data is decoded serially
+	std::vector<unsigned int> pdecoded1(indices.size());
+	assert(meshopt_decodeIndexBufferParallel(&pdecoded1[0], indices.size(), 4, &buffer1[0], buffer1.size(), dispatchReverse, &tasks) == 0);
+	assert(pdecoded1 == expected);
+
+	// truncated and corrupted block headers must be detected
+	for (size_t i = 0; i < buffer2.size(); i += 97)
+		assert(meshopt_decodeIndexBufferParallel(&pdecoded[0], indices.size(), 4, &buffer2[0], i, dispatchReverse, &tasks) < 0);
+
+	std::vector<unsigned char> corrupt = buffer2;
+	corrupt[1 + 8 * 3] ^= 1;
+	assert(meshopt_decodeIndexBufferParallel(&pdecoded[0], indices.size(), 4, &corrupt[0], corrupt.size(), dispatchReverse, &tasks) < 0);
+}
+
+static void decodeIndexRange()
+{
+	const size_t N = 120;
+
+	std::vector<unsigned int> indices;
+	encodeIndexGrid(indices, N);
+
+	size_t index_count = indices.size();
+
+	std::vector<unsigned char> buffer1(meshopt_encodeIndexBufferBound(index_count, (N + 1) * (N + 1)));
+	meshopt_encodeIndexVersion(1);
+	buffer1.resize(meshopt_encodeIndexBuffer(&buffer1[0], buffer1.size(), &indices[0], index_count));
+
+	std::vector<unsigned char> buffer2(meshopt_encodeIndexBufferBound(index_count, (N + 1) * (N + 1)));
+	meshopt_encodeIndexVersion(2);
+	buffer2.resize(meshopt_encodeIndexBuffer(&buffer2[0], buffer2.size(), &indices[0], index_count));
+	meshopt_encodeIndexVersion(0);
+
+	std::vector<unsigned int> expected1(index_count), expected2(index_count);
+	assert(meshopt_decodeIndexBuffer(&expected1[0], index_count, &buffer1[0], buffer1.size()) == 0);
+	assert(meshopt_decodeIndexBuffer(&expected2[0], index_count, &buffer2[0], buffer2.size()) == 0);
+
+	// ranges cover block boundaries as well as partial blocks
+	const size_t ranges[][2] = {
+	    {0, index_count},
+	    {0, 0},
+	    {300, 150},
+	    {4096 * 3, 4096 * 3},
+	    {4000 * 3, 200 * 3},
+	    {4095 * 3, 3},
+	    {12345 * 3, 5000 * 3},
+	    {index_count - 30, 30},
+	    {index_count, 0},
 	};
 
-	unsigned short encoded[4 * 4];
-	meshopt_encodeFilterQuat(encoded, 4, 8, 12, data);
+	for (size_t i = 0; i < sizeof(ranges) / sizeof(ranges[0]); ++i)
+	{
+		size_t offset = ranges[i][0], range = ranges[i][1];
 
-	assert(memcmp(encoded, expected, sizeof(expected)) == 0);
+		std::vector<unsigned int> decoded(range + 1);
 
-	short decoded[4 * 4];
-	memcpy(decoded, encoded, sizeof(decoded));
-	meshopt_decodeFilterQuat(decoded, 4, 8);
+		assert(meshopt_decodeIndexRange(&decoded[0], offset, range, index_count, 4, &buffer1[0], buffer1.size()) == 0);
+		assert(memcmp(&decoded[0], &expected1[offset], range * 4) == 0);
 
-	for (size_t i = 0; i < 4; ++i)
+		assert(meshopt_decodeIndexRange(&decoded[0], offset, range, index_count, 4, &buffer2[0], buffer2.size()) == 0);
+		assert(memcmp(&decoded[0], &expected2[offset], range * 4) == 0);
+	}
+
+	// version 2 ranges only need the blocks that contain them, so a corrupted block doesn't affect other ranges
+	std::vector<unsigned char> corrupt = buffer2;
+	corrupt[corrupt.size() - 20] ^= 0xff;
+
+	std::vector<unsigned int> decoded(300);
+	assert(meshopt_decodeIndexRange(&decoded[0], 300, 300, index_count, 4, &corrupt[0], corrupt.size()) == 0);
+	assert(memcmp(&decoded[0], &expected2[300], 300 * 4) == 0);
+}
+
+static void validateIndexBuffer()
+{
+	const size_t N = 50;
+
+	// grid triangles are mostly encoded with FIFO references; shuffled triangles at the end exercise free indices and codeaux bytes
+	std::vector<unsigned int> indices;
+	encodeIndexGrid(indices, N);
+
+	for (size_t i = 0; i < 500; ++i)
 	{
-		float dx = decoded[i * 4 + 0] / 32767.f;
-		float dy = decoded[i * 4 + 1] / 32767.f;
-		float dz = decoded[i * 4 + 2] / 32767.f;
-		float dw = decoded[i * 4 + 3] / 32767.f;
+		indices.push_back(unsigned(i * 7919 % 2601));
+		indices.push_back(unsigned(i * 104729 % 2601));
+		indices.push_back(unsigned(i * 1299709 % 2601));
+	}
 
-		float dp =
-		    data[i * 4 + 0] * dx +
-		    data[i * 4 + 1] * dy +
-		    data[i * 4 + 2] * dz +
-		    data[i * 4 + 3] * dw;
+	size_t index_count = indices.size();
+	std::vector<unsigned int> decoded(index_count);
 
-		assert(fabsf(fabsf(dp) - 1.f) < 1e-4f);
+	for (int version = 0; version <= 2; ++version)
+	{
+		std::vector<unsigned char> buffer(meshopt_encodeIndexBufferBound(index_count, (N + 1) * (N + 1)));
+		meshopt_encodeIndexVersion(version);
+		buffer.resize(meshopt_encodeIndexBuffer(&buffer[0], buffer.size(), &indices[0], index_count));
+		meshopt_encodeIndexVersion(0);
+
+		assert(meshopt_validateIndexBuffer(index_count, &buffer[0], buffer.size()) == 0);
+
+		// validation must produce the same result as decoding for truncated, extended and corrupted streams
+		for (size_t i = 0; i <= buffer.size(); i += (i < 64 || i + 64 > buffer.size()) ? 1 : 37)
+		{
+			std::vector<unsigned char> shortbuffer(buffer.begin(), buffer.begin() + i);
+			const unsigned char* data = i == 0 ? 0 : &shortbuffer[0];
+
+			int result = meshopt_validateIndexBuffer(index_count, data, i);
+			assert(result == meshopt_decodeIndexBuffer(&decoded[0], index_count, 4, data, i));
+			assert(i == buffer.size() || result < 0);
+		}
+
+		std::vector<unsigned char> largebuffer(buffer);
+		largebuffer.push_back(0);
+
+		assert(meshopt_validateIndexBuffer(index_count, &largebuffer[0], largebuffer.size()) == -3);
+
+		for (size_t i = 0; i < buffer.size(); i += (i < 64 ? 1 : 37))
+		{
+			std::vector<unsigned char> brokenbuffer(buffer);
+			brokenbuffer[i] ^= (unsigned char)(0xf0 | i);
+
+			int result = meshopt_validateIndexBuffer(index_count, &brokenbuffer[0], brokenbuffer.size());
+			assert(result == meshopt_decodeIndexBuffer(&decoded[0], index_count, 4, &brokenbuffer[0], brokenbuffer.size()));
+		}
 	}
+
+	// index count must match the encoded stream
+	std::vector<unsigned char> buffer(meshopt_encodeIndexBufferBound(index_count, (N + 1) * (N + 1)));
+	buffer.resize(meshopt_encodeIndexBuffer(&buffer[0], buffer.size(), &indices[0], index_count));
+
+	assert(meshopt_validateIndexBuffer(index_count - 3, &buffer[0], buffer.size()) < 0);
+	assert(meshopt_validateIndexBuffer(index_count + 3, &buffer[0], buffer.size()) < 0);
 }
 
-void encodeFilterExp()
+static void validateVertexBufferMatches(const std::vector<unsigned char>& buffer, size_t vertex_count, size_t vertex_size, size_t step)
 {
-	const float data[3] = {
-	    1,
-	    -23.4f,
-	    -0.1f,
+	std::vector<unsigned char> decoded(vertex_count * vertex_size);
+
+	assert(meshopt_validateVertexBuffer(vertex_count, vertex_size, &buffer[0], buffer.size()) == 0);
+
+	// validation must produce the same result as decoding for truncated, extended and corrupted streams
+	for (size_t i = 0; i <= buffer.size(); i += (i < 64 || i + 64 > buffer.size()) ? 1 : step)
+	{
+		std::vector<unsigned char> shortbuffer(buffer.begin(), buffer.begin() + i);
+		const unsigned char* input = i == 0 ? 0 : &shortbuffer[0];
+
+		int result = meshopt_validateVertexBuffer(vertex_count, vertex_size, input, i);
+		assert(result == meshopt_decodeVertexBuffer(&decoded[0], vertex_count, vertex_size, input, i));
+		assert(i == buffer.size() || result < 0);
+	}
+
+	std::vector<unsigned char> largebuffer(buffer);
+	largebuffer.push_back(0);
+
+	assert(meshopt_validateVertexBuffer(vertex_count, vertex_size, &largebuffer[0], largebuffer.size()) == -3);
+
+	for (size_t i = 0; i < buffer.size(); i += (i < 64 ? 1 : step))
+	{
+		std::vector<unsigned char> brokenbuffer(buffer);
+		brokenbuffer[i] ^= (unsigned char)(0x81 | i);
+
+		int result = meshopt_validateVertexBuffer(vertex_count, vertex_size, &brokenbuffer[0], brokenbuffer.size());
+		assert(result == meshopt_decodeVertexBuffer(&decoded[0], vertex_count, vertex_size, &brokenbuffer[0], brokenbuffer.size()));
+	}
+}
+
+static void validateVertexBuffer()
+{
+	// 64-byte vertices use 128-vertex blocks and 2048-vertex chunks, so version 1+ streams have multiple chunks; most bytes are zero to keep the stream small
+	const size_t vertex_count = 2500;
+	const size_t vertex_size = 64;
+
+	std::vector<unsigned char> data(vertex_count * vertex_size);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int v0 = unsigned(i * 3), v1 = unsigned(i * 2654435761u);
+		memcpy(&data[i * vertex_size + 0], &v0, 4);
+		memcpy(&data[i * vertex_size + 4], &v1, 4);
+
+		// sparse outliers produce byte groups with escaped values
+		data[i * vertex_size + 8] = (i % 13 == 0) ? 200 : (unsigned char)(i % 4);
+	}
+
+	for (int version = 0; version <= 2; ++version)
+	{
+		std::vector<unsigned char> buffer;
+
+		// a short stream is checked exhaustively, and a long stream is sampled
+		encodeVertexWithVersion(buffer, &data[0], 200, vertex_size, version);
+		validateVertexBufferMatches(buffer, 200, vertex_size, 1);
+
+		encodeVertexWithVersion(buffer, &data[0], vertex_count, vertex_size, version);
+		validateVertexBufferMatches(buffer, vertex_count, vertex_size, 211);
+	}
+
+	// vertex count and size must match the encoded stream
+	std::vector<unsigned char> buffer;
+	encodeVertexWithVersion(buffer, &data[0], vertex_count, vertex_size, 1);
+
+	assert(meshopt_validateVertexBuffer(vertex_count - 200, vertex_size, &buffer[0], buffer.size()) < 0);
+	assert(meshopt_validateVertexBuffer(vertex_count, vertex_size - 4, &buffer[0], buffer.size()) < 0);
+}
+
+static void decodeVertexStrided()
+{
+	const size_t vertex_count = 5000;
+
+	std::vector<unsigned int> data0(vertex_count * 3), data1(vertex_count);
+	for (size_t i = 0; i < vertex_count * 3; ++i)
+		data0[i] = unsigned(i * i);
+	for (size_t i = 0; i < vertex_count; ++i)
+		data1[i] = unsigned(i * 7);
+
+	std::vector<unsigned char> buffer0(meshopt_encodeVertexBufferBound(vertex_count, 12));
+	buffer0.resize(meshopt_encodeVertexBuffer(&buffer0[0], buffer0.size(), &data0[0], vertex_count, 12));
+
+	std::vector<unsigned char> buffer1;
+	encodeVertexV1(buffer1, &data1[0], vertex_count, 4);
+
+	// two streams are decoded into an interleaved buffer with a gap that must be preserved
+	std::vector<unsigned int> decoded(vertex_count * 5, 0xdeadbeef);
+	assert(meshopt_decodeVertexBufferStrided(&decoded[0], vertex_count, 12, 20, &buffer0[0], buffer0.size()) == 0);
+	assert(meshopt_decodeVertexBufferStrided(&decoded[3], vertex_count, 4, 20, &buffer1[0], buffer1.size()) == 0);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		assert(memcmp(&decoded[i * 5], &data0[i * 3], 12) == 0);
+		assert(decoded[i * 5 + 3] == data1[i]);
+		assert(decoded[i * 5 + 4] == 0xdeadbeef);
+	}
+
+	// errors are reported the same way as for dense decoding
+	assert(meshopt_decodeVertexBufferStrided(&decoded[0], vertex_count, 12, 20, &buffer0[0], buffer0.size() - 1) < 0);
+}
+
+static void decodeFilterOct8()
+{
+	const unsigned char data[4 * 4] = {
+	    0, 1, 127, 0,
+	    0, 187, 127, 1,
+	    255, 1, 127, 0,
+	    14, 130, 127, 1, // clang-format :-/
 	};
 
-	const unsigned int expected[3] = {
-	    0xf7000200,
-	    0xf7ffd133,
-	    0xf7ffffcd,
+	const unsigned char expected[4 * 4] = {
+	    0, 1, 127, 0,
+	    0, 159, 82, 1,
+	    255, 1, 127, 0,
+	    1, 130, 241, 1, // clang-format :-/
 	};
 
-	unsigned int encoded[3];
-	meshopt_encodeFilterExp(encoded, 1, 12, 15, data);
+	// Aligned by 4
+	unsigned char full[4 * 4];
+	memcpy(full, data, sizeof(full));
+	meshopt_decodeFilterOct(full, 4, 4);
+	assert(memcmp(full, expected, sizeof(full)) == 0);
 
-	assert(memcmp(encoded, expected, sizeof(expected)) == 0);
+	// Tail processing for unaligned data
+	unsigned char tail[3 * 4];
+	memcpy(tail, data, sizeof(tail));
+	meshopt_decodeFilterOct(tail, 3, 4);
+	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+}
+
+static void decodeFilterOct12()
+{
+	const unsigned short data[4 * 4] = {
+	    0, 1, 2047, 0,
+	    0, 1870, 2047, 1,
+	    2017, 1, 2047, 0,
+	    14, 1300, 2047, 1, // clang-format :-/
+	};
+
+	const unsigned short expected[4 * 4] = {
+	    0, 16, 32767, 0,
+	    0, 32621, 3088, 1,
+	    32764, 16, 471, 0,
+	    307, 28541, 16093, 1, // clang-format :-/
+	};
+
+	// Aligned by 4
+	unsigned short full[4 * 4];
+	memcpy(full, data, sizeof(full));
+	meshopt_decodeFilterOct(full, 4, 8);
+	assert(memcmp(full, expected, sizeof(full)) == 0);
+
+	// Tail processing for unaligned data
+	unsigned short tail[3 * 4];
+	memcpy(tail, data, sizeof(tail));
+	meshopt_decodeFilterOct(tail, 3, 8);
+	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+}
+
+static void decodeFilterQuat12()
+{
+	const unsigned short data[4 * 4] = {
+	    0, 1, 0, 0x7fc,
+	    0, 1870, 0, 0x7fd,
+	    2017, 1, 0, 0x7fe,
+	    14, 1300, 0, 0x7ff, // clang-format :-/
+	};
+
+	const unsigned short expected[4 * 4] = {
+	    32767, 0, 11, 0,
+	    0, 25013, 0, 21166,
+	    11, 0, 23504, 22830,
+	    158, 14715, 0, 29277, // clang-format :-/
+	};
+
+	// Aligned by 4
+	unsigned short full[4 * 4];
+	memcpy(full, data, sizeof(full));
+	meshopt_decodeFilterQuat(full, 4, 8);
+	assert(memcmp(full, expected, sizeof(full)) == 0);
+
+	// Tail processing for unaligned data
+	unsigned short tail[3 * 4];
+	memcpy(tail, data, sizeof(tail));
+	meshopt_decodeFilterQuat(tail, 3, 8);
+	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+}
+
+static void decodeFilterExp()
+{
+	const unsigned int data[4] = {
+	    0,
+	    0xff000003,
+	    0x02fffff7,
+	    0xfe7fffff, // clang-format :-/
+	};
+
+	const unsigned int expected[4] = {
+	    0,
+	    0x3fc00000,
+	    0xc2100000,
+	    0x49fffffe, // clang-format :-/
+	};
+
+	// Aligned by 4
+	unsigned int full[4];
+	memcpy(full, data, sizeof(full));
+	meshopt_decodeFilterExp(full, 4, 4);
+	assert(memcmp(full, expected, sizeof(full)) == 0);
+
+	// Tail processing for unaligned data
+	unsigned int tail[3];
+	memcpy(tail, data, sizeof(tail));
+	meshopt_decodeFilterExp(tail, 3, 4);
+	assert(memcmp(tail, expected, sizeof(tail)) == 0);
+}
+
+static void decodeVertexFiltered()
+{
+	const size_t vertex_count = 1000;
+
+	std::vector<float> data(vertex_count * 4);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		float x = float(i % 7) - 3.f, y = float(i % 11) - 5.f, z = float(i % 13) - 6.f;
+		float l = sqrtf(x * x + y * y + z * z) + 1e-3f;
+
+		data[i * 4 + 0] = x / l;
+		data[i * 4 + 1] = y / l;
+		data[i * 4 + 2] = z / l;
+		data[i * 4 + 3] = float(i);
+	}
+
+	std::vector<unsigned char> oct(vertex_count * 8), quat(vertex_count * 8), exp(vertex_count * 8);
+	meshopt_encodeFilterOct(&oct[0], vertex_count, 8, 12, &data[0]);
+	meshopt_encodeFilterQuat(&quat[0], vertex_count, 8, 12, &data[0]);
+	meshopt_encodeFilterExp(&exp[0], vertex_count, 8, 15, &data[0]);
+
+	const unsigned char* inputs[] = {&oct[0], &quat[0], &exp[0]};
+	void (*filters[])(void*, size_t, size_t) = {meshopt_decodeFilterOct, meshopt_decodeFilterQuat, meshopt_decodeFilterExp};
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		std::vector<unsigned char> buffer(meshopt_encodeVertexBufferBound(vertex_count, 8));
+		buffer.resize(meshopt_encodeVertexBuffer(&buffer[0], buffer.size(), inputs[i], vertex_count, 8));
+
+		std::vector<unsigned char> expected(vertex_count * 8);
+		assert(meshopt_decodeVertexBuffer(&expected[0], vertex_count, 8, &buffer[0], buffer.size()) == 0);
+		filters[i](&expected[0], vertex_count, 8);
+
+		std::vector<unsigned char> decoded(vertex_count * 8);
+		assert(meshopt_decodeVertexBufferFiltered(&decoded[0], vertex_count, 8, &buffer[0], buffer.size(), filters[i]) == 0);
+		assert(decoded == expected);
+	}
+}
+
+void encodeFilterOct8()
+{
+	const float data[4 * 4] = {
+	    1, 0, 0, 0,
+	    0, -1, 0, 0,
+	    0.7071068f, 0, 0.707168f, 1,
+	    -0.7071068f, 0, -0.707168f, 1, // clang-format :-/
+	};
+
+	const unsigned char expected[4 * 4] = {
+	    0x7f, 0, 0x7f, 0,
+	    0, 0x81, 0x7f, 0,
+	    0x3f, 0, 0x7f, 0x7f,
+	    0x81, 0x40, 0x7f, 0x7f, // clang-format :-/
+	};
+
+	unsigned char encoded[4 * 4];
+	meshopt_encodeFilterOct(encoded, 4, 4, 8, data);
+
+	assert(memcmp(encoded, expected, sizeof(expected)) == 0);
+
+	signed char decoded[4 * 4];
+	memcpy(decoded, encoded, sizeof(decoded));
+	meshopt_decodeFilterOct(decoded, 4, 4);
+
+	for (size_t i = 0; i < 4 * 4; ++i)
+		assert(fabsf(decoded[i] / 127.f - data[i]) < 1e-2f);
+}
+
+void encodeFilterOct12()
+{
+	const float data[4 * 4] = {
+	    1, 0, 0, 0,
+	    0, -1, 0, 0,
+	    0.7071068f, 0, 0.707168f, 1,
+	    -0.7071068f, 0, -0.707168f, 1, // clang-format :-/
+	};
+
+	const unsigned short expected[4 * 4] = {
+	    0x7ff, 0, 0x7ff, 0,
+	    0x0, 0xf801, 0x7ff, 0,
+	    0x3ff, 0, 0x7ff, 0x7fff,
+	    0xf801, 0x400, 0x7ff, 0x7fff, // clang-format :-/
+	};
+
+	unsigned short encoded[4 * 4];
+	meshopt_encodeFilterOct(encoded, 4, 8, 12, data);
+
+	assert(memcmp(encoded, expected, sizeof(expected)) == 0);
+
+	short decoded[4 * 4];
+	memcpy(decoded, encoded, sizeof(decoded));
+	meshopt_decodeFilterOct(decoded, 4, 8);
+
+	for (size_t i = 0; i < 4 * 4; ++i)
+		assert(fabsf(decoded[i] / 32767.f - data[i]) < 1e-3f);
+}
+
+void encodeFilterQuat12()
+{
+	const float data[4 * 4] = {
+	    1, 0, 0, 0,
+	    0, -1, 0, 0,
+	    0.7071068f, 0, 0, 0.707168f,
+	    -0.7071068f, 0, 0, -0.707168f, // clang-format :-/
+	};
+
+	const unsigned short expected[4 * 4] = {
+	    0, 0, 0, 0x7fc,
+	    0, 0, 0, 0x7fd,
+	    0x7ff, 0, 0, 0x7ff,
+	    0x7ff, 0, 0, 0x7ff, // clang-format :-/
+	};
+
+	unsigned short encoded[4 * 4];
+	meshopt_encodeFilterQuat(encoded, 4, 8, 12, data);
+
+	assert(memcmp(encoded, expected, sizeof(expected)) == 0);
+
+	short decoded[4 * 4];
+	memcpy(decoded, encoded, sizeof(decoded));
+	meshopt_decodeFilterQuat(decoded, 4, 8);
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		float dx = decoded[i * 4 + 0] / 32767.f;
+		float dy = decoded[i * 4 + 1] / 32767.f;
+		float dz = decoded[i * 4 + 2] / 32767.f;
+		float dw = decoded[i * 4 + 3] / 32767.f;
+
+		float dp =
+		    data[i * 4 + 0] * dx +
+		    data[i * 4 + 1] * dy +
+		    data[i * 4 + 2] * dz +
+		    data[i * 4 + 3] * dw;
+
+		assert(fabsf(fabsf(dp) - 1.f) < 1e-4f);
+	}
+}
+
+void encodeFilterExp()
+{
+	const float data[3] = {
+	    1,
+	    -23.4f,
+	    -0.1f,
+	};
+
+	const unsigned int expected[3] = {
+	    0xf7000200,
+	    0xf7ffd133,
+	    0xf7ffffcd,
+	};
+
+	unsigned int encoded[3];
+	meshopt_encodeFilterExp(encoded, 1, 12, 15, data);
+
+	assert(memcmp(encoded, expected, sizeof(expected)) == 0);
+
+	float decoded[3];
+	memcpy(decoded, encoded, sizeof(decoded));
+	meshopt_decodeFilterExp(decoded, 3, 4);
+
+	for (size_t i = 0; i < 3; ++i)
+		assert(fabsf(decoded[i] - data[i]) < 1e-3f);
+}
+
+static void clusterBoundsDegenerate()
+{
+	const float vbd[] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+	const unsigned int ibd[] = {0, 0, 0};
+	const unsigned int ib1[] = {0, 1, 2};
+
+	// all of the bounds below are degenerate as they use 0 triangles, one topology-degenerate triangle and one position-degenerate triangle respectively
+	meshopt_Bounds bounds0 = meshopt_computeClusterBounds(0, 0, 0, 0, 12);
+	meshopt_Bounds boundsd = meshopt_computeClusterBounds(ibd, 3, vbd, 3, 12);
+	meshopt_Bounds bounds1 = meshopt_computeClusterBounds(ib1, 3, vbd, 3, 12);
+
+	assert(bounds0.center[0] == 0 && bounds0.center[1] == 0 && bounds0.center[2] == 0 && bounds0.radius == 0);
+	assert(boundsd.center[0] == 0 && boundsd.center[1] == 0 && boundsd.center[2] == 0 && boundsd.radius == 0);
+	assert(bounds1.center[0] == 0 && bounds1.center[1] == 0 && bounds1.center[2] == 0 && bounds1.radius == 0);
+
+	const float vb1[] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
+	const unsigned int ib2[] = {0, 1, 2, 0, 2, 1};
+
+	// these bounds have a degenerate cone since the cluster has two triangles with opposite normals
+	meshopt_Bounds bounds2 = meshopt_computeClusterBounds(ib2, 6, vb1, 3, 12);
+
+	assert(bounds2.cone_apex[0] == 0 && bounds2.cone_apex[1] == 0 && bounds2.cone_apex[2] == 0);
+	assert(bounds2.cone_axis[0] == 0 && bounds2.cone_axis[1] == 0 && bounds2.cone_axis[2] == 0);
+	assert(bounds2.cone_cutoff == 1);
+	assert(bounds2.cone_axis_s8[0] == 0 && bounds2.cone_axis_s8[1] == 0 && bounds2.cone_axis_s8[2] == 0);
+	assert(bounds2.cone_cutoff_s8 == 127);
+
+	// however, the bounding sphere needs to be in tact (here we only check bbox for simplicity)
+	assert(bounds2.center[0] - bounds2.radius <= 0 && bounds2.center[0] + bounds2.radius >= 1);
+	assert(bounds2.center[1] - bounds2.radius <= 0 && bounds2.center[1] + bounds2.radius >= 1);
+	assert(bounds2.center[2] - bounds2.radius <= 0 && bounds2.center[2] + bounds2.radius >= 1);
+}
+
+static void buildMeshletsParallel()
+{
+	const size_t N = 300;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(0.f);
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+	size_t index_count = ib.size();
+
+	const size_t max_vertices = 64, max_triangles = 124;
+
+	size_t max_meshlets = meshopt_buildMeshletsParallelBound(index_count, max_vertices, max_triangles);
+	std::vector<meshopt_Meshlet> meshlets(max_meshlets);
+	std::vector<unsigned int> meshlet_vertices(max_meshlets * max_vertices);
+	std::vector<unsigned char> meshlet_triangles(max_meshlets * max_triangles * 3);
+
+	size_t tasks = 0;
+	size_t meshlet_count = meshopt_buildMeshletsParallel(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], index_count, &vb[0], vertex_count, 12, max_vertices, max_triangles, 0.f, dispatchReverse, &tasks);
+
+	assert(tasks > 1);
+	assert(meshlet_count > 0 && meshlet_count <= max_meshlets);
+
+	// meshlets must use the regular tightly packed layout, and contain every input triangle exactly once
+	std::vector<unsigned long long> triangles, source;
+	size_t vertex_offset = 0, triangle_offset = 0;
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+
+		assert(m.vertex_offset == vertex_offset && m.triangle_offset == triangle_offset);
+		assert(m.vertex_count <= max_vertices && m.triangle_count <= max_triangles);
+
+		for (size_t j = 0; j < m.triangle_count * 3; j += 3)
+		{
+			unsigned int a = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 0]];
+			unsigned int b = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 1]];
+			unsigned int c = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 2]];
+
+			triangles.push_back((((unsigned long long)a) << 40) | (((unsigned long long)b) << 20) | c);
+		}
+
+		vertex_offset += m.vertex_count;
+		triangle_offset += (m.triangle_count * 3 + 3) & ~3;
+	}
+
+	for (size_t i = 0; i < index_count; i += 3)
+		source.push_back((((unsigned long long)ib[i + 0]) << 40) | (((unsigned long long)ib[i + 1]) << 20) | ib[i + 2]);
+
+	std::sort(triangles.begin(), triangles.end());
+	std::sort(source.begin(), source.end());
+	assert(triangles == source);
+
+	// small meshes are processed serially and match the regular builder
+	size_t small_count = 600 * 3;
+	std::vector<meshopt_Meshlet> smeshlets(meshopt_buildMeshletsBound(small_count, max_vertices, max_triangles));
+	std::vector<unsigned int> smeshlet_vertices(smeshlets.size() * max_vertices);
+	std::vector<unsigned char> smeshlet_triangles(smeshlets.size() * max_triangles * 3);
+
+	tasks = 0;
+	size_t scount = meshopt_buildMeshlets(&smeshlets[0], &smeshlet_vertices[0], &smeshlet_triangles[0], &ib[0], small_count, &vb[0], vertex_count, 12, max_vertices, max_triangles, 0.f);
+	assert(scount == meshopt_buildMeshletsParallel(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], small_count, &vb[0], vertex_count, 12, max_vertices, max_triangles, 0.f, dispatchReverse, &tasks));
+	assert(tasks == 0);
+
+	for (size_t i = 0; i < scount; ++i)
+	{
+		const meshopt_Meshlet& m = smeshlets[i];
+
+		assert(memcmp(&m, &meshlets[i], sizeof(m)) == 0);
+		assert(memcmp(&smeshlet_vertices[m.vertex_offset], &meshlet_vertices[m.vertex_offset], m.vertex_count * sizeof(unsigned int)) == 0);
+		assert(memcmp(&smeshlet_triangles[m.triangle_offset], &meshlet_triangles[m.triangle_offset], m.triangle_count * 3) == 0);
+	}
+}
+
+static void computeMeshletBoundsBatch()
+{
+	const size_t N = 150;
+
+	// curved grid so that meshlets get non-trivial normal cones
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(sinf(float(x) * 0.1f) * 4.f);
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+
+	const size_t max_vertices = 64, max_triangles = 124;
+
+	size_t max_meshlets = meshopt_buildMeshletsBound(ib.size(), max_vertices, max_triangles);
+	std::vector<meshopt_Meshlet> meshlets(max_meshlets);
+	std::vector<unsigned int> meshlet_vertices(max_meshlets * max_vertices);
+	std::vector<unsigned char> meshlet_triangles(max_meshlets * max_triangles * 3);
+
+	size_t meshlet_count = meshopt_buildMeshlets(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], ib.size(), &vb[0], vertex_count, 12, max_vertices, max_triangles, 0.f);
+
+	std::vector<meshopt_Bounds> bounds(meshlet_count), batch(meshlet_count), serial(meshlet_count);
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+		bounds[i] = meshopt_computeMeshletBounds(&meshlet_vertices[m.vertex_offset], &meshlet_triangles[m.triangle_offset], m.triangle_count, &vb[0], vertex_count, 12);
+	}
+
+	size_t tasks = 0;
+	meshopt_computeMeshletBoundsBatch(&batch[0], &meshlets[0], meshlet_count, &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], vertex_count, 12, dispatchReverse, &tasks);
+	assert(tasks > 1);
+
+	meshopt_computeMeshletBoundsBatch(&serial[0], &meshlets[0], meshlet_count, &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], vertex_count, 12, NULL, NULL);
+
+	assert(memcmp(&bounds[0], &batch[0], meshlet_count * sizeof(meshopt_Bounds)) == 0);
+	assert(memcmp(&bounds[0], &serial[0], meshlet_count * sizeof(meshopt_Bounds)) == 0);
+
+	// compact culling data must decode to a sphere that contains the original sphere
+	float box_min[3] = {0.f, 0.f, -4.f};
+	float box_size = float(N);
+
+	std::vector<meshopt_MeshletCullData> cull(meshlet_count);
+	meshopt_computeMeshletCullData(&cull[0], &meshlets[0], meshlet_count, &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], vertex_count, 12, box_min, box_size, dispatchReverse, &tasks);
+
+	float step = box_size / 65535.f;
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Bounds& b = bounds[i];
+		const meshopt_MeshletCullData& c = cull[i];
+
+		float dx = box_min[0] + c.center[0] * step - b.center[0];
+		float dy = box_min[1] + c.center[1] * step - b.center[1];
+		float dz = box_min[2] + c.center[2] * step - b.center[2];
+
+		assert(sqrtf(dx * dx + dy * dy + dz * dz) + b.radius <= c.radius * step);
+		assert(c.radius * step <= b.radius + 4 * step);
+
+		assert(memcmp(c.cone_axis_s8, b.cone_axis_s8, 3) == 0 && c.cone_cutoff_s8 == b.cone_cutoff_s8);
+	}
+
+	// radii that don't fit into the box are clamped to the maximum value
+	meshopt_computeMeshletCullData(&cull[0], &meshlets[0], meshlet_count, &meshlet_vertices[0], &meshlet_triangles[0], &vb[0], vertex_count, 12, box_min, 2.f, NULL, NULL);
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+		assert(bounds[i].radius < 2.f || cull[i].radius == 65535);
+}
+
+static void optimizeVertexCacheParallel()
+{
+	const size_t N = 300;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(0.f);
+		}
+
+	// triangles are emitted in a scrambled order to give the optimizer some work to do
+	std::vector<unsigned int> ib;
+	for (size_t i = 0; i < N * N; ++i)
+	{
+		size_t cell = (i * 7919) % (N * N);
+		unsigned int v = unsigned(cell / N * (N + 1) + cell % N);
+
+		ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+		ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+	}
+
+	size_t vertex_count = vb.size() / 3;
+	size_t index_count = ib.size();
+
+	std::vector<unsigned int> result(index_count);
+
+	size_t tasks = 0;
+	meshopt_optimizeVertexCacheParallel(&result[0], &ib[0], index_count, &vb[0], vertex_count, 12, dispatchReverse, &tasks);
+
+	assert(tasks > 1);
+
+	// result must contain every input triangle exactly once, without rotating it
+	std::vector<unsigned long long> triangles, source;
+
+	for (size_t i = 0; i < index_count; i += 3)
+	{
+		triangles.push_back((((unsigned long long)result[i + 0]) << 40) | (((unsigned long long)result[i + 1]) << 20) | result[i + 2]);
+		source.push_back((((unsigned long long)ib[i + 0]) << 40) | (((unsigned long long)ib[i + 1]) << 20) | ib[i + 2]);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+	std::sort(source.begin(), source.end());
+	assert(triangles == source);
+
+	// partitioning shouldn't significantly affect the efficiency
+	std::vector<unsigned int> serial(index_count);
+	meshopt_optimizeVertexCache(&serial[0], &ib[0], index_count, vertex_count);
+
+	float acmr_serial = meshopt_analyzeVertexCache(&serial[0], index_count, vertex_count, 16, 0, 0).acmr;
+	float acmr_parallel = meshopt_analyzeVertexCache(&result[0], index_count, vertex_count, 16, 0, 0).acmr;
+
+	assert(acmr_parallel < acmr_serial * 1.05f);
+
+	// in-place optimization is supported
+	tasks = 0;
+	meshopt_optimizeVertexCacheParallel(&ib[0], &ib[0], index_count, &vb[0], vertex_count, 12, dispatchReverse, &tasks);
+	assert(tasks > 1);
+	assert(ib == result);
+
+	// small meshes are processed serially and match the regular optimizer
+	size_t small_count = 600 * 3;
+
+	tasks = 0;
+	meshopt_optimizeVertexCache(&serial[0], &ib[0], small_count, vertex_count);
+	meshopt_optimizeVertexCacheParallel(&result[0], &ib[0], small_count, &vb[0], vertex_count, 12, dispatchReverse, &tasks);
+	assert(tasks == 0);
+	assert(memcmp(&serial[0], &result[0], small_count * sizeof(unsigned int)) == 0);
+}
+
+static void optimizeVertexCacheTable()
+{
+	const size_t N = 40;
+
+	// triangles are emitted in a scrambled order to give the optimizer some work to do
+	std::vector<unsigned int> ib;
+	for (size_t i = 0; i < N * N; ++i)
+	{
+		size_t cell = (i * 1031) % (N * N);
+		unsigned int v = unsigned(cell / N * (N + 1) + cell % N);
+
+		ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+		ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+	}
+
+	size_t vertex_count = (N + 1) * (N + 1);
+	size_t index_count = ib.size();
+
+	// same values as the table used by meshopt_optimizeVertexCache
+	const meshopt_VertexScoreTable table = {
+	    {0.779f, 0.791f, 0.789f, 0.981f, 0.843f, 0.726f, 0.847f, 0.882f, 0.867f, 0.799f, 0.642f, 0.613f, 0.600f, 0.568f, 0.372f, 0.234f},
+	    {0.995f, 0.713f, 0.450f, 0.404f, 0.059f, 0.005f, 0.147f, 0.006f},
+	};
+
+	std::vector<unsigned int> expected(index_count), result(index_count);
+	meshopt_optimizeVertexCache(&expected[0], &ib[0], index_count, vertex_count);
+	meshopt_optimizeVertexCacheTable(&result[0], &ib[0], index_count, vertex_count, &table);
+	assert(result == expected);
+
+	// a table that mostly rewards cache hits still produces a valid and reasonably efficient order
+	meshopt_VertexScoreTable fifo = {};
+	for (int i = 0; i < 16; ++i)
+		fifo.cache[i] = 1.f - float(i) / 16.f;
+	for (int i = 0; i < 8; ++i)
+		fifo.live[i] = 0.1f;
+
+	meshopt_optimizeVertexCacheTable(&result[0], &ib[0], index_count, vertex_count, &fifo);
+
+	// result must contain every input triangle exactly once
+	std::vector<unsigned long long> triangles, source;
+
+	for (size_t i = 0; i < index_count; i += 3)
+	{
+		triangles.push_back((((unsigned long long)result[i + 0]) << 40) | (((unsigned long long)result[i + 1]) << 20) | result[i + 2]);
+		source.push_back((((unsigned long long)ib[i + 0]) << 40) | (((unsigned long long)ib[i + 1]) << 20) | ib[i + 2]);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+	std::sort(source.begin(), source.end());
+	assert(triangles == source);
+
+	float acmr_input = meshopt_analyzeVertexCache(&ib[0], index_count, vertex_count, 16, 0, 0).acmr;
+	float acmr_fifo = meshopt_analyzeVertexCache(&result[0], index_count, vertex_count, 16, 0, 0).acmr;
+	assert(acmr_fifo < acmr_input);
+
+	// works in place and with 16-bit indices
+	std::vector<unsigned short> ib16(index_count);
+	for (size_t i = 0; i < index_count; ++i)
+		ib16[i] = (unsigned short)ib[i];
+
+	meshopt_optimizeVertexCacheTable(&ib16[0], &ib16[0], index_count, vertex_count, &table);
+
+	for (size_t i = 0; i < index_count; ++i)
+		assert(ib16[i] == expected[i]);
+}
+
+static void optimizeVertexCacheIncremental()
+{
+	const size_t N = 40;
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = (N + 1) * (N + 1);
+	size_t index_count = ib.size();
+
+	std::vector<unsigned int> optimized(index_count);
+	meshopt_optimizeVertexCache(&optimized[0], &ib[0], index_count, vertex_count);
+
+	// scramble a range of triangles to simulate a local edit
+	const size_t edit_begin = 1000, edit_size = 40;
+
+	std::vector<unsigned int> edited = optimized;
+	std::vector<unsigned int> dirty;
+
+	for (size_t i = 0; i < edit_size; ++i)
+	{
+		size_t src = edit_begin + (i * 17) % edit_size;
+
+		for (int k = 0; k < 3; ++k)
+			edited[(edit_begin + i) * 3 + k] = optimized[src * 3 + k];
+
+		dirty.push_back(unsigned(edit_begin + i));
+	}
+
+	std::vector<unsigned int> result(index_count);
+
+	// no dirty triangles: the buffer is copied as is
+	assert(meshopt_optimizeVertexCacheIncremental(&result[0], &edited[0], index_count, vertex_count, NULL, 0) == 0);
+	assert(result == edited);
+
+	size_t reoptimized = meshopt_optimizeVertexCacheIncremental(&result[0], &edited[0], index_count, vertex_count, &dirty[0], dirty.size());
+	assert(reoptimized == edit_size + 64 * 2);
+
+	// triangles outside of the window stay in place
+	for (size_t i = 0; i < index_count; ++i)
+		if (i / 3 < edit_begin - 64 || i / 3 >= edit_begin + edit_size + 64)
+			assert(result[i] == edited[i]);
+
+	// result must contain every input triangle exactly once
+	std::vector<unsigned long long> triangles, source;
+
+	for (size_t i = 0; i < index_count; i += 3)
+	{
+		triangles.push_back((((unsigned long long)result[i + 0]) << 40) | (((unsigned long long)result[i + 1]) << 20) | result[i + 2]);
+		source.push_back((((unsigned long long)edited[i + 0]) << 40) | (((unsigned long long)edited[i + 1]) << 20) | edited[i + 2]);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+	std::sort(source.begin(), source.end());
+	assert(triangles == source);
+
+	float acmr_edited = meshopt_analyzeVertexCache(&edited[0], index_count, vertex_count, 16, 0, 0).acmr;
+	float acmr_result = meshopt_analyzeVertexCache(&result[0], index_count, vertex_count, 16, 0, 0).acmr;
+	assert(acmr_result < acmr_edited);
+
+	// works in place and with 16-bit indices
+	std::vector<unsigned short> ib16(index_count);
+	for (size_t i = 0; i < index_count; ++i)
+		ib16[i] = (unsigned short)edited[i];
+
+	meshopt_optimizeVertexCacheIncremental(&ib16[0], &ib16[0], index_count, vertex_count, &dirty[0], dirty.size());
+
+	for (size_t i = 0; i < index_count; ++i)
+		assert(ib16[i] == result[i]);
+}
+
+static void optimizeVertexFetchRemapIncremental()
+{
+	const size_t N = 40;
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = (N + 1) * (N + 1);
+	size_t index_count = ib.size();
+
+	meshopt_optimizeVertexCache(&ib[0], &ib[0], index_count, vertex_count);
+
+	// when all vertices are dirty, the result matches the regular remap
+	std::vector<unsigned int> all(vertex_count);
+	for (size_t i = 0; i < vertex_count; ++i)
+		all[i] = unsigned(i);
+
+	std::vector<unsigned int> expected(vertex_count), remap(vertex_count);
+	meshopt_optimizeVertexFetchRemap(&expected[0], &ib[0], index_count, vertex_count);
+	meshopt_optimizeVertexFetchRemapIncremental(&remap[0], &ib[0], index_count, vertex_count, &all[0], all.size());
+	assert(remap == expected);
+
+	// mark vertices of a range of triangles as dirty, plus a vertex that isn't referenced by them
+	std::vector<unsigned char> dirty(vertex_count);
+	std::vector<unsigned int> dirty_vertices;
+
+	for (size_t i = 1200 * 3; i < 1400 * 3; ++i)
+		if (!dirty[ib[i]])
+		{
+			dirty[ib[i]] = 1;
+			dirty_vertices.push_back(ib[i]);
+		}
+
+	unsigned int extra = ib[0];
+	assert(!dirty[extra]);
+	dirty[extra] = 1;
+	dirty_vertices.push_back(extra);
+
+	size_t changed = meshopt_optimizeVertexFetchRemapIncremental(&remap[0], &ib[0], index_count, vertex_count, &dirty_vertices[0], dirty_vertices.size());
+	assert(changed > 0 && changed <= dirty_vertices.size());
+
+	// dirty vertices are permuted among their own positions, other vertices keep theirs
+	std::vector<unsigned char> used(vertex_count);
+	size_t moved = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		assert(remap[i] < vertex_count && !used[remap[i]]);
+		used[remap[i]] = 1;
+
+		assert(dirty[i] ? dirty[remap[i]] : remap[i] == i);
+		moved += remap[i] != i;
+	}
+
+	assert(moved == changed);
+
+	// works with 16-bit indices
+	std::vector<unsigned short> ib16(index_count);
+	for (size_t i = 0; i < index_count; ++i)
+		ib16[i] = (unsigned short)ib[i];
+
+	std::vector<unsigned int> remap16(vertex_count);
+	meshopt_optimizeVertexFetchRemapIncremental(&remap16[0], &ib16[0], index_count, vertex_count, &dirty_vertices[0], dirty_vertices.size());
+	assert(remap16 == remap);
+}
+
+static void buildMeshletsIncremental()
+{
+	const size_t N = 60;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(0.f);
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+
+	const size_t max_vertices = 64, max_triangles = 124;
+
+	// reserve space for rebuilding up to the entire mesh
+	size_t max_meshlets = meshopt_buildMeshletsBound(ib.size(), max_vertices, max_triangles) * 2;
+	std::vector<meshopt_Meshlet> meshlets(max_meshlets);
+	std::vector<unsigned int> meshlet_vertices(max_meshlets * max_vertices);
+	std::vector<unsigned char> meshlet_triangles(max_meshlets * max_triangles * 3);
+
+	size_t meshlet_count = meshopt_buildMeshlets(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], ib.size(), &vb[0], vertex_count, 12, max_vertices, max_triangles, 0.f);
+	assert(meshlet_count > 4);
+
+	std::vector<std::vector<unsigned long long> > original(meshlet_count);
+	std::vector<unsigned long long> source;
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+
+		for (size_t j = 0; j < m.triangle_count * 3; j += 3)
+		{
+			unsigned int a = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 0]];
+			unsigned int b = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 1]];
+			unsigned int c = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 2]];
+
+			original[i].push_back((((unsigned long long)a) << 40) | (((unsigned long long)b) << 20) | c);
+		}
+
+		source.insert(source.end(), original[i].begin(), original[i].end());
+	}
+
+	// rebuild two meshlets from their own triangles
+	const unsigned int dirty[] = {1, 3};
+
+	size_t result_count = meshopt_buildMeshletsIncremental(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], meshlet_count, dirty, 2, NULL, 0, &vb[0], vertex_count, 12, max_vertices, max_triangles, 0.f);
+	assert(result_count >= meshlet_count);
+
+	std::vector<unsigned long long> triangles;
+
+	for (size_t i = 0; i < result_count; ++i)
+	{
+		const meshopt_Meshlet& m = meshlets[i];
+		assert(m.vertex_count <= max_vertices && m.triangle_count <= max_triangles);
+
+		std::vector<unsigned long long> meshlet;
+
+		for (size_t j = 0; j < m.triangle_count * 3; j += 3)
+		{
+			unsigned int a = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 0]];
+			unsigned int b = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 1]];
+			unsigned int c = meshlet_vertices[m.vertex_offset + meshlet_triangles[m.triangle_offset + j + 2]];
+
+			meshlet.push_back((((unsigned long long)a) << 40) | (((unsigned long long)b) << 20) | c);
+		}
+
+		// remaining meshlets come first, in their original order
+		if (i < meshlet_count - 2)
+		{
+			size_t src = i + (i >= 1) + (i >= 2);
+			assert(meshlet == original[src]);
+		}
+
+		triangles.insert(triangles.end(), meshlet.begin(), meshlet.end());
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+	std::sort(source.begin(), source.end());
+	assert(triangles == source);
+
+	// new triangles can be supplied explicitly; here, the first meshlet is replaced with a single triangle
+	size_t replaced_count = meshopt_buildMeshletsIncremental(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], result_count, dirty, 1, &ib[0], 3, &vb[0], vertex_count, 12, max_vertices, max_triangles, 0.f);
+	assert(replaced_count == result_count);
+
+	const meshopt_Meshlet& last = meshlets[replaced_count - 1];
+	assert(last.vertex_count == 3 && last.triangle_count == 1);
+	assert(meshlet_vertices[last.vertex_offset + meshlet_triangles[last.triangle_offset + 0]] == ib[0]);
+	assert(meshlet_vertices[last.vertex_offset + meshlet_triangles[last.triangle_offset + 1]] == ib[1]);
+	assert(meshlet_vertices[last.vertex_offset + meshlet_triangles[last.triangle_offset + 2]] == ib[2]);
+}
+
+static void analyzeOverdrawParallel()
+{
+	const size_t N = 50;
+
+	// a wavy surface folded over itself produces nontrivial overdraw from all directions
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(float((x * 7 + y * 3) % 11));
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+
+	meshopt_OverdrawStatistics serial = meshopt_analyzeOverdraw(&ib[0], ib.size(), &vb[0], vertex_count, 12);
+	assert(serial.pixels_covered > 0 && serial.pixels_shaded > serial.pixels_covered);
+
+	// default resolution matches the regular analyzer
+	size_t tasks = 0;
+	meshopt_OverdrawStatistics parallel = meshopt_analyzeOverdrawParallel(&ib[0], ib.size(), &vb[0], vertex_count, 12, 256, dispatchReverse, &tasks);
+
+	assert(tasks == 3);
+	assert(parallel.pixels_covered == serial.pixels_covered);
+	assert(parallel.pixels_shaded == serial.pixels_shaded);
+	assert(parallel.overdraw == serial.overdraw);
+
+	// dispatch is optional
+	meshopt_OverdrawStatistics inline_ = meshopt_analyzeOverdrawParallel(&ib[0], ib.size(), &vb[0], vertex_count, 12, 256, NULL, NULL);
+	assert(inline_.pixels_shaded == serial.pixels_shaded);
+
+	// lower resolution covers fewer pixels and produces a coarser overdraw estimate; odd resolutions exercise row padding
+	meshopt_OverdrawStatistics low = meshopt_analyzeOverdrawParallel(&ib[0], ib.size(), &vb[0], vertex_count, 12, 63, dispatchReverse, &tasks);
+	assert(low.pixels_covered > 0 && low.pixels_covered < serial.pixels_covered / 4 + 1000);
+	assert(low.overdraw >= 1.f);
+}
+
+static void analyzeMesh()
+{
+	const size_t N = 40;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(float((x * 5 + y * 3) % 7));
+		}
+
+	// scrambled triangle order produces partially filled warps and cache misses
+	std::vector<unsigned int> ib;
+	for (size_t i = 0; i < N * N; ++i)
+	{
+		size_t cell = (i * 499) % (N * N);
+		unsigned int v = unsigned(cell / N * (N + 1) + cell % N);
+
+		ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+		ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+	}
+
+	size_t vertex_count = vb.size() / 3;
+	size_t index_count = ib.size();
+
+	meshopt_VertexCacheStatistics vcs = meshopt_analyzeVertexCache(&ib[0], index_count, vertex_count, 16, 32, 64);
+	meshopt_VertexFetchStatistics vfs = meshopt_analyzeVertexFetch(&ib[0], index_count, vertex_count, 12);
+	meshopt_OverdrawStatistics os = meshopt_analyzeOverdraw(&ib[0], index_count, &vb[0], vertex_count, 12);
+
+	unsigned int vertex_histogram[33];
+	unsigned int triangle_histogram[65];
+
+	meshopt_MeshStatistics ms = meshopt_analyzeMesh(&ib[0], index_count, &vb[0], vertex_count, 12, 12, 16, 32, 64, vertex_histogram, triangle_histogram);
+
+	assert(ms.vertex_cache.vertices_transformed == vcs.vertices_transformed);
+	assert(ms.vertex_cache.warps_executed == vcs.warps_executed);
+	assert(ms.vertex_cache.acmr == vcs.acmr);
+	assert(ms.vertex_cache.atvr == vcs.atvr);
+
+	assert(ms.vertex_fetch.bytes_fetched == vfs.bytes_fetched);
+	assert(ms.vertex_fetch.overfetch == vfs.overfetch);
+
+	assert(ms.overdraw.pixels_covered == os.pixels_covered);
+	assert(ms.overdraw.pixels_shaded == os.pixels_shaded);
+	assert(ms.overdraw.overdraw == os.overdraw);
+
+	// histograms account for every warp, vertex and triangle
+	unsigned int warps = 0, vertices = 0, triangles = 0, twarps = 0;
+
+	for (unsigned int i = 0; i <= 32; ++i)
+		warps += vertex_histogram[i], vertices += vertex_histogram[i] * i;
+
+	for (unsigned int i = 0; i <= 64; ++i)
+		twarps += triangle_histogram[i], triangles += triangle_histogram[i] * i;
+
+	assert(warps == vcs.warps_executed && twarps == vcs.warps_executed);
+	assert(vertices == vcs.vertices_transformed);
+	assert(triangles == index_count / 3);
+	assert(vertex_histogram[0] == 0 && triangle_histogram[0] == 0);
+
+	// histograms are optional
+	meshopt_MeshStatistics msn = meshopt_analyzeMesh(&ib[0], index_count, &vb[0], vertex_count, 12, 12, 16, 0, 0, NULL, NULL);
+	meshopt_VertexCacheStatistics vcsn = meshopt_analyzeVertexCache(&ib[0], index_count, vertex_count, 16, 0, 0);
+
+	assert(msn.vertex_cache.vertices_transformed == vcsn.vertices_transformed);
+	assert(msn.vertex_cache.warps_executed == 1);
+}
+
+static void spatialSortParallel()
+{
+	const size_t vertex_count = 200000;
+
+	// pseudo-random points with many duplicate Morton codes to exercise sort stability
+	std::vector<float> vb(vertex_count * 4);
+	unsigned int seed = 42;
+
+	for (size_t i = 0; i < vertex_count * 4; ++i)
+	{
+		seed = seed * 1103515245 + 12345;
+		vb[i] = float((seed >> 16) % 2000) * 0.5f;
+	}
+
+	std::vector<unsigned int> remap(vertex_count), premap(vertex_count);
+	meshopt_spatialSortRemap(&remap[0], &vb[0], vertex_count, 16);
+
+	size_t tasks = 0;
+	meshopt_spatialSortRemapParallel(&premap[0], &vb[0], vertex_count, 16, dispatchReverse, &tasks);
+
+	assert(tasks > 1);
+	assert(remap == premap);
+}
+
+static void generateIndexParallel()
+{
+	const size_t N = 200;
+
+	// grid with 3 unique vertices per triangle; positions are shared between triangles, and every other vertex has a distinct attribute
+	std::vector<float> vb;
+	std::vector<unsigned int> ib;
+
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			static const int corners[6][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 0}, {1, 1}, {0, 1}};
+
+			for (int k = 0; k < 6; ++k)
+			{
+				ib.push_back(unsigned(vb.size() / 4));
+
+				vb.push_back(float(x + corners[k][0]));
+				vb.push_back(float(y + corners[k][1]));
+				vb.push_back(0.f);
+				vb.push_back(float((ib.size() / 2) % 2));
+			}
+		}
+
+	// reverse the triangle order so that vertices are first referenced out of order
+	std::reverse(ib.begin(), ib.end());
+
+	size_t vertex_count = vb.size() / 4;
+	size_t index_count = ib.size();
+
+	size_t tasks = 0;
+
+	std::vector<unsigned int> remap(vertex_count), premap(vertex_count);
+	size_t unique = meshopt_generateVertexRemap(&remap[0], &ib[0], index_count, &vb[0], vertex_count, 16);
+	assert(unique < vertex_count);
+	assert(meshopt_generateVertexRemapParallel(&premap[0], &ib[0], index_count, &vb[0], vertex_count, 16, dispatchReverse, &tasks) == unique);
+	assert(remap == premap);
+	assert(tasks > 1);
+
+	// unindexed variant and unreferenced vertices
+	unique = meshopt_generateVertexRemap(&remap[0], NULL, vertex_count, &vb[0], vertex_count, 12);
+	assert(meshopt_generateVertexRemapParallel(&premap[0], NULL, vertex_count, &vb[0], vertex_count, 12, dispatchReverse, &tasks) == unique);
+	assert(remap == premap);
+
+	unique = meshopt_generateVertexRemap(&remap[0], &ib[0], index_count / 2, &vb[0], vertex_count, 16);
+	assert(meshopt_generateVertexRemapParallel(&premap[0], &ib[0], index_count / 2, &vb[0], vertex_count, 16, dispatchReverse, &tasks) == unique);
+	assert(remap == premap);
+
+	std::vector<unsigned int> shadow(index_count), pshadow(index_count);
+	meshopt_generateShadowIndexBuffer(&shadow[0], &ib[0], index_count, &vb[0], vertex_count, 12, 16);
+	meshopt_generateShadowIndexBufferParallel(&pshadow[0], &ib[0], index_count, &vb[0], vertex_count, 12, 16, dispatchReverse, &tasks);
+	assert(shadow == pshadow);
+
+	std::vector<unsigned int> adjacency(index_count * 2), padjacency(index_count * 2);
+	meshopt_generateAdjacencyIndexBuffer(&adjacency[0], &ib[0], index_count, &vb[0], vertex_count, 16);
+	meshopt_generateAdjacencyIndexBufferParallel(&padjacency[0], &ib[0], index_count, &vb[0], vertex_count, 16, dispatchReverse, &tasks);
+	assert(adjacency == padjacency);
+
+	std::vector<unsigned int> tess(index_count * 4), ptess(index_count * 4);
+	meshopt_generateTessellationIndexBuffer(&tess[0], &ib[0], index_count, &vb[0], vertex_count, 16);
+	meshopt_generateTessellationIndexBufferParallel(&ptess[0], &ib[0], index_count, &vb[0], vertex_count, 16, dispatchReverse, &tasks);
+	assert(tess == ptess);
+}
+
+static void optimizeVertexFetchMulti()
+{
+	// 0 1 2 3 4; vertex 4 is unused
+	float pn[] = {0, 0, 1, 1, 2, 2, 3, 3, 4, 4};
+	unsigned char color[] = {10, 11, 12, 13, 14};
+	unsigned int ib[] = {3, 1, 0, 3, 2, 1};
+
+	// first stream is interleaved with the second component of pn
+	meshopt_Stream streams[] = {
+	    {pn, sizeof(float), sizeof(float) * 2},
+	    {color, 1, 1},
+	};
+
+	float pos[5] = {};
+	void* destinations[] = {pos, color};
+
+	unsigned int remap[5];
+	unsigned int expected_ib[6];
+	size_t expected_count = meshopt_optimizeVertexFetchRemap(remap, ib, 6, 5);
+	meshopt_remapIndexBuffer(expected_ib, ib, 6, remap);
+
+	assert(meshopt_optimizeVertexFetchMulti(destinations, ib, 6, 5, streams, 2) == expected_count);
+	assert(expected_count == 4);
+	assert(memcmp(ib, expected_ib, sizeof(ib)) == 0);
+
+	float expected_pos[] = {3, 1, 0, 2};
+	unsigned char expected_color[] = {13, 11, 10, 12};
+
+	assert(memcmp(pos, expected_pos, sizeof(expected_pos)) == 0);
+	assert(memcmp(color, expected_color, sizeof(expected_color)) == 0);
+}
+
+static void buildClusterLod()
+{
+	const size_t N = 60;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(float((x * 7 + y * 13) % 5) * 0.05f);
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+	size_t index_count = ib.size();
+
+	const size_t max_vertices = 64, max_triangles = 124;
+
+	size_t max_clusters = meshopt_buildClusterLodBound(index_count, max_vertices, max_triangles);
+	std::vector<meshopt_ClusterLod> clusters(max_clusters);
+	std::vector<unsigned int> cluster_vertices(max_clusters * max_vertices);
+	std::vector<unsigned char> cluster_triangles(max_clusters * max_triangles * 3);
+
+	size_t cluster_count = meshopt_buildClusterLod(&clusters[0], &cluster_vertices[0], &cluster_triangles[0], &ib[0], index_count, &vb[0], vertex_count, 12, max_vertices, max_triangles);
+	assert(cluster_count > 0 && cluster_count <= max_clusters);
+
+	unsigned int max_level = 0;
+	size_t base_triangles = 0;
+
+	for (size_t i = 0; i < cluster_count; ++i)
+	{
+		const meshopt_ClusterLod& c = clusters[i];
+
+		assert(c.meshlet.vertex_count <= max_vertices && c.meshlet.triangle_count <= max_triangles);
+
+		for (size_t j = 0; j < c.meshlet.vertex_count; ++j)
+			assert(cluster_vertices[c.meshlet.vertex_offset + j] < vertex_count);
 
-	float decoded[3];
-	memcpy(decoded, encoded, sizeof(decoded));
-	meshopt_decodeFilterExp(decoded, 3, 4);
+		// the hierarchy must be monotonic for the selection to produce a consistent cut
+		assert(c.parent_error >= c.lod_error);
 
-	for (size_t i = 0; i < 3; ++i)
-		assert(fabsf(decoded[i] - data[i]) < 1e-3f);
-}
+		float dx = c.parent_bounds[0] - c.lod_bounds[0], dy = c.parent_bounds[1] - c.lod_bounds[1], dz = c.parent_bounds[2] - c.lod_bounds[2];
+		assert(sqrtf(dx * dx + dy * dy + dz * dz) + c.lod_bounds[3] <= c.parent_bounds[3] * 1.001f + 1e-3f);
 
-static void clusterBoundsDegenerate()
-{
-	const float vbd[] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
-	const unsigned int ibd[] = {0, 0, 0};
-	const unsigned int ib1[] = {0, 1, 2};
+		assert((c.level == 0) == (c.refined == ~0u));
+		assert((c.group == ~0u) == (c.parent_error == FLT_MAX));
 
-	// all of the bounds below are degenerate as they use 0 triangles, one topology-degenerate triangle and one position-degenerate triangle respectively
-	meshopt_Bounds bounds0 = meshopt_computeClusterBounds(0, 0, 0, 0, 12);
-	meshopt_Bounds boundsd = meshopt_computeClusterBounds(ibd, 3, vbd, 3, 12);
-	meshopt_Bounds bounds1 = meshopt_computeClusterBounds(ib1, 3, vbd, 3, 12);
+		max_level = std::max(max_level, c.level);
+		base_triangles += c.level == 0 ? c.meshlet.triangle_count : 0;
+	}
 
-	assert(bounds0.center[0] == 0 && bounds0.center[1] == 0 && bounds0.center[2] == 0 && bounds0.radius == 0);
-	assert(boundsd.center[0] == 0 && boundsd.center[1] == 0 && boundsd.center[2] == 0 && boundsd.radius == 0);
-	assert(bounds1.center[0] == 0 && bounds1.center[1] == 0 && bounds1.center[2] == 0 && bounds1.radius == 0);
+	assert(base_triangles == index_count / 3);
+	assert(max_level > 1);
 
-	const float vb1[] = {1, 0, 0, 0, 1, 0, 0, 0, 1};
-	const unsigned int ib2[] = {0, 1, 2, 0, 2, 1};
+	// selecting a cut with a given error threshold must cover the mesh and use fewer triangles as the threshold increases
+	size_t fine = 0, coarse = 0;
 
-	// these bounds have a degenerate cone since the cluster has two triangles with opposite normals
-	meshopt_Bounds bounds2 = meshopt_computeClusterBounds(ib2, 6, vb1, 3, 12);
+	for (size_t i = 0; i < cluster_count; ++i)
+	{
+		const meshopt_ClusterLod& c = clusters[i];
 
-	assert(bounds2.cone_apex[0] == 0 && bounds2.cone_apex[1] == 0 && bounds2.cone_apex[2] == 0);
-	assert(bounds2.cone_axis[0] == 0 && bounds2.cone_axis[1] == 0 && bounds2.cone_axis[2] == 0);
-	assert(bounds2.cone_cutoff == 1);
-	assert(bounds2.cone_axis_s8[0] == 0 && bounds2.cone_axis_s8[1] == 0 && bounds2.cone_axis_s8[2] == 0);
-	assert(bounds2.cone_cutoff_s8 == 127);
+		fine += (c.lod_error <= 0.f && c.parent_error > 0.f) ? c.meshlet.triangle_count : 0;
+		coarse += (c.lod_error <= 1e3f && c.parent_error > 1e3f) ? c.meshlet.triangle_count : 0;
+	}
 
-	// however, the bounding sphere needs to be in tact (here we only check bbox for simplicity)
-	assert(bounds2.center[0] - bounds2.radius <= 0 && bounds2.center[0] + bounds2.radius >= 1);
-	assert(bounds2.center[1] - bounds2.radius <= 0 && bounds2.center[1] + bounds2.radius >= 1);
-	assert(bounds2.center[2] - bounds2.radius <= 0 && bounds2.center[2] + bounds2.radius >= 1);
+	assert(fine == index_count / 3);
+	assert(coarse > 0 && coarse < fine / 4);
 }
 
 static size_t allocCount;
@@ -840,6 +2514,324 @@ static void customAllocator()
 	allocCount = freeCount = 0;
 }
 
+struct ProfileStats
+{
+	const char* stack[8];
+	size_t depth;
+
+	size_t begins;
+	size_t counters;
+	size_t passes;
+};
+
+static void profileCallback(void* context, int event, const char* name, size_t value)
+{
+	ProfileStats& stats = *static_cast<ProfileStats*>(context);
+
+	if (event == meshopt_ProfileBegin)
+	{
+		assert(stats.depth < sizeof(stats.stack) / sizeof(stats.stack[0]));
+		stats.stack[stats.depth++] = name;
+		stats.begins++;
+	}
+	else if (event == meshopt_ProfileEnd)
+	{
+		assert(stats.depth > 0 && strcmp(stats.stack[stats.depth - 1], name) == 0);
+		stats.depth--;
+	}
+	else
+	{
+		assert(event == meshopt_ProfileCounter && stats.depth > 0);
+		stats.counters++;
+		stats.passes += strcmp(name, "simplify.passes") == 0 ? value : 0;
+	}
+}
+
+static void profiler()
+{
+	const size_t N = 10;
+
+	float vb[(N + 1) * (N + 1) * 3];
+	unsigned int ib[N * N * 6];
+
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb[(y * (N + 1) + x) * 3 + 0] = float(x);
+			vb[(y * (N + 1) + x) * 3 + 1] = float(y);
+			vb[(y * (N + 1) + x) * 3 + 2] = 0.f;
+		}
+
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int* quad = &ib[(y * N + x) * 6];
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			quad[0] = v, quad[1] = v + 1, quad[2] = v + unsigned(N) + 1;
+			quad[3] = v + 1, quad[4] = v + unsigned(N) + 2, quad[5] = v + unsigned(N) + 1;
+		}
+
+	ProfileStats stats = {};
+	meshopt_setProfiler(profileCallback, &stats);
+
+	unsigned int result[N * N * 6];
+	meshopt_simplify(result, ib, N * N * 6, vb, (N + 1) * (N + 1), 12, 6, 1.f);
+	meshopt_simplifySloppy(result, ib, N * N * 6, vb, (N + 1) * (N + 1), 12, 6, 1.f);
+
+	meshopt_Meshlet meshlets[N * N * 2];
+	unsigned int meshlet_vertices[N * N * 2 * 64];
+	unsigned char meshlet_triangles[N * N * 2 * 16 * 3];
+	meshopt_buildMeshlets(meshlets, meshlet_vertices, meshlet_triangles, ib, N * N * 6, vb, (N + 1) * (N + 1), 12, 64, 16, 0.f);
+
+	meshopt_setProfiler(NULL, NULL);
+
+	// phases are balanced and properly nested; without MESHOPTIMIZER_PROFILE, instrumentation is compiled out
+	assert(stats.depth == 0);
+
+#if MESHOPTIMIZER_PROFILE
+	assert(stats.begins > 0 && stats.counters > 0 && stats.passes > 0);
+#else
+	assert(stats.begins == 0 && stats.counters == 0);
+#endif
+
+	// disabled profiler should not get called anymore
+	meshopt_simplify(result, ib, N * N * 6, vb, (N + 1) * (N + 1), 12, 6, 1.f);
+	assert(stats.depth == 0);
+}
+
+static void vertexRemapStream()
+{
+	const size_t vertex_count = 1000;
+
+	// vertices repeat with a period of 300, so there are 300 unique vertices
+	std::vector<unsigned int> vb(vertex_count * 2);
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		vb[i * 2 + 0] = unsigned(i % 300);
+		vb[i * 2 + 1] = unsigned((i % 300) * 7);
+	}
+
+	std::vector<unsigned int> remap(vertex_count, ~0u);
+	std::vector<unsigned int> expected(vertex_count);
+	size_t unique = meshopt_generateVertexRemap(&expected[0], NULL, vertex_count, &vb[0], vertex_count, 8);
+	assert(unique == 300);
+
+	std::vector<unsigned char> data(meshopt_vertexRemapStreamBound(200, 8));
+	meshopt_VertexRemapStream stream = {&data[0], 200, 8, 3, 0, 0, 0};
+
+	const size_t chunk_size = 64;
+
+	for (unsigned int p = 0; p < stream.partition_count; ++p)
+	{
+		meshopt_vertexRemapStreamBegin(&stream, p);
+
+		for (size_t i = 0; i < vertex_count; i += chunk_size)
+		{
+			size_t count = std::min(chunk_size, vertex_count - i);
+			assert(meshopt_vertexRemapStreamAdd(&stream, &remap[i], &vb[i * 2], count) == 0);
+		}
+	}
+
+	assert(stream.unique_count == unique);
+
+	// the order is different but the remap must identify the same vertices
+	std::vector<unsigned int> mapping(unique, ~0u);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		assert(remap[i] < unique);
+
+		if (mapping[remap[i]] == ~0u)
+			mapping[remap[i]] = expected[i];
+
+		assert(mapping[remap[i]] == expected[i]);
+	}
+
+	// a single partition can't fit all vertices
+	meshopt_VertexRemapStream small = {&data[0], 200, 8, 1, 0, 0, 0};
+	meshopt_vertexRemapStreamBegin(&small, 0);
+	assert(meshopt_vertexRemapStreamAdd(&small, &remap[0], &vb[0], vertex_count) == -1);
+}
+
+struct BatchVertex
+{
+	unsigned int id;
+	float px, py, pz;
+};
+
+static void optimizeMeshBatch()
+{
+	typedef BatchVertex Vertex;
+
+	const size_t mesh_count = 1000;
+	const size_t N = 8;
+
+	// meshes are grids with shuffled triangles and an unreferenced vertex, so every stage of the pipeline has work to do
+	std::vector<std::vector<Vertex> > vertices(mesh_count);
+	std::vector<std::vector<unsigned int> > indices(mesh_count);
+
+	for (size_t m = 0; m < mesh_count; ++m)
+	{
+		size_t size = 1 + m % N;
+
+		for (size_t y = 0; y <= size; ++y)
+			for (size_t x = 0; x <= size; ++x)
+			{
+				Vertex v = {unsigned(vertices[m].size()), float(x), float(y), float((x * y + m) % 3)};
+				vertices[m].push_back(v);
+			}
+
+		Vertex unused = {~0u, 0.f, 0.f, 0.f};
+		vertices[m].insert(vertices[m].begin(), unused);
+
+		for (size_t y = 0; y < size; ++y)
+			for (size_t x = 0; x < size; ++x)
+			{
+				unsigned int v = unsigned(y * (size + 1) + x + 1);
+				unsigned int tri[6] = {v, v + 1, v + unsigned(size) + 1, v + 1, v + unsigned(size) + 2, v + unsigned(size) + 1};
+
+				indices[m].insert((x + y) % 2 ? indices[m].end() : indices[m].begin(), tri, tri + 6);
+			}
+	}
+
+	std::vector<meshopt_BatchMesh> batch(mesh_count);
+	std::vector<std::vector<Vertex> > bvertices = vertices;
+	std::vector<std::vector<unsigned int> > bindices = indices;
+
+	for (size_t m = 0; m < mesh_count; ++m)
+	{
+		meshopt_BatchMesh mesh = {&bindices[m][0], bindices[m].size(), &bvertices[m][0], bvertices[m].size(), sizeof(Vertex), offsetof(Vertex, px)};
+		batch[m] = mesh;
+	}
+
+	size_t tasks = 0;
+	meshopt_optimizeMeshBatch(&batch[0], mesh_count, 1.05f, dispatchReverse, &tasks);
+	assert(tasks > 1);
+
+	// batch results must match the individual optimization functions
+	for (size_t m = 0; m < mesh_count; ++m)
+	{
+		std::vector<unsigned int>& ib = indices[m];
+		std::vector<Vertex>& vb = vertices[m];
+
+		meshopt_optimizeVertexCache(&ib[0], &ib[0], ib.size(), vb.size());
+		meshopt_optimizeOverdraw(&ib[0], &ib[0], ib.size(), &vb[0].px, vb.size(), sizeof(Vertex), 1.05f);
+		size_t vertex_count = meshopt_optimizeVertexFetch(&vb[0], &ib[0], ib.size(), &vb[0], vb.size(), sizeof(Vertex));
+
+		assert(batch[m].vertex_count == vertex_count && vertex_count == vb.size() - 1);
+		assert(bindices[m] == ib);
+		assert(memcmp(&bvertices[m][0], &vb[0], vertex_count * sizeof(Vertex)) == 0);
+	}
+
+	// serial processing only allocates the group table and one scratch buffer per group
+	meshopt_setAllocator(customAlloc, customFree);
+
+	size_t allocs = allocCount;
+	meshopt_optimizeMeshBatch(&batch[0], mesh_count, 0.f, NULL, NULL);
+	assert(allocCount - allocs == 1 + tasks);
+
+	meshopt_setAllocator(operator new, operator delete);
+}
+
+static void scratchContext()
+{
+	const size_t N = 10;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(float((x * y) % 3));
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+	size_t index_count = ib.size();
+
+	size_t scratch = meshopt_generateVertexRemapScratchBound(vertex_count);
+	scratch = std::max(scratch, meshopt_optimizeVertexCacheScratchBound(index_count, vertex_count));
+	scratch = std::max(scratch, meshopt_buildMeshletsScratchBound(index_count, vertex_count));
+	scratch = std::max(scratch, meshopt_simplifyScratchBound(index_count, vertex_count));
+	scratch = std::max(scratch, meshopt_optimizeOverdrawScratchBound(index_count, vertex_count));
+	scratch = std::max(scratch, meshopt_optimizeVertexFetchScratchBound(vertex_count, 12));
+
+	std::vector<unsigned long long> storage((scratch + 7) / 8);
+	meshopt_Context context = {&storage[0], scratch, 0, 0};
+
+	meshopt_setAllocator(customAlloc, customFree);
+
+	std::vector<unsigned int> remap(vertex_count), remapc(vertex_count);
+	assert(meshopt_generateVertexRemap(&remap[0], &ib[0], index_count, &vb[0], vertex_count, 12) == meshopt_generateVertexRemapWithContext(&remapc[0], &ib[0], index_count, &vb[0], vertex_count, 12, &context));
+	assert(remap == remapc);
+
+	std::vector<unsigned int> opt(index_count), optc(index_count);
+	meshopt_optimizeVertexCache(&opt[0], &ib[0], index_count, vertex_count);
+	meshopt_optimizeVertexCacheWithContext(&optc[0], &ib[0], index_count, vertex_count, &context);
+	assert(opt == optc);
+
+	// in-place optimization requires an extra copy of the indices
+	meshopt_optimizeVertexCacheWithContext(&optc[0], &optc[0], index_count, vertex_count, &context);
+
+	size_t max_meshlets = meshopt_buildMeshletsBound(index_count, 64, 64);
+	std::vector<meshopt_Meshlet> meshlets(max_meshlets), meshletsc(max_meshlets);
+	std::vector<unsigned int> meshlet_vertices(max_meshlets * 64), meshlet_verticesc(max_meshlets * 64);
+	std::vector<unsigned char> meshlet_triangles(max_meshlets * 64 * 3), meshlet_trianglesc(max_meshlets * 64 * 3);
+	size_t meshlet_count = meshopt_buildMeshlets(&meshlets[0], &meshlet_vertices[0], &meshlet_triangles[0], &ib[0], index_count, &vb[0], vertex_count, 12, 64, 64, 0.5f);
+	assert(meshlet_count == meshopt_buildMeshletsWithContext(&meshletsc[0], &meshlet_verticesc[0], &meshlet_trianglesc[0], &ib[0], index_count, &vb[0], vertex_count, 12, 64, 64, 0.5f, &context));
+	assert(meshlet_vertices == meshlet_verticesc && meshlet_triangles == meshlet_trianglesc);
+
+	std::vector<unsigned int> lod(index_count), lodc(index_count);
+	size_t lod_count = meshopt_simplify(&lod[0], &ib[0], index_count, &vb[0], vertex_count, 12, index_count / 4, 1e-2f);
+	assert(lod_count == meshopt_simplifyWithContext(&lodc[0], &ib[0], index_count, &vb[0], vertex_count, 12, index_count / 4, 1e-2f, 0, NULL, &context));
+	assert(lod == lodc);
+
+	std::vector<unsigned int> ovd(index_count), ovdc(index_count);
+	meshopt_optimizeOverdraw(&ovd[0], &opt[0], index_count, &vb[0], vertex_count, 12, 1.05f);
+	meshopt_optimizeOverdrawWithContext(&ovdc[0], &opt[0], index_count, &vb[0], vertex_count, 12, 1.05f, &context);
+	assert(ovd == ovdc);
+
+	std::vector<float> fetch(vb.size()), fetchc(vb.size());
+	assert(meshopt_optimizeVertexFetch(&fetch[0], &ovd[0], index_count, &vb[0], vertex_count, 12) == meshopt_optimizeVertexFetchWithContext(&fetchc[0], &ovdc[0], index_count, &vb[0], vertex_count, 12, &context));
+	assert(fetch == fetchc && ovd == ovdc);
+
+	size_t allocs = allocCount;
+
+	// with enough scratch memory, repeated calls don't allocate
+	meshopt_generateVertexRemapWithContext(&remapc[0], &ib[0], index_count, &vb[0], vertex_count, 12, &context);
+	meshopt_optimizeVertexCacheWithContext(&optc[0], &optc[0], index_count, vertex_count, &context);
+	meshopt_buildMeshletsWithContext(&meshletsc[0], &meshlet_verticesc[0], &meshlet_trianglesc[0], &ib[0], index_count, &vb[0], vertex_count, 12, 64, 64, 0.5f, &context);
+	meshopt_simplifyWithContext(&lodc[0], &ib[0], index_count, &vb[0], vertex_count, 12, index_count / 4, 1e-2f, 0, NULL, &context);
+	meshopt_optimizeOverdrawWithContext(&ovdc[0], &ovdc[0], index_count, &vb[0], vertex_count, 12, 1.05f, &context);
+	meshopt_optimizeVertexFetchWithContext(&fetchc[0], &ovdc[0], index_count, &fetchc[0], vertex_count, 12, &context);
+	assert(allocCount == allocs);
+
+	assert(context.size == 0);
+	assert(context.peak <= scratch);
+
+	// insufficient scratch memory falls back to the allocation callbacks, and peak reports the required size
+	meshopt_Context small = {&storage[0], 64, 0, 0};
+	meshopt_simplifyWithContext(&lodc[0], &ib[0], index_count, &vb[0], vertex_count, 12, index_count / 4, 1e-2f, 0, NULL, &small);
+	assert(allocCount > allocs && allocCount == freeCount);
+	assert(small.size == 0 && small.peak > 64 && small.peak <= meshopt_simplifyScratchBound(index_count, vertex_count));
+	assert(lod == lodc);
+
+	meshopt_setAllocator(operator new, operator delete);
+
+	allocCount = freeCount = 0;
+}
+
 static void emptyMesh()
 {
 	meshopt_optimizeVertexCache(0, 0, 0, 0);
@@ -898,6 +2890,71 @@ static void simplifyPointsStuck()
 	assert(meshopt_simplifyPoints(0, vb, 3, 12, 0) == 0);
 }
 
+static void simplifyPointsStream()
+{
+	const size_t N = 40;
+
+	std::vector<float> vb;
+	for (size_t z = 0; z < 30; ++z)
+		for (size_t y = 0; y < N; ++y)
+			for (size_t x = 0; x < N; ++x)
+			{
+				vb.push_back(float(x));
+				vb.push_back(float(y) + float(x % 3) * 0.1f);
+				vb.push_back(float(z));
+			}
+
+	size_t vertex_count = vb.size() / 3;
+	const size_t target = 500;
+
+	std::vector<unsigned char> data(meshopt_simplifyPointsStreamBound(2000));
+	meshopt_SimplifyPointsStream stream = {&data[0], 2000, target, {0, 0, 0}, {float(N), float(N), 30}, 0, 0, 0, 0, 0};
+
+	// feed the points in small batches without a dispatcher
+	const size_t batch_size = 1000;
+
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		meshopt_simplifyPointsStreamBegin(&stream, pass);
+
+		for (size_t i = 0; i < vertex_count; i += batch_size)
+			meshopt_simplifyPointsStreamAdd(&stream, &vb[i * 3], std::min(batch_size, vertex_count - i), 12, NULL, NULL);
+	}
+
+	// the cell capacity is smaller than the number of points so the grid must have been coarsened
+	assert(stream.level > 0 && stream.cell_count <= 2000);
+
+	std::vector<unsigned int> result(target);
+	size_t count = meshopt_simplifyPointsStreamEnd(&stream, &result[0]);
+
+	assert(count > target / 2 && count <= target);
+
+	std::vector<unsigned char> used(vertex_count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		assert(result[i] < vertex_count && !used[result[i]]);
+		used[result[i]] = 1;
+	}
+
+	// the result doesn't depend on the batch size or the dispatcher
+	std::vector<unsigned char> data2(data.size());
+	meshopt_SimplifyPointsStream stream2 = {&data2[0], 2000, target, {0, 0, 0}, {float(N), float(N), 30}, 0, 0, 0, 0, 0};
+
+	size_t tasks = 0;
+
+	for (unsigned int pass = 0; pass < 2; ++pass)
+	{
+		meshopt_simplifyPointsStreamBegin(&stream2, pass);
+		meshopt_simplifyPointsStreamAdd(&stream2, &vb[0], vertex_count, 12, dispatchReverse, &tasks);
+	}
+
+	assert(tasks > 2);
+
+	std::vector<unsigned int> result2(target);
+	assert(meshopt_simplifyPointsStreamEnd(&stream2, &result2[0]) == count);
+	assert(memcmp(&result[0], &result2[0], count * sizeof(unsigned int)) == 0);
+}
+
 static void simplifyFlip()
 {
 	// this mesh has been constructed by taking a tessellated irregular grid with a square cutout
@@ -1027,6 +3084,185 @@ static void simplifyLockBorder()
 	assert(memcmp(ib, expected, sizeof(expected)) == 0);
 }
 
+static void simplifyLods()
+{
+	const size_t N = 10;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(float((x * y) % 3) * 0.1f);
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+	size_t index_count = ib.size();
+
+	const size_t targets[] = {index_count / 2, index_count / 4, index_count / 8, 0};
+	const float errors[] = {1e-2f, 1e-1f, 1e-1f, 1.f};
+	const size_t lod_count = sizeof(targets) / sizeof(targets[0]);
+
+	std::vector<unsigned int> lods(index_count * lod_count);
+	size_t counts[lod_count] = {};
+	float lod_errors[lod_count] = {};
+
+	size_t total = meshopt_simplifyLods(&lods[0], counts, &ib[0], index_count, &vb[0], vertex_count, 12, targets, errors, lod_count, 0, lod_errors);
+
+	// first level is identical to regular simplification
+	std::vector<unsigned int> lod(index_count);
+	float error = 0;
+	assert(counts[0] == meshopt_simplify(&lod[0], &ib[0], index_count, &vb[0], vertex_count, 12, targets[0], errors[0], 0, &error));
+	assert(memcmp(&lods[0], &lod[0], counts[0] * sizeof(unsigned int)) == 0);
+	assert(lod_errors[0] == error);
+
+	// subsequent levels continue simplification from the previous level
+	size_t offset = 0;
+
+	for (size_t i = 0; i < lod_count; ++i)
+	{
+		assert(counts[i] % 3 == 0);
+		assert(i == 0 || (counts[i] <= counts[i - 1] && lod_errors[i] >= lod_errors[i - 1]));
+
+		for (size_t j = 0; j < counts[i]; ++j)
+			assert(lods[offset + j] < vertex_count);
+
+		offset += counts[i];
+	}
+
+	assert(total == offset);
+	assert(counts[lod_count - 1] < counts[0]);
+}
+
+static void simplifySloppyLods()
+{
+	const size_t N = 40;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(float((x * y) % 3) * 0.1f);
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+	size_t index_count = ib.size();
+
+	const size_t targets[] = {index_count / 2, index_count / 8, index_count / 32, 0};
+	const float errors[] = {1.f, 1.f, 1.f, 1.f};
+	const size_t lod_count = sizeof(targets) / sizeof(targets[0]);
+
+	std::vector<unsigned int> lods(index_count * lod_count);
+	size_t counts[lod_count] = {};
+	float lod_errors[lod_count] = {};
+
+	size_t total = meshopt_simplifySloppyLods(&lods[0], counts, &ib[0], index_count, &vb[0], vertex_count, 12, targets, errors, lod_count, lod_errors);
+
+	// first level is identical to regular simplification
+	std::vector<unsigned int> lod(index_count);
+	float error = 0;
+	assert(counts[0] == meshopt_simplifySloppy(&lod[0], &ib[0], index_count, &vb[0], vertex_count, 12, targets[0], errors[0], &error));
+	assert(memcmp(&lods[0], &lod[0], counts[0] * sizeof(unsigned int)) == 0);
+	assert(lod_errors[0] == error);
+
+	// subsequent levels are clustered from the previous level
+	size_t offset = 0;
+
+	for (size_t i = 0; i < lod_count; ++i)
+	{
+		assert(counts[i] % 3 == 0);
+		assert(counts[i] <= targets[i]);
+		assert(i == 0 || (counts[i] <= counts[i - 1] && lod_errors[i] >= lod_errors[i - 1]));
+
+		for (size_t j = 0; j < counts[i]; ++j)
+			assert(lods[offset + j] < vertex_count);
+
+		offset += counts[i];
+	}
+
+	assert(total == offset);
+	assert(counts[2] > 0 && counts[3] == 0 && lod_errors[3] == 1.f);
+}
+
+static void simplifyParallel()
+{
+	const size_t N = 300;
+
+	std::vector<float> vb;
+	for (size_t y = 0; y <= N; ++y)
+		for (size_t x = 0; x <= N; ++x)
+		{
+			vb.push_back(float(x));
+			vb.push_back(float(y));
+			vb.push_back(float((x * y) % 5) * 0.01f);
+		}
+
+	std::vector<unsigned int> ib;
+	for (size_t y = 0; y < N; ++y)
+		for (size_t x = 0; x < N; ++x)
+		{
+			unsigned int v = unsigned(y * (N + 1) + x);
+
+			ib.push_back(v), ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 1);
+			ib.push_back(v + 1), ib.push_back(v + unsigned(N) + 2), ib.push_back(v + unsigned(N) + 1);
+		}
+
+	size_t vertex_count = vb.size() / 3;
+	size_t index_count = ib.size();
+	size_t target_index_count = index_count / 10;
+
+	size_t tasks = 0;
+	float error = 0;
+
+	std::vector<unsigned int> lod(index_count);
+	size_t lod_count = meshopt_simplifyParallel(&lod[0], &ib[0], index_count, &vb[0], vertex_count, 12, target_index_count, 1e-2f, 0, &error, dispatchReverse, &tasks);
+
+	assert(tasks > 1);
+	assert(lod_count % 3 == 0 && lod_count <= target_index_count);
+	assert(error > 0 && error <= 1e-2f);
+
+	// locked borders must preserve the mesh outline
+	for (size_t i = 0; i < lod_count; ++i)
+		assert(lod[i] < vertex_count);
+
+	unsigned int corners[] = {0, unsigned(N), unsigned(N * (N + 1)), unsigned(N * (N + 1) + N)};
+	for (size_t k = 0; k < 4; ++k)
+		assert(std::find(lod.begin(), lod.begin() + lod_count, corners[k]) != lod.begin() + lod_count);
+
+	// small meshes are processed serially and match the regular simplifier
+	size_t small_count = 600 * 3;
+	std::vector<unsigned int> slod(small_count), plod(small_count);
+
+	tasks = 0;
+	size_t scount = meshopt_simplify(&slod[0], &ib[0], small_count, &vb[0], vertex_count, 12, small_count / 4, 1e-2f);
+	assert(scount == meshopt_simplifyParallel(&plod[0], &ib[0], small_count, &vb[0], vertex_count, 12, small_count / 4, 1e-2f, 0, NULL, dispatchReverse, &tasks));
+	assert(tasks == 0);
+	assert(slod == plod);
+}
+
 static void adjacency()
 {
 	// 0 1/4
@@ -1085,6 +3321,81 @@ static void tessellation()
 	assert(memcmp(tessib, expected, sizeof(expected)) == 0);
 }
 
+static void canonicalizeTriangles(std::vector<unsigned int>& indices)
+{
+	std::vector<unsigned long long> triangles;
+
+	for (size_t i = 0; i < indices.size(); i += 3)
+	{
+		unsigned int a = indices[i + 0], b = indices[i + 1], c = indices[i + 2];
+
+		// rotate the smallest index first, preserving winding
+		if (b < a && b < c)
+			a = indices[i + 1], b = indices[i + 2], c = indices[i + 0];
+		else if (c < a && c < b)
+			a = indices[i + 2], b = indices[i + 0], c = indices[i + 1];
+
+		triangles.push_back((((unsigned long long)a << 20) | b) << 20 | c);
+	}
+
+	std::sort(triangles.begin(), triangles.end());
+
+	indices.clear();
+
+	for (size_t i = 0; i < triangles.size(); ++i)
+	{
+		indices.push_back(unsigned(triangles[i] >> 40));
+		indices.push_back(unsigned(triangles[i] >> 20) & 0xfffff);
+		indices.push_back(unsigned(triangles[i]) & 0xfffff);
+	}
+}
+
+static void stripifyAdjacency()
+{
+	const size_t N = 50;
+
+	std::vector<unsigned int> grid;
+	encodeIndexGrid(grid, N);
+
+	// shuffle triangles so that the input order has no locality
+	size_t face_count = grid.size() / 3;
+
+	std::vector<unsigned int> indices(grid.size());
+
+	for (size_t i = 0; i < face_count; ++i)
+	{
+		size_t j = (i * 1237) % face_count;
+
+		indices[i * 3 + 0] = grid[j * 3 + 0];
+		indices[i * 3 + 1] = grid[j * 3 + 1];
+		indices[i * 3 + 2] = grid[j * 3 + 2];
+	}
+
+	std::vector<unsigned int> expected = indices;
+	canonicalizeTriangles(expected);
+
+	for (int restart = 0; restart < 2; ++restart)
+	{
+		unsigned int restart_index = restart ? ~0u : 0;
+
+		std::vector<unsigned int> strip(meshopt_stripifyBound(indices.size()));
+		strip.resize(meshopt_stripifyAdjacency(&strip[0], &indices[0], indices.size(), (N + 1) * (N + 1), restart_index));
+
+		std::vector<unsigned int> window(meshopt_stripifyBound(indices.size()));
+		window.resize(meshopt_stripify(&window[0], &indices[0], indices.size(), (N + 1) * (N + 1), restart_index));
+
+		// adjacency lets strips continue regardless of input order
+		assert(strip.size() < window.size());
+		assert(strip.size() < indices.size() * 2 / 3);
+
+		std::vector<unsigned int> result(meshopt_unstripifyBound(strip.size()));
+		result.resize(meshopt_unstripify(&result[0], &strip[0], strip.size(), restart_index));
+
+		canonicalizeTriangles(result);
+		assert(result == expected);
+	}
+}
+
 void runTests()
 {
 	decodeIndexV0();
@@ -1097,7 +3408,11 @@ void runTests()
 	decodeIndexRejectInvalidVersion();
 	decodeIndexMalformedVByte();
 	roundtripIndexTricky();
+	roundtripIndexLong();
 	encodeIndexEmpty();
+	decodeIndexParallel();
+	decodeIndexRange();
+	validateIndexBuffer();
 
 	decodeIndexSequence();
 	decodeIndexSequence16();
@@ -1108,6 +3423,13 @@ void runTests()
 	decodeIndexSequenceRejectInvalidVersion();
 	encodeIndexSequenceEmpty();
 
+	roundtripMeshlet();
+	roundtripMeshletLarge();
+	encodeMeshletMemorySafe();
+	encodeMeshletWorstCase();
+	decodeMeshletMemorySafe();
+	decodeMeshletRejectExtraBytes();
+
 	decodeVertexV0();
 	encodeVertexMemorySafe();
 	decodeVertexMemorySafe();
@@ -1117,11 +3439,19 @@ void runTests()
 	decodeVertexBitGroupSentinels();
 	decodeVertexLarge();
 	encodeVertexEmpty();
-
+	decodeVertexV1();
+	decodeVertexV1MemorySafe();
+	decodeVertexV2();
+	decodeVertexParallel();
+	decodeVertexRange();
+	validateVertexBuffer();
+
+	decodeVertexStrided();
 	decodeFilterOct8();
 	decodeFilterOct12();
 	decodeFilterQuat12();
 	decodeFilterExp();
+	decodeVertexFiltered();
 
 	encodeFilterOct8();
 	encodeFilterOct12();
@@ -1129,19 +3459,42 @@ void runTests()
 	encodeFilterExp();
 
 	clusterBoundsDegenerate();
+	buildMeshletsParallel();
+	computeMeshletBoundsBatch();
+	optimizeVertexCacheParallel();
+	optimizeVertexCacheTable();
+	optimizeVertexCacheIncremental();
+	optimizeVertexFetchRemapIncremental();
+	buildMeshletsIncremental();
+	analyzeOverdrawParallel();
+	analyzeMesh();
+	spatialSortParallel();
+	generateIndexParallel();
+	optimizeVertexFetchMulti();
+	buildClusterLod();
 
 	customAllocator();
+	scratchContext();
+	optimizeMeshBatch();
+	profiler();
+
+	vertexRemapStream();
 
 	emptyMesh();
 
 	simplifyStuck();
 	simplifySloppyStuck();
 	simplifyPointsStuck();
+	simplifyPointsStream();
 	simplifyFlip();
 	simplifyScale();
 	simplifyDegenerate();
 	simplifyLockBorder();
+	simplifyLods();
+	simplifySloppyLods();
+	simplifyParallel();
 
 	adjacency();
 	tessellation();
+	stripifyAdjacency();
 }
@@ -135,7 +135,13 @@ static Attr interpolateHermite(const Attr& v0, const Attr& t0, const Attr& v1, c
 
 static void resampleKeyframes(std::vector<Attr>& data, const std::vector<float>& input, const std::vector<Attr>& output, cgltf_animation_path_type type, cgltf_interpolation_type interpolation, size_t components, int frames, float mint, int freq)
 {
+	// find the keyframe and interpolation factor for every frame first, so that the loops below only need to interpolate attribute data
+	std::vector<unsigned int> keys(frames);
+	std::vector<float> factors(frames);
+	std::vector<float> ranges(frames);
+
 	size_t cursor = 0;
+	int interpolated = 0;
 
 	for (int i = 0; i < frames; ++i)
 	{
@@ -151,6 +157,8 @@ static void resampleKeyframes(std::vector<Attr>& data, const std::vector<float>&
 			cursor++;
 		}
 
+		keys[i] = unsigned(cursor);
+
 		if (cursor + 1 < input.size())
 		{
 			float cursor_time = input[cursor + 0];
@@ -160,50 +168,59 @@ static void resampleKeyframes(std::vector<Attr>& data, const std::vector<float>&
 			float inv_range = (range == 0.f) ? 0.f : 1.f / (next_time - cursor_time);
 			float t = std::max(0.f, std::min(1.f, (time - cursor_time) * inv_range));
 
-			for (size_t j = 0; j < components; ++j)
-			{
-				switch (interpolation)
-				{
-				case cgltf_interpolation_type_linear:
-				{
-					const Attr& v0 = output[(cursor + 0) * components + j];
-					const Attr& v1 = output[(cursor + 1) * components + j];
-					data.push_back(interpolateLinear(v0, v1, t, type));
-				}
-				break;
+			factors[i] = t;
+			ranges[i] = range;
 
-				case cgltf_interpolation_type_step:
-				{
-					const Attr& v = output[cursor * components + j];
-					data.push_back(v);
-				}
-				break;
+			// frame times are increasing, so frames after the last keyframe form a suffix
+			interpolated = i + 1;
+		}
+	}
 
-				case cgltf_interpolation_type_cubic_spline:
-				{
-					const Attr& v0 = output[(cursor * 3 + 1) * components + j];
-					const Attr& b0 = output[(cursor * 3 + 2) * components + j];
-					const Attr& a1 = output[(cursor * 3 + 3) * components + j];
-					const Attr& v1 = output[(cursor * 3 + 4) * components + j];
-					data.push_back(interpolateHermite(v0, b0, v1, a1, t, range, type));
-				}
-				break;
+	data.resize(frames * components);
+
+	Attr* result = data.empty() ? NULL : &data[0];
 
-				default:
-					assert(!"Unknown interpolation type");
-				}
-			}
+	// interpolation type is constant for the entire track, so each type gets a separate loop over frames
+	switch (interpolation)
+	{
+	case cgltf_interpolation_type_linear:
+		for (int i = 0; i < interpolated; ++i)
+		{
+			const Attr* v0 = &output[keys[i] * components];
+			const Attr* v1 = v0 + components;
+
+			for (size_t j = 0; j < components; ++j)
+				result[i * components + j] = interpolateLinear(v0[j], v1[j], factors[i], type);
 		}
-		else
+		break;
+
+	case cgltf_interpolation_type_step:
+		for (int i = 0; i < interpolated; ++i)
+			memcpy(&result[i * components], &output[keys[i] * components], components * sizeof(Attr));
+		break;
+
+	case cgltf_interpolation_type_cubic_spline:
+		for (int i = 0; i < interpolated; ++i)
 		{
-			size_t offset = (interpolation == cgltf_interpolation_type_cubic_spline) ? cursor * 3 + 1 : cursor;
+			const Attr* v0 = &output[(keys[i] * 3 + 1) * components];
+			const Attr* b0 = v0 + components;
+			const Attr* a1 = b0 + components;
+			const Attr* v1 = a1 + components;
 
 			for (size_t j = 0; j < components; ++j)
-			{
-				const Attr& v = output[offset * components + j];
-				data.push_back(v);
-			}
+				result[i * components + j] = interpolateHermite(v0[j], b0[j], v1[j], a1[j], factors[i], ranges[i], type);
 		}
+		break;
+
+	default:
+		assert(!"Unknown interpolation type");
+	}
+
+	for (int i = interpolated; i < frames; ++i)
+	{
+		size_t offset = (interpolation == cgltf_interpolation_type_cubic_spline) ? keys[i] * 3 + 1 : keys[i];
+
+		memcpy(&result[i * components], &output[offset * components], components * sizeof(Attr));
 	}
 }
 
@@ -297,9 +314,8 @@ void processAnimation(Animation& animation, const Settings& settings)
 	animation.start = mint;
 	animation.frames = frames;
 
-	std::vector<Attr> base;
-
-	for (size_t i = 0; i < animation.tracks.size(); ++i)
+	// tracks are resampled independently, so the output doesn't depend on the number of jobs
+	parallelFor(animation.tracks.size(), settings.mesh_jobs, [&](size_t i)
 	{
 		Track& track = animation.tracks[i];
 
@@ -327,10 +343,10 @@ void processAnimation(Animation& animation, const Settings& settings)
 			track.data.resize(track.components);
 
 			// track.dummy is true iff track redundantly sets up the value to be equal to default node transform
-			base.resize(track.components);
+			std::vector<Attr> base(track.components);
 			getBaseTransform(&base[0], track.components, track.path, track.node);
 
 			track.dummy = getMaxDelta(track.data, track.path, 1, &base[0], track.components) <= tolerance;
 		}
-	}
+	});
 }
@@ -92,7 +92,21 @@ static void fillParams(basisu::basis_compressor_params& params, const char* inpu
 	params.m_status_output = false;
 }
 
-static const char* prepareEncode(basisu::basis_compressor_params& params, const cgltf_image& image, const char* input_path, const ImageInfo& info, const Settings& settings, TempFile& temp_input, TempFile& temp_output)
+static unsigned long long hashImage(const std::string& data, int width, int height, bool uastc, const BasisSettings& bs, const ImageInfo& info, const Settings& settings)
+{
+	unsigned long long hash = hashString(0, "image");
+	hash = hashString(hash, getVersion().c_str());
+
+	// the encoded result depends on source image contents and the parameters passed to fillParams
+	int params[] = {width, height, uastc, bs.etc1s_l, bs.etc1s_q, bs.uastc_l, info.srgb, info.normal_map, settings.texture_flipy};
+	hash = hashData(hash, params, sizeof(params));
+	hash = hashData(hash, &bs.uastc_q, sizeof(bs.uastc_q));
+	hash = hashData(hash, data.c_str(), data.size());
+
+	return hash;
+}
+
+static const char* prepareEncode(basisu::basis_compressor_params& params, const cgltf_image& image, const char* input_path, const ImageInfo& info, const Settings& settings, TempFile& temp_input, TempFile& temp_output, unsigned long long& cache_key, std::string& encoded)
 {
 	std::string img_data;
 	std::string mime_type;
@@ -107,17 +121,26 @@ static const char* prepareEncode(basisu::basis_compressor_params& params, const
 
 	adjustDimensions(width, height, settings);
 
+	int quality = settings.texture_quality[info.kind];
+	bool uastc = settings.texture_mode[info.kind] == TextureMode_UASTC;
+
+	const BasisSettings& bs = kBasisSettings[quality - 1];
+
+	if (settings.cache_path)
+	{
+		cache_key = hashImage(img_data, width, height, uastc, bs, info, settings);
+
+		// cached images leave params empty, which makes basis_parallel_compress skip them
+		if (readCache(settings.cache_path, cache_key, ".ktx2", encoded))
+			return nullptr;
+	}
+
 	temp_input.create(mimeExtension(mime_type.c_str()));
 	temp_output.create(".ktx2");
 
 	if (!writeFile(temp_input.path.c_str(), img_data))
 		return "error writing temporary file";
 
-	int quality = settings.texture_quality[info.kind];
-	bool uastc = settings.texture_mode[info.kind] == TextureMode_UASTC;
-
-	const BasisSettings& bs = kBasisSettings[quality - 1];
-
 	fillParams(params, temp_input.path.c_str(),temp_output.path.c_str(), uastc, width, height, bs, info, settings);
 
 	return nullptr;
@@ -132,6 +155,7 @@ void encodeImages(std::string* encoded, const cgltf_data* data, const std::vecto
 
 	std::vector<TempFile> temp_inputs(data->images_count);
 	std::vector<TempFile> temp_outputs(data->images_count);
+	std::vector<unsigned long long> cache_keys(data->images_count);
 
 	for (size_t i = 0; i < data->images_count; ++i)
 	{
@@ -141,7 +165,7 @@ void encodeImages(std::string* encoded, const cgltf_data* data, const std::vecto
 		if (settings.texture_mode[info.kind] == TextureMode_Raw)
 			continue;
 
-		if (const char* error = prepareEncode(params[i], image, input_path, info, settings, temp_inputs[i], temp_outputs[i]))
+		if (const char* error = prepareEncode(params[i], image, input_path, info, settings, temp_inputs[i], temp_outputs[i], cache_keys[i], encoded[i]))
 			encoded[i] = error;
 
 		// image is ready to encode in parallel
@@ -161,6 +185,8 @@ void encodeImages(std::string* encoded, const cgltf_data* data, const std::vecto
 			encoded[i] = "error encoding image";
 		else if (!readFile(temp_outputs[i].path.c_str(), encoded[i]))
 			encoded[i] = "error reading temporary file";
+		else if (settings.cache_path)
+			writeCache(settings.cache_path, cache_keys[i], ".ktx2", encoded[i]);
 	}
 }
 #endif
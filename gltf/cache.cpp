@@ -0,0 +1,328 @@
+// This file is part of gltfpack; see gltfpack.h for version/license details
+#include "gltfpack.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// cache files start with a magic tag and the full key, which is verified on load to guard against truncated or foreign files
+static const char kCacheMagic[8] = {'G', 'L', 'T', 'F', 'P', 'C', '0', '1'};
+
+unsigned long long hashData(unsigned long long hash, const void* data, size_t size)
+{
+	const unsigned long long m = 0x9e3779b97f4a7c15ull;
+
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+	// process data in 8-byte words; this is much faster than byte-wise hashing, and the mixing below is strong enough for a cache
+	for (; size >= 8; bytes += 8, size -= 8)
+	{
+		unsigned long long k;
+		memcpy(&k, bytes, 8);
+
+		k *= m;
+		k ^= k >> 29;
+
+		hash = (hash ^ k) * m;
+		hash ^= hash >> 32;
+	}
+
+	for (; size > 0; ++bytes, --size)
+		hash = (hash ^ *bytes) * 0x100000001b3ull;
+
+	// finalizer from splitmix64
+	hash ^= hash >> 30;
+	hash *= 0xbf58476d1ce4e5b9ull;
+	hash ^= hash >> 27;
+	hash *= 0x94d049bb133111ebull;
+	hash ^= hash >> 31;
+
+	return hash;
+}
+
+unsigned long long hashString(unsigned long long hash, const char* data)
+{
+	return hashData(hash, data, strlen(data) + 1);
+}
+
+static std::string getCachePath(const char* cache_path, unsigned long long key, const char* suffix)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "%016llx", key);
+
+	std::string result = cache_path;
+
+	if (!result.empty() && result[result.size() - 1] != '/' && result[result.size() - 1] != '\\')
+		result += '/';
+
+	result += name;
+	result += suffix;
+
+	return result;
+}
+
+bool readCache(const char* cache_path, unsigned long long key, const char* suffix, std::string& data)
+{
+	std::string contents;
+	if (!readFile(getCachePath(cache_path, key, suffix).c_str(), contents))
+		return false;
+
+	if (contents.size() < sizeof(kCacheMagic) + sizeof(key) || memcmp(contents.c_str(), kCacheMagic, sizeof(kCacheMagic)) != 0)
+		return false;
+
+	unsigned long long file_key = 0;
+	memcpy(&file_key, contents.c_str() + sizeof(kCacheMagic), sizeof(key));
+
+	if (file_key != key)
+		return false;
+
+	data.assign(contents, sizeof(kCacheMagic) + sizeof(key), std::string::npos);
+	return true;
+}
+
+static FILE* createTempFile(const char* cache_path, const std::string& path, std::string& temp_path)
+{
+	static std::atomic<unsigned int> counter(0);
+
+	// temporary names mix process and thread identity, time and a counter so that concurrent writers (including other processes) rarely pick the same name;
+	// the file is created exclusively, so a collision results in a retry instead of two writers sharing the same file
+	unsigned long long seed = hashString(0, path.c_str());
+
+#if defined(_WIN32)
+	int pid = _getpid();
+	seed = hashData(seed, &pid, sizeof(pid));
+#elif !defined(__wasi__)
+	pid_t pid = getpid();
+	seed = hashData(seed, &pid, sizeof(pid));
+#endif
+
+	size_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+	seed = hashData(seed, &thread, sizeof(thread));
+
+	time_t now = time(NULL);
+	clock_t ticks = clock();
+	seed = hashData(seed, &now, sizeof(now));
+	seed = hashData(seed, &ticks, sizeof(ticks));
+
+	for (int attempt = 0; attempt < 16; ++attempt)
+	{
+		unsigned int index = counter++;
+		unsigned long long name = hashData(seed, &index, sizeof(index));
+
+		char temp_suffix[32];
+		snprintf(temp_suffix, sizeof(temp_suffix), ".%016llx.tmp", name);
+
+		temp_path = path + temp_suffix;
+
+		FILE* file = fopen(temp_path.c_str(), "wbx");
+
+		if (!file && errno == ENOENT)
+		{
+#ifdef _WIN32
+			_mkdir(cache_path);
+#else
+			mkdir(cache_path, 0777);
+#endif
+
+			file = fopen(temp_path.c_str(), "wbx");
+		}
+
+		if (file || errno != EEXIST)
+			return file;
+	}
+
+	return NULL;
+}
+
+bool writeCache(const char* cache_path, unsigned long long key, const char* suffix, const std::string& data)
+{
+	std::string path = getCachePath(cache_path, key, suffix);
+
+	// the entry is written under a unique temporary name and renamed so that concurrent writers never observe partial entries
+	std::string temp_path;
+	FILE* file = createTempFile(cache_path, path, temp_path);
+	if (!file)
+		return false;
+
+	fwrite(kCacheMagic, sizeof(kCacheMagic), 1, file);
+	fwrite(&key, sizeof(key), 1, file);
+	fwrite(data.c_str(), data.size(), 1, file);
+
+	int rc = ferror(file);
+	rc |= fclose(file);
+
+	if (rc)
+	{
+		remove(temp_path.c_str());
+		return false;
+	}
+
+#ifdef _WIN32
+	// rename can't replace an existing file on Windows; the existing entry has the same contents so it's safe to remove
+	remove(path.c_str());
+#endif
+
+	if (rename(temp_path.c_str(), path.c_str()) != 0)
+	{
+		remove(temp_path.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+template <typename T>
+static void writeValue(std::string& data, const T& value)
+{
+	data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readValue(const std::string& data, size_t& offset, T& value)
+{
+	if (data.size() - offset < sizeof(T))
+		return false;
+
+	memcpy(&value, data.c_str() + offset, sizeof(T));
+	offset += sizeof(T);
+	return true;
+}
+
+template <typename T>
+static void writeArray(std::string& data, const std::vector<T>& values)
+{
+	writeValue(data, (unsigned long long)values.size());
+
+	if (!values.empty())
+		data.append(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(T));
+}
+
+template <typename T>
+static bool readArray(const std::string& data, size_t& offset, std::vector<T>& values)
+{
+	unsigned long long count = 0;
+	if (!readValue(data, offset, count) || (data.size() - offset) / sizeof(T) < count)
+		return false;
+
+	values.resize(size_t(count));
+
+	if (count)
+		memcpy(&values[0], data.c_str() + offset, size_t(count) * sizeof(T));
+
+	offset += size_t(count) * sizeof(T);
+	return true;
+}
+
+static unsigned long long hashMesh(const Mesh& mesh, const Settings& settings)
+{
+	unsigned long long hash = hashString(0, "mesh");
+	hash = hashString(hash, getVersion().c_str());
+
+	// processMesh only depends on mesh geometry and simplification/optimization settings
+	hash = hashData(hash, &mesh.type, sizeof(mesh.type));
+	hash = hashData(hash, &settings.simplify_threshold, sizeof(settings.simplify_threshold));
+	hash = hashData(hash, &settings.simplify_aggressive, sizeof(settings.simplify_aggressive));
+	hash = hashData(hash, &settings.compressmore, sizeof(settings.compressmore));
+
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		const Stream& stream = mesh.streams[i];
+
+		int header[4] = {stream.type, stream.index, stream.target, int(stream.data.size())};
+		hash = hashData(hash, header, sizeof(header));
+
+		if (!stream.data.empty())
+			hash = hashData(hash, &stream.data[0], stream.data.size() * sizeof(Attr));
+	}
+
+	unsigned int index_count = unsigned(mesh.indices.size());
+	hash = hashData(hash, &index_count, sizeof(index_count));
+
+	if (!mesh.indices.empty())
+		hash = hashData(hash, &mesh.indices[0], mesh.indices.size() * sizeof(unsigned int));
+
+	return hash;
+}
+
+static void encodeMesh(std::string& data, const Mesh& mesh)
+{
+	writeValue(data, (unsigned int)mesh.streams.size());
+
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		const Stream& stream = mesh.streams[i];
+
+		writeValue(data, int(stream.type));
+		writeValue(data, stream.index);
+		writeValue(data, stream.target);
+		writeArray(data, stream.data);
+	}
+
+	writeArray(data, mesh.indices);
+}
+
+static bool decodeMesh(Mesh& mesh, const std::string& data)
+{
+	size_t offset = 0;
+
+	unsigned int stream_count = 0;
+	if (!readValue(data, offset, stream_count))
+		return false;
+
+	std::vector<Stream> streams(stream_count);
+
+	for (size_t i = 0; i < streams.size(); ++i)
+	{
+		Stream& stream = streams[i];
+
+		int type = 0;
+		if (!readValue(data, offset, type) || !readValue(data, offset, stream.index) || !readValue(data, offset, stream.target) || !readArray(data, offset, stream.data))
+			return false;
+
+		stream.type = cgltf_attribute_type(type);
+	}
+
+	std::vector<unsigned int> indices;
+	if (!readArray(data, offset, indices) || offset != data.size())
+		return false;
+
+	mesh.streams.swap(streams);
+	mesh.indices.swap(indices);
+	return true;
+}
+
+bool processMeshCached(Mesh& mesh, const Settings& settings)
+{
+	if (!settings.cache_path)
+	{
+		processMesh(mesh, settings);
+		return false;
+	}
+
+	unsigned long long key = hashMesh(mesh, settings);
+
+	std::string data;
+	if (readCache(settings.cache_path, key, ".mesh", data) && decodeMesh(mesh, data))
+		return true;
+
+	processMesh(mesh, settings);
+
+	data.clear();
+	encodeMesh(data, mesh);
+
+	writeCache(settings.cache_path, key, ".mesh", data);
+	return false;
+}
@@ -1,16 +1,27 @@
 // This file is part of gltfpack; see gltfpack.h for version/license details
 #include "gltfpack.h"
 
+#include <utility>
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
 #include <io.h>
+#include <windows.h>
 #else
 #include <unistd.h>
 #endif
 
+#if !defined(_WIN32) && !defined(__wasi__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 TempFile::TempFile()
 	: fd(-1)
 {
@@ -138,3 +149,115 @@ bool writeFile(const char* path, const std::string& data)
 
 	return rc == 0 && result == data.size();
 }
+
+// munmap needs the mapping size, so we keep track of all live mappings; there are only as many as there are input files
+// note that input files are only mapped and unmapped on the main thread, so this doesn't need to be synchronized
+static std::vector<std::pair<void*, size_t> > gMappings;
+
+static void* readFileHeap(const char* path, size_t* size)
+{
+	FILE* file = fopen(path, "rb");
+	if (!file)
+		return NULL;
+
+	fseek(file, 0, SEEK_END);
+	long length = ftell(file);
+	fseek(file, 0, SEEK_SET);
+
+	// we allocate at least one byte so that empty files can be distinguished from errors
+	void* data = length < 0 ? NULL : malloc(length + 1);
+	size_t result = data ? fread(data, 1, length, file) : 0;
+	int rc = fclose(file);
+
+	if (data && (rc != 0 || result != size_t(length)))
+	{
+		free(data);
+		return NULL;
+	}
+
+	*size = data ? size_t(length) : 0;
+	return data;
+}
+
+void* mapFile(const char* path, size_t* size)
+{
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return NULL;
+
+	LARGE_INTEGER length = {};
+	if (!GetFileSizeEx(file, &length) || length.QuadPart == 0 || (unsigned long long)length.QuadPart > size_t(-1))
+	{
+		CloseHandle(file);
+		return readFileHeap(path, size);
+	}
+
+	// copy-on-write mapping ensures that accidental writes never reach the input file
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+	void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0) : NULL;
+
+	if (mapping)
+		CloseHandle(mapping);
+	CloseHandle(file);
+
+	if (!data)
+		return readFileHeap(path, size);
+
+	*size = size_t(length.QuadPart);
+	gMappings.push_back(std::make_pair(data, *size));
+
+	return data;
+#elif !defined(__wasi__)
+	int fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return NULL;
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || st.st_size <= 0 || (unsigned long long)st.st_size > size_t(-1))
+	{
+		close(fd);
+		return readFileHeap(path, size);
+	}
+
+	// copy-on-write mapping ensures that accidental writes never reach the input file
+	void* data = mmap(NULL, size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+
+	if (data == MAP_FAILED)
+		return readFileHeap(path, size);
+
+	*size = size_t(st.st_size);
+	gMappings.push_back(std::make_pair(data, *size));
+
+	return data;
+#else
+	return readFileHeap(path, size);
+#endif
+}
+
+void unmapFile(void* data)
+{
+	if (!data)
+		return;
+
+	for (size_t i = 0; i < gMappings.size(); ++i)
+		if (gMappings[i].first == data)
+		{
+			size_t size = gMappings[i].second;
+
+			gMappings[i] = gMappings.back();
+			gMappings.pop_back();
+
+#if defined(_WIN32)
+			(void)size;
+			UnmapViewOfFile(data);
+#elif !defined(__wasi__)
+			munmap(data, size);
+#endif
+			return;
+		}
+
+	// data that isn't a mapping was read into heap memory as a fallback
+	free(data);
+}
@@ -3,6 +3,11 @@
 
 #include <algorithm>
 
+#ifndef __wasi__
+#include <atomic>
+#include <thread>
+#endif
+
 #include <locale.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -22,56 +27,115 @@ std::string getVersion()
 	return result;
 }
 
-static void finalizeBufferViews(std::string& json, std::vector<BufferView>& views, std::string& bin, std::string* fallback, size_t& fallback_size)
+#ifndef __wasi__
+static void parallelWorker(std::atomic<size_t>* next, size_t count, const std::function<void(size_t)>* body)
 {
+	for (size_t i = (*next)++; i < count; i = (*next)++)
+		(*body)(i);
+}
+#endif
+
+void parallelFor(size_t count, int jobs, const std::function<void(size_t)>& body)
+{
+#ifndef __wasi__
+	size_t threads = jobs == 0 ? std::thread::hardware_concurrency() : size_t(jobs);
+	threads = std::min(threads, count);
+
+	if (threads > 1)
+	{
+		// work is distributed dynamically since items (e.g. meshes) can vary in cost by orders of magnitude
+		std::atomic<size_t> next(0);
+
+		std::vector<std::thread> workers;
+		for (size_t i = 0; i < threads - 1; ++i)
+			workers.push_back(std::thread(parallelWorker, &next, count, &body));
+
+		parallelWorker(&next, count, &body);
+
+		for (size_t i = 0; i < workers.size(); ++i)
+			workers[i].join();
+
+		return;
+	}
+#else
+	(void)jobs;
+#endif
+
+	for (size_t i = 0; i < count; ++i)
+		body(i);
+}
+
+static void writeBinary(FILE* out, size_t& offset, const char* data, size_t size)
+{
+	// out may be NULL when no output is requested, in which case we still need to track offsets for statistics
+	if (out && size)
+		fwrite(data, 1, size, out);
+
+	offset += size;
+}
+
+static void writeBinaryPadding(FILE* out, size_t& offset)
+{
+	static const char zero[4] = {};
+
+	writeBinary(out, offset, zero, ((offset + 3) & ~3) - offset);
+}
+
+static void finalizeBufferViews(std::string& json, std::vector<BufferView>& views, FILE* bin, size_t& bin_size, FILE* fallback, size_t& fallback_size)
+{
+	std::string compressed;
+
 	for (size_t i = 0; i < views.size(); ++i)
 	{
 		BufferView& view = views[i];
 
-		size_t bin_offset = bin.size();
+		size_t bin_offset = bin_size;
 		size_t fallback_offset = fallback_size;
 
 		size_t count = view.data.size() / view.stride;
 
 		if (view.compression == BufferView::Compression_None)
 		{
-			bin += view.data;
+			writeBinary(bin, bin_size, view.data.c_str(), view.data.size());
 		}
 		else
 		{
+			compressed.clear();
+
 			switch (view.compression)
 			{
 			case BufferView::Compression_Attribute:
-				compressVertexStream(bin, view.data, count, view.stride);
+				compressVertexStream(compressed, view.data, count, view.stride);
 				break;
 			case BufferView::Compression_Index:
-				compressIndexStream(bin, view.data, count, view.stride);
+				compressIndexStream(compressed, view.data, count, view.stride);
 				break;
 			case BufferView::Compression_IndexSequence:
-				compressIndexSequence(bin, view.data, count, view.stride);
+				compressIndexSequence(compressed, view.data, count, view.stride);
 				break;
 			default:
 				assert(!"Unknown compression type");
 			}
 
-			if (fallback)
-				*fallback += view.data;
-			fallback_size += view.data.size();
+			writeBinary(bin, bin_size, compressed.c_str(), compressed.size());
+			writeBinary(fallback, fallback_size, view.data.c_str(), view.data.size());
 		}
 
 		size_t raw_offset = (view.compression != BufferView::Compression_None) ? fallback_offset : bin_offset;
 
 		comma(json);
-		writeBufferView(json, view.kind, view.filter, count, view.stride, raw_offset, view.data.size(), view.compression, bin_offset, bin.size() - bin_offset);
+		writeBufferView(json, view.kind, view.filter, count, view.stride, raw_offset, view.data.size(), view.compression, bin_offset, bin_size - bin_offset);
 
 		// record written bytes for statistics
-		view.bytes = bin.size() - bin_offset;
+		view.bytes = bin_size - bin_offset;
+		view.raw_bytes = view.data.size();
+
+		// view data has been written to the output and is no longer needed
+		std::string().swap(view.data);
 
 		// align each bufferView by 4 bytes
-		bin.resize((bin.size() + 3) & ~3);
-		if (fallback)
-			fallback->resize((fallback->size() + 3) & ~3);
-		fallback_size = (fallback_size + 3) & ~3;
+		writeBinaryPadding(bin, bin_size);
+		writeBinaryPadding(fallback, fallback_size);
 	}
 }
 
@@ -88,7 +152,7 @@ static void printMeshStats(const std::vector<Mesh>& meshes, const char* name)
 		const Mesh& mesh = meshes[i];
 
 		mesh_triangles += mesh.indices.size() / 3;
-		mesh_vertices += mesh.streams.empty() ? 0 : mesh.streams[0].data.size();
+		mesh_vertices += mesh.streams.empty() ? 0 : getStreamCount(mesh.streams[0]);
 
 		size_t instances = std::max(size_t(1), mesh.nodes.size() + mesh.instances.size());
 
@@ -149,12 +213,12 @@ static void printAttributeStats(const std::vector<BufferView>& views, BufferView
 		default:;
 		}
 
-		size_t count = view.data.size() / view.stride;
+		size_t count = view.raw_bytes / view.stride;
 
 		printf("stats: %s %s: compressed %d bytes (%.1f bits), raw %d bytes (%d bits)\n",
 		    name, variant,
 		    int(view.bytes), double(view.bytes) / double(count) * 8,
-		    int(view.data.size()), int(view.stride * 8));
+		    int(view.raw_bytes), int(view.stride * 8));
 	}
 }
 
@@ -174,7 +238,7 @@ static void printImageStats(const std::vector<BufferView>& views, TextureKind ki
 			continue;
 
 		count += 1;
-		bytes += view.data.size();
+		bytes += view.raw_bytes;
 	}
 
 	if (count)
@@ -250,7 +314,7 @@ static bool canTransformMesh(const Mesh& mesh)
 	return true;
 }
 
-static void process(cgltf_data* data, const char* input_path, const char* output_path, const char* report_path, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const Settings& settings, std::string& json, std::string& bin, std::string& fallback, size_t& fallback_size)
+static void process(cgltf_data* data, const char* input_path, const char* output_path, const char* report_path, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const Settings& settings, std::string& json, FILE* bin, size_t& bin_size, FILE* fallback, size_t& fallback_size)
 {
 	if (settings.verbose)
 	{
@@ -323,7 +387,9 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 		}
 		else if (canTransformMesh(mesh))
 		{
+			unpackMesh(mesh);
 			mergeMeshInstances(mesh);
+			packMesh(mesh);
 
 			assert(mesh.nodes.empty());
 			mesh.scene = scene;
@@ -338,8 +404,22 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 
 	optimizeMaterials(data, input_path, images);
 
+	std::vector<std::string> encoded_images;
+
+#ifdef WITH_BASISU
+	// encodeImages only reads source images and image information, so it can run alongside mesh processing
+	std::thread image_encoder;
+
+	if (data->images_count && settings.texture_ktx2)
+	{
+		encoded_images.resize(data->images_count);
+
+		image_encoder = std::thread(encodeImages, encoded_images.data(), data, std::cref(images), input_path, std::cref(settings));
+	}
+#endif
+
 	// streams need to be filtered before mesh merging (or processing) to make sure we can merge meshes with redundant streams
-	for (size_t i = 0; i < meshes.size(); ++i)
+	parallelFor(meshes.size(), settings.mesh_jobs, [&](size_t i)
 	{
 		Mesh& mesh = meshes[i];
 		MaterialInfo mi = mesh.material ? materials[mesh.material - data->materials] : MaterialInfo();
@@ -354,7 +434,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 		}
 
 		filterStreams(mesh, mi);
-	}
+	});
 
 	mergeMeshMaterials(data, meshes, settings);
 	mergeMeshes(meshes, settings);
@@ -368,7 +448,8 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 
 	for (size_t i = 0; i < meshes.size(); ++i)
 	{
-		const Mesh& mesh = meshes[i];
+		Mesh mesh = meshes[i];
+		unpackMesh(mesh);
 
 		if (settings.simplify_debug > 0)
 		{
@@ -390,10 +471,19 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	}
 #endif
 
-	for (size_t i = 0; i < meshes.size(); ++i)
+	// meshes are processed independently and in place, so the output doesn't depend on the number of jobs
+	std::vector<char> mesh_cached(meshes.size());
+
+	parallelFor(meshes.size(), settings.mesh_jobs, [&](size_t i)
 	{
-		processMesh(meshes[i], settings);
-	}
+		// processing needs floating point data; processed meshes are packed again to keep memory footprint low until they are written
+		unpackMesh(meshes[i]);
+		mesh_cached[i] = processMeshCached(meshes[i], settings);
+		packMesh(meshes[i]);
+	});
+
+	if (settings.cache_path && settings.verbose)
+		printf("cache: %d of %d meshes reused\n", int(std::count(mesh_cached.begin(), mesh_cached.end(), 1)), int(meshes.size()));
 
 #ifndef NDEBUG
 	meshes.insert(meshes.end(), debug_meshes.begin(), debug_meshes.end());
@@ -453,15 +543,10 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 		append(json_samplers, "}");
 	}
 
-	std::vector<std::string> encoded_images;
-
 #ifdef WITH_BASISU
-	if (data->images_count && settings.texture_ktx2)
-	{
-		encoded_images.resize(data->images_count);
-
-		encodeImages(encoded_images.data(), data, images, input_path, settings);
-	}
+	// image encoding runs concurrently with mesh processing; results are only needed when writing images below
+	if (image_encoder.joinable())
+		image_encoder.join();
 #endif
 
 	for (size_t i = 0; i < data->images_count; ++i)
@@ -822,7 +907,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	writeExtensions(json, extensions, sizeof(extensions) / sizeof(extensions[0]));
 
 	std::string json_views;
-	finalizeBufferViews(json_views, views, bin, settings.fallback ? &fallback : NULL, fallback_size);
+	finalizeBufferViews(json_views, views, bin, bin_size, fallback, fallback_size);
 
 	writeArray(json, "bufferViews", json_views);
 	writeArray(json, "accessors", json_accessors);
@@ -863,7 +948,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 	if (settings.verbose)
 	{
 		printMeshStats(meshes, "output");
-		printSceneStats(views, meshes, node_offset, mesh_offset, material_offset, json.size(), bin.size());
+		printSceneStats(views, meshes, node_offset, mesh_offset, material_offset, json.size(), bin_size);
 	}
 
 	if (settings.verbose > 1)
@@ -881,7 +966,7 @@ static void process(cgltf_data* data, const char* input_path, const char* output
 
 	if (report_path)
 	{
-		if (!printReport(report_path, data, views, meshes, node_offset, mesh_offset, material_offset, animations.size(), json.size(), bin.size()))
+		if (!printReport(report_path, data, views, meshes, node_offset, mesh_offset, material_offset, animations.size(), json.size(), bin_size))
 		{
 			fprintf(stderr, "Warning: cannot save report to %s\n", report_path);
 		}
@@ -893,6 +978,44 @@ static void writeU32(FILE* out, uint32_t data)
 	fwrite(&data, 4, 1, out);
 }
 
+static bool copyFile(FILE* out, FILE* in)
+{
+	if (fflush(in) != 0 || fseek(in, 0, SEEK_SET) != 0)
+		return false;
+
+	char buffer[65536];
+
+	for (;;)
+	{
+		size_t size = fread(buffer, 1, sizeof(buffer), in);
+		if (size == 0)
+			break;
+
+		if (fwrite(buffer, 1, size, out) != size)
+			return false;
+	}
+
+	return ferror(in) == 0;
+}
+
+static void discardOutputs(FILE* outbin, const char* binpath, FILE* outfb, const char* fbpath)
+{
+	// partially written buffers are useless, so they are closed and removed to avoid leaving stale files behind
+	if (outbin)
+	{
+		fclose(outbin);
+
+		if (binpath)
+			remove(binpath);
+	}
+
+	if (outfb)
+	{
+		fclose(outfb);
+		remove(fbpath);
+	}
+}
+
 static const char* getBaseName(const char* path)
 {
 	const char* slash = strrchr(path, '/');
@@ -952,6 +1075,12 @@ int gltfpack(const char* input, const char* output, const char* report, Settings
 	std::string iext = getExtension(input);
 	std::string oext = output ? getExtension(output) : "";
 
+	if (output && oext != ".gltf" && oext != ".glb")
+	{
+		fprintf(stderr, "Error saving %s: unknown extension (expected .gltf or .glb)\n", output);
+		return 4;
+	}
+
 	if (iext == ".gltf" || iext == ".glb")
 	{
 		const char* error = 0;
@@ -996,9 +1125,50 @@ int gltfpack(const char* input, const char* output, const char* report, Settings
 		settings.texture_embed = true;
 	}
 
-	std::string json, bin, fallback;
-	size_t fallback_size = 0;
-	process(data, input, output, report, meshes, animations, settings, json, bin, fallback, fallback_size);
+	std::string binpath, fbpath;
+
+	if (output)
+	{
+		std::string base = output;
+		base.erase(base.size() - oext.size());
+
+		binpath = base + ".bin";
+		fbpath = base + ".fallback.bin";
+	}
+
+	// buffer data is streamed directly to the output files as each buffer view is finalized
+	// GLB requires the JSON chunk to precede the binary chunk, so for .glb output binary data is staged in a temporary file
+	TempFile glbbin;
+	FILE* outbin = NULL;
+	FILE* outfb = NULL;
+
+	if (output && oext == ".glb")
+	{
+		glbbin.create(".bin");
+		outbin = fopen(glbbin.path.c_str(), "w+b");
+	}
+	else if (output && oext == ".gltf")
+	{
+		outbin = fopen(binpath.c_str(), "wb");
+	}
+
+	if (output && settings.fallback)
+		outfb = fopen(fbpath.c_str(), "wb");
+
+	// for .glb output, the binary data is in a temporary file that is removed automatically
+	const char* binpath_out = oext == ".gltf" ? binpath.c_str() : NULL;
+
+	if (output && (!outbin || (!outfb && settings.fallback)))
+	{
+		fprintf(stderr, "Error saving %s\n", output);
+		discardOutputs(outbin, binpath_out, outfb, fbpath.c_str());
+		cgltf_free(data);
+		return 4;
+	}
+
+	std::string json;
+	size_t bin_size = 0, fallback_size = 0;
+	process(data, input, output, report, meshes, animations, settings, json, outbin, bin_size, outfb, fallback_size);
 
 	cgltf_free(data);
 
@@ -1007,24 +1177,19 @@ int gltfpack(const char* input, const char* output, const char* report, Settings
 		return 0;
 	}
 
+	int rc = 0;
+
 	if (oext == ".gltf")
 	{
-		std::string binpath = output;
-		binpath.replace(binpath.size() - 5, 5, ".bin");
-
-		std::string fbpath = output;
-		fbpath.replace(fbpath.size() - 5, 5, ".fallback.bin");
-
 		FILE* outjson = fopen(output, "wb");
-		FILE* outbin = fopen(binpath.c_str(), "wb");
-		FILE* outfb = settings.fallback ? fopen(fbpath.c_str(), "wb") : NULL;
-		if (!outjson || !outbin || (!outfb && settings.fallback))
+		if (!outjson)
 		{
 			fprintf(stderr, "Error saving %s\n", output);
+			discardOutputs(outbin, binpath_out, outfb, fbpath.c_str());
 			return 4;
 		}
 
-		std::string bufferspec = getBufferSpec(getBaseName(binpath.c_str()), bin.size(), settings.fallback ? getBaseName(fbpath.c_str()) : NULL, fallback_size, settings.compress);
+		std::string bufferspec = getBufferSpec(getBaseName(binpath.c_str()), bin_size, settings.fallback ? getBaseName(fbpath.c_str()) : NULL, fallback_size, settings.compress);
 
 		fprintf(outjson, "{");
 		fwrite(bufferspec.c_str(), bufferspec.size(), 1, outjson);
@@ -1032,37 +1197,20 @@ int gltfpack(const char* input, const char* output, const char* report, Settings
 		fwrite(json.c_str(), json.size(), 1, outjson);
 		fprintf(outjson, "}");
 
-		fwrite(bin.c_str(), bin.size(), 1, outbin);
-
-		if (settings.fallback)
-			fwrite(fallback.c_str(), fallback.size(), 1, outfb);
-
-		int rc = 0;
+		rc |= ferror(outjson);
 		rc |= fclose(outjson);
-		rc |= fclose(outbin);
-		if (outfb)
-			rc |= fclose(outfb);
-
-		if (rc)
-		{
-			fprintf(stderr, "Error saving %s\n", output);
-			return 4;
-		}
 	}
 	else if (oext == ".glb")
 	{
-		std::string fbpath = output;
-		fbpath.replace(fbpath.size() - 4, 4, ".fallback.bin");
-
 		FILE* out = fopen(output, "wb");
-		FILE* outfb = settings.fallback ? fopen(fbpath.c_str(), "wb") : NULL;
-		if (!out || (!outfb && settings.fallback))
+		if (!out)
 		{
 			fprintf(stderr, "Error saving %s\n", output);
+			discardOutputs(outbin, binpath_out, outfb, fbpath.c_str());
 			return 4;
 		}
 
-		std::string bufferspec = getBufferSpec(NULL, bin.size(), settings.fallback ? getBaseName(fbpath.c_str()) : NULL, fallback_size, settings.compress);
+		std::string bufferspec = getBufferSpec(NULL, bin_size, settings.fallback ? getBaseName(fbpath.c_str()) : NULL, fallback_size, settings.compress);
 
 		json.insert(0, "{" + bufferspec + ",");
 		json.push_back('}');
@@ -1070,38 +1218,45 @@ int gltfpack(const char* input, const char* output, const char* report, Settings
 		while (json.size() % 4)
 			json.push_back(' ');
 
-		while (bin.size() % 4)
-			bin.push_back('\0');
+		// each buffer view is padded to 4 bytes so the binary chunk is always aligned
+		assert(bin_size % 4 == 0);
 
 		writeU32(out, 0x46546C67);
 		writeU32(out, 2);
-		writeU32(out, uint32_t(12 + 8 + json.size() + 8 + bin.size()));
+		writeU32(out, uint32_t(12 + 8 + json.size() + 8 + bin_size));
 
 		writeU32(out, uint32_t(json.size()));
 		writeU32(out, 0x4E4F534A);
 		fwrite(json.c_str(), json.size(), 1, out);
 
-		writeU32(out, uint32_t(bin.size()));
+		writeU32(out, uint32_t(bin_size));
 		writeU32(out, 0x004E4942);
-		fwrite(bin.c_str(), bin.size(), 1, out);
 
-		if (settings.fallback)
-			fwrite(fallback.c_str(), fallback.size(), 1, outfb);
+		rc |= !copyFile(out, outbin);
 
-		int rc = 0;
+		rc |= ferror(out);
 		rc |= fclose(out);
-		if (outfb)
-			rc |= fclose(outfb);
+	}
 
-		if (rc)
-		{
-			fprintf(stderr, "Error saving %s\n", output);
-			return 4;
-		}
+	rc |= ferror(outbin);
+	rc |= fclose(outbin);
+
+	if (outfb)
+	{
+		rc |= ferror(outfb);
+		rc |= fclose(outfb);
 	}
-	else
+
+	if (rc)
 	{
-		fprintf(stderr, "Error saving %s: unknown extension (expected .gltf or .glb)\n", output);
+		fprintf(stderr, "Error saving %s\n", output);
+
+		// all outputs are closed at this point; their contents may be incomplete
+		remove(output);
+		if (binpath_out)
+			remove(binpath_out);
+		if (outfb)
+			remove(fbpath.c_str());
 		return 4;
 	}
 
@@ -1122,6 +1277,7 @@ Settings defaults()
 	settings.anim_freq = 30;
 	settings.simplify_threshold = 1.f;
 	settings.texture_scale = 1.f;
+	settings.mesh_jobs = 1;
 	for (int kind = 0; kind < TextureKind__Count; ++kind)
 		settings.texture_quality[kind] = 8;
 
@@ -1327,6 +1483,14 @@ int main(int argc, char** argv)
 		{
 			settings.texture_jobs = clamp(atoi(argv[++i]), 0, 128);
 		}
+		else if (strcmp(arg, "-j") == 0 && i + 1 < argc && isdigit(argv[i + 1][0]))
+		{
+			settings.mesh_jobs = clamp(atoi(argv[++i]), 0, 128);
+		}
+		else if (strcmp(arg, "-cache") == 0 && i + 1 < argc && !settings.cache_path)
+		{
+			settings.cache_path = argv[++i];
+		}
 		else if (strcmp(arg, "-noq") == 0)
 		{
 			// TODO: Warn if -noq is used and suggest -vpf instead; use -noqq to silence
@@ -1461,6 +1625,8 @@ int main(int argc, char** argv)
 			fprintf(stderr, "\t-mi: use EXT_mesh_gpu_instancing when serializing multiple mesh instances\n");
 			fprintf(stderr, "\nMiscellaneous:\n");
 			fprintf(stderr, "\t-cf: produce compressed gltf/glb files with fallback for loaders that don't support compression\n");
+			fprintf(stderr, "\t-j N: use N threads when processing meshes and animations (default: 1; 0 uses all available cores)\n");
+			fprintf(stderr, "\t-cache dir: reuse processed meshes and encoded textures from previous runs stored in directory dir\n");
 			fprintf(stderr, "\t-noq: disable quantization; produces much larger glTF files with no extensions\n");
 			fprintf(stderr, "\t-v: verbose output (print version when used without other options)\n");
 			fprintf(stderr, "\t-r file: output a JSON report to file\n");
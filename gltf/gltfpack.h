@@ -15,6 +15,7 @@
 
 #include <assert.h>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -30,6 +31,12 @@ struct Stream
 	int target; // 0 = base mesh, 1+ = morph target
 
 	std::vector<Attr> data;
+
+	// compact storage used between processing stages; when packed is not empty, data is empty (see packStream/unpackStream)
+	cgltf_component_type packed_type;
+	bool packed_normalized;
+	unsigned char packed_components;
+	std::vector<unsigned char> packed;
 };
 
 struct Transform
@@ -144,6 +151,10 @@ struct Settings
 
 	int texture_jobs;
 
+	int mesh_jobs;
+
+	const char* cache_path;
+
 	bool quantize;
 
 	bool compress;
@@ -263,6 +274,7 @@ struct BufferView
 	std::string data;
 
 	size_t bytes;
+	size_t raw_bytes;
 };
 
 struct TempFile
@@ -277,6 +289,10 @@ struct TempFile
 	void create(const char* suffix);
 };
 
+std::string getVersion();
+
+void parallelFor(size_t count, int jobs, const std::function<void(size_t)>& body);
+
 std::string getFullPath(const char* path, const char* base_path);
 std::string getFileName(const char* path);
 std::string getExtension(const char* path);
@@ -284,12 +300,21 @@ std::string getExtension(const char* path);
 bool readFile(const char* path, std::string& data);
 bool writeFile(const char* path, const std::string& data);
 
+void* mapFile(const char* path, size_t* size);
+void unmapFile(void* data);
+
 cgltf_data* parseObj(const char* path, std::vector<Mesh>& meshes, const char** error);
 cgltf_data* parseGltf(const char* path, std::vector<Mesh>& meshes, std::vector<Animation>& animations, const char** error);
 
 void processAnimation(Animation& animation, const Settings& settings);
 void processMesh(Mesh& mesh, const Settings& settings);
 
+unsigned long long hashData(unsigned long long hash, const void* data, size_t size);
+unsigned long long hashString(unsigned long long hash, const char* data);
+bool readCache(const char* cache_path, unsigned long long key, const char* suffix, std::string& data);
+bool writeCache(const char* cache_path, unsigned long long key, const char* suffix, const std::string& data);
+bool processMeshCached(Mesh& mesh, const Settings& settings);
+
 void debugSimplify(const Mesh& mesh, Mesh& kinds, Mesh& loops, float ratio);
 void debugMeshlets(const Mesh& mesh, Mesh& meshlets, Mesh& bounds, int max_vertices, bool scan);
 
@@ -302,6 +327,13 @@ void mergeMeshes(std::vector<Mesh>& meshes, const Settings& settings);
 void filterEmptyMeshes(std::vector<Mesh>& meshes);
 void filterStreams(Mesh& mesh, const MaterialInfo& mi);
 
+void packStream(Stream& stream);
+void unpackStream(Stream& stream);
+void packMesh(Mesh& mesh);
+void unpackMesh(Mesh& mesh);
+size_t getStreamCount(const Stream& stream);
+const std::vector<Attr>& getStreamData(const Stream& stream, std::vector<Attr>& scratch);
+
 void mergeMeshMaterials(cgltf_data* data, std::vector<Mesh>& meshes, const Settings& settings);
 void markNeededMaterials(cgltf_data* data, std::vector<MaterialInfo>& materials, const std::vector<Mesh>& meshes, const Settings& settings);
 
@@ -286,32 +286,92 @@ void mergeMeshInstances(Mesh& mesh)
 	mesh.nodes.clear();
 }
 
-void mergeMeshes(std::vector<Mesh>& meshes, const Settings& settings)
+static bool isMergeableNode(cgltf_node* node, const Settings& settings)
 {
-	for (size_t i = 0; i < meshes.size(); ++i)
+	bool transform = node->has_translation | node->has_rotation | node->has_scale | node->has_matrix | (!!node->weights);
+	bool named = settings.keep_nodes && node->name && *node->name;
+
+	return !transform && !named;
+}
+
+static unsigned long long hashMergeKey(const Mesh& mesh, const Settings& settings)
+{
+	// the hash covers everything that canMergeMeshes compares, so meshes that can be merged always have the same hash
+	int header[6] = {mesh.scene, int(mesh.type), int(mesh.targets), int(mesh.indices.empty()), int(mesh.nodes.size()), int(mesh.streams.size())};
+	unsigned long long hash = hashData(0, header, sizeof(header));
+
+	hash = hashData(hash, &mesh.material, sizeof(mesh.material));
+	hash = hashData(hash, &mesh.skin, sizeof(mesh.skin));
+
+	for (size_t i = 0; i < mesh.nodes.size(); ++i)
+	{
+		// this mirrors canMergeMeshNodes: nodes without transforms can be merged with their siblings, so they are keyed by parent
+		cgltf_node* node = mesh.nodes[i];
+		bool mergeable = isMergeableNode(node, settings);
+
+		cgltf_node* key = mergeable ? node->parent : node;
+		hash = hashData(hash, &key, sizeof(key));
+		hash = hashData(hash, &mergeable, sizeof(mergeable));
+	}
+
+	for (size_t i = 0; i < mesh.target_weights.size(); ++i)
+	{
+		// weights are compared as floats, so -0 and 0 need to hash identically
+		float weight = mesh.target_weights[i] == 0.f ? 0.f : mesh.target_weights[i];
+		hash = hashData(hash, &weight, sizeof(weight));
+	}
+
+	for (size_t i = 0; i < mesh.target_names.size(); ++i)
+		hash = hashString(hash, mesh.target_names[i]);
+
+	for (size_t i = 0; i < mesh.variants.size(); ++i)
+	{
+		hash = hashData(hash, &mesh.variants[i].variant, sizeof(mesh.variants[i].variant));
+		hash = hashData(hash, &mesh.variants[i].material, sizeof(mesh.variants[i].material));
+	}
+
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+	{
+		int stream[3] = {int(mesh.streams[i].type), mesh.streams[i].index, mesh.streams[i].target};
+		hash = hashData(hash, stream, sizeof(stream));
+	}
+
+	return hash;
+}
+
+static void mergeMeshGroup(std::vector<Mesh>& meshes, const std::pair<unsigned long long, size_t>* group, size_t group_size, const Settings& settings)
+{
+	// group is sorted by mesh index; since merge compatibility is an equivalence relation, merging every mesh into the first compatible one
+	// produces the same result as scanning all subsequent meshes in order; the quadratic loop only repeats for hash collisions
+	for (size_t i = 0; i < group_size; ++i)
 	{
-		Mesh& target = meshes[i];
+		Mesh& target = meshes[group[i].second];
 
 		if (target.streams.empty())
 			continue;
 
-		size_t target_vertices = target.streams[0].data.size();
+		size_t target_vertices = getStreamCount(target.streams[0]);
 		size_t target_indices = target.indices.size();
 
 		size_t last_merged = i;
 
-		for (size_t j = i + 1; j < meshes.size(); ++j)
+		for (size_t j = i + 1; j < group_size; ++j)
 		{
-			Mesh& mesh = meshes[j];
+			Mesh& mesh = meshes[group[j].second];
 
 			if (!mesh.streams.empty() && canMergeMeshes(target, mesh, settings))
 			{
-				target_vertices += mesh.streams[0].data.size();
+				target_vertices += getStreamCount(mesh.streams[0]);
 				target_indices += mesh.indices.size();
 				last_merged = j;
 			}
 		}
 
+		if (last_merged == i)
+			continue;
+
+		unpackMesh(target);
+
 		for (size_t j = 0; j < target.streams.size(); ++j)
 			target.streams[j].data.reserve(target_vertices);
 
@@ -319,10 +379,11 @@ void mergeMeshes(std::vector<Mesh>& meshes, const Settings& settings)
 
 		for (size_t j = i + 1; j <= last_merged; ++j)
 		{
-			Mesh& mesh = meshes[j];
+			Mesh& mesh = meshes[group[j].second];
 
 			if (!mesh.streams.empty() && canMergeMeshes(target, mesh, settings))
 			{
+				unpackMesh(mesh);
 				mergeMeshes(target, mesh);
 
 				mesh.streams.clear();
@@ -334,6 +395,38 @@ void mergeMeshes(std::vector<Mesh>& meshes, const Settings& settings)
 
 		assert(target.streams[0].data.size() == target_vertices);
 		assert(target.indices.size() == target_indices);
+
+		packMesh(target);
+	}
+}
+
+void mergeMeshes(std::vector<Mesh>& meshes, const Settings& settings)
+{
+	// group meshes by the hash of their merge key to avoid comparing all pairs of meshes
+	std::vector<std::pair<unsigned long long, size_t> > keys;
+	keys.reserve(meshes.size());
+
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		const Mesh& mesh = meshes[i];
+
+		// meshes with instances are never merged
+		if (!mesh.streams.empty() && mesh.instances.empty())
+			keys.push_back(std::make_pair(hashMergeKey(mesh, settings), i));
+	}
+
+	std::sort(keys.begin(), keys.end());
+
+	for (size_t i = 0; i < keys.size();)
+	{
+		size_t j = i + 1;
+		while (j < keys.size() && keys[j].first == keys[i].first)
+			++j;
+
+		if (j - i > 1)
+			mergeMeshGroup(meshes, &keys[i], j - i, settings);
+
+		i = j;
 	}
 }
 
@@ -348,7 +441,7 @@ void filterEmptyMeshes(std::vector<Mesh>& meshes)
 		if (mesh.streams.empty())
 			continue;
 
-		if (mesh.streams[0].data.empty())
+		if (getStreamCount(mesh.streams[0]) == 0)
 			continue;
 
 		if (mesh.type != cgltf_primitive_type_points && mesh.indices.empty())
@@ -407,14 +500,17 @@ void filterStreams(Mesh& mesh, const MaterialInfo& mi)
 	bool morph_tangent = false;
 	int keep_texture_set = -1;
 
+	// streams may be packed; only the few streams that are analyzed below need to be unpacked
+	std::vector<Attr> scratch;
+
 	for (size_t i = 0; i < mesh.streams.size(); ++i)
 	{
 		Stream& stream = mesh.streams[i];
 
 		if (stream.target)
 		{
-			morph_normal = morph_normal || (stream.type == cgltf_attribute_type_normal && hasDeltas(stream.data));
-			morph_tangent = morph_tangent || (stream.type == cgltf_attribute_type_tangent && hasDeltas(stream.data));
+			morph_normal = morph_normal || (stream.type == cgltf_attribute_type_normal && hasDeltas(getStreamData(stream, scratch)));
+			morph_tangent = morph_tangent || (stream.type == cgltf_attribute_type_tangent && hasDeltas(getStreamData(stream, scratch)));
 		}
 
 		if (stream.type == cgltf_attribute_type_texcoord && (mi.textureSetMask & (1u << stream.index)) != 0)
@@ -438,7 +534,7 @@ void filterStreams(Mesh& mesh, const MaterialInfo& mi)
 		if ((stream.type == cgltf_attribute_type_joints || stream.type == cgltf_attribute_type_weights) && !mesh.skin)
 			continue;
 
-		if (stream.type == cgltf_attribute_type_color && !hasColors(stream.data))
+		if (stream.type == cgltf_attribute_type_color && !hasColors(getStreamData(stream, scratch)))
 			continue;
 
 		if (stream.target && stream.type == cgltf_attribute_type_normal && !morph_normal)
@@ -451,8 +547,12 @@ void filterStreams(Mesh& mesh, const MaterialInfo& mi)
 		std::vector<Attr> data;
 		data.swap(stream.data);
 
+		std::vector<unsigned char> packed;
+		packed.swap(stream.packed);
+
 		mesh.streams[write] = stream;
 		mesh.streams[write].data.swap(data);
+		mesh.streams[write].packed.swap(packed);
 
 		write++;
 	}
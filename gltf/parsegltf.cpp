@@ -46,15 +46,84 @@ static void readAccessor(std::vector<float>& data, const cgltf_accessor* accesso
 	cgltf_accessor_unpack_floats(accessor, &data[0], data.size());
 }
 
+static const unsigned char* getAccessorData(const cgltf_accessor* accessor)
+{
+	if (accessor->is_sparse || !accessor->buffer_view)
+		return NULL;
+
+	const cgltf_buffer_view* view = accessor->buffer_view;
+
+	// decompressed (meshopt) buffer views store their data separately
+	if (view->data)
+		return static_cast<const unsigned char*>(view->data) + accessor->offset;
+
+	if (!view->buffer->data)
+		return NULL;
+
+	return static_cast<const unsigned char*>(view->buffer->data) + view->offset + accessor->offset;
+}
+
+template <typename T>
+static void readComponents(std::vector<Attr>& data, const unsigned char* source, size_t stride, size_t components, float scale)
+{
+	for (size_t i = 0; i < data.size(); ++i)
+	{
+		const unsigned char* element = source + i * stride;
+
+		for (size_t k = 0; k < components; ++k)
+		{
+			T value;
+			memcpy(&value, element + k * sizeof(T), sizeof(T));
+
+			// this matches the conversion in cgltf_accessor_unpack_floats exactly
+			data[i].f[k] = scale == 0.f ? float(value) : value / scale;
+		}
+	}
+}
+
+static bool readAccessorFast(std::vector<Attr>& data, const cgltf_accessor* accessor)
+{
+	const unsigned char* source = getAccessorData(accessor);
+	if (!source)
+		return false;
+
+	// matrix accessors have padding rules for small components, so they use the generic path
+	if (accessor->type != cgltf_type_scalar && accessor->type != cgltf_type_vec2 && accessor->type != cgltf_type_vec3 && accessor->type != cgltf_type_vec4)
+		return false;
+
+	size_t components = cgltf_num_components(accessor->type);
+
+	switch (accessor->component_type)
+	{
+	case cgltf_component_type_r_32f:
+		readComponents<float>(data, source, accessor->stride, components, 0.f);
+		return true;
+
+	case cgltf_component_type_r_8u:
+		readComponents<unsigned char>(data, source, accessor->stride, components, accessor->normalized ? 255.f : 0.f);
+		return true;
+
+	case cgltf_component_type_r_16u:
+		readComponents<unsigned short>(data, source, accessor->stride, components, accessor->normalized ? 65535.f : 0.f);
+		return true;
+
+	default:
+		return false;
+	}
+}
+
 static void readAccessor(std::vector<Attr>& data, const cgltf_accessor* accessor)
 {
+	data.resize(accessor->count);
+
+	if (readAccessorFast(data, accessor))
+		return;
+
 	size_t components = cgltf_num_components(accessor->type);
 
 	std::vector<float> temp(accessor->count * components);
 	cgltf_accessor_unpack_floats(accessor, &temp[0], temp.size());
 
-	data.resize(accessor->count);
-
 	for (size_t i = 0; i < accessor->count; ++i)
 	{
 		for (size_t k = 0; k < components && k < 4; ++k)
@@ -62,6 +131,51 @@ static void readAccessor(std::vector<Attr>& data, const cgltf_accessor* accessor
 	}
 }
 
+template <typename T>
+static void readIndexComponents(std::vector<unsigned int>& indices, const unsigned char* source, size_t stride)
+{
+	for (size_t i = 0; i < indices.size(); ++i)
+	{
+		T value;
+		memcpy(&value, source + i * stride, sizeof(T));
+
+		indices[i] = value;
+	}
+}
+
+static void readIndices(std::vector<unsigned int>& indices, const cgltf_accessor* accessor)
+{
+	indices.resize(accessor->count);
+
+	const unsigned char* source = getAccessorData(accessor);
+
+	if (source && accessor->type == cgltf_type_scalar)
+	{
+		switch (accessor->component_type)
+		{
+		case cgltf_component_type_r_8u:
+			readIndexComponents<unsigned char>(indices, source, accessor->stride);
+			return;
+
+		case cgltf_component_type_r_16u:
+			readIndexComponents<unsigned short>(indices, source, accessor->stride);
+			return;
+
+		case cgltf_component_type_r_32u:
+			if (accessor->stride == sizeof(unsigned int) && !indices.empty())
+				memcpy(&indices[0], source, indices.size() * sizeof(unsigned int));
+			else
+				readIndexComponents<unsigned int>(indices, source, accessor->stride);
+			return;
+
+		default:;
+		}
+	}
+
+	for (size_t i = 0; i < accessor->count; ++i)
+		indices[i] = unsigned(cgltf_accessor_read_index(accessor, i));
+}
+
 static void fixupIndices(std::vector<unsigned int>& indices, cgltf_primitive_type& type)
 {
 	if (type == cgltf_primitive_type_line_loop)
@@ -146,12 +260,25 @@ static void parseMeshesGltf(cgltf_data* data, std::vector<Mesh>& meshes, std::ve
 	meshes.reserve(total_primitives);
 	mesh_remap.resize(data->meshes_count);
 
+	// meshes that aren't referenced by any node are discarded by parseMeshNodesGltf, so we don't need to decode them
+	std::vector<char> mesh_used(data->meshes_count);
+
+	for (size_t i = 0; i < data->nodes_count; ++i)
+		if (data->nodes[i].mesh)
+			mesh_used[data->nodes[i].mesh - data->meshes] = 1;
+
 	for (size_t mi = 0; mi < data->meshes_count; ++mi)
 	{
 		const cgltf_mesh& mesh = data->meshes[mi];
 
 		size_t remap_offset = meshes.size();
 
+		if (!mesh_used[mi])
+		{
+			mesh_remap[mi] = std::make_pair(remap_offset, remap_offset);
+			continue;
+		}
+
 		for (size_t pi = 0; pi < mesh.primitives_count; ++pi)
 		{
 			const cgltf_primitive& primitive = mesh.primitives[pi];
@@ -175,9 +302,7 @@ static void parseMeshesGltf(cgltf_data* data, std::vector<Mesh>& meshes, std::ve
 
 			if (primitive.indices)
 			{
-				result.indices.resize(primitive.indices->count);
-				for (size_t i = 0; i < primitive.indices->count; ++i)
-					result.indices[i] = unsigned(cgltf_accessor_read_index(primitive.indices, i));
+				readIndices(result.indices, primitive.indices);
 			}
 			else if (primitive.type != cgltf_primitive_type_points)
 			{
@@ -214,6 +339,9 @@ static void parseMeshesGltf(cgltf_data* data, std::vector<Mesh>& meshes, std::ve
 					for (size_t i = 0; i < s.data.size(); ++i)
 						s.data[i].f[3] = 1.0f;
 				}
+
+				// streams are stored compactly until they need to be processed
+				packStream(s);
 			}
 
 			for (size_t ti = 0; ti < primitive.targets_count; ++ti)
@@ -238,6 +366,7 @@ static void parseMeshesGltf(cgltf_data* data, std::vector<Mesh>& meshes, std::ve
 					s.target = int(ti + 1);
 
 					readAccessor(s.data, attr.data);
+					packStream(s);
 				}
 			}
 
@@ -380,12 +509,44 @@ static bool needsDummyBuffers(cgltf_data* data)
 	return false;
 }
 
+static cgltf_result readFileMapped(const cgltf_memory_options* memory_options, const cgltf_file_options* file_options, const char* path, cgltf_size* size, void** data)
+{
+	(void)memory_options;
+	(void)file_options;
+
+	size_t length = 0;
+	void* result = mapFile(path, &length);
+
+	if (!result)
+		return cgltf_result_file_not_found;
+
+	// buffers request a specific size which must be available in the file; extra data past that is ignored
+	if (*size > length)
+	{
+		unmapFile(result);
+		return cgltf_result_io_error;
+	}
+
+	*size = *size ? *size : length;
+	*data = result;
+
+	return cgltf_result_success;
+}
+
+static void releaseFileMapped(const cgltf_memory_options* memory_options, const cgltf_file_options* file_options, void* data)
+{
+	(void)memory_options;
+	(void)file_options;
+
+	unmapFile(data);
+}
+
 static void freeFile(cgltf_data* data)
 {
 	data->json = NULL;
 	data->bin = NULL;
 
-	free(data->file_data);
+	releaseFileMapped(NULL, NULL, data->file_data);
 	data->file_data = NULL;
 }
 
@@ -423,12 +584,15 @@ static bool freeUnusedBuffers(cgltf_data* data)
 
 		if (!used[i] && buffer.data)
 		{
-			if (buffer.data != data->bin)
-				free(buffer.data);
-			else
+			if (buffer.data == data->bin)
 				free_bin = true;
+			else if (buffer.data_free_method == cgltf_data_free_method_file_release)
+				releaseFileMapped(NULL, NULL, buffer.data);
+			else if (buffer.data_free_method == cgltf_data_free_method_memory_free)
+				free(buffer.data);
 
 			buffer.data = NULL;
+			buffer.data_free_method = cgltf_data_free_method_none;
 		}
 	}
 
@@ -439,7 +603,11 @@ cgltf_data* parseGltf(const char* path, std::vector<Mesh>& meshes, std::vector<A
 {
 	cgltf_data* data = 0;
 
+	// input files are memory-mapped so that buffer data is paged in on demand instead of being copied to the heap
 	cgltf_options options = {};
+	options.file.read = readFileMapped;
+	options.file.release = releaseFileMapped;
+
 	cgltf_result result = cgltf_parse_file(&options, path, &data);
 
 	if (data && !data->bin)
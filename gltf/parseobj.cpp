@@ -199,6 +199,9 @@ static void parseMeshesObj(fastObjMesh* obj, cgltf_data* data, std::vector<Mesh>
 
 		parseMeshObj(obj, face_offset, face_vertex_offset, face_count, face_vertex_count, index_count, mesh);
 
+		// streams are stored compactly until they need to be processed
+		packMesh(mesh);
+
 		face_offset += face_count;
 		face_vertex_offset += face_vertex_count;
 	}
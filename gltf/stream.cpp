@@ -7,6 +7,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "../src/meshoptimizer.h"
 
@@ -30,17 +31,21 @@ static void updateAttributeBounds(const Mesh& mesh, cgltf_attribute_type type, B
 {
 	Attr pad = {};
 
+	std::vector<Attr> scratch;
+
 	for (size_t j = 0; j < mesh.streams.size(); ++j)
 	{
 		const Stream& s = mesh.streams[j];
 
 		if (s.type == type)
 		{
+			const std::vector<Attr>& data = getStreamData(s, scratch);
+
 			if (s.target == 0)
 			{
-				for (size_t k = 0; k < s.data.size(); ++k)
+				for (size_t k = 0; k < data.size(); ++k)
 				{
-					const Attr& a = s.data[k];
+					const Attr& a = data[k];
 
 					b.min.f[0] = std::min(b.min.f[0], a.f[0]);
 					b.min.f[1] = std::min(b.min.f[1], a.f[1]);
@@ -55,9 +60,9 @@ static void updateAttributeBounds(const Mesh& mesh, cgltf_attribute_type type, B
 			}
 			else
 			{
-				for (size_t k = 0; k < s.data.size(); ++k)
+				for (size_t k = 0; k < data.size(); ++k)
 				{
-					const Attr& a = s.data[k];
+					const Attr& a = data[k];
 
 					pad.f[0] = std::max(pad.f[0], fabsf(a.f[0]));
 					pad.f[1] = std::max(pad.f[1], fabsf(a.f[1]));
@@ -932,3 +937,177 @@ void compressIndexSequence(std::string& bin, const std::string& data, size_t cou
 
 	bin.append(reinterpret_cast<const char*>(&compressed[0]), size);
 }
+
+// compact formats that are tried when packing the stream, in order of preference; q / scale must recover the original value exactly
+static const cgltf_component_type kPackTypes[] = {cgltf_component_type_r_8u, cgltf_component_type_r_8u, cgltf_component_type_r_16u, cgltf_component_type_r_16u};
+static const float kPackScales[] = {1.f, 255.f, 1.f, 65535.f};
+static const float kPackLimits[] = {255.f, 1.f, 65535.f, 1.f};
+
+static const int kPackFormats = sizeof(kPackTypes) / sizeof(kPackTypes[0]);
+
+static size_t getComponentSize(cgltf_component_type type)
+{
+	return type == cgltf_component_type_r_8u ? 1 : type == cgltf_component_type_r_16u ? 2 : 4;
+}
+
+static unsigned int getPackFormats(float v, unsigned int formats)
+{
+	unsigned int result = 0;
+
+	for (int k = 0; k < kPackFormats; ++k)
+	{
+		// comparing bit patterns rejects -0 and NaN as well as inexact values
+		if ((formats & (1 << k)) && v >= 0.f && v <= kPackLimits[k])
+		{
+			float r = float(int(v * kPackScales[k] + 0.5f)) / kPackScales[k];
+
+			if (memcmp(&r, &v, sizeof(float)) == 0)
+				result |= 1 << k;
+		}
+	}
+
+	return result;
+}
+
+void packStream(Stream& stream)
+{
+	if (stream.data.empty() || !stream.packed.empty())
+		return;
+
+	size_t count = stream.data.size();
+
+	size_t components = 1;
+	unsigned int formats = (1 << kPackFormats) - 1;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Attr& a = stream.data[i];
+
+		for (int k = 0; k < 4; ++k)
+		{
+			uint32_t bits;
+			memcpy(&bits, &a.f[k], sizeof(float));
+
+			// zero components are representable in all formats, and trailing zero components don't need to be stored
+			if (bits)
+			{
+				components = std::max(components, size_t(k + 1));
+				formats = formats ? getPackFormats(a.f[k], formats) : 0;
+			}
+		}
+	}
+
+	int format = 0;
+	while (format < kPackFormats && (formats & (1 << format)) == 0)
+		format++;
+
+	cgltf_component_type type = format < kPackFormats ? kPackTypes[format] : cgltf_component_type_r_32f;
+	float scale = format < kPackFormats ? kPackScales[format] : 1.f;
+
+	size_t size = getComponentSize(type);
+
+	stream.packed.resize(count * components * size);
+
+	unsigned char* dst = &stream.packed[0];
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Attr& a = stream.data[i];
+
+		for (size_t k = 0; k < components; ++k, dst += size)
+		{
+			if (type == cgltf_component_type_r_8u)
+				*dst = (unsigned char)(int(a.f[k] * scale + 0.5f));
+			else if (type == cgltf_component_type_r_16u)
+			{
+				uint16_t v = uint16_t(int(a.f[k] * scale + 0.5f));
+				memcpy(dst, &v, sizeof(v));
+			}
+			else
+				memcpy(dst, &a.f[k], sizeof(float));
+		}
+	}
+
+	stream.packed_type = type;
+	stream.packed_normalized = scale != 1.f;
+	stream.packed_components = (unsigned char)components;
+
+	std::vector<Attr>().swap(stream.data);
+}
+
+static void unpackStreamData(const Stream& stream, std::vector<Attr>& data)
+{
+	size_t count = getStreamCount(stream);
+	size_t components = stream.packed_components;
+
+	cgltf_component_type type = stream.packed_type;
+	size_t size = getComponentSize(type);
+
+	float scale = 1.f;
+	for (int k = 0; k < kPackFormats; ++k)
+		if (kPackTypes[k] == type && (kPackScales[k] != 1.f) == stream.packed_normalized)
+			scale = kPackScales[k];
+
+	data.clear();
+	data.resize(count);
+
+	const unsigned char* src = &stream.packed[0];
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		Attr& a = data[i];
+
+		for (size_t k = 0; k < components; ++k, src += size)
+		{
+			if (type == cgltf_component_type_r_8u)
+				a.f[k] = float(*src) / scale;
+			else if (type == cgltf_component_type_r_16u)
+			{
+				uint16_t v;
+				memcpy(&v, src, sizeof(v));
+				a.f[k] = float(v) / scale;
+			}
+			else
+				memcpy(&a.f[k], src, sizeof(float));
+		}
+	}
+}
+
+void unpackStream(Stream& stream)
+{
+	if (stream.packed.empty())
+		return;
+
+	unpackStreamData(stream, stream.data);
+
+	std::vector<unsigned char>().swap(stream.packed);
+}
+
+void packMesh(Mesh& mesh)
+{
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+		packStream(mesh.streams[i]);
+}
+
+void unpackMesh(Mesh& mesh)
+{
+	for (size_t i = 0; i < mesh.streams.size(); ++i)
+		unpackStream(mesh.streams[i]);
+}
+
+size_t getStreamCount(const Stream& stream)
+{
+	if (stream.packed.empty())
+		return stream.data.size();
+
+	return stream.packed.size() / (stream.packed_components * getComponentSize(stream.packed_type));
+}
+
+const std::vector<Attr>& getStreamData(const Stream& stream, std::vector<Attr>& scratch)
+{
+	if (stream.packed.empty())
+		return stream.data;
+
+	unpackStreamData(stream, scratch);
+	return scratch;
+}
@@ -930,11 +930,19 @@ void writeMeshAttributes(std::string& json, std::vector<BufferView>& views, std:
 
 	for (size_t j = 0; j < mesh.streams.size(); ++j)
 	{
-		const Stream& stream = mesh.streams[j];
-
-		if (stream.target != target)
+		if (mesh.streams[j].target != target)
 			continue;
 
+		// packed streams are restored temporarily, since quantization needs floating point data
+		Stream unpacked = {};
+		const Stream& stream = mesh.streams[j].packed.empty() ? mesh.streams[j] : unpacked;
+
+		if (!mesh.streams[j].packed.empty())
+		{
+			unpacked = mesh.streams[j];
+			unpackStream(unpacked);
+		}
+
 		scratch.clear();
 		StreamFormat format = writeVertexStream(scratch, stream, qp, qt, settings);
 		BufferView::Compression compression = settings.compress ? BufferView::Compression_Attribute : BufferView::Compression_None;
@@ -79,22 +79,49 @@ var MeshoptDecoder = (function() {
 		var worker = {
 			object: new Worker(url),
 			pending: 0,
-			requests: {}
+			requests: {},
+			batch: [],
+			transfer: []
 		};
 
 		worker.object.onmessage = function(event) {
-			var data = event.data;
+			var batch = event.data.batch || [event.data];
+
+			for (var i = 0; i < batch.length; ++i) {
+				var data = batch[i];
 
-			worker.pending -= data.count;
-			worker.requests[data.id][data.action](data.value);
+				worker.pending -= data.count;
+				worker.requests[data.id][data.action](data.value);
 
-			delete worker.requests[data.id];
+				delete worker.requests[data.id];
+			}
 		};
 
 		return worker;
 	}
 
+	function terminateWorkers() {
+		for (var i = 0; i < workers.length; ++i) {
+			var worker = workers[i];
+
+			// requests that are still in flight would never complete after the worker is terminated
+			for (var id in worker.requests) {
+				worker.requests[id].reject(new Error("Worker terminated"));
+			}
+
+			worker.object.terminate();
+		}
+
+		workers.length = 0;
+	}
+
 	function initWorkers(count) {
+		terminateWorkers();
+
+		if (count == 0) {
+			return;
+		}
+
 		var source =
 			"var instance; var ready = WebAssembly.instantiate(new Uint8Array([" + new Uint8Array(unpack(wasm)) + "]), {})" +
 			".then(function(result) { instance = result.instance; instance.exports.__wasm_call_ctors(); });" +
@@ -111,7 +138,7 @@ var MeshoptDecoder = (function() {
 		URL.revokeObjectURL(url);
 	}
 
-	function decodeWorker(count, size, source, mode, filter) {
+	function pickWorker() {
 		var worker = workers[0];
 
 		for (var i = 1; i < workers.length; ++i) {
@@ -120,6 +147,26 @@ var MeshoptDecoder = (function() {
 			}
 		}
 
+		return worker;
+	}
+
+	function isShared(array) {
+		return typeof SharedArrayBuffer !== 'undefined' && array.buffer instanceof SharedArrayBuffer;
+	}
+
+	function flushWorker(worker) {
+		var batch = worker.batch;
+		var transfer = worker.transfer;
+
+		worker.batch = [];
+		worker.transfer = [];
+
+		worker.object.postMessage({ batch: batch }, transfer);
+	}
+
+	function decodeWorker(count, size, source, mode, filter) {
+		var worker = pickWorker();
+
 		return new Promise(function (resolve, reject) {
 			var data = new Uint8Array(source);
 			var id = requestId++;
@@ -130,9 +177,51 @@ var MeshoptDecoder = (function() {
 		});
 	}
 
+	function decodeWorkerShared(target, count, size, source, mode, filter) {
+		var worker = pickWorker();
+
+		return new Promise(function (resolve, reject) {
+			// shared sources can be read by the worker directly; other sources are copied so that the copy can be transferred
+			var data = isShared(source) ? source : new Uint8Array(source);
+			var id = requestId++;
+
+			worker.pending += count;
+			worker.requests[id] = { resolve: resolve, reject: reject };
+			worker.batch.push({ id: id, count: count, size: size, source: data, target: target, mode: mode, filter: filter });
+
+			if (data !== source) {
+				worker.transfer.push(data.buffer);
+			}
+
+			// requests issued in the same task are sent to the worker in one message to reduce messaging overhead
+			if (worker.batch.length == 1) {
+				Promise.resolve().then(function() { flushWorker(worker); });
+			}
+		});
+	}
+
 	function workerProcess(event) {
 		ready.then(function() {
 			var data = event.data;
+
+			if (data.batch) {
+				var results = [];
+
+				for (var i = 0; i < data.batch.length; ++i) {
+					var item = data.batch[i];
+					try {
+						// target is backed by a SharedArrayBuffer, so the result doesn't need to be sent back
+						decode(instance.exports[item.mode], item.target, item.count, item.size, item.source, instance.exports[item.filter]);
+						results.push({ id: item.id, count: item.count, action: "resolve" });
+					} catch (error) {
+						results.push({ id: item.id, count: item.count, action: "reject", value: error });
+					}
+				}
+
+				self.postMessage({ batch: results });
+				return;
+			}
+
 			try {
 				var target = new Uint8Array(data.count * data.size);
 				decode(instance.exports[data.mode], target, data.count, data.size, data.source, instance.exports[data.filter]);
@@ -171,6 +260,19 @@ var MeshoptDecoder = (function() {
 				decode(instance.exports[decoders[mode]], target, count, size, source, instance.exports[filters[filter]]);
 				return target;
 			});
+		},
+		decodeGltfBufferShared: function(target, count, size, source, mode, filter) {
+			if (!isShared(target)) {
+				throw new Error("Target must be backed by a SharedArrayBuffer");
+			}
+
+			if (workers.length > 0) {
+				return decodeWorkerShared(target, count, size, source, decoders[mode], filters[filter]);
+			}
+
+			return ready.then(function() {
+				decode(instance.exports[decoders[mode]], target, count, size, source, instance.exports[filters[filter]]);
+			});
 		}
 	};
 })();
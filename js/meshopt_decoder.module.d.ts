@@ -12,4 +12,5 @@ export const MeshoptDecoder: {
 
     useWorkers: (count: number) => void;
     decodeGltfBufferAsync: (count: number, size: number, source: Uint8Array, mode: string, filter?: string) => Promise<Uint8Array>;
+    decodeGltfBufferShared: (target: Uint8Array, count: number, size: number, source: Uint8Array, mode: string, filter?: string) => Promise<void>;
 };
@@ -6,6 +6,46 @@ process.on('unhandledRejection', error => {
 	process.exit(1);
 });
 
+// Node doesn't implement Web Workers; this emulates the subset that useWorkers relies on with worker_threads
+function installWorkerShim() {
+	var threads = require('worker_threads');
+	var sources = {};
+	var nextUrl = 0;
+
+	var prelude =
+		"var parentPort = require('worker_threads').parentPort;" +
+		"var self = { postMessage: function(data, transfer) { parentPort.postMessage(data, transfer); } };" +
+		"parentPort.on('message', function(data) { self.onmessage({ data: data }); });";
+
+	global.Blob = function(parts) {
+		this.source = parts.join('');
+	};
+
+	URL.createObjectURL = function(blob) {
+		var url = 'blob:shim/' + nextUrl++;
+		sources[url] = blob.source;
+		return url;
+	};
+
+	URL.revokeObjectURL = function(url) {
+		delete sources[url];
+	};
+
+	global.Worker = function(url) {
+		var worker = this;
+		this.thread = new threads.Worker(prelude + sources[url], { eval: true });
+		this.thread.on('message', function(data) { worker.onmessage({ data: data }); });
+	};
+
+	global.Worker.prototype.postMessage = function(data, transfer) {
+		this.thread.postMessage(data, transfer);
+	};
+
+	global.Worker.prototype.terminate = function() {
+		this.thread.terminate();
+	};
+}
+
 var tests = {
 	decodeVertexBuffer: function() {
 		var encoded = new Uint8Array([
@@ -30,6 +70,36 @@ var tests = {
 		assert.deepStrictEqual(result, expected);
 	},
 
+	decodeGltfBufferShared: function() {
+		var encoded = new Uint8Array([
+			0xa0, 0x01, 0x3f, 0x00, 0x00, 0x00, 0x58, 0x57, 0x58, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01,
+			0x0c, 0x00, 0x00, 0x00, 0x58, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+			0x3f, 0x00, 0x00, 0x00, 0x17, 0x18, 0x17, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x00,
+			0x00, 0x00, 0x17, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		]);
+
+		var expected = new Uint8Array([
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			44, 1, 0, 0, 0, 0, 0, 0, 244, 1, 0, 0,
+			0, 0, 44, 1, 0, 0, 0, 0, 0, 0, 244, 1,
+			44, 1, 44, 1, 0, 0, 0, 0, 244, 1, 244, 1
+		]);
+
+		assert.throws(function() { decoder.decodeGltfBufferShared(new Uint8Array(expected.length), 4, 12, encoded, "ATTRIBUTES"); });
+
+		// decode into the middle of a larger shared buffer to make sure the surrounding data is preserved
+		var shared = new Uint8Array(new SharedArrayBuffer(expected.length + 8));
+		var result = new Uint8Array(shared.buffer, 4, expected.length);
+
+		return decoder.decodeGltfBufferShared(result, 4, 12, encoded, "ATTRIBUTES").then(function() {
+			assert.deepStrictEqual(new Uint8Array(result), expected);
+			assert.deepStrictEqual(shared.subarray(0, 4), new Uint8Array(4));
+			assert.deepStrictEqual(shared.subarray(4 + expected.length), new Uint8Array(4));
+		});
+	},
+
 	decodeVertexBuffer_More: function() {
 		var encoded = new Uint8Array([
 			0xa0, 0x00, 0x01, 0x2a, 0xaa, 0xaa, 0xaa, 0x02, 0x04, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44,
@@ -253,6 +323,54 @@ var tests = {
 
 		assert.deepStrictEqual(result, expected);
 	},
+
+	decodeGltfBufferWorkers: function() {
+		var encoded = new Uint8Array([
+			0xa0, 0x01, 0x3f, 0x00, 0x00, 0x00, 0x58, 0x57, 0x58, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01,
+			0x0c, 0x00, 0x00, 0x00, 0x58, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,
+			0x3f, 0x00, 0x00, 0x00, 0x17, 0x18, 0x17, 0x01, 0x26, 0x00, 0x00, 0x00, 0x01, 0x0c, 0x00,
+			0x00, 0x00, 0x17, 0x01, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		]);
+
+		var expected = new Uint8Array([
+			0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+			44, 1, 0, 0, 0, 0, 0, 0, 244, 1, 0, 0,
+			0, 0, 44, 1, 0, 0, 0, 0, 0, 0, 244, 1,
+			44, 1, 44, 1, 0, 0, 0, 0, 244, 1, 244, 1
+		]);
+
+		installWorkerShim();
+		decoder.useWorkers(2);
+
+		function decodeAll() {
+			var shared = new Uint8Array(new SharedArrayBuffer(expected.length));
+
+			return Promise.all([
+				decoder.decodeGltfBufferAsync(4, 12, encoded, 'ATTRIBUTES'),
+				decoder.decodeGltfBufferShared(shared, 4, 12, encoded, 'ATTRIBUTES'),
+			]).then(function(results) {
+				assert.deepStrictEqual(results[0], expected);
+				assert.deepStrictEqual(new Uint8Array(shared), expected);
+			});
+		}
+
+		return decodeAll().then(function() {
+			var pending = decoder.decodeGltfBufferAsync(4, 12, encoded, 'ATTRIBUTES');
+
+			// reinitialization terminates the existing workers and rejects their requests
+			decoder.useWorkers(2);
+
+			return pending.then(function() {
+				assert.fail('request should have been rejected');
+			}, function(error) {
+				assert.equal(error.message, 'Worker terminated');
+			});
+		}).then(decodeAll).then(function() {
+			decoder.useWorkers(0);
+		});
+	},
 };
 
 decoder.ready.then(() => {
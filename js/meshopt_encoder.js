@@ -105,6 +105,38 @@ var MeshoptEncoder = (function() {
 		}
 	}
 
+	function encodeVertexBuffer(source, count, size) {
+		assert(size > 0 && size <= 256);
+		assert(size % 4 == 0);
+		var bound = instance.exports.meshopt_encodeVertexBufferBound(count, size);
+		return encode(instance.exports.meshopt_encodeVertexBuffer, bound, source, count, size);
+	}
+
+	function encodeIndexBuffer(source, count, size) {
+		assert(size == 2 || size == 4);
+		assert(count % 3 == 0);
+		var indices = index32(source, size);
+		var bound = instance.exports.meshopt_encodeIndexBufferBound(count, maxindex(indices) + 1);
+		return encode(instance.exports.meshopt_encodeIndexBuffer, bound, indices, count, 4);
+	}
+
+	function encodeIndexSequence(source, count, size) {
+		assert(size == 2 || size == 4);
+		var indices = index32(source, size);
+		var bound = instance.exports.meshopt_encodeIndexSequenceBound(count, maxindex(indices) + 1);
+		return encode(instance.exports.meshopt_encodeIndexSequence, bound, indices, count, 4);
+	}
+
+	function encodeGltfBuffer(source, count, size, mode) {
+		var table = {
+			ATTRIBUTES: encodeVertexBuffer,
+			TRIANGLES: encodeIndexBuffer,
+			INDICES: encodeIndexSequence,
+		};
+		assert(table[mode]);
+		return table[mode](source, count, size);
+	}
+
 	function filter(fun, source, count, stride, bits, insize) {
 		var sbrk = instance.exports.sbrk;
 		var tp = sbrk(count * stride);
@@ -118,6 +150,100 @@ var MeshoptEncoder = (function() {
 		return target;
 	}
 
+	var workers = [];
+	var requestId = 0;
+
+	function createWorker(url) {
+		var worker = {
+			object: new Worker(url),
+			pending: 0,
+			requests: {}
+		};
+
+		worker.object.onmessage = function(event) {
+			var data = event.data;
+
+			worker.pending -= data.count;
+			worker.requests[data.id][data.action](data.value);
+
+			delete worker.requests[data.id];
+		};
+
+		return worker;
+	}
+
+	function terminateWorkers() {
+		for (var i = 0; i < workers.length; ++i) {
+			var worker = workers[i];
+
+			// requests that are still in flight would never complete after the worker is terminated
+			for (var id in worker.requests) {
+				worker.requests[id].reject(new Error("Worker terminated"));
+			}
+
+			worker.object.terminate();
+		}
+
+		workers.length = 0;
+	}
+
+	function initWorkers(count) {
+		terminateWorkers();
+
+		if (count == 0) {
+			return;
+		}
+
+		var source =
+			"var instance; var ready = WebAssembly.instantiate(new Uint8Array([" + new Uint8Array(unpack(wasm)) + "]), {})" +
+			".then(function(result) { instance = result.instance; instance.exports.__wasm_call_ctors();" +
+			" instance.exports.meshopt_encodeVertexVersion(0); instance.exports.meshopt_encodeIndexVersion(1); });" +
+			"self.onmessage = workerProcess;" +
+			assert.toString() + bytes.toString() + encode.toString() + maxindex.toString() + index32.toString() +
+			encodeVertexBuffer.toString() + encodeIndexBuffer.toString() + encodeIndexSequence.toString() + encodeGltfBuffer.toString() +
+			workerProcess.toString();
+
+		var blob = new Blob([source], {type: 'text/javascript'});
+		var url = URL.createObjectURL(blob);
+
+		for (var i = 0; i < count; ++i) {
+			workers[i] = createWorker(url);
+		}
+
+		URL.revokeObjectURL(url);
+	}
+
+	function encodeWorker(source, count, size, mode) {
+		var worker = workers[0];
+
+		for (var i = 1; i < workers.length; ++i) {
+			if (workers[i].pending < worker.pending) {
+				worker = workers[i];
+			}
+		}
+
+		return new Promise(function (resolve, reject) {
+			var data = new Uint8Array(bytes(source));
+			var id = requestId++;
+
+			worker.pending += count;
+			worker.requests[id] = { resolve: resolve, reject: reject };
+			worker.object.postMessage({ id: id, count: count, size: size, source: data, mode: mode }, [ data.buffer ]);
+		});
+	}
+
+	function workerProcess(event) {
+		ready.then(function() {
+			var data = event.data;
+			try {
+				var target = encodeGltfBuffer(data.source, data.count, data.size, data.mode);
+				self.postMessage({ id: data.id, count: data.count, action: "resolve", value: target }, [ target.buffer ]);
+			} catch (error) {
+				self.postMessage({ id: data.id, count: data.count, action: "reject", value: error });
+			}
+		});
+	}
+
 	return {
 		ready: ready,
 		supported: true,
@@ -125,33 +251,21 @@ var MeshoptEncoder = (function() {
 			var optf = triangles ? (optsize ? instance.exports.meshopt_optimizeVertexCacheStrip : instance.exports.meshopt_optimizeVertexCache) : undefined;
 			return reorder(indices, maxindex(indices) + 1, optf);
 		},
-		encodeVertexBuffer: function(source, count, size) {
-			assert(size > 0 && size <= 256);
-			assert(size % 4 == 0);
-			var bound = instance.exports.meshopt_encodeVertexBufferBound(count, size);
-			return encode(instance.exports.meshopt_encodeVertexBuffer, bound, source, count, size);
+		encodeVertexBuffer: encodeVertexBuffer,
+		encodeIndexBuffer: encodeIndexBuffer,
+		encodeIndexSequence: encodeIndexSequence,
+		encodeGltfBuffer: encodeGltfBuffer,
+		useWorkers: function(count) {
+			initWorkers(count);
 		},
-		encodeIndexBuffer: function(source, count, size) {
-			assert(size == 2 || size == 4);
-			assert(count % 3 == 0);
-			var indices = index32(source, size);
-			var bound = instance.exports.meshopt_encodeIndexBufferBound(count, maxindex(indices) + 1);
-			return encode(instance.exports.meshopt_encodeIndexBuffer, bound, indices, count, 4);
-		},
-		encodeIndexSequence: function(source, count, size) {
-			assert(size == 2 || size == 4);
-			var indices = index32(source, size);
-			var bound = instance.exports.meshopt_encodeIndexSequenceBound(count, maxindex(indices) + 1);
-			return encode(instance.exports.meshopt_encodeIndexSequence, bound, indices, count, 4);
-		},
-		encodeGltfBuffer: function(source, count, size, mode) {
-			var table = {
-				ATTRIBUTES: this.encodeVertexBuffer,
-				TRIANGLES: this.encodeIndexBuffer,
-				INDICES: this.encodeIndexSequence,
-			};
-			assert(table[mode]);
-			return table[mode](source, count, size);
+		encodeGltfBufferAsync: function(source, count, size, mode) {
+			if (workers.length > 0) {
+				return encodeWorker(source, count, size, mode);
+			}
+
+			return ready.then(function() {
+				return encodeGltfBuffer(source, count, size, mode);
+			});
 		},
 		encodeFilterOct: function(source, count, stride, bits) {
 			assert(stride == 4 || stride == 8);
@@ -12,6 +12,9 @@ export const MeshoptEncoder: {
 
     encodeGltfBuffer: (source: Uint8Array, count: number, size: number, mode: string) => Uint8Array;
 
+    useWorkers: (count: number) => void;
+    encodeGltfBufferAsync: (source: Uint8Array, count: number, size: number, mode: string) => Promise<Uint8Array>;
+
     encodeFilterOct: (source: Float32Array, count: number, stride: number, bits: number) => Uint8Array;
     encodeFilterQuat: (source: Float32Array, count: number, stride: number, bits: number) => Uint8Array;
     encodeFilterExp: (source: Float32Array, count: number, stride: number, bits: number) => Uint8Array;
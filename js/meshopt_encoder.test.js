@@ -7,6 +7,46 @@ process.on('unhandledRejection', error => {
 	process.exit(1);
 });
 
+// Node doesn't implement Web Workers; this emulates the subset that useWorkers relies on with worker_threads
+function installWorkerShim() {
+	var threads = require('worker_threads');
+	var sources = {};
+	var nextUrl = 0;
+
+	var prelude =
+		"var parentPort = require('worker_threads').parentPort;" +
+		"var self = { postMessage: function(data, transfer) { parentPort.postMessage(data, transfer); } };" +
+		"parentPort.on('message', function(data) { self.onmessage({ data: data }); });";
+
+	global.Blob = function(parts) {
+		this.source = parts.join('');
+	};
+
+	URL.createObjectURL = function(blob) {
+		var url = 'blob:shim/' + nextUrl++;
+		sources[url] = blob.source;
+		return url;
+	};
+
+	URL.revokeObjectURL = function(url) {
+		delete sources[url];
+	};
+
+	global.Worker = function(url) {
+		var worker = this;
+		this.thread = new threads.Worker(prelude + sources[url], { eval: true });
+		this.thread.on('message', function(data) { worker.onmessage({ data: data }); });
+	};
+
+	global.Worker.prototype.postMessage = function(data, transfer) {
+		this.thread.postMessage(data, transfer);
+	};
+
+	global.Worker.prototype.terminate = function() {
+		this.thread.terminate();
+	};
+}
+
 function bytes(view) {
 	return new Uint8Array(view.buffer, view.byteOffset, view.byteLength);
 }
@@ -183,6 +223,49 @@ var tests = {
 
 		assert.deepEqual(decoded, data);
 	},
+
+	encodeGltfBufferAsync: function() {
+		var data = new Uint32Array([0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9]);
+
+		return encoder.encodeGltfBufferAsync(bytes(data), data.length, 4, 'TRIANGLES').then(function(encoded) {
+			assert.deepEqual(encoded, encoder.encodeGltfBuffer(bytes(data), data.length, 4, 'TRIANGLES'));
+		});
+	},
+
+	encodeGltfBufferWorkers: function() {
+		var indices = new Uint32Array([0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9]);
+		var vertices = new Uint16Array([0, 0, 0, 0, 300, 0, 0, 0, 0, 300, 0, 0, 300, 300, 0, 0]);
+
+		installWorkerShim();
+		encoder.useWorkers(2);
+
+		function encodeAll() {
+			return Promise.all([
+				encoder.encodeGltfBufferAsync(bytes(indices), indices.length, 4, 'TRIANGLES'),
+				encoder.encodeGltfBufferAsync(bytes(indices), indices.length, 4, 'INDICES'),
+				encoder.encodeGltfBufferAsync(bytes(vertices), vertices.length / 4, 8, 'ATTRIBUTES'),
+			]).then(function(results) {
+				assert.deepEqual(results[0], encoder.encodeGltfBuffer(bytes(indices), indices.length, 4, 'TRIANGLES'));
+				assert.deepEqual(results[1], encoder.encodeGltfBuffer(bytes(indices), indices.length, 4, 'INDICES'));
+				assert.deepEqual(results[2], encoder.encodeGltfBuffer(bytes(vertices), vertices.length / 4, 8, 'ATTRIBUTES'));
+			});
+		}
+
+		return encodeAll().then(function() {
+			var pending = encoder.encodeGltfBufferAsync(bytes(indices), indices.length, 4, 'TRIANGLES');
+
+			// reinitialization terminates the existing workers and rejects their requests
+			encoder.useWorkers(2);
+
+			return pending.then(function() {
+				assert.fail('request should have been rejected');
+			}, function(error) {
+				assert.equal(error.message, 'Worker terminated');
+			});
+		}).then(encodeAll).then(function() {
+			encoder.useWorkers(0);
+		});
+	},
 };
 
 Promise.all([encoder.ready, decoder.ready]).then(() => {
@@ -10,5 +10,8 @@ export const MeshoptSimplifier: {
     
     simplify: (indices: Uint32Array, vertex_positions: Float32Array, vertex_positions_stride: number, target_index_count: number, target_error: number, flags?: Flags[]) => [Uint32Array, number];
 
+    useWorkers: (count: number) => void;
+    simplifyAsync: (indices: Uint32Array, vertex_positions: Float32Array, vertex_positions_stride: number, target_index_count: number, target_error: number, flags?: Flags[]) => Promise<[Uint32Array, number]>;
+
     getScale: (vertex_positions: Float32Array, vertex_positions_stride: number) => number;
 };
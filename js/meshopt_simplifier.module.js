@@ -5,8 +5,11 @@ var MeshoptSimplifier = (function() {
 
 	// Built with clang version 14.0.4
 	// Built from meshoptimizer 0.18
-	var wasm = "b9H79TebbbecD9Geueu9Geub9Gbb9Gquuuuuuu99uueu9Gvuuuuub9Gluuuue999Giuuue999Gluuuueu9Giuuueuimxdilvorbwwbewlve9Weiiviebeoweuecj;jekr7oo9TW9T9VV95dbH9F9F939H79T9F9J9H229F9Jt9VV7bbz9TW79O9V9Wt9F79P9T9W29P9M95beX9TW79O9V9Wt9F79P9T9W29P9M959t9J9H2Wbla9TW79O9V9Wt9F9V9Wt9P9T9P96W9wWVtW94SWt9J9O9sW9T9H9Wbvl79IV9RboDwebcekdDqq:STxdbk;48YiKuP99Hu8Jjjjjbcj;bb9Rgq8KjjjjbaqcKfcbc;Kbz1jjjb8AcualcdtgkalcFFFFi0Egxcbyd;S1jjbHjjjjbbhmaqcKfaqyd94gPcdtfamBdbaqamBdwaqaPcefBd94axcbyd;S1jjbHjjjjbbhsaqcKfaqyd94gPcdtfasBdbaqasBdxaqaPcefBd94cuadcitadcFFFFe0Ecbyd;S1jjbHjjjjbbhzaqcKfaqyd94gPcdtfazBdbaqazBdzaqaPcefBd94aqcwfaeadalcbz:cjjjbaxcbyd;S1jjbHjjjjbbhHaqcKfaqyd94gPcdtfaHBdbaqaPcefBd94axcbyd;S1jjbHjjjjbbhOaqcKfaqyd94gPcdtfaOBdbaqaPcefBd94alcd4alfhAcehCinaCgPcethCaPaA6mbkcbhXcuaPcdtgAaPcFFFFi0Ecbyd;S1jjbHjjjjbbhCaqcKfaqyd94gQcdtfaCBdbaqaQcefBd94aCcFeaAz1jjjbhLdnalTmbavcd4hKaPcufhQinaiaXaK2cdtfgYydlgPcH4aP7c:F:b:DD2aYydbgPcH4aP7c;D;O:B8J27aYydwgPcH4aP7c:3F;N8N27hAcbhPdndninaLaAaQGgAcdtfg8AydbgCcuSmeaiaCaK2cdtfaYcxz:ljjjbTmdaPcefgPaAfhAaPaQ9nmbxdkka8AaXBdbaXhCkaHaXcdtfaCBdbaXcefgXal9hmbkcbhPaOhCinaCaPBdbaCclfhCalaPcefgP9hmbkcbhPaHhCaOhAindnaPaCydbgQSmbaAaOaQcdtfgQydbBdbaQaPBdbkaCclfhCaAclfhAalaPcefgP9hmbkkcbhAalcbyd;S1jjbHjjjjbbhYaqcKfaqyd94gPcdtfaYBdbaqaPcefBd94axcbyd;S1jjbHjjjjbbhPaqcKfaqyd94gCcdtfaPBdbaqaCcefBd94axcbyd;S1jjbHjjjjbbhCaqcKfaqyd94gQcdtfaCBdbaqaQcefBd94aPcFeakz1jjjbhEaCcFeakz1jjjbh3dnalTmbazcwfh5indnamaAcdtgPfydbg8ETmbazasaPfydbcitfh8Fa3aPfhaaEaPfhXcbhKindndna8FaKcitfydbgLaA9hmbaXaABdbaaaABdbxekdnamaLcdtgkfydbghTmbazasakfydbcitgPfydbaASmeahcufh8Aa5aPfhCcbhPina8AaPSmeaPcefhPaCydbhQaCcwfhCaQaA9hmbkaPah6meka3akfgPaAaLaPydbcuSEBdbaXaLaAaXydbcuSEBdbkaKcefgKa8E9hmbkkaAcefgAal9hmbkaHhCaOhAa3hQaEhKcbhPindndnaPaCydbg8A9hmbdnaPaAydbg8A9hmbaKydbh8AdnaQydbgLcu9hmba8Acu9hmbaYaPfcb86bbxikaYaPfhXdnaPaLSmbaPa8ASmbaXce86bbxikaXcl86bbxdkdnaPaOa8AcdtgLfydb9hmbdnaQydbgXcuSmbaPaXSmbaKydbgkcuSmbaPakSmba3aLfydbg8EcuSmba8Ea8ASmbaEaLfydbgLcuSmbaLa8ASmbdnaHaXcdtfydbaHaLcdtfydb9hmbaHakcdtfydbaHa8Ecdtfydb9hmbaYaPfcd86bbxlkaYaPfcl86bbxikaYaPfcl86bbxdkaYaPfcl86bbxekaYaPfaYa8AfRbb86bbkaCclfhCaAclfhAaQclfhQaKclfhKalaPcefgP9hmbkawceGTmbaYhPalhCindnaPRbbce9hmbaPcl86bbkaPcefhPaCcufgCmbkkcbhKcualcx2alc;v:Q;v:Qe0Ecbyd;S1jjbHjjjjbbhmaqcKfaqyd94gPcdtfamBdbaqaPcefBd94amaialavz:djjjb8Acualc8S2gCalc;D;O;f8U0Ecbyd;S1jjbHjjjjbbhPaqcKfaqyd94gAcdtfaPBdbaqaAcefBd94aPcbaCz1jjjbhzdnadTmbaehCindnamaCclfydbg8Acx2fgPIdbamaCydbgLcx2fgAIdbgg:tg8JamaCcwfydbgXcx2fgQclfIdbaAclfIdbg8K:tg8LNaQIdbag:tg8MaPclfIdba8K:tg8NN:tgyayNa8NaQcwfIdbaAcwfIdbg8P:tgINa8LaPcwfIdba8P:tg8NN:tg8La8LNa8Na8MNaIa8JN:tg8Ja8JNMM:rg8MJbbbb9ETmbaya8M:vhya8Ja8M:vh8Ja8La8M:vh8LkazaHaLcdtfydbc8S2fgPa8La8M:rg8Ma8LNNg8NaPIdbMUdbaPa8Ja8Ma8JNg8RNgIaPIdlMUdlaPaya8MayNg8SNgRaPIdwMUdwaPa8Ra8LNg8RaPIdxMUdxaPa8Sa8LNg8UaPIdzMUdzaPa8Sa8JNg8SaPIdCMUdCaPa8La8Maya8PNa8LagNa8Ka8JNMM:mg8KNggNg8LaPIdKMUdKaPa8JagNg8JaPId3MUd3aPayagNgyaPIdaMUdaaPaga8KNggaPId8KMUd8KaPa8MaPIdyMUdyazaHa8Acdtfydbc8S2fgPa8NaPIdbMUdbaPaIaPIdlMUdlaPaRaPIdwMUdwaPa8RaPIdxMUdxaPa8UaPIdzMUdzaPa8SaPIdCMUdCaPa8LaPIdKMUdKaPa8JaPId3MUd3aPayaPIdaMUdaaPagaPId8KMUd8KaPa8MaPIdyMUdyazaHaXcdtfydbc8S2fgPa8NaPIdbMUdbaPaIaPIdlMUdlaPaRaPIdwMUdwaPa8RaPIdxMUdxaPa8UaPIdzMUdzaPa8SaPIdCMUdCaPa8LaPIdKMUdKaPa8JaPId3MUd3aPayaPIdaMUdaaPagaPId8KMUd8KaPa8MaPIdyMUdyaCcxfhCaKcifgKad6mbkcbh8AaehXincbhCinaYaeaCc:81jjbfydbgLa8AfcdtfydbgAfRbbhPdndnaYaXaCfydbgQfRbbgKc99fcFeGcpe0mbaPceSmbaPcd9hmekdnaKcufcFeGce0mbaEaQcdtfydbaA9hmekdnaPcufcFeGce0mba3aAcdtfydbaQ9hmekdnaKcv2aPfc:G1jjbfRbbTmbaHaAcdtfydbaHaQcdtfydb0mekJbbacJbbjZaPceSEh8MaKceShkaeaLcdtc:81jjbfydba8AfcdtfydbhLdnamaAcx2fgPcwfIdbamaQcx2fgKcwfIdbg8K:tg8La8LNaPIdbaKIdbg8P:tg8Ja8JNaPclfIdbaKclfIdbg8N:tgyayNMM:rggJbbbb9ETmba8Lag:vh8Layag:vhya8Jag:vh8JkJbbaca8MakEh8SdnamaLcx2fgPIdwa8K:tg8Ma8La8Ma8LNaPIdba8P:tgRa8JNayaPIdla8N:tg8RNMMgIN:tg8Ma8MNaRa8JaIN:tg8La8LNa8RayaIN:tg8Ja8JNMM:rgyJbbbb9ETmba8May:vh8Ma8Jay:vh8Ja8Lay:vh8LkazaHaQcdtfydbc8S2fgPa8La8SagNgya8LNNgIaPIdbMUdbaPa8Jaya8JNg8SNgRaPIdlMUdlaPa8Maya8MNggNg8RaPIdwMUdwaPa8Sa8LNg8SaPIdxMUdxaPaga8LNg8UaPIdzMUdzaPaga8JNg8VaPIdCMUdCaPa8Laya8Ma8KNa8La8PNa8Na8JNMM:mg8KNggNg8LaPIdKMUdKaPa8JagNg8JaPId3MUd3aPa8MagNg8MaPIdaMUdaaPaga8KNggaPId8KMUd8KaPayaPIdyMUdyazaHaAcdtfydbc8S2fgPaIaPIdbMUdbaPaRaPIdlMUdlaPa8RaPIdwMUdwaPa8SaPIdxMUdxaPa8UaPIdzMUdzaPa8VaPIdCMUdCaPa8LaPIdKMUdKaPa8JaPId3MUd3aPa8MaPIdaMUdaaPagaPId8KMUd8KaPayaPIdyMUdykaCclfgCcx9hmbkaXcxfhXa8Acifg8Aad6mbkkdnabaeSmbabaeadcdtz:hjjjb8Akcuadcx2adc;v:Q;v:Qe0Ecbyd;S1jjbHjjjjbbhaaqcKfaqyd94gPcdtfaaBdbaqaPcefBd94cuadcdtadcFFFFi0Ecbyd;S1jjbHjjjjbbh5aqcKfaqyd94gPcdtfa5BdbaqaPcefBd94axcbyd;S1jjbHjjjjbbhiaqcKfaqyd94gPcdtfaiBdbaqaPcefBd94alcbyd;S1jjbHjjjjbbh8WaqcKfaqyd94gPcdtfa8WBdbaqaPcefBd94JbbbbhRdnadao9nmbararNh8Saacwfh8Xaqydzh8Yaqydxh8Zaqydwh80JbbbbhRinaqcwfabadgsalaHz:cjjjbcbhhabhXcbhkincbhPindnaHaXaPfydbgAcdtgefydbgKaHabaPc:81jjbfydbakfcdtfydbgCcdtfydbg8ASmbaYaCfRbbgLcv2aYaAfRbbgQfc;q1jjbfRbbgdaQcv2aLfg8Ec;q1jjbfRbbg8FVcFeGTmbdna8Ec:G1jjbfRbbTmba8AaK0mekdnaQaL9hmbaQcufcFeGce0mbaEaefydbaC9hmekaaahcx2fgQaCaAa8FcFeGgKEBdlaQaAaCaKEBdbaQada8FGcFeGcb9hBdwahcefhhkaPclfgPcx9hmbkaXcxfhXakcifgkas6mbkdndnahTmbaahCahh8AinaCcwfgLJbbbbJbbjZazaHaCydbgAcdtfydbc8S2fgPIdyg8L:va8LJbbbb9BEaPIdwamaCclfgeydbgQcx2fgKcwfIdbg8LNaPIdzaKIdbg8JNaPIdaMg8Ma8MMMa8LNaPIdlaKclfIdbg8MNaPIdCa8LNaPId3Mg8La8LMMa8MNaPIdba8JNaPIdxa8MNaPIdKMg8La8LMMa8JNaPId8KMMM:lNgyJbbbbJbbjZazaHaQaAaLydbgKEgLcdtfydbc8S2fgPIdyg8L:va8LJbbbb9BEaPIdwamaAaQaKEgXcx2fgKcwfIdbg8LNaPIdzaKIdbg8JNaPIdaMg8Ma8MMMa8LNaPIdlaKclfIdbg8MNaPIdCa8LNaPId3Mg8La8LMMa8MNaPIdba8JNaPIdxa8MNaPIdKMg8La8LMMa8JNaPId8KMMM:lNg8Laya8L9FgPEUdbaeaQaXaPEBdbaCaAaLaPEBdbaCcxfhCa8Acufg8Ambkaqcjefcbcj;abz1jjjb8Aa8XhPahhCinaqcjefaPydbcO4c;8ZGfgAaAydbcefBdbaPcxfhPaCcufgCmbkcbhPcbhCinaqcjefaPfgAydbhQaAaCBdbaQaCfhCaPclfgPcj;ab9hmbkcbhPa8XhCinaqcjefaCydbcO4c;8ZGfgAaAydbgAcefBdba5aAcdtfaPBdbaCcxfhCahaPcefgP9hmbkasao9RgAci9Uh81dnalTmbcbhPaihCinaCaPBdbaCclfhCalaPcefgP9hmbkkcbhBa8Wcbalz1jjjbh83aAcO9UhUa81ce4h85cbh86cbhkdninaaa5akcdtfydbcx2fgXIdwg8Ja8S9Emea86a819pmeJFFuuh8Ldna85ah9pmbaaa5a85cdtfydbcx2fIdwJbb;aZNh8Lkdna8Ja8L9ETmba86aU0mdkdna83aHaXydlg87cdtg88fydbgAfg89Rbba83aHaXydbgecdtg8:fydbgZfgnRbbVmbdna80aZcdtgPfydbgQTmba8Ya8ZaPfydbcitfhPamaAcx2fg8Ecwfhda8EclfhxamaZcx2fg8Fcwfhva8FclfhwcbhCcehLdnindnaiaPydbcdtfydbgKaASmbaiaPclfydbcdtfydbg8AaASmbama8Acx2fg8AIdbamaKcx2fgKIdbg8M:tg8LawIdbaKclfIdbgy:tggNa8FIdba8M:tg8Ka8AclfIdbay:tg8JN:ta8LaxIdbay:tg8PNa8EIdba8M:tg8Na8JN:tNa8JavIdbaKcwfIdbgy:tgINaga8AcwfIdbay:tg8MN:ta8JadIdbay:tgyNa8Pa8MN:tNa8Ma8KNaIa8LN:ta8Ma8NNaya8LN:tNMMJbbbb9DmdkaPcwfhPaCcefgCaQ6hLaQaC9hmbkkaLceGTmba85cefh85xekaXcwfhQazaAc8S2fgPazaZc8S2fgCIdbaPIdbMUdbaPaCIdlaPIdlMUdlaPaCIdwaPIdwMUdwaPaCIdxaPIdxMUdxaPaCIdzaPIdzMUdzaPaCIdCaPIdCMUdCaPaCIdKaPIdKMUdKaPaCId3aPId3MUd3aPaCIdaaPIdaMUdaaPaCId8KaPId8KMUd8KaPaCIdyaPIdyMUdydndndndnaYaefgCRbbc9:fPdebdkaehPinaiaPcdtgPfaABdbaOaPfydbgPae9hmbxikkaOa88fydbhPaOa8:fydbheaia8:fa87BdbaPh87kaiaecdtfa87Bdbkance86bba89ce86bbaQIdbg8LaRaRa8L9DEhRaBcefhBcecdaCRbbceSEa86fh86kakcefgkah9hmbkkaBTmbdnalTmbcbhCaEhPindnaPydbgAcuSmbdnaCaiaAcdtgQfydbgA9hmbaEaQfydbhAkaPaABdbkaPclfhPalaCcefgC9hmbkcbhCa3hPindnaPydbgAcuSmbdnaCaiaAcdtgQfydbgA9hmba3aQfydbhAkaPaABdbkaPclfhPalaCcefgC9hmbkkcbhdabhPcbhKindnaiaPydbcdtfydbgCaiaPclfydbcdtfydbgASmbaCaiaPcwfydbcdtfydbgQSmbaAaQSmbabadcdtfg8AaCBdba8AclfaABdba8AcwfaQBdbadcifhdkaPcxfhPaKcifgKas9pmdxbkkashdxdkadao0mbkkdnaDTmbaDaR:rUdbkaqyd94gPcdtaqcKffc98fhHdninaPTmeaHydbcbyd;W1jjbH:bjjjbbaHc98fhHaPcufhPxbkkaqcj;bbf8Kjjjjbadk;pleouabydbcbaicdtz1jjjb8Aadci9UhvdnadTmbabydbhodnalTmbaehradhwinaoalarydbcdtfydbcdtfgDaDydbcefBdbarclfhrawcufgwmbxdkkaehradhwinaoarydbcdtfgDaDydbcefBdbarclfhrawcufgwmbkkdnaiTmbabydbhrabydlhwcbhDaihoinawaDBdbawclfhwarydbaDfhDarclfhraocufgombkkdnadci6mbavceavce0EhqabydlhvabydwhrinaecwfydbhwaeclfydbhDaeydbhodnalTmbalawcdtfydbhwalaDcdtfydbhDalaocdtfydbhokaravaocdtfgdydbcitfaDBdbaradydbcitfawBdladadydbcefBdbaravaDcdtfgdydbcitfawBdbaradydbcitfaoBdladadydbcefBdbaravawcdtfgwydbcitfaoBdbarawydbcitfaDBdlawawydbcefBdbaecxfheaqcufgqmbkkdnaiTmbabydlhrabydbhwinararydbawydb9RBdbawclfhwarclfhraicufgimbkkk:3ldouv998Jjjjjbca9Rglczfcwfcbyd11jjbBdbalcb8Pdj1jjb83izalcwfcbydN1jjbBdbalcb8Pd:m1jjb83ibdnadTmbaicd4hvdnabTmbavcdthocbhraehwinabarcx2fgiaearav2cdtfgDIdbUdbaiaDIdlUdlaiaDIdwUdwcbhiinalczfaifgDawaifIdbgqaDIdbgkakaq9EEUdbalaifgDaqaDIdbgkakaq9DEUdbaiclfgicx9hmbkawaofhwarcefgrad9hmbxdkkavcdthrcbhwincbhiinalczfaifgDaeaifIdbgqaDIdbgkakaq9EEUdbalaifgDaqaDIdbgkakaq9DEUdbaiclfgicx9hmbkaearfheawcefgwad9hmbkkalIdbalIdzgk:tJbbbb:xgqalIdlalIdCgx:tgmamaq9DEgqalIdwalIdKgm:tgPaPaq9DEhPdnabTmbadTmbJbbbbJbbjZaP:vaPJbbbb9BEhqinabaqabIdbak:tNUdbabclfgiaqaiIdbax:tNUdbabcwfgiaqaiIdbam:tNUdbabcxfhbadcufgdmbkkaPk:Qdidui99ducbhi8Jjjjjbca9Rglczfcwfcbyd11jjbBdbalcb8Pdj1jjb83izalcwfcbydN1jjbBdbalcb8Pd:m1jjb83ibdndnaembJbbjFhvJbbjFhoJbbjFhrxekadcd4cdthwincbhdinalczfadfgDabadfIdbgoaDIdbgrarao9EEUdbaladfgDaoaDIdbgrarao9DEUdbadclfgdcx9hmbkabawfhbaicefgiae9hmbkalIdwalIdK:thralIdlalIdC:thoalIdbalIdz:thvkavJbbbb:xgvaoaoav9DEgoararao9DEk9DeeuabcFeaicdtz1jjjbhlcbhidnadTmbindnalaeydbcdtfgbydbcu9hmbabaiBdbaicefhikaeclfheadcufgdmbkkaik9teiucbcbyd;01jjbgeabcifc98GfgbBd;01jjbdndnabZbcztgd9nmbcuhiabad9RcFFifcz4nbcuSmekaehikaik;LeeeudndnaeabVciGTmbabhixekdndnadcz9pmbabhixekabhiinaiaeydbBdbaiclfaeclfydbBdbaicwfaecwfydbBdbaicxfaecxfydbBdbaiczfhiaeczfheadc9Wfgdcs0mbkkadcl6mbinaiaeydbBdbaeclfheaiclfhiadc98fgdci0mbkkdnadTmbinaiaeRbb86bbaicefhiaecefheadcufgdmbkkabk;aeedudndnabciGTmbabhixekaecFeGc:b:c:ew2hldndnadcz9pmbabhixekabhiinaialBdbaicxfalBdbaicwfalBdbaiclfalBdbaiczfhiadc9Wfgdcs0mbkkadcl6mbinaialBdbaiclfhiadc98fgdci0mbkkdnadTmbinaiae86bbaicefhiadcufgdmbkkabk9teiucbcbyd;01jjbgeabcrfc94GfgbBd;01jjbdndnabZbcztgd9nmbcuhiabad9RcFFifcz4nbcuSmekaehikaik9:eiuZbhedndncbyd;01jjbgdaecztgi9nmbcuheadai9RcFFifcz4nbcuSmekadhekcbabae9Rcifc98Gcbyd;01jjbfgdBd;01jjbdnadZbcztge9nmbadae9RcFFifcz4nb8Akk6eiucbhidnadTmbdninabRbbglaeRbbgv9hmeaecefheabcefhbadcufgdmbxdkkalav9Rhikaikk:cedbcjwk9PFFuuFFuuFFuuFFuFFFuFFFuFbbbbbbbbeeebeebebbeeebebbbbbebebbbbbebbbdbbbbbbbbbbbbbbbeeeeebebbbbbebbbbbeebbbbbbc;Swkxebbbdbbbj9Kbb";
+	var wasm_base = "b9H79TebbbecD9Geueu9Geub9Gbb9Gquuuuuuu99uueu9Gvuuuuub9Gluuuue999Giuuue999Gluuuueu9Giuuueuimxdilvorbwwbewlve9Weiiviebeoweuecj;jekr7oo9TW9T9VV95dbH9F9F939H79T9F9J9H229F9Jt9VV7bbz9TW79O9V9Wt9F79P9T9W29P9M95beX9TW79O9V9Wt9F79P9T9W29P9M959t9J9H2Wbla9TW79O9V9Wt9F9V9Wt9P9T9P96W9wWVtW94SWt9J9O9sW9T9H9Wbvl79IV9RboDwebcekdDqq:STxdbk;48YiKuP99Hu8Jjjjjbcj;bb9Rgq8KjjjjbaqcKfcbc;Kbz1jjjb8AcualcdtgkalcFFFFi0Egxcbyd;S1jjbHjjjjbbhmaqcKfaqyd94gPcdtfamBdbaqamBdwaqaPcefBd94axcbyd;S1jjbHjjjjbbhsaqcKfaqyd94gPcdtfasBdbaqasBdxaqaPcefBd94cuadcitadcFFFFe0Ecbyd;S1jjbHjjjjbbhzaqcKfaqyd94gPcdtfazBdbaqazBdzaqaPcefBd94aqcwfaeadalcbz:cjjjbaxcbyd;S1jjbHjjjjbbhHaqcKfaqyd94gPcdtfaHBdbaqaPcefBd94axcbyd;S1jjbHjjjjbbhOaqcKfaqyd94gPcdtfaOBdbaqaPcefBd94alcd4alfhAcehCinaCgPcethCaPaA6mbkcbhXcuaPcdtgAaPcFFFFi0Ecbyd;S1jjbHjjjjbbhCaqcKfaqyd94gQcdtfaCBdbaqaQcefBd94aCcFeaAz1jjjbhLdnalTmbavcd4hKaPcufhQinaiaXaK2cdtfgYydlgPcH4aP7c:F:b:DD2aYydbgPcH4aP7c;D;O:B8J27aYydwgPcH4aP7c:3F;N8N27hAcbhPdndninaLaAaQGgAcdtfg8AydbgCcuSmeaiaCaK2cdtfaYcxz:ljjjbTmdaPcefgPaAfhAaPaQ9nmbxdkka8AaXBdbaXhCkaHaXcdtfaCBdbaXcefgXal9hmbkcbhPaOhCinaCaPBdbaCclfhCalaPcefgP9hmbkcbhPaHhCaOhAindnaPaCydbgQSmbaAaOaQcdtfgQydbBdbaQaPBdbkaCclfhCaAclfhAalaPcefgP9hmbkkcbhAalcbyd;S1jjbHjjjjbbhYaqcKfaqyd94gPcdtfaYBdbaqaPcefBd94axcbyd;S1jjbHjjjjbbhPaqcKfaqyd94gCcdtfaPBdbaqaCcefBd94axcbyd;S1jjbHjjjjbbhCaqcKfaqyd94gQcdtfaCBdbaqaQcefBd94aPcFeakz1jjjbhEaCcFeakz1jjjbh3dnalTmbazcwfh5indnamaAcdtgPfydbg8ETmbazasaPfydbcitfh8Fa3aPfhaaEaPfhXcbhKindndna8FaKcitfydbgLaA9hmbaXaABdbaaaABdbxekdnamaLcdtgkfydbghTmbazasakfydbcitgPfydbaASmeahcufh8Aa5aPfhCcbhPina8AaPSmeaPcefhPaCydbhQaCcwfhCaQaA9hmbkaPah6meka3akfgPaAaLaPydbcuSEBdbaXaLaAaXydbcuSEBdbkaKcefgKa8E9hmbkkaAcefgAal9hmbkaHhCaOhAa3hQaEhKcbhPindndnaPaCydbg8A9hmbdnaPaAydbg8A9hmbaKydbh8AdnaQydbgLcu9hmba8Acu9hmbaYaPfcb86bbxikaYaPfhXdnaPaLSmbaPa8ASmbaXce86bbxikaXcl86bbxdkdnaPaOa8AcdtgLfydb9hmbdnaQydbgXcuSmbaPaXSmbaKydbgkcuSmbaPakSmba3aLfydbg8EcuSmba8Ea8ASmbaEaLfydbgLcuSmbaLa8ASmbdnaHaXcdtfydbaHaLcdtfydb9hmbaHakcdtfydbaHa8Ecdtfydb9hmbaYaPfcd86bbxlkaYaPfcl86bbxikaYaPfcl86bbxdkaYaPfcl86bbxekaYaPfaYa8AfRbb86bbkaCclfhCaAclfhAaQclfhQaKclfhKalaPcefgP9hmbkawceGTmbaYhPalhCindnaPRbbce9hmbaPcl86bbkaPcefhPaCcufgCmbkkcbhKcualcx2alc;v:Q;v:Qe0Ecbyd;S1jjbHjjjjbbhmaqcKfaqyd94gPcdtfamBdbaqaPcefBd94amaialavz:djjjb8Acualc8S2gCalc;D;O;f8U0Ecbyd;S1jjbHjjjjbbhPaqcKfaqyd94gAcdtfaPBdbaqaAcefBd94aPcbaCz1jjjbhzdnadTmbaehCindnamaCclfydbg8Acx2fgPIdbamaCydbgLcx2fgAIdbgg:tg8JamaCcwfydbgXcx2fgQclfIdbaAclfIdbg8K:tg8LNaQIdbag:tg8MaPclfIdba8K:tg8NN:tgyayNa8NaQcwfIdbaAcwfIdbg8P:tgINa8LaPcwfIdba8P:tg8NN:tg8La8LNa8Na8MNaIa8JN:tg8Ja8JNMM:rg8MJbbbb9ETmbaya8M:vhya8Ja8M:vh8Ja8La8M:vh8LkazaHaLcdtfydbc8S2fgPa8La8M:rg8Ma8LNNg8NaPIdbMUdbaPa8Ja8Ma8JNg8RNgIaPIdlMUdlaPaya8MayNg8SNgRaPIdwMUdwaPa8Ra8LNg8RaPIdxMUdxaPa8Sa8LNg8UaPIdzMUdzaPa8Sa8JNg8SaPIdCMUdCaPa8La8Maya8PNa8LagNa8Ka8JNMM:mg8KNggNg8LaPIdKMUdKaPa8JagNg8JaPId3MUd3aPayagNgyaPIdaMUdaaPaga8KNggaPId8KMUd8KaPa8MaPIdyMUdyazaHa8Acdtfydbc8S2fgPa8NaPIdbMUdbaPaIaPIdlMUdlaPaRaPIdwMUdwaPa8RaPIdxMUdxaPa8UaPIdzMUdzaPa8SaPIdCMUdCaPa8LaPIdKMUdKaPa8JaPId3MUd3aPayaPIdaMUdaaPagaPId8KMUd8KaPa8MaPIdyMUdyazaHaXcdtfydbc8S2fgPa8NaPIdbMUdbaPaIaPIdlMUdlaPaRaPIdwMUdwaPa8RaPIdxMUdxaPa8UaPIdzMUdzaPa8SaPIdCMUdCaPa8LaPIdKMUdKaPa8JaPId3MUd3aPayaPIdaMUdaaPagaPId8KMUd8KaPa8MaPIdyMUdyaCcxfhCaKcifgKad6mbkcbh8AaehXincbhCinaYaeaCc:81jjbfydbgLa8AfcdtfydbgAfRbbhPdndnaYaXaCfydbgQfRbbgKc99fcFeGcpe0mbaPceSmbaPcd9hmekdnaKcufcFeGce0mbaEaQcdtfydbaA9hmekdnaPcufcFeGce0mba3aAcdtfydbaQ9hmekdnaKcv2aPfc:G1jjbfRbbTmbaHaAcdtfydbaHaQcdtfydb0mekJbbacJbbjZaPceSEh8MaKceShkaeaLcdtc:81jjbfydba8AfcdtfydbhLdnamaAcx2fgPcwfIdbamaQcx2fgKcwfIdbg8K:tg8La8LNaPIdbaKIdbg8P:tg8Ja8JNaPclfIdbaKclfIdbg8N:tgyayNMM:rggJbbbb9ETmba8Lag:vh8Layag:vhya8Jag:vh8JkJbbaca8MakEh8SdnamaLcx2fgPIdwa8K:tg8Ma8La8Ma8LNaPIdba8P:tgRa8JNayaPIdla8N:tg8RNMMgIN:tg8Ma8MNaRa8JaIN:tg8La8LNa8RayaIN:tg8Ja8JNMM:rgyJbbbb9ETmba8May:vh8Ma8Jay:vh8Ja8Lay:vh8LkazaHaQcdtfydbc8S2fgPa8La8SagNgya8LNNgIaPIdbMUdbaPa8Jaya8JNg8SNgRaPIdlMUdlaPa8Maya8MNggNg8RaPIdwMUdwaPa8Sa8LNg8SaPIdxMUdxaPaga8LNg8UaPIdzMUdzaPaga8JNg8VaPIdCMUdCaPa8Laya8Ma8KNa8La8PNa8Na8JNMM:mg8KNggNg8LaPIdKMUdKaPa8JagNg8JaPId3MUd3aPa8MagNg8MaPIdaMUdaaPaga8KNggaPId8KMUd8KaPayaPIdyMUdyazaHaAcdtfydbc8S2fgPaIaPIdbMUdbaPaRaPIdlMUdlaPa8RaPIdwMUdwaPa8SaPIdxMUdxaPa8UaPIdzMUdzaPa8VaPIdCMUdCaPa8LaPIdKMUdKaPa8JaPId3MUd3aPa8MaPIdaMUdaaPagaPId8KMUd8KaPayaPIdyMUdykaCclfgCcx9hmbkaXcxfhXa8Acifg8Aad6mbkkdnabaeSmbabaeadcdtz:hjjjb8Akcuadcx2adc;v:Q;v:Qe0Ecbyd;S1jjbHjjjjbbhaaqcKfaqyd94gPcdtfaaBdbaqaPcefBd94cuadcdtadcFFFFi0Ecbyd;S1jjbHjjjjbbh5aqcKfaqyd94gPcdtfa5BdbaqaPcefBd94axcbyd;S1jjbHjjjjbbhiaqcKfaqyd94gPcdtfaiBdbaqaPcefBd94alcbyd;S1jjbHjjjjbbh8WaqcKfaqyd94gPcdtfa8WBdbaqaPcefBd94JbbbbhRdnadao9nmbararNh8Saacwfh8Xaqydzh8Yaqydxh8Zaqydwh80JbbbbhRinaqcwfabadgsalaHz:cjjjbcbhhabhXcbhkincbhPindnaHaXaPfydbgAcdtgefydbgKaHabaPc:81jjbfydbakfcdtfydbgCcdtfydbg8ASmbaYaCfRbbgLcv2aYaAfRbbgQfc;q1jjbfRbbgdaQcv2aLfg8Ec;q1jjbfRbbg8FVcFeGTmbdna8Ec:G1jjbfRbbTmba8AaK0mekdnaQaL9hmbaQcufcFeGce0mbaEaefydbaC9hmekaaahcx2fgQaCaAa8FcFeGgKEBdlaQaAaCaKEBdbaQada8FGcFeGcb9hBdwahcefhhkaPclfgPcx9hmbkaXcxfhXakcifgkas6mbkdndnahTmbaahCahh8AinaCcwfgLJbbbbJbbjZazaHaCydbgAcdtfydbc8S2fgPIdyg8L:va8LJbbbb9BEaPIdwamaCclfgeydbgQcx2fgKcwfIdbg8LNaPIdzaKIdbg8JNaPIdaMg8Ma8MMMa8LNaPIdlaKclfIdbg8MNaPIdCa8LNaPId3Mg8La8LMMa8MNaPIdba8JNaPIdxa8MNaPIdKMg8La8LMMa8JNaPId8KMMM:lNgyJbbbbJbbjZazaHaQaAaLydbgKEgLcdtfydbc8S2fgPIdyg8L:va8LJbbbb9BEaPIdwamaAaQaKEgXcx2fgKcwfIdbg8LNaPIdzaKIdbg8JNaPIdaMg8Ma8MMMa8LNaPIdlaKclfIdbg8MNaPIdCa8LNaPId3Mg8La8LMMa8MNaPIdba8JNaPIdxa8MNaPIdKMg8La8LMMa8JNaPId8KMMM:lNg8Laya8L9FgPEUdbaeaQaXaPEBdbaCaAaLaPEBdbaCcxfhCa8Acufg8Ambkaqcjefcbcj;abz1jjjb8Aa8XhPahhCinaqcjefaPydbcO4c;8ZGfgAaAydbcefBdbaPcxfhPaCcufgCmbkcbhPcbhCinaqcjefaPfgAydbhQaAaCBdbaQaCfhCaPclfgPcj;ab9hmbkcbhPa8XhCinaqcjefaCydbcO4c;8ZGfgAaAydbgAcefBdba5aAcdtfaPBdbaCcxfhCahaPcefgP9hmbkasao9RgAci9Uh81dnalTmbcbhPaihCinaCaPBdbaCclfhCalaPcefgP9hmbkkcbhBa8Wcbalz1jjjbh83aAcO9UhUa81ce4h85cbh86cbhkdninaaa5akcdtfydbcx2fgXIdwg8Ja8S9Emea86a819pmeJFFuuh8Ldna85ah9pmbaaa5a85cdtfydbcx2fIdwJbb;aZNh8Lkdna8Ja8L9ETmba86aU0mdkdna83aHaXydlg87cdtg88fydbgAfg89Rbba83aHaXydbgecdtg8:fydbgZfgnRbbVmbdna80aZcdtgPfydbgQTmba8Ya8ZaPfydbcitfhPamaAcx2fg8Ecwfhda8EclfhxamaZcx2fg8Fcwfhva8FclfhwcbhCcehLdnindnaiaPydbcdtfydbgKaASmbaiaPclfydbcdtfydbg8AaASmbama8Acx2fg8AIdbamaKcx2fgKIdbg8M:tg8LawIdbaKclfIdbgy:tggNa8FIdba8M:tg8Ka8AclfIdbay:tg8JN:ta8LaxIdbay:tg8PNa8EIdba8M:tg8Na8JN:tNa8JavIdbaKcwfIdbgy:tgINaga8AcwfIdbay:tg8MN:ta8JadIdbay:tgyNa8Pa8MN:tNa8Ma8KNaIa8LN:ta8Ma8NNaya8LN:tNMMJbbbb9DmdkaPcwfhPaCcefgCaQ6hLaQaC9hmbkkaLceGTmba85cefh85xekaXcwfhQazaAc8S2fgPazaZc8S2fgCIdbaPIdbMUdbaPaCIdlaPIdlMUdlaPaCIdwaPIdwMUdwaPaCIdxaPIdxMUdxaPaCIdzaPIdzMUdzaPaCIdCaPIdCMUdCaPaCIdKaPIdKMUdKaPaCId3aPId3MUd3aPaCIdaaPIdaMUdaaPaCId8KaPId8KMUd8KaPaCIdyaPIdyMUdydndndndnaYaefgCRbbc9:fPdebdkaehPinaiaPcdtgPfaABdbaOaPfydbgPae9hmbxikkaOa88fydbhPaOa8:fydbheaia8:fa87BdbaPh87kaiaecdtfa87Bdbkance86bba89ce86bbaQIdbg8LaRaRa8L9DEhRaBcefhBcecdaCRbbceSEa86fh86kakcefgkah9hmbkkaBTmbdnalTmbcbhCaEhPindnaPydbgAcuSmbdnaCaiaAcdtgQfydbgA9hmbaEaQfydbhAkaPaABdbkaPclfhPalaCcefgC9hmbkcbhCa3hPindnaPydbgAcuSmbdnaCaiaAcdtgQfydbgA9hmba3aQfydbhAkaPaABdbkaPclfhPalaCcefgC9hmbkkcbhdabhPcbhKindnaiaPydbcdtfydbgCaiaPclfydbcdtfydbgASmbaCaiaPcwfydbcdtfydbgQSmbaAaQSmbabadcdtfg8AaCBdba8AclfaABdba8AcwfaQBdbadcifhdkaPcxfhPaKcifgKas9pmdxbkkashdxdkadao0mbkkdnaDTmbaDaR:rUdbkaqyd94gPcdtaqcKffc98fhHdninaPTmeaHydbcbyd;W1jjbH:bjjjbbaHc98fhHaPcufhPxbkkaqcj;bbf8Kjjjjbadk;pleouabydbcbaicdtz1jjjb8Aadci9UhvdnadTmbabydbhodnalTmbaehradhwinaoalarydbcdtfydbcdtfgDaDydbcefBdbarclfhrawcufgwmbxdkkaehradhwinaoarydbcdtfgDaDydbcefBdbarclfhrawcufgwmbkkdnaiTmbabydbhrabydlhwcbhDaihoinawaDBdbawclfhwarydbaDfhDarclfhraocufgombkkdnadci6mbavceavce0EhqabydlhvabydwhrinaecwfydbhwaeclfydbhDaeydbhodnalTmbalawcdtfydbhwalaDcdtfydbhDalaocdtfydbhokaravaocdtfgdydbcitfaDBdbaradydbcitfawBdladadydbcefBdbaravaDcdtfgdydbcitfawBdbaradydbcitfaoBdladadydbcefBdbaravawcdtfgwydbcitfaoBdbarawydbcitfaDBdlawawydbcefBdbaecxfheaqcufgqmbkkdnaiTmbabydlhrabydbhwinararydbawydb9RBdbawclfhwarclfhraicufgimbkkk:3ldouv998Jjjjjbca9Rglczfcwfcbyd11jjbBdbalcb8Pdj1jjb83izalcwfcbydN1jjbBdbalcb8Pd:m1jjb83ibdnadTmbaicd4hvdnabTmbavcdthocbhraehwinabarcx2fgiaearav2cdtfgDIdbUdbaiaDIdlUdlaiaDIdwUdwcbhiinalczfaifgDawaifIdbgqaDIdbgkakaq9EEUdbalaifgDaqaDIdbgkakaq9DEUdbaiclfgicx9hmbkawaofhwarcefgrad9hmbxdkkavcdthrcbhwincbhiinalczfaifgDaeaifIdbgqaDIdbgkakaq9EEUdbalaifgDaqaDIdbgkakaq9DEUdbaiclfgicx9hmbkaearfheawcefgwad9hmbkkalIdbalIdzgk:tJbbbb:xgqalIdlalIdCgx:tgmamaq9DEgqalIdwalIdKgm:tgPaPaq9DEhPdnabTmbadTmbJbbbbJbbjZaP:vaPJbbbb9BEhqinabaqabIdbak:tNUdbabclfgiaqaiIdbax:tNUdbabcwfgiaqaiIdbam:tNUdbabcxfhbadcufgdmbkkaPk:Qdidui99ducbhi8Jjjjjbca9Rglczfcwfcbyd11jjbBdbalcb8Pdj1jjb83izalcwfcbydN1jjbBdbalcb8Pd:m1jjb83ibdndnaembJbbjFhvJbbjFhoJbbjFhrxekadcd4cdthwincbhdinalczfadfgDabadfIdbgoaDIdbgrarao9EEUdbaladfgDaoaDIdbgrarao9DEUdbadclfgdcx9hmbkabawfhbaicefgiae9hmbkalIdwalIdK:thralIdlalIdC:thoalIdbalIdz:thvkavJbbbb:xgvaoaoav9DEgoararao9DEk9DeeuabcFeaicdtz1jjjbhlcbhidnadTmbindnalaeydbcdtfgbydbcu9hmbabaiBdbaicefhikaeclfheadcufgdmbkkaik9teiucbcbyd;01jjbgeabcifc98GfgbBd;01jjbdndnabZbcztgd9nmbcuhiabad9RcFFifcz4nbcuSmekaehikaik;LeeeudndnaeabVciGTmbabhixekdndnadcz9pmbabhixekabhiinaiaeydbBdbaiclfaeclfydbBdbaicwfaecwfydbBdbaicxfaecxfydbBdbaiczfhiaeczfheadc9Wfgdcs0mbkkadcl6mbinaiaeydbBdbaeclfheaiclfhiadc98fgdci0mbkkdnadTmbinaiaeRbb86bbaicefhiaecefheadcufgdmbkkabk;aeedudndnabciGTmbabhixekaecFeGc:b:c:ew2hldndnadcz9pmbabhixekabhiinaialBdbaicxfalBdbaicwfalBdbaiclfalBdbaiczfhiadc9Wfgdcs0mbkkadcl6mbinaialBdbaiclfhiadc98fgdci0mbkkdnadTmbinaiae86bbaicefhiadcufgdmbkkabk9teiucbcbyd;01jjbgeabcrfc94GfgbBd;01jjbdndnabZbcztgd9nmbcuhiabad9RcFFifcz4nbcuSmekaehikaik9:eiuZbhedndncbyd;01jjbgdaecztgi9nmbcuheadai9RcFFifcz4nbcuSmekadhekcbabae9Rcifc98Gcbyd;01jjbfgdBd;01jjbdnadZbcztge9nmbadae9RcFFifcz4nb8Akk6eiucbhidnadTmbdninabRbbglaeRbbgv9hmeaecefheabcefhbadcufgdmbxdkkalav9Rhikaikk:cedbcjwk9PFFuuFFuuFFuuFFuFFFuFFFuFbbbbbbbbeeebeebebbeeebebbbbbebebbbbbebbbdbbbbbbbbbbbbbbbeeeeebebbbbbebbbbbeebbbbbbc;Swkxebbbdbbbj9Kbb";
+	// SIMD build (build/simplifier_simd.wasm) is embedded by "make js"; wasm_base is used while it is empty
+	var wasm_simd = "";
 
+	var detector = new Uint8Array([0,97,115,109,1,0,0,0,1,4,1,96,0,0,3,3,2,0,0,5,3,1,0,1,12,1,0,10,22,2,12,0,65,0,65,0,65,0,252,10,0,0,11,7,0,65,0,253,15,26,11]);
 	var wasmpack = new Uint8Array([32,0,65,2,1,106,34,33,3,128,11,4,13,64,6,253,10,7,15,116,127,5,8,12,40,16,19,54,20,9,27,255,113,17,42,67,24,23,146,148,18,14,22,45,70,69,56,114,101,21,25,63,75,136,108,28,118,29,73,115]);
 
 	if (typeof WebAssembly !== 'object') {
@@ -15,6 +18,8 @@ var MeshoptSimplifier = (function() {
 		};
 	}
 
+	var wasm = wasm_simd && WebAssembly.validate(detector) ? wasm_simd : wasm_base;
+
 	var instance;
 
 	var ready =
@@ -111,6 +116,107 @@ var MeshoptSimplifier = (function() {
 		LockBorder: 1,
 	};
 
+	var workers = [];
+	var requestId = 0;
+
+	function createWorker(url) {
+		var worker = {
+			object: new Worker(url),
+			pending: 0,
+			requests: {}
+		};
+
+		worker.object.onmessage = function(event) {
+			var data = event.data;
+
+			worker.pending -= data.count;
+			worker.requests[data.id][data.action](data.value);
+
+			delete worker.requests[data.id];
+		};
+
+		return worker;
+	}
+
+	function terminateWorkers() {
+		for (var i = 0; i < workers.length; ++i) {
+			var worker = workers[i];
+
+			// requests that are still in flight would never complete after the worker is terminated
+			for (var id in worker.requests) {
+				worker.requests[id].reject(new Error("Worker terminated"));
+			}
+
+			worker.object.terminate();
+		}
+
+		workers.length = 0;
+	}
+
+	function initWorkers(count) {
+		terminateWorkers();
+
+		if (count == 0) {
+			return;
+		}
+
+		var source =
+			"var instance; var ready = WebAssembly.instantiate(new Uint8Array([" + new Uint8Array(unpack(wasm)) + "]), {})" +
+			".then(function(result) { instance = result.instance; instance.exports.__wasm_call_ctors(); });" +
+			"self.onmessage = workerProcess;" +
+			bytes.toString() + simplify.toString() + workerProcess.toString();
+
+		var blob = new Blob([source], {type: 'text/javascript'});
+		var url = URL.createObjectURL(blob);
+
+		for (var i = 0; i < count; ++i) {
+			workers[i] = createWorker(url);
+		}
+
+		URL.revokeObjectURL(url);
+	}
+
+	function simplifyWorker(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, options) {
+		var worker = workers[0];
+
+		for (var i = 1; i < workers.length; ++i) {
+			if (workers[i].pending < worker.pending) {
+				worker = workers[i];
+			}
+		}
+
+		return new Promise(function (resolve, reject) {
+			// inputs are copied so that the copies can be transferred to the worker
+			var ib = new Uint32Array(indices);
+			var vb = new Float32Array(vertex_positions);
+			var id = requestId++;
+
+			worker.pending += ib.length;
+			worker.requests[id] = { resolve: resolve, reject: reject };
+			worker.object.postMessage({ id: id, count: ib.length, indices: ib, vertex_positions: vb, vertex_positions_stride: vertex_positions_stride, target_index_count: target_index_count, target_error: target_error, options: options }, [ ib.buffer, vb.buffer ]);
+		});
+	}
+
+	function workerProcess(event) {
+		ready.then(function() {
+			var data = event.data;
+			try {
+				var result = simplify(instance.exports.meshopt_simplify, data.indices, data.indices.length, data.vertex_positions, data.vertex_positions.length, data.vertex_positions_stride * 4, data.target_index_count, data.target_error, data.options);
+				self.postMessage({ id: data.id, count: data.count, action: "resolve", value: result }, [ result[0].buffer ]);
+			} catch (error) {
+				self.postMessage({ id: data.id, count: data.count, action: "reject", value: error });
+			}
+		});
+	}
+
+	function simplifyOptionMask(flags) {
+		var options = 0;
+		for (var i = 0; i < (flags ? flags.length : 0); ++i) {
+			options |= simplifyOptions[flags[i]];
+		}
+		return options;
+	}
+
 	return {
 		ready: ready,
 		supported: true,
@@ -131,10 +237,7 @@ var MeshoptSimplifier = (function() {
 			assert(vertex_positions_stride >= 3);
 			assert(target_index_count % 3 == 0);
 
-			var options = 0;
-			for (var i = 0; i < (flags ? flags.length : 0); ++i) {
-				options |= simplifyOptions[flags[i]];
-			}
+			var options = simplifyOptionMask(flags);
 
 			var indices32 = indices.BYTES_PER_ELEMENT == 4 ? indices : new Uint32Array(indices);
 			var result = simplify(instance.exports.meshopt_simplify, indices32, indices.length, vertex_positions, vertex_positions.length, vertex_positions_stride * 4, target_index_count, target_error, options);
@@ -143,6 +246,33 @@ var MeshoptSimplifier = (function() {
 			return result;
 		},
 
+		useWorkers: function(count) {
+			initWorkers(count);
+		},
+
+		simplifyAsync: function(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, flags) {
+			assert(indices instanceof Uint32Array || indices instanceof Int32Array || indices instanceof Uint16Array || indices instanceof Int16Array);
+			assert(indices.length % 3 == 0);
+			assert(vertex_positions instanceof Float32Array);
+			assert(vertex_positions.length % vertex_positions_stride == 0);
+			assert(vertex_positions_stride >= 3);
+			assert(target_index_count % 3 == 0);
+
+			var options = simplifyOptionMask(flags);
+			var simplifier = this;
+
+			if (workers.length == 0) {
+				return ready.then(function() {
+					return simplifier.simplify(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, flags);
+				});
+			}
+
+			return simplifyWorker(indices, vertex_positions, vertex_positions_stride, target_index_count, target_error, options).then(function(result) {
+				result[0] = (indices instanceof Uint32Array) ? result[0] : new indices.constructor(result[0]);
+				return result;
+			});
+		},
+
 		getScale: function(vertex_positions, vertex_positions_stride) {
 			assert(vertex_positions instanceof Float32Array);
 			assert(vertex_positions.length % vertex_positions_stride == 0);
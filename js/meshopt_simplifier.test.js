@@ -6,6 +6,46 @@ process.on('unhandledRejection', error => {
 	process.exit(1);
 });
 
+// Node doesn't implement Web Workers; this emulates the subset that useWorkers relies on with worker_threads
+function installWorkerShim() {
+	var threads = require('worker_threads');
+	var sources = {};
+	var nextUrl = 0;
+
+	var prelude =
+		"var parentPort = require('worker_threads').parentPort;" +
+		"var self = { postMessage: function(data, transfer) { parentPort.postMessage(data, transfer); } };" +
+		"parentPort.on('message', function(data) { self.onmessage({ data: data }); });";
+
+	global.Blob = function(parts) {
+		this.source = parts.join('');
+	};
+
+	URL.createObjectURL = function(blob) {
+		var url = 'blob:shim/' + nextUrl++;
+		sources[url] = blob.source;
+		return url;
+	};
+
+	URL.revokeObjectURL = function(url) {
+		delete sources[url];
+	};
+
+	global.Worker = function(url) {
+		var worker = this;
+		this.thread = new threads.Worker(prelude + sources[url], { eval: true });
+		this.thread.on('message', function(data) { worker.onmessage({ data: data }); });
+	};
+
+	global.Worker.prototype.postMessage = function(data, transfer) {
+		this.thread.postMessage(data, transfer);
+	};
+
+	global.Worker.prototype.terminate = function() {
+		this.thread.terminate();
+	};
+}
+
 var tests = {
 	compactMesh: function() {
 		var indices = new Uint32Array([
@@ -60,6 +100,29 @@ var tests = {
 		assert.equal(res[1], 0); // error
 	},
 
+	simplifyAsync: function() {
+		var indices = new Uint32Array([
+			0, 2, 1,
+			1, 2, 3,
+			3, 2, 4,
+			2, 5, 4,
+		]);
+
+		var positions = new Float32Array([
+			0, 2, 0,
+			0, 1, 0,
+			1, 1, 0,
+			0, 0, 0,
+			1, 0, 0,
+			2, 0, 0,
+		]);
+
+		return simplifier.simplifyAsync(indices, positions, 3, /* target indices */ 3, /* target error */ 0.01).then(function(res) {
+			assert.deepEqual(res[0], new Uint32Array([3, 0, 5]));
+			assert.equal(res[1], 0); // error
+		});
+	},
+
 	simplify16: function() {
 		// 0
 		// 1 2
@@ -130,6 +193,54 @@ var tests = {
 
 		assert(simplifier.getScale(positions, 3) == 3.0);
 	},
+
+	simplifyWorkers: function() {
+		var indices = new Uint32Array([
+			0, 2, 1,
+			1, 2, 3,
+			3, 2, 4,
+			2, 5, 4,
+		]);
+
+		var positions = new Float32Array([
+			0, 2, 0,
+			0, 1, 0,
+			1, 1, 0,
+			0, 0, 0,
+			1, 0, 0,
+			2, 0, 0,
+		]);
+
+		installWorkerShim();
+		simplifier.useWorkers(2);
+
+		function simplifyAll() {
+			return Promise.all([
+				simplifier.simplifyAsync(indices, positions, 3, /* target indices */ 3, /* target error */ 0.01),
+				simplifier.simplifyAsync(new Uint16Array(indices), positions, 3, /* target indices */ 3, /* target error */ 0.01),
+				simplifier.simplifyAsync(indices, positions, 3, /* target indices */ 3, /* target error */ 0.01, ['LockBorder']),
+			]).then(function(results) {
+				assert.deepEqual(results[0], simplifier.simplify(indices, positions, 3, 3, 0.01));
+				assert.deepEqual(results[1], simplifier.simplify(new Uint16Array(indices), positions, 3, 3, 0.01));
+				assert.deepEqual(results[2], simplifier.simplify(indices, positions, 3, 3, 0.01, ['LockBorder']));
+			});
+		}
+
+		return simplifyAll().then(function() {
+			var pending = simplifier.simplifyAsync(indices, positions, 3, 3, 0.01);
+
+			// reinitialization terminates the existing workers and rejects their requests
+			simplifier.useWorkers(2);
+
+			return pending.then(function() {
+				assert.fail('request should have been rejected');
+			}, function(error) {
+				assert.equal(error.message, 'Worker terminated');
+			});
+		}).then(simplifyAll).then(function() {
+			simplifier.useWorkers(0);
+		});
+	},
 };
 
 Promise.all([simplifier.ready]).then(() => {
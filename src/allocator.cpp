@@ -6,3 +6,9 @@ void meshopt_setAllocator(void* (MESHOPTIMIZER_ALLOC_CALLCONV *allocate)(size_t)
 	meshopt_Allocator::Storage::allocate = allocate;
 	meshopt_Allocator::Storage::deallocate = deallocate;
 }
+
+void meshopt_setProfiler(void (*callback)(void* context, int event, const char* name, size_t value), void* context)
+{
+	meshopt_Profiler::Storage::callback = callback;
+	meshopt_Profiler::Storage::context = context;
+}
@@ -0,0 +1,121 @@
+// This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
+#include "meshoptimizer.h"
+
+#include <assert.h>
+#include <string.h>
+
+namespace meshopt
+{
+
+// meshes are grouped until the group reaches this many indices; this amortizes scratch allocation and dispatch overhead for small meshes
+const size_t kBatchGroupIndices = 65536;
+
+struct MeshBatch
+{
+	meshopt_BatchMesh* meshes;
+	const size_t* groups;
+	float overdraw_threshold;
+};
+
+static size_t getBatchScratchBound(const meshopt_BatchMesh& mesh)
+{
+	size_t vcache = meshopt_optimizeVertexCacheScratchBound(mesh.index_count, mesh.vertex_count);
+	size_t overdraw = meshopt_optimizeOverdrawScratchBound(mesh.index_count, mesh.vertex_count);
+	size_t vfetch = meshopt_optimizeVertexFetchScratchBound(mesh.vertex_count, mesh.vertex_size);
+
+	// each stage releases its scratch memory before the next one starts
+	size_t result = vcache > overdraw ? vcache : overdraw;
+	return result > vfetch ? result : vfetch;
+}
+
+static void optimizeMesh(meshopt_BatchMesh& mesh, float overdraw_threshold, meshopt_Context* context)
+{
+	assert(mesh.vertex_size % 4 == 0);
+	assert(mesh.vertex_positions_offset + 12 <= mesh.vertex_size);
+
+	meshopt_optimizeVertexCacheWithContext(mesh.indices, mesh.indices, mesh.index_count, mesh.vertex_count, context);
+
+	if (overdraw_threshold > 0)
+	{
+		const float* positions = reinterpret_cast<const float*>(static_cast<unsigned char*>(mesh.vertices) + mesh.vertex_positions_offset);
+
+		meshopt_optimizeOverdrawWithContext(mesh.indices, mesh.indices, mesh.index_count, positions, mesh.vertex_count, mesh.vertex_size, overdraw_threshold, context);
+	}
+
+	mesh.vertex_count = meshopt_optimizeVertexFetchWithContext(mesh.vertices, mesh.indices, mesh.index_count, mesh.vertices, mesh.vertex_count, mesh.vertex_size, context);
+}
+
+static void optimizeMeshGroup(const MeshBatch& batch, size_t group)
+{
+	size_t begin = batch.groups[group], end = batch.groups[group + 1];
+
+	size_t scratch = 0;
+	for (size_t i = begin; i < end; ++i)
+	{
+		size_t bound = getBatchScratchBound(batch.meshes[i]);
+		scratch = scratch > bound ? scratch : bound;
+	}
+
+	meshopt_Allocator allocator;
+
+	// all meshes in the group share one scratch buffer that is sized for the largest mesh, so the optimizers don't need to allocate memory
+	meshopt_Context context = {};
+	context.data = allocator.allocate<unsigned char>(scratch);
+	context.capacity = scratch;
+
+	for (size_t i = begin; i < end; ++i)
+		optimizeMesh(batch.meshes[i], batch.overdraw_threshold, &context);
+
+	assert(context.peak <= context.capacity);
+}
+
+static void optimizeMeshGroupTask(void* context, size_t index)
+{
+	const MeshBatch& batch = *static_cast<const MeshBatch*>(context);
+
+	optimizeMeshGroup(batch, index);
+}
+
+} // namespace meshopt
+
+void meshopt_optimizeMeshBatch(meshopt_BatchMesh* meshes, size_t mesh_count, float overdraw_threshold, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(overdraw_threshold == 0 || overdraw_threshold >= 1);
+
+	if (mesh_count == 0)
+		return;
+
+	meshopt_Allocator allocator;
+
+	// split meshes into contiguous groups with roughly kBatchGroupIndices indices each; large meshes get a group of their own
+	size_t* groups = allocator.allocate<size_t>(mesh_count + 1);
+	size_t group_count = 0;
+	size_t group_indices = 0;
+
+	for (size_t i = 0; i < mesh_count; ++i)
+	{
+		if (i == 0 || group_indices >= kBatchGroupIndices)
+		{
+			groups[group_count++] = i;
+			group_indices = 0;
+		}
+
+		group_indices += meshes[i].index_count;
+	}
+
+	groups[group_count] = mesh_count;
+
+	MeshBatch batch = {meshes, groups, overdraw_threshold};
+
+	if (dispatch && group_count > 1)
+	{
+		dispatch(context, optimizeMeshGroupTask, &batch, group_count);
+	}
+	else
+	{
+		for (size_t i = 0; i < group_count; ++i)
+			optimizeMeshGroup(batch, i);
+	}
+}
@@ -6,6 +6,51 @@
 #include <math.h>
 #include <string.h>
 
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// The SIMD implementation requires SSE2, which can be enabled unconditionally through compiler settings
+#if defined(__SSE2__)
+#define SIMD_SSE
+#endif
+
+// MSVC supports compiling SSE2 code regardless of compile options; we assume all 32-bit CPUs support SSE2
+#if !defined(SIMD_SSE) && defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64))
+#define SIMD_SSE
+#endif
+
+// The NEON implementation requires vector division and square root which are only available on AArch64
+#if (defined(__ARM_NEON__) || defined(__ARM_NEON)) && defined(__aarch64__)
+#define SIMD_NEON
+#endif
+
+#if !defined(SIMD_NEON) && defined(_MSC_VER) && defined(_M_ARM64)
+#define SIMD_NEON
+#endif
+
+// When targeting Wasm SIMD we can't use runtime cpuid checks so we unconditionally enable SIMD
+#if defined(__wasm_simd128__)
+#define SIMD_WASM
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef SIMD_NEON
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef SIMD_WASM
+#include <wasm_simd128.h>
+#endif
+
 // This work is based on:
 // Graham Wihlidal. Optimizing the Graphics Pipeline with Compute. 2016
 // Matthaeus Chajdas. GeometryFX 1.2 - Cluster Culling. 2016
@@ -19,6 +64,12 @@ const size_t kMeshletMaxVertices = 255;
 // A reasonable limit is around 2*max_vertices or less
 const size_t kMeshletMaxTriangles = 512;
 
+// Parallel builder splits the mesh into partitions of up to this many triangles; meshlets can't cross partition boundaries
+const size_t kMeshletPartitionSize = 65536;
+
+// Batched bounds generator processes this many meshlets per task
+const size_t kMeshletBoundsBlockSize = 256;
+
 struct TriangleAdjacency2
 {
 	unsigned int* counts;
@@ -75,6 +126,323 @@ static void buildTriangleAdjacency(TriangleAdjacency2& adjacency, const unsigned
 	}
 }
 
+// the batched versions below process 4 triangles or points at once; positions are gathered and transposed in registers
+// the order of operations matches the scalar versions in computeBoundingSphere and meshopt_computeClusterBounds so the results are identical
+#ifdef SIMD_SSE
+static __m128 loadPosition(const float* p)
+{
+	__m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+	return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+}
+
+static void computeTriangleNormals4(float* normals, float* areas, const float* const* p0, const float* const* p1, const float* const* p2)
+{
+	__m128 x0 = loadPosition(p0[0]), y0 = loadPosition(p0[1]), z0 = loadPosition(p0[2]), w0 = loadPosition(p0[3]);
+	_MM_TRANSPOSE4_PS(x0, y0, z0, w0);
+
+	__m128 x1 = loadPosition(p1[0]), y1 = loadPosition(p1[1]), z1 = loadPosition(p1[2]), w1 = loadPosition(p1[3]);
+	_MM_TRANSPOSE4_PS(x1, y1, z1, w1);
+
+	__m128 x2 = loadPosition(p2[0]), y2 = loadPosition(p2[1]), z2 = loadPosition(p2[2]), w2 = loadPosition(p2[3]);
+	_MM_TRANSPOSE4_PS(x2, y2, z2, w2);
+
+	__m128 p10x = _mm_sub_ps(x1, x0), p10y = _mm_sub_ps(y1, y0), p10z = _mm_sub_ps(z1, z0);
+	__m128 p20x = _mm_sub_ps(x2, x0), p20y = _mm_sub_ps(y2, y0), p20z = _mm_sub_ps(z2, z0);
+
+	__m128 nx = _mm_sub_ps(_mm_mul_ps(p10y, p20z), _mm_mul_ps(p10z, p20y));
+	__m128 ny = _mm_sub_ps(_mm_mul_ps(p10z, p20x), _mm_mul_ps(p10x, p20z));
+	__m128 nz = _mm_sub_ps(_mm_mul_ps(p10x, p20y), _mm_mul_ps(p10y, p20x));
+
+	__m128 area = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, nx), _mm_mul_ps(ny, ny)), _mm_mul_ps(nz, nz)));
+
+	_mm_storeu_ps(normals + 0, _mm_div_ps(nx, area));
+	_mm_storeu_ps(normals + 4, _mm_div_ps(ny, area));
+	_mm_storeu_ps(normals + 8, _mm_div_ps(nz, area));
+	_mm_storeu_ps(areas, area);
+}
+
+static void loadPoints4(__m128& x, __m128& y, __m128& z, const float points[][3])
+{
+	__m128 w;
+	x = loadPosition(points[0]), y = loadPosition(points[1]), z = loadPosition(points[2]), w = loadPosition(points[3]);
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+static void findExtremes4(float* values, unsigned int* indices, const float points[][3], size_t count)
+{
+	__m128 minx, miny, minz, maxx, maxy, maxz;
+	loadPoints4(minx, miny, minz, points);
+	maxx = minx, maxy = miny, maxz = minz;
+
+	__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+	__m128i minix = index, miniy = index, miniz = index, maxix = index, maxiy = index, maxiz = index;
+
+	// each lane tracks the first extremum among points with the same index modulo 4
+	for (size_t i = 4; i < count; i += 4)
+	{
+		__m128 x, y, z;
+		loadPoints4(x, y, z, points + i);
+
+		index = _mm_add_epi32(index, _mm_set1_epi32(4));
+
+#define UPDATE(cmp, v, e, ei) \
+	{ \
+		__m128 m = cmp(v, e); \
+		e = _mm_or_ps(_mm_and_ps(m, v), _mm_andnot_ps(m, e)); \
+		ei = _mm_or_si128(_mm_and_si128(_mm_castps_si128(m), index), _mm_andnot_si128(_mm_castps_si128(m), ei)); \
+	}
+
+		UPDATE(_mm_cmplt_ps, x, minx, minix);
+		UPDATE(_mm_cmplt_ps, y, miny, miniy);
+		UPDATE(_mm_cmplt_ps, z, minz, miniz);
+		UPDATE(_mm_cmpgt_ps, x, maxx, maxix);
+		UPDATE(_mm_cmpgt_ps, y, maxy, maxiy);
+		UPDATE(_mm_cmpgt_ps, z, maxz, maxiz);
+
+#undef UPDATE
+	}
+
+	_mm_storeu_ps(values + 0, minx), _mm_storeu_ps(values + 4, miny), _mm_storeu_ps(values + 8, minz);
+	_mm_storeu_ps(values + 12, maxx), _mm_storeu_ps(values + 16, maxy), _mm_storeu_ps(values + 20, maxz);
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(indices + 0), minix), _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + 4), miniy), _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + 8), miniz);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(indices + 12), maxix), _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + 16), maxiy), _mm_storeu_si128(reinterpret_cast<__m128i*>(indices + 20), maxiz);
+}
+
+static unsigned int findOutside4(const float points[][3], const float center[3], float radius2)
+{
+	__m128 x, y, z;
+	loadPoints4(x, y, z, points);
+
+	__m128 dx = _mm_sub_ps(x, _mm_set1_ps(center[0]));
+	__m128 dy = _mm_sub_ps(y, _mm_set1_ps(center[1]));
+	__m128 dz = _mm_sub_ps(z, _mm_set1_ps(center[2]));
+
+	__m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+	return _mm_movemask_ps(_mm_cmpgt_ps(d2, _mm_set1_ps(radius2)));
+}
+#endif
+
+#ifdef SIMD_NEON
+static void transpose4(float32x4_t& r0, float32x4_t& r1, float32x4_t& r2, float32x4_t& r3)
+{
+	float32x4x2_t t0 = vzipq_f32(r0, r2);
+	float32x4x2_t t1 = vzipq_f32(r1, r3);
+	float32x4x2_t u0 = vzipq_f32(t0.val[0], t1.val[0]);
+	float32x4x2_t u1 = vzipq_f32(t0.val[1], t1.val[1]);
+
+	r0 = u0.val[0];
+	r1 = u0.val[1];
+	r2 = u1.val[0];
+	r3 = u1.val[1];
+}
+
+static float32x4_t loadPosition(const float* p)
+{
+	return vcombine_f32(vld1_f32(p), vld1_dup_f32(p + 2));
+}
+
+static void computeTriangleNormals4(float* normals, float* areas, const float* const* p0, const float* const* p1, const float* const* p2)
+{
+	float32x4_t x0 = loadPosition(p0[0]), y0 = loadPosition(p0[1]), z0 = loadPosition(p0[2]), w0 = loadPosition(p0[3]);
+	transpose4(x0, y0, z0, w0);
+
+	float32x4_t x1 = loadPosition(p1[0]), y1 = loadPosition(p1[1]), z1 = loadPosition(p1[2]), w1 = loadPosition(p1[3]);
+	transpose4(x1, y1, z1, w1);
+
+	float32x4_t x2 = loadPosition(p2[0]), y2 = loadPosition(p2[1]), z2 = loadPosition(p2[2]), w2 = loadPosition(p2[3]);
+	transpose4(x2, y2, z2, w2);
+
+	float32x4_t p10x = vsubq_f32(x1, x0), p10y = vsubq_f32(y1, y0), p10z = vsubq_f32(z1, z0);
+	float32x4_t p20x = vsubq_f32(x2, x0), p20y = vsubq_f32(y2, y0), p20z = vsubq_f32(z2, z0);
+
+	// note: we use separate multiply and add instead of vmlaq/vfmaq to avoid fusing which would change the results
+	float32x4_t nx = vsubq_f32(vmulq_f32(p10y, p20z), vmulq_f32(p10z, p20y));
+	float32x4_t ny = vsubq_f32(vmulq_f32(p10z, p20x), vmulq_f32(p10x, p20z));
+	float32x4_t nz = vsubq_f32(vmulq_f32(p10x, p20y), vmulq_f32(p10y, p20x));
+
+	float32x4_t area = vsqrtq_f32(vaddq_f32(vaddq_f32(vmulq_f32(nx, nx), vmulq_f32(ny, ny)), vmulq_f32(nz, nz)));
+
+	vst1q_f32(normals + 0, vdivq_f32(nx, area));
+	vst1q_f32(normals + 4, vdivq_f32(ny, area));
+	vst1q_f32(normals + 8, vdivq_f32(nz, area));
+	vst1q_f32(areas, area);
+}
+
+static void loadPoints4(float32x4_t& x, float32x4_t& y, float32x4_t& z, const float points[][3])
+{
+	float32x4_t w;
+	x = loadPosition(points[0]), y = loadPosition(points[1]), z = loadPosition(points[2]), w = loadPosition(points[3]);
+	transpose4(x, y, z, w);
+}
+
+static void findExtremes4(float* values, unsigned int* indices, const float points[][3], size_t count)
+{
+	float32x4_t minx, miny, minz, maxx, maxy, maxz;
+	loadPoints4(minx, miny, minz, points);
+	maxx = minx, maxy = miny, maxz = minz;
+
+	const unsigned int lanes[4] = {0, 1, 2, 3};
+	uint32x4_t index = vld1q_u32(lanes);
+	uint32x4_t minix = index, miniy = index, miniz = index, maxix = index, maxiy = index, maxiz = index;
+
+	// each lane tracks the first extremum among points with the same index modulo 4
+	for (size_t i = 4; i < count; i += 4)
+	{
+		float32x4_t x, y, z;
+		loadPoints4(x, y, z, points + i);
+
+		index = vaddq_u32(index, vdupq_n_u32(4));
+
+#define UPDATE(cmp, v, e, ei) \
+	{ \
+		uint32x4_t m = cmp(v, e); \
+		e = vbslq_f32(m, v, e); \
+		ei = vbslq_u32(m, index, ei); \
+	}
+
+		UPDATE(vcltq_f32, x, minx, minix);
+		UPDATE(vcltq_f32, y, miny, miniy);
+		UPDATE(vcltq_f32, z, minz, miniz);
+		UPDATE(vcgtq_f32, x, maxx, maxix);
+		UPDATE(vcgtq_f32, y, maxy, maxiy);
+		UPDATE(vcgtq_f32, z, maxz, maxiz);
+
+#undef UPDATE
+	}
+
+	vst1q_f32(values + 0, minx), vst1q_f32(values + 4, miny), vst1q_f32(values + 8, minz);
+	vst1q_f32(values + 12, maxx), vst1q_f32(values + 16, maxy), vst1q_f32(values + 20, maxz);
+
+	vst1q_u32(indices + 0, minix), vst1q_u32(indices + 4, miniy), vst1q_u32(indices + 8, miniz);
+	vst1q_u32(indices + 12, maxix), vst1q_u32(indices + 16, maxiy), vst1q_u32(indices + 20, maxiz);
+}
+
+static unsigned int findOutside4(const float points[][3], const float center[3], float radius2)
+{
+	float32x4_t x, y, z;
+	loadPoints4(x, y, z, points);
+
+	float32x4_t dx = vsubq_f32(x, vdupq_n_f32(center[0]));
+	float32x4_t dy = vsubq_f32(y, vdupq_n_f32(center[1]));
+	float32x4_t dz = vsubq_f32(z, vdupq_n_f32(center[2]));
+
+	float32x4_t d2 = vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz));
+
+	const unsigned int bits[4] = {1, 2, 4, 8};
+	return vaddvq_u32(vandq_u32(vcgtq_f32(d2, vdupq_n_f32(radius2)), vld1q_u32(bits)));
+}
+#endif
+
+#ifdef SIMD_WASM
+static void transpose4(v128_t& r0, v128_t& r1, v128_t& r2, v128_t& r3)
+{
+	v128_t t0 = wasm_i32x4_shuffle(r0, r1, 0, 4, 1, 5);
+	v128_t t1 = wasm_i32x4_shuffle(r2, r3, 0, 4, 1, 5);
+	v128_t t2 = wasm_i32x4_shuffle(r0, r1, 2, 6, 3, 7);
+	v128_t t3 = wasm_i32x4_shuffle(r2, r3, 2, 6, 3, 7);
+
+	r0 = wasm_i64x2_shuffle(t0, t1, 0, 2);
+	r1 = wasm_i64x2_shuffle(t0, t1, 1, 3);
+	r2 = wasm_i64x2_shuffle(t2, t3, 0, 2);
+	r3 = wasm_i64x2_shuffle(t2, t3, 1, 3);
+}
+
+static v128_t loadPosition(const float* p)
+{
+	return wasm_f32x4_replace_lane(wasm_v128_load64_zero(p), 2, p[2]);
+}
+
+static void computeTriangleNormals4(float* normals, float* areas, const float* const* p0, const float* const* p1, const float* const* p2)
+{
+	v128_t x0 = loadPosition(p0[0]), y0 = loadPosition(p0[1]), z0 = loadPosition(p0[2]), w0 = loadPosition(p0[3]);
+	transpose4(x0, y0, z0, w0);
+
+	v128_t x1 = loadPosition(p1[0]), y1 = loadPosition(p1[1]), z1 = loadPosition(p1[2]), w1 = loadPosition(p1[3]);
+	transpose4(x1, y1, z1, w1);
+
+	v128_t x2 = loadPosition(p2[0]), y2 = loadPosition(p2[1]), z2 = loadPosition(p2[2]), w2 = loadPosition(p2[3]);
+	transpose4(x2, y2, z2, w2);
+
+	v128_t p10x = wasm_f32x4_sub(x1, x0), p10y = wasm_f32x4_sub(y1, y0), p10z = wasm_f32x4_sub(z1, z0);
+	v128_t p20x = wasm_f32x4_sub(x2, x0), p20y = wasm_f32x4_sub(y2, y0), p20z = wasm_f32x4_sub(z2, z0);
+
+	v128_t nx = wasm_f32x4_sub(wasm_f32x4_mul(p10y, p20z), wasm_f32x4_mul(p10z, p20y));
+	v128_t ny = wasm_f32x4_sub(wasm_f32x4_mul(p10z, p20x), wasm_f32x4_mul(p10x, p20z));
+	v128_t nz = wasm_f32x4_sub(wasm_f32x4_mul(p10x, p20y), wasm_f32x4_mul(p10y, p20x));
+
+	v128_t area = wasm_f32x4_sqrt(wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(nx, nx), wasm_f32x4_mul(ny, ny)), wasm_f32x4_mul(nz, nz)));
+
+	wasm_v128_store(normals + 0, wasm_f32x4_div(nx, area));
+	wasm_v128_store(normals + 4, wasm_f32x4_div(ny, area));
+	wasm_v128_store(normals + 8, wasm_f32x4_div(nz, area));
+	wasm_v128_store(areas, area);
+}
+
+static void loadPoints4(v128_t& x, v128_t& y, v128_t& z, const float points[][3])
+{
+	v128_t w;
+	x = loadPosition(points[0]), y = loadPosition(points[1]), z = loadPosition(points[2]), w = loadPosition(points[3]);
+	transpose4(x, y, z, w);
+}
+
+static void findExtremes4(float* values, unsigned int* indices, const float points[][3], size_t count)
+{
+	v128_t minx, miny, minz, maxx, maxy, maxz;
+	loadPoints4(minx, miny, minz, points);
+	maxx = minx, maxy = miny, maxz = minz;
+
+	v128_t index = wasm_i32x4_make(0, 1, 2, 3);
+	v128_t minix = index, miniy = index, miniz = index, maxix = index, maxiy = index, maxiz = index;
+
+	// each lane tracks the first extremum among points with the same index modulo 4
+	for (size_t i = 4; i < count; i += 4)
+	{
+		v128_t x, y, z;
+		loadPoints4(x, y, z, points + i);
+
+		index = wasm_i32x4_add(index, wasm_i32x4_splat(4));
+
+#define UPDATE(cmp, v, e, ei) \
+	{ \
+		v128_t m = cmp(v, e); \
+		e = wasm_v128_bitselect(v, e, m); \
+		ei = wasm_v128_bitselect(index, ei, m); \
+	}
+
+		UPDATE(wasm_f32x4_lt, x, minx, minix);
+		UPDATE(wasm_f32x4_lt, y, miny, miniy);
+		UPDATE(wasm_f32x4_lt, z, minz, miniz);
+		UPDATE(wasm_f32x4_gt, x, maxx, maxix);
+		UPDATE(wasm_f32x4_gt, y, maxy, maxiy);
+		UPDATE(wasm_f32x4_gt, z, maxz, maxiz);
+
+#undef UPDATE
+	}
+
+	wasm_v128_store(values + 0, minx), wasm_v128_store(values + 4, miny), wasm_v128_store(values + 8, minz);
+	wasm_v128_store(values + 12, maxx), wasm_v128_store(values + 16, maxy), wasm_v128_store(values + 20, maxz);
+
+	wasm_v128_store(indices + 0, minix), wasm_v128_store(indices + 4, miniy), wasm_v128_store(indices + 8, miniz);
+	wasm_v128_store(indices + 12, maxix), wasm_v128_store(indices + 16, maxiy), wasm_v128_store(indices + 20, maxiz);
+}
+
+static unsigned int findOutside4(const float points[][3], const float center[3], float radius2)
+{
+	v128_t x, y, z;
+	loadPoints4(x, y, z, points);
+
+	v128_t dx = wasm_f32x4_sub(x, wasm_f32x4_splat(center[0]));
+	v128_t dy = wasm_f32x4_sub(y, wasm_f32x4_splat(center[1]));
+	v128_t dz = wasm_f32x4_sub(z, wasm_f32x4_splat(center[2]));
+
+	v128_t d2 = wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(dx, dx), wasm_f32x4_mul(dy, dy)), wasm_f32x4_mul(dz, dz));
+
+	return wasm_i32x4_bitmask(wasm_f32x4_gt(d2, wasm_f32x4_splat(radius2)));
+}
+#endif
+
 static void computeBoundingSphere(float result[4], const float points[][3], size_t count)
 {
 	assert(count > 0);
@@ -83,7 +451,36 @@ static void computeBoundingSphere(float result[4], const float points[][3], size
 	size_t pmin[3] = {0, 0, 0};
 	size_t pmax[3] = {0, 0, 0};
 
-	for (size_t i = 0; i < count; ++i)
+	size_t offset = 0;
+
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	if (count >= 4)
+	{
+		offset = count & ~size_t(3);
+
+		float values[24];
+		unsigned int indices[24];
+		findExtremes4(values, indices, points, offset);
+
+		// merge per-lane extremums; on ties, the point with the smallest index wins to match the scalar loop
+		for (int axis = 0; axis < 6; ++axis)
+		{
+			int best = 0;
+
+			for (int k = 1; k < 4; ++k)
+			{
+				float v = values[axis * 4 + k], bv = values[axis * 4 + best];
+
+				if ((axis < 3 ? v < bv : v > bv) || (v == bv && indices[axis * 4 + k] < indices[axis * 4 + best]))
+					best = k;
+			}
+
+			(axis < 3 ? pmin[axis] : pmax[axis - 3]) = indices[axis * 4 + best];
+		}
+	}
+#endif
+
+	for (size_t i = offset; i < count; ++i)
 	{
 		const float* p = points[i];
 
@@ -122,6 +519,23 @@ static void computeBoundingSphere(float result[4], const float points[][3], size
 	// iteratively adjust the sphere up until all points fit
 	for (size_t i = 0; i < count; ++i)
 	{
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+		// most points are inside the sphere, so we check 4 points at a time and skip to the first one that is outside
+		if (i + 4 <= count)
+		{
+			unsigned int outside = findOutside4(&points[i], center, radius * radius);
+
+			if (outside == 0)
+			{
+				i += 3;
+				continue;
+			}
+
+			for (; (outside & 1) == 0; outside >>= 1)
+				i++;
+		}
+#endif
+
 		const float* p = points[i];
 		float d2 = (p[0] - center[0]) * (p[0] - center[0]) + (p[1] - center[1]) * (p[1] - center[1]) + (p[2] - center[2]) * (p[2] - center[2]);
 
@@ -318,6 +732,32 @@ static size_t kdtreePartition(unsigned int* indices, size_t count, const float*
 	return m;
 }
 
+static unsigned int kdtreeSplitAxis(float& split, const float* points, size_t stride, const unsigned int* indices, size_t count)
+{
+	float mean[3] = {};
+	float vars[3] = {};
+	float runc = 1, runs = 1;
+
+	// gather statistics on the points in the subtree using Welford's algorithm
+	for (size_t i = 0; i < count; ++i, runc += 1.f, runs = 1.f / runc)
+	{
+		const float* point = points + indices[i] * stride;
+
+		for (int k = 0; k < 3; ++k)
+		{
+			float delta = point[k] - mean[k];
+			mean[k] += delta * runs;
+			vars[k] += delta * (point[k] - mean[k]);
+		}
+	}
+
+	// split axis is one where the variance is largest
+	unsigned int axis = vars[0] >= vars[1] && vars[0] >= vars[2] ? 0 : vars[1] >= vars[2] ? 1 : 2;
+
+	split = mean[axis];
+	return axis;
+}
+
 static size_t kdtreeBuildLeaf(size_t offset, KDNode* nodes, size_t node_count, unsigned int* indices, size_t count)
 {
 	assert(offset + count <= node_count);
@@ -350,27 +790,9 @@ static size_t kdtreeBuild(size_t offset, KDNode* nodes, size_t node_count, const
 	if (count <= leaf_size)
 		return kdtreeBuildLeaf(offset, nodes, node_count, indices, count);
 
-	float mean[3] = {};
-	float vars[3] = {};
-	float runc = 1, runs = 1;
-
-	// gather statistics on the points in the subtree using Welford's algorithm
-	for (size_t i = 0; i < count; ++i, runc += 1.f, runs = 1.f / runc)
-	{
-		const float* point = points + indices[i] * stride;
+	float split = 0;
+	unsigned int axis = kdtreeSplitAxis(split, points, stride, indices, count);
 
-		for (int k = 0; k < 3; ++k)
-		{
-			float delta = point[k] - mean[k];
-			mean[k] += delta * runs;
-			vars[k] += delta * (point[k] - mean[k]);
-		}
-	}
-
-	// split axis is one where the variance is largest
-	unsigned int axis = vars[0] >= vars[1] && vars[0] >= vars[2] ? 0 : vars[1] >= vars[2] ? 1 : 2;
-
-	float split = mean[axis];
 	size_t middle = kdtreePartition(indices, count, points, stride, axis, split);
 
 	// when the partition is degenerate simply consolidate the points into a single node
@@ -435,6 +857,182 @@ static void kdtreeNearest(KDNode* nodes, unsigned int root, const float* points,
 	}
 }
 
+struct MeshletPartition
+{
+	size_t index_offset;
+	size_t index_count;
+
+	size_t vertex_offset;
+	size_t vertex_count;
+
+	size_t meshlet_offset;
+	size_t meshlet_count;
+};
+
+struct MeshletPartitionBuilder
+{
+	meshopt_Meshlet* meshlets;
+	unsigned int* meshlet_vertices;
+	unsigned char* meshlet_triangles;
+
+	MeshletPartition* partitions;
+
+	const unsigned int* partition_indices;
+	const unsigned int* partition_vertices;
+
+	const float* vertex_positions;
+	size_t vertex_positions_stride;
+
+	size_t max_vertices;
+	size_t max_triangles;
+	float cone_weight;
+};
+
+static size_t partitionTriangles(MeshletPartition* partitions, size_t partition_offset, const float* points, size_t stride, unsigned int* indices, size_t offset, size_t count, size_t leaf_size)
+{
+	// split the triangles along the kd-tree until each subtree fits into a partition; partitions are emitted in depth-first order
+	if (count > leaf_size)
+	{
+		float split = 0;
+		unsigned int axis = kdtreeSplitAxis(split, points, stride, indices + offset, count);
+
+		size_t middle = kdtreePartition(indices + offset, count, points, stride, axis, split);
+
+		// when the partition is degenerate we keep the points in a single (oversized) partition, similarly to kdtreeBuild
+		if (middle > leaf_size / 2 && middle < count - leaf_size / 2)
+		{
+			partition_offset = partitionTriangles(partitions, partition_offset, points, stride, indices, offset, middle, leaf_size);
+			return partitionTriangles(partitions, partition_offset, points, stride, indices, offset + middle, count - middle, leaf_size);
+		}
+	}
+
+	MeshletPartition& partition = partitions[partition_offset];
+
+	// index_offset temporarily stores the triangle offset into the kd-tree order
+	partition.index_offset = offset;
+	partition.index_count = count * 3;
+
+	return partition_offset + 1;
+}
+
+static void buildMeshletsPartitionTask(void* context, size_t task_index)
+{
+	const MeshletPartitionBuilder& builder = *static_cast<const MeshletPartitionBuilder*>(context);
+	MeshletPartition& partition = builder.partitions[task_index];
+
+	meshopt_Allocator allocator;
+
+	const unsigned int* vertices = builder.partition_vertices + partition.vertex_offset;
+	size_t vertex_stride_float = builder.vertex_positions_stride / sizeof(float);
+
+	// gather partition vertex positions so that all per-vertex data is proportional to the partition size
+	float* positions = allocator.allocate<float>(partition.vertex_count * 3);
+
+	for (size_t i = 0; i < partition.vertex_count; ++i)
+		memcpy(&positions[i * 3], builder.vertex_positions + vertices[i] * vertex_stride_float, 3 * sizeof(float));
+
+	meshopt_Meshlet* meshlets = builder.meshlets + partition.meshlet_offset;
+	unsigned int* meshlet_vertices = builder.meshlet_vertices + partition.meshlet_offset * builder.max_vertices;
+	unsigned char* meshlet_triangles = builder.meshlet_triangles + partition.meshlet_offset * builder.max_triangles * 3;
+
+	size_t meshlet_count = meshopt_buildMeshletsWithContext(meshlets, meshlet_vertices, meshlet_triangles, builder.partition_indices + partition.index_offset, partition.index_count, positions, partition.vertex_count, sizeof(float) * 3, builder.max_vertices, builder.max_triangles, builder.cone_weight, NULL);
+
+	// remap partition-local vertex indices back to the original vertex buffer
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[i];
+
+		for (size_t j = 0; j < meshlet.vertex_count; ++j)
+			meshlet_vertices[meshlet.vertex_offset + j] = vertices[meshlet_vertices[meshlet.vertex_offset + j]];
+	}
+
+	partition.meshlet_count = meshlet_count;
+}
+
+struct MeshletBoundsTask
+{
+	meshopt_Bounds* bounds;
+	meshopt_MeshletCullData* cull_data;
+
+	const meshopt_Meshlet* meshlets;
+	size_t meshlet_count;
+	const unsigned int* meshlet_vertices;
+	const unsigned char* meshlet_triangles;
+
+	const float* vertex_positions;
+	size_t vertex_count;
+	size_t vertex_positions_stride;
+
+	float box_min[3];
+	float box_size;
+};
+
+static void quantizeCullData(meshopt_MeshletCullData& result, const meshopt_Bounds& bounds, const float box_min[3], float box_size)
+{
+	float scale = box_size > 0.f ? 65535.f / box_size : 0.f;
+	float step = box_size / 65535.f;
+
+	float error2 = 0.f;
+
+	for (int k = 0; k < 3; ++k)
+	{
+		float v = (bounds.center[k] - box_min[k]) * scale;
+		v = v < 0.f ? 0.f : (v > 65535.f ? 65535.f : v);
+
+		unsigned short q = (unsigned short)(int(v + 0.5f));
+
+		// measure the error of the decoded center so that the radius can be expanded to keep the sphere conservative
+		float e = box_min[k] + float(q) * step - bounds.center[k];
+
+		result.center[k] = q;
+		error2 += e * e;
+	}
+
+	// note that we need to round this up instead of rounding to nearest, hence +1
+	float radius = (bounds.radius + sqrtf(error2)) * scale;
+	int radius_q = radius < 65534.f ? int(radius) + 1 : 65535;
+
+	// radius that doesn't fit is clamped, which makes the decoded sphere smaller than the original one; 65535 marks such spheres for the caller
+	result.radius = (unsigned short)radius_q;
+
+	result.cone_axis_s8[0] = bounds.cone_axis_s8[0];
+	result.cone_axis_s8[1] = bounds.cone_axis_s8[1];
+	result.cone_axis_s8[2] = bounds.cone_axis_s8[2];
+	result.cone_cutoff_s8 = bounds.cone_cutoff_s8;
+}
+
+static void computeMeshletBoundsTask(void* context, size_t task_index)
+{
+	const MeshletBoundsTask& task = *static_cast<MeshletBoundsTask*>(context);
+
+	size_t begin = task_index * kMeshletBoundsBlockSize;
+	size_t end = task.meshlet_count - begin < kMeshletBoundsBlockSize ? task.meshlet_count : begin + kMeshletBoundsBlockSize;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		const meshopt_Meshlet& meshlet = task.meshlets[i];
+
+		meshopt_Bounds bounds = meshopt_computeMeshletBounds(&task.meshlet_vertices[meshlet.vertex_offset], &task.meshlet_triangles[meshlet.triangle_offset], meshlet.triangle_count, task.vertex_positions, task.vertex_count, task.vertex_positions_stride);
+
+		if (task.bounds)
+			task.bounds[i] = bounds;
+
+		if (task.cull_data)
+			quantizeCullData(task.cull_data[i], bounds, task.box_min, task.box_size);
+	}
+}
+
+static void computeMeshletBoundsBlocks(MeshletBoundsTask& task, meshopt_Dispatch dispatch, void* context)
+{
+	size_t block_count = (task.meshlet_count + kMeshletBoundsBlockSize - 1) / kMeshletBoundsBlockSize;
+
+	if (dispatch)
+		dispatch(context, computeMeshletBoundsTask, &task, block_count);
+	else
+		for (size_t i = 0; i < block_count; ++i)
+			computeMeshletBoundsTask(&task, i);
+}
+
 } // namespace meshopt
 
 size_t meshopt_buildMeshletsBound(size_t index_count, size_t max_vertices, size_t max_triangles)
@@ -460,6 +1058,27 @@ size_t meshopt_buildMeshletsBound(size_t index_count, size_t max_vertices, size_
 }
 
 size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight)
+{
+	return meshopt_buildMeshletsWithContext(meshlets, meshlet_vertices, meshlet_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight, NULL);
+}
+
+size_t meshopt_buildMeshletsScratchBound(size_t index_count, size_t vertex_count)
+{
+	using namespace meshopt;
+
+	size_t face_count = index_count / 3;
+
+	// triangle adjacency, live triangles, emitted flags, triangle cones, kd-tree indices and nodes, used vertex flags
+	return meshopt_Allocator::scratch<unsigned int>(vertex_count) * 2 + meshopt_Allocator::scratch<unsigned int>(index_count) +
+	       meshopt_Allocator::scratch<unsigned int>(vertex_count) +
+	       meshopt_Allocator::scratch<unsigned char>(face_count) +
+	       meshopt_Allocator::scratch<Cone>(face_count) +
+	       meshopt_Allocator::scratch<unsigned int>(face_count) +
+	       meshopt_Allocator::scratch<KDNode>(face_count * 2) +
+	       meshopt_Allocator::scratch<unsigned char>(vertex_count);
+}
+
+size_t meshopt_buildMeshletsWithContext(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, meshopt_Context* context)
 {
 	using namespace meshopt;
 
@@ -471,10 +1090,14 @@ size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_ve
 	assert(max_triangles >= 1 && max_triangles <= kMeshletMaxTriangles);
 	assert(max_triangles % 4 == 0); // ensures the caller will compute output space properly as index data is 4b aligned
 
-	meshopt_Allocator allocator;
+	MESHOPTIMIZER_PROFILE_BEGIN("buildMeshlets");
+
+	meshopt_Allocator allocator(context);
 
+	MESHOPTIMIZER_PROFILE_BEGIN("buildMeshlets.buildTriangleAdjacency");
 	TriangleAdjacency2 adjacency = {};
 	buildTriangleAdjacency(adjacency, indices, index_count, vertex_count, allocator);
+	MESHOPTIMIZER_PROFILE_END("buildMeshlets.buildTriangleAdjacency");
 
 	unsigned int* live_triangles = allocator.allocate<unsigned int>(vertex_count);
 	memcpy(live_triangles, adjacency.counts, vertex_count * sizeof(unsigned int));
@@ -485,20 +1108,24 @@ size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_ve
 	memset(emitted_flags, 0, face_count);
 
 	// for each triangle, precompute centroid & normal to use for scoring
+	MESHOPTIMIZER_PROFILE_BEGIN("buildMeshlets.computeTriangleCones");
 	Cone* triangles = allocator.allocate<Cone>(face_count);
 	float mesh_area = computeTriangleCones(triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride);
+	MESHOPTIMIZER_PROFILE_END("buildMeshlets.computeTriangleCones");
 
 	// assuming each meshlet is a square patch, expected radius is sqrt(expected area)
 	float triangle_area_avg = face_count == 0 ? 0.f : mesh_area / float(face_count) * 0.5f;
 	float meshlet_expected_radius = sqrtf(triangle_area_avg * max_triangles) * 0.5f;
 
 	// build a kd-tree for nearest neighbor lookup
+	MESHOPTIMIZER_PROFILE_BEGIN("buildMeshlets.kdtreeBuild");
 	unsigned int* kdindices = allocator.allocate<unsigned int>(face_count);
 	for (size_t i = 0; i < face_count; ++i)
 		kdindices[i] = unsigned(i);
 
 	KDNode* nodes = allocator.allocate<KDNode>(face_count * 2);
 	kdtreeBuild(0, nodes, face_count * 2, &triangles[0].px, sizeof(Cone) / sizeof(float), kdindices, face_count, /* leaf_size= */ 8);
+	MESHOPTIMIZER_PROFILE_END("buildMeshlets.kdtreeBuild");
 
 	// index of the vertex in the meshlet, 0xff if the vertex isn't used
 	unsigned char* used = allocator.allocate<unsigned char>(vertex_count);
@@ -509,6 +1136,12 @@ size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_ve
 
 	Cone meshlet_cone_acc = {};
 
+	MESHOPTIMIZER_PROFILE_BEGIN("buildMeshlets.emitTriangles");
+
+#if MESHOPTIMIZER_PROFILE
+	size_t kdtree_queries = 0;
+#endif
+
 	for (;;)
 	{
 		unsigned int best_triangle = ~0u;
@@ -578,6 +1211,10 @@ size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_ve
 
 			kdtreeNearest(nodes, 0, &triangles[0].px, sizeof(Cone) / sizeof(float), emitted_flags, position, index, limit);
 
+#if MESHOPTIMIZER_PROFILE
+			kdtree_queries++;
+#endif
+
 			best_triangle = index;
 		}
 
@@ -638,10 +1275,162 @@ size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_ve
 		meshlets[meshlet_offset++] = meshlet;
 	}
 
+	MESHOPTIMIZER_PROFILE_COUNTER("buildMeshlets.kdtreeQueries", kdtree_queries);
+	MESHOPTIMIZER_PROFILE_COUNTER("buildMeshlets.meshlets", meshlet_offset);
+	MESHOPTIMIZER_PROFILE_END("buildMeshlets.emitTriangles");
+	MESHOPTIMIZER_PROFILE_END("buildMeshlets");
+
 	assert(meshlet_offset <= meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles));
 	return meshlet_offset;
 }
 
+size_t meshopt_buildMeshletsParallelBound(size_t index_count, size_t max_vertices, size_t max_triangles)
+{
+	using namespace meshopt;
+
+	size_t face_count = index_count / 3;
+
+	// every partition except the first one has more than half of the partition size triangles, and may leave one extra meshlet unfilled
+	size_t partition_limit = face_count / (kMeshletPartitionSize / 2) + 1;
+
+	return meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles) + partition_limit;
+}
+
+size_t meshopt_buildMeshletsParallel(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	assert(max_vertices >= 3 && max_vertices <= kMeshletMaxVertices);
+	assert(max_triangles >= 1 && max_triangles <= kMeshletMaxTriangles);
+	assert(max_triangles % 4 == 0); // ensures the caller will compute output space properly as index data is 4b aligned
+
+	size_t face_count = index_count / 3;
+
+	// small meshes can't be split into multiple partitions so we use the serial builder which produces the same result
+	if (!dispatch || face_count <= kMeshletPartitionSize)
+		return meshopt_buildMeshlets(meshlets, meshlet_vertices, meshlet_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight);
+
+	meshopt_Allocator allocator;
+
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	// split triangles into spatially coherent partitions using triangle centroids
+	float* centroids = allocator.allocate<float>(face_count * 3);
+
+	for (size_t i = 0; i < face_count; ++i)
+	{
+		unsigned int a = indices[i * 3 + 0], b = indices[i * 3 + 1], c = indices[i * 3 + 2];
+		assert(a < vertex_count && b < vertex_count && c < vertex_count);
+
+		const float* p0 = vertex_positions + vertex_stride_float * a;
+		const float* p1 = vertex_positions + vertex_stride_float * b;
+		const float* p2 = vertex_positions + vertex_stride_float * c;
+
+		centroids[i * 3 + 0] = (p0[0] + p1[0] + p2[0]) / 3.f;
+		centroids[i * 3 + 1] = (p0[1] + p1[1] + p2[1]) / 3.f;
+		centroids[i * 3 + 2] = (p0[2] + p1[2] + p2[2]) / 3.f;
+	}
+
+	unsigned int* kdindices = allocator.allocate<unsigned int>(face_count);
+	for (size_t i = 0; i < face_count; ++i)
+		kdindices[i] = unsigned(i);
+
+	MeshletPartition* partitions = allocator.allocate<MeshletPartition>(face_count / (kMeshletPartitionSize / 2) + 1);
+	size_t partition_count = partitionTriangles(partitions, 0, centroids, 3, kdindices, 0, face_count, kMeshletPartitionSize);
+
+	// build partition-local index buffers; each partition references a compact list of vertices
+	unsigned int* partition_indices = allocator.allocate<unsigned int>(index_count);
+	unsigned int* partition_vertices = allocator.allocate<unsigned int>(index_count);
+
+	unsigned int* vertex_partition = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* vertex_local = allocator.allocate<unsigned int>(vertex_count);
+	memset(vertex_partition, -1, vertex_count * sizeof(unsigned int));
+
+	size_t index_offset = 0;
+	size_t vertex_offset = 0;
+	size_t meshlet_offset = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		MeshletPartition& partition = partitions[i];
+
+		const unsigned int* triangles = kdindices + partition.index_offset;
+		size_t partition_vertex_count = 0;
+
+		for (size_t j = 0; j < partition.index_count; ++j)
+		{
+			unsigned int v = indices[triangles[j / 3] * 3 + j % 3];
+
+			if (vertex_partition[v] != i)
+			{
+				vertex_partition[v] = unsigned(i);
+				vertex_local[v] = unsigned(partition_vertex_count);
+				partition_vertices[vertex_offset + partition_vertex_count++] = v;
+			}
+
+			partition_indices[index_offset + j] = vertex_local[v];
+		}
+
+		partition.index_offset = index_offset;
+		partition.vertex_offset = vertex_offset;
+		partition.vertex_count = partition_vertex_count;
+
+		// each partition writes its meshlets into a separate region of the output that is large enough for the worst case
+		partition.meshlet_offset = meshlet_offset;
+		partition.meshlet_count = 0;
+
+		index_offset += partition.index_count;
+		vertex_offset += partition_vertex_count;
+		meshlet_offset += meshopt_buildMeshletsBound(partition.index_count, max_vertices, max_triangles);
+	}
+
+	assert(index_offset == index_count);
+	assert(meshlet_offset <= meshopt_buildMeshletsParallelBound(index_count, max_vertices, max_triangles));
+
+	MeshletPartitionBuilder builder = {meshlets, meshlet_vertices, meshlet_triangles, partitions, partition_indices, partition_vertices, vertex_positions, vertex_positions_stride, max_vertices, max_triangles, cone_weight};
+
+	dispatch(context, buildMeshletsPartitionTask, &builder, partition_count);
+
+	// compact the meshlets and their data so that the output follows the regular layout; this moves data towards the beginning so it can be done in place
+	size_t result_count = 0;
+	size_t vertex_data = 0;
+	size_t triangle_data = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		const MeshletPartition& partition = partitions[i];
+
+		if (partition.meshlet_count == 0)
+			continue;
+
+		const meshopt_Meshlet& last = meshlets[partition.meshlet_offset + partition.meshlet_count - 1];
+		size_t vertex_size = last.vertex_offset + last.vertex_count;
+		size_t triangle_size = last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3);
+
+		memmove(meshlet_vertices + vertex_data, meshlet_vertices + partition.meshlet_offset * max_vertices, vertex_size * sizeof(unsigned int));
+		memmove(meshlet_triangles + triangle_data, meshlet_triangles + partition.meshlet_offset * max_triangles * 3, triangle_size);
+
+		for (size_t j = 0; j < partition.meshlet_count; ++j)
+		{
+			meshopt_Meshlet meshlet = meshlets[partition.meshlet_offset + j];
+
+			meshlet.vertex_offset += unsigned(vertex_data);
+			meshlet.triangle_offset += unsigned(triangle_data);
+
+			meshlets[result_count++] = meshlet;
+		}
+
+		vertex_data += vertex_size;
+		triangle_data += triangle_size;
+	}
+
+	return result_count;
+}
+
 size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, size_t vertex_count, size_t max_vertices, size_t max_triangles)
 {
 	using namespace meshopt;
@@ -681,6 +1470,87 @@ size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int* meshle
 	return meshlet_offset;
 }
 
+size_t meshopt_buildMeshletsIncremental(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, size_t meshlet_count, const unsigned int* dirty_meshlets, size_t dirty_count, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+
+	meshopt_Allocator allocator;
+
+	unsigned char* dirty = allocator.allocate<unsigned char>(meshlet_count);
+	memset(dirty, 0, meshlet_count);
+
+	for (size_t i = 0; i < dirty_count; ++i)
+	{
+		assert(dirty_meshlets[i] < meshlet_count);
+		dirty[dirty_meshlets[i]] = 1;
+	}
+
+	// when new triangles aren't provided, dirty meshlets are rebuilt from their own triangles; they need to be extracted before meshlet data is compacted
+	if (!indices)
+	{
+		index_count = 0;
+
+		for (size_t i = 0; i < meshlet_count; ++i)
+			index_count += dirty[i] ? meshlets[i].triangle_count * 3 : 0;
+
+		unsigned int* dirty_indices = allocator.allocate<unsigned int>(index_count);
+		size_t offset = 0;
+
+		for (size_t i = 0; i < meshlet_count; ++i)
+		{
+			const meshopt_Meshlet& meshlet = meshlets[i];
+
+			if (!dirty[i])
+				continue;
+
+			for (size_t j = 0; j < meshlet.triangle_count * 3; ++j)
+				dirty_indices[offset++] = meshlet_vertices[meshlet.vertex_offset + meshlet_triangles[meshlet.triangle_offset + j]];
+		}
+
+		indices = dirty_indices;
+	}
+
+	// compact remaining meshlets in order; since meshlet data is laid out in meshlet order, data only moves towards the beginning of the arrays
+	size_t result = 0;
+	size_t vertex_offset = 0;
+	size_t triangle_offset = 0;
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		meshopt_Meshlet meshlet = meshlets[i];
+
+		if (dirty[i])
+			continue;
+
+		assert(meshlet.vertex_offset >= vertex_offset && meshlet.triangle_offset >= triangle_offset);
+
+		size_t triangle_size = (meshlet.triangle_count * 3 + 3) & ~3;
+
+		memmove(&meshlet_vertices[vertex_offset], &meshlet_vertices[meshlet.vertex_offset], meshlet.vertex_count * sizeof(unsigned int));
+		memmove(&meshlet_triangles[triangle_offset], &meshlet_triangles[meshlet.triangle_offset], triangle_size);
+
+		meshlet.vertex_offset = unsigned(vertex_offset);
+		meshlet.triangle_offset = unsigned(triangle_offset);
+		meshlets[result++] = meshlet;
+
+		vertex_offset += meshlet.vertex_count;
+		triangle_offset += triangle_size;
+	}
+
+	// new meshlets are appended after the remaining ones
+	size_t count = meshopt_buildMeshlets(&meshlets[result], &meshlet_vertices[vertex_offset], &meshlet_triangles[triangle_offset], indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		meshlets[result + i].vertex_offset += unsigned(vertex_offset);
+		meshlets[result + i].triangle_offset += unsigned(triangle_offset);
+	}
+
+	return result + count;
+}
+
 meshopt_Bounds meshopt_computeClusterBounds(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
 	using namespace meshopt;
@@ -699,7 +1569,47 @@ meshopt_Bounds meshopt_computeClusterBounds(const unsigned int* indices, size_t
 	float corners[kMeshletMaxTriangles][3][3];
 	size_t triangles = 0;
 
-	for (size_t i = 0; i < index_count; i += 3)
+	size_t offset = 0;
+
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	// process 4 triangles at a time; degenerate triangles are skipped when storing the results to preserve the order of the remaining ones
+	for (; offset + 12 <= index_count; offset += 12)
+	{
+		const float* p0[4];
+		const float* p1[4];
+		const float* p2[4];
+
+		for (int k = 0; k < 4; ++k)
+		{
+			unsigned int a = indices[offset + k * 3 + 0], b = indices[offset + k * 3 + 1], c = indices[offset + k * 3 + 2];
+			assert(a < vertex_count && b < vertex_count && c < vertex_count);
+
+			p0[k] = vertex_positions + vertex_stride_float * a;
+			p1[k] = vertex_positions + vertex_stride_float * b;
+			p2[k] = vertex_positions + vertex_stride_float * c;
+		}
+
+		float tn[12], ta[4];
+		computeTriangleNormals4(tn, ta, p0, p1, p2);
+
+		for (int k = 0; k < 4; ++k)
+		{
+			// no need to include degenerate triangles - they will be invisible anyway
+			if (ta[k] == 0.f)
+				continue;
+
+			normals[triangles][0] = tn[k + 0];
+			normals[triangles][1] = tn[k + 4];
+			normals[triangles][2] = tn[k + 8];
+			memcpy(corners[triangles][0], p0[k], 3 * sizeof(float));
+			memcpy(corners[triangles][1], p1[k], 3 * sizeof(float));
+			memcpy(corners[triangles][2], p2[k], 3 * sizeof(float));
+			triangles++;
+		}
+	}
+#endif
+
+	for (size_t i = offset; i < index_count; i += 3)
 	{
 		unsigned int a = indices[i + 0], b = indices[i + 1], c = indices[i + 2];
 		assert(a < vertex_count && b < vertex_count && c < vertex_count);
@@ -854,3 +1764,28 @@ meshopt_Bounds meshopt_computeMeshletBounds(const unsigned int* meshlet_vertices
 
 	return meshopt_computeClusterBounds(indices, triangle_count * 3, vertex_positions, vertex_count, vertex_positions_stride);
 }
+
+void meshopt_computeMeshletBoundsBatch(meshopt_Bounds* bounds, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	MeshletBoundsTask task = {bounds, NULL, meshlets, meshlet_count, meshlet_vertices, meshlet_triangles, vertex_positions, vertex_count, vertex_positions_stride, {0.f, 0.f, 0.f}, 0.f};
+
+	computeMeshletBoundsBlocks(task, dispatch, context);
+}
+
+void meshopt_computeMeshletCullData(meshopt_MeshletCullData* cull_data, const meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float box_min[3], float box_size, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(box_size >= 0.f);
+
+	MeshletBoundsTask task = {NULL, cull_data, meshlets, meshlet_count, meshlet_vertices, meshlet_triangles, vertex_positions, vertex_count, vertex_positions_stride, {box_min[0], box_min[1], box_min[2]}, box_size};
+
+	computeMeshletBoundsBlocks(task, dispatch, context);
+}
@@ -0,0 +1,444 @@
+// This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
+#include "meshoptimizer.h"
+
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <string.h>
+
+// This work is based on:
+// Brian Karis, Rune Stubbe, Graham Wihlidal. Nanite: A Deep Dive. 2021
+namespace meshopt
+{
+
+// Number of clusters that are merged into a group for simplification; a group of N clusters must simplify into at most N-1 clusters
+const size_t kClusterLodGroupSize = 4;
+
+struct ClusterLodBuilder
+{
+	meshopt_ClusterLod* clusters;
+	unsigned int* cluster_vertices;
+	unsigned char* cluster_triangles;
+
+	size_t cluster_count;
+	size_t vertex_data;
+	size_t triangle_data;
+	unsigned int group_count;
+
+	const float* vertex_positions;
+	size_t vertex_count;
+	size_t vertex_positions_stride;
+
+	size_t max_vertices;
+	size_t max_triangles;
+
+	// maps each vertex to the first vertex with the same position
+	const unsigned int* position_remap;
+
+	// maps vertices to group-local indices; vertex_group identifies the group that vertex_local is valid for
+	unsigned int* vertex_local;
+	unsigned int* vertex_group;
+	unsigned int group_stamp;
+};
+
+static void mergeSphere(float* result, const float* sphere)
+{
+	float dx = sphere[0] - result[0], dy = sphere[1] - result[1], dz = sphere[2] - result[2];
+	float d = sqrtf(dx * dx + dy * dy + dz * dz);
+
+	// one sphere contains the other
+	if (d + sphere[3] <= result[3])
+		return;
+
+	if (d + result[3] <= sphere[3])
+	{
+		memcpy(result, sphere, 4 * sizeof(float));
+		return;
+	}
+
+	float r = (d + result[3] + sphere[3]) * 0.5f;
+	float t = (r - result[3]) / d;
+
+	result[0] += dx * t;
+	result[1] += dy * t;
+	result[2] += dz * t;
+	result[3] = r;
+}
+
+static void initCluster(ClusterLodBuilder& builder, meshopt_ClusterLod& cluster, unsigned int level, unsigned int refined, const float* lod_bounds, float lod_error)
+{
+	const meshopt_Meshlet& meshlet = cluster.meshlet;
+
+	cluster.bounds = meshopt_computeMeshletBounds(&builder.cluster_vertices[meshlet.vertex_offset], &builder.cluster_triangles[meshlet.triangle_offset], meshlet.triangle_count, builder.vertex_positions, builder.vertex_count, builder.vertex_positions_stride);
+
+	cluster.level = level;
+	cluster.group = ~0u;
+	cluster.refined = refined;
+
+	if (lod_bounds)
+		memcpy(cluster.lod_bounds, lod_bounds, 4 * sizeof(float));
+	else
+	{
+		memcpy(cluster.lod_bounds, cluster.bounds.center, 3 * sizeof(float));
+		cluster.lod_bounds[3] = cluster.bounds.radius;
+	}
+
+	cluster.lod_error = lod_error;
+
+	// clusters that aren't simplified further are always selected once their own error is acceptable
+	memcpy(cluster.parent_bounds, cluster.lod_bounds, 4 * sizeof(float));
+	cluster.parent_error = FLT_MAX;
+}
+
+static size_t groupClusters(unsigned int* groups, unsigned int* group_offsets, const unsigned int* pending, size_t pending_count, const ClusterLodBuilder& builder, meshopt_Allocator& allocator)
+{
+	size_t vertex_count = builder.vertex_count;
+
+	// build position => cluster adjacency; clusters are identified by their index in the pending list
+	unsigned int* counts = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* offsets = allocator.allocate<unsigned int>(vertex_count);
+	memset(counts, 0, vertex_count * sizeof(unsigned int));
+
+	size_t total = 0;
+
+	for (size_t i = 0; i < pending_count; ++i)
+	{
+		const meshopt_Meshlet& meshlet = builder.clusters[pending[i]].meshlet;
+
+		for (size_t j = 0; j < meshlet.vertex_count; ++j)
+			counts[builder.position_remap[builder.cluster_vertices[meshlet.vertex_offset + j]]]++;
+
+		total += meshlet.vertex_count;
+	}
+
+	unsigned int offset = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		offsets[i] = offset;
+		offset += counts[i];
+	}
+
+	unsigned int* data = allocator.allocate<unsigned int>(total);
+
+	for (size_t i = 0; i < pending_count; ++i)
+	{
+		const meshopt_Meshlet& meshlet = builder.clusters[pending[i]].meshlet;
+
+		for (size_t j = 0; j < meshlet.vertex_count; ++j)
+			data[offsets[builder.position_remap[builder.cluster_vertices[meshlet.vertex_offset + j]]]++] = unsigned(i);
+	}
+
+	// fix offsets that have been disturbed by the previous pass
+	for (size_t i = 0; i < vertex_count; ++i)
+		offsets[i] -= counts[i];
+
+	// greedily grow groups from clusters in order, adding the ungrouped neighbor that shares the most vertices with the group
+	unsigned int* group = allocator.allocate<unsigned int>(pending_count);
+	memset(group, -1, pending_count * sizeof(unsigned int));
+
+	unsigned int* shared = allocator.allocate<unsigned int>(pending_count);
+	memset(shared, 0, pending_count * sizeof(unsigned int));
+
+	unsigned int* touched = allocator.allocate<unsigned int>(total);
+
+	size_t group_count = 0;
+	size_t group_size = 0;
+
+	for (size_t i = 0; i < pending_count; ++i)
+	{
+		if (group[i] != ~0u)
+			continue;
+
+		group_offsets[group_count] = unsigned(group_size);
+
+		size_t member_begin = group_size;
+		groups[group_size++] = unsigned(i);
+		group[i] = unsigned(group_count);
+
+		while (group_size - member_begin < kClusterLodGroupSize)
+		{
+			size_t touched_count = 0;
+
+			for (size_t m = member_begin; m < group_size; ++m)
+			{
+				const meshopt_Meshlet& meshlet = builder.clusters[pending[groups[m]]].meshlet;
+
+				for (size_t j = 0; j < meshlet.vertex_count; ++j)
+				{
+					unsigned int v = builder.position_remap[builder.cluster_vertices[meshlet.vertex_offset + j]];
+
+					for (size_t k = 0; k < counts[v]; ++k)
+					{
+						unsigned int neighbor = data[offsets[v] + k];
+
+						if (group[neighbor] != ~0u)
+							continue;
+
+						if (shared[neighbor]++ == 0)
+							touched[touched_count++] = neighbor;
+					}
+				}
+			}
+
+			unsigned int best = ~0u;
+			unsigned int best_shared = 0;
+
+			for (size_t k = 0; k < touched_count; ++k)
+			{
+				unsigned int neighbor = touched[k];
+
+				if (shared[neighbor] > best_shared)
+				{
+					best = neighbor;
+					best_shared = shared[neighbor];
+				}
+
+				shared[neighbor] = 0;
+			}
+
+			if (best == ~0u)
+				break;
+
+			groups[group_size++] = best;
+			group[best] = unsigned(group_count);
+		}
+
+		group_count++;
+	}
+
+	assert(group_size == pending_count);
+	group_offsets[group_count] = unsigned(group_size);
+
+	return group_count;
+}
+
+static size_t simplifyGroup(ClusterLodBuilder& builder, const unsigned int* members, size_t member_count, const unsigned int* pending, unsigned int* next, size_t next_count, unsigned int level, unsigned int* group_indices, unsigned int* group_vertices, float* group_positions, meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles)
+{
+	unsigned int stamp = builder.group_stamp++;
+	size_t vertex_stride_float = builder.vertex_positions_stride / sizeof(float);
+
+	size_t index_count = 0;
+	size_t vertex_count = 0;
+
+	// gather group triangles into a compact local mesh
+	for (size_t i = 0; i < member_count; ++i)
+	{
+		const meshopt_Meshlet& meshlet = builder.clusters[pending[members[i]]].meshlet;
+
+		for (size_t j = 0; j < meshlet.triangle_count * 3; ++j)
+		{
+			unsigned int v = builder.cluster_vertices[meshlet.vertex_offset + builder.cluster_triangles[meshlet.triangle_offset + j]];
+
+			if (builder.vertex_group[v] != stamp)
+			{
+				builder.vertex_group[v] = stamp;
+				builder.vertex_local[v] = unsigned(vertex_count);
+
+				group_vertices[vertex_count] = v;
+				memcpy(&group_positions[vertex_count * 3], builder.vertex_positions + v * vertex_stride_float, 3 * sizeof(float));
+				vertex_count++;
+			}
+
+			group_indices[index_count++] = builder.vertex_local[v];
+		}
+	}
+
+	// vertices on the group border are shared with other groups, so they need to stay in place to keep the levels crack-free
+	size_t target_index_count = index_count / 6 * 3;
+	float error = 0.f;
+
+	size_t simplified = meshopt_simplify(group_indices, group_indices, index_count, group_positions, vertex_count, sizeof(float) * 3, target_index_count, 1.f, meshopt_SimplifyLockBorder, &error);
+
+	size_t meshlet_count = meshopt_buildMeshlets(meshlets, meshlet_vertices, meshlet_triangles, group_indices, simplified, group_positions, vertex_count, sizeof(float) * 3, builder.max_vertices, builder.max_triangles, 0.f);
+
+	// when simplification doesn't reduce the number of clusters, the group remains at the current level and isn't simplified further
+	if (meshlet_count >= member_count)
+		return next_count;
+
+	unsigned int group_id = builder.group_count++;
+
+	// group bounds and error must contain bounds and error of all clusters in the group to keep the selection monotonic
+	const meshopt_ClusterLod& first = builder.clusters[pending[members[0]]];
+
+	float group_bounds[4];
+	memcpy(group_bounds, first.lod_bounds, sizeof(group_bounds));
+
+	float group_error = error * meshopt_simplifyScale(group_positions, vertex_count, sizeof(float) * 3);
+
+	for (size_t i = 0; i < member_count; ++i)
+	{
+		const meshopt_ClusterLod& cluster = builder.clusters[pending[members[i]]];
+
+		mergeSphere(group_bounds, cluster.lod_bounds);
+		group_error = group_error < cluster.lod_error ? cluster.lod_error : group_error;
+	}
+
+	for (size_t i = 0; i < member_count; ++i)
+	{
+		meshopt_ClusterLod& cluster = builder.clusters[pending[members[i]]];
+
+		cluster.group = group_id;
+		memcpy(cluster.parent_bounds, group_bounds, sizeof(group_bounds));
+		cluster.parent_error = group_error;
+	}
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& meshlet = meshlets[i];
+		meshopt_ClusterLod& cluster = builder.clusters[builder.cluster_count];
+
+		cluster.meshlet = meshlet;
+		cluster.meshlet.vertex_offset = unsigned(builder.vertex_data);
+		cluster.meshlet.triangle_offset = unsigned(builder.triangle_data);
+
+		// remap group-local vertex indices back to the original vertex buffer
+		for (size_t j = 0; j < meshlet.vertex_count; ++j)
+			builder.cluster_vertices[builder.vertex_data + j] = group_vertices[meshlet_vertices[meshlet.vertex_offset + j]];
+
+		size_t triangle_size = (meshlet.triangle_count * 3 + 3) & ~3;
+		memcpy(&builder.cluster_triangles[builder.triangle_data], &meshlet_triangles[meshlet.triangle_offset], triangle_size);
+
+		builder.vertex_data += meshlet.vertex_count;
+		builder.triangle_data += triangle_size;
+
+		initCluster(builder, cluster, level + 1, group_id, group_bounds, group_error);
+
+		next[next_count++] = unsigned(builder.cluster_count++);
+	}
+
+	return next_count;
+}
+
+static size_t buildClusterLodLevel(ClusterLodBuilder& builder, const unsigned int* pending, size_t pending_count, unsigned int* next, unsigned int level)
+{
+	meshopt_Allocator allocator;
+
+	unsigned int* groups = allocator.allocate<unsigned int>(pending_count);
+	unsigned int* group_offsets = allocator.allocate<unsigned int>(pending_count + 1);
+	size_t group_count = groupClusters(groups, group_offsets, pending, pending_count, builder, allocator);
+
+	size_t max_index_count = kClusterLodGroupSize * builder.max_triangles * 3;
+	size_t max_vertex_count = kClusterLodGroupSize * builder.max_vertices;
+	size_t max_meshlets = meshopt_buildMeshletsBound(max_index_count, builder.max_vertices, builder.max_triangles);
+
+	unsigned int* group_indices = allocator.allocate<unsigned int>(max_index_count);
+	unsigned int* group_vertices = allocator.allocate<unsigned int>(max_vertex_count);
+	float* group_positions = allocator.allocate<float>(max_vertex_count * 3);
+
+	meshopt_Meshlet* meshlets = allocator.allocate<meshopt_Meshlet>(max_meshlets);
+	unsigned int* meshlet_vertices = allocator.allocate<unsigned int>(max_meshlets * builder.max_vertices);
+	unsigned char* meshlet_triangles = allocator.allocate<unsigned char>(max_meshlets * builder.max_triangles * 3);
+
+	size_t next_count = 0;
+
+	for (size_t i = 0; i < group_count; ++i)
+	{
+		const unsigned int* members = &groups[group_offsets[i]];
+		size_t member_count = group_offsets[i + 1] - group_offsets[i];
+
+		// a single cluster can't be simplified into fewer clusters
+		if (member_count < 2)
+			continue;
+
+		next_count = simplifyGroup(builder, members, member_count, pending, next, next_count, level, group_indices, group_vertices, group_positions, meshlets, meshlet_vertices, meshlet_triangles);
+	}
+
+	return next_count;
+}
+
+} // namespace meshopt
+
+size_t meshopt_buildClusterLodBound(size_t index_count, size_t max_vertices, size_t max_triangles)
+{
+	using namespace meshopt;
+
+	// each accepted group of up to 4 clusters produces at most 3 clusters, so every level has at most 3/4 of the clusters of the previous level
+	return meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles) * kClusterLodGroupSize;
+}
+
+size_t meshopt_buildClusterLod(meshopt_ClusterLod* clusters, unsigned int* cluster_vertices, unsigned char* cluster_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	assert(max_vertices >= 3 && max_vertices <= 255);
+	assert(max_triangles >= 1 && max_triangles <= 512);
+	assert(max_triangles % 4 == 0);
+
+	meshopt_Allocator allocator;
+
+	// vertices with the same position need to be treated as shared between clusters, even if they have different attributes
+	unsigned int* shadow = allocator.allocate<unsigned int>(index_count);
+	meshopt_generateShadowIndexBuffer(shadow, indices, index_count, vertex_positions, vertex_count, sizeof(float) * 3, vertex_positions_stride);
+
+	unsigned int* position_remap = allocator.allocate<unsigned int>(vertex_count);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		position_remap[i] = unsigned(i);
+
+	for (size_t i = 0; i < index_count; ++i)
+		position_remap[indices[i]] = shadow[i];
+
+	// the first level is built directly from the input mesh
+	size_t max_meshlets = meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles);
+	meshopt_Meshlet* meshlets = allocator.allocate<meshopt_Meshlet>(max_meshlets);
+
+	size_t meshlet_count = meshopt_buildMeshlets(meshlets, cluster_vertices, cluster_triangles, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, 0.f);
+
+	ClusterLodBuilder builder = {};
+	builder.clusters = clusters;
+	builder.cluster_vertices = cluster_vertices;
+	builder.cluster_triangles = cluster_triangles;
+	builder.vertex_positions = vertex_positions;
+	builder.vertex_count = vertex_count;
+	builder.vertex_positions_stride = vertex_positions_stride;
+	builder.max_vertices = max_vertices;
+	builder.max_triangles = max_triangles;
+	builder.position_remap = position_remap;
+
+	size_t cluster_limit = meshopt_buildClusterLodBound(index_count, max_vertices, max_triangles);
+
+	unsigned int* pending = allocator.allocate<unsigned int>(cluster_limit);
+	unsigned int* next = allocator.allocate<unsigned int>(cluster_limit);
+
+	for (size_t i = 0; i < meshlet_count; ++i)
+	{
+		clusters[i].meshlet = meshlets[i];
+		initCluster(builder, clusters[i], 0, ~0u, NULL, 0.f);
+
+		pending[i] = unsigned(i);
+	}
+
+	if (meshlet_count)
+	{
+		const meshopt_Meshlet& last = meshlets[meshlet_count - 1];
+
+		builder.vertex_data = last.vertex_offset + last.vertex_count;
+		builder.triangle_data = last.triangle_offset + ((last.triangle_count * 3 + 3) & ~3);
+	}
+
+	builder.cluster_count = meshlet_count;
+
+	builder.vertex_local = allocator.allocate<unsigned int>(vertex_count);
+	builder.vertex_group = allocator.allocate<unsigned int>(vertex_count);
+	memset(builder.vertex_group, -1, vertex_count * sizeof(unsigned int));
+
+	size_t pending_count = meshlet_count;
+
+	// every level groups the clusters of the previous level and simplifies each group; clusters that can't be simplified further stay in the hierarchy as terminal nodes
+	for (unsigned int level = 0; pending_count > 1; ++level)
+	{
+		pending_count = buildClusterLodLevel(builder, pending, pending_count, next, level);
+
+		unsigned int* temp = pending;
+		pending = next;
+		next = temp;
+	}
+
+	assert(builder.cluster_count <= cluster_limit);
+	return builder.cluster_count;
+}
@@ -4,6 +4,47 @@
 #include <assert.h>
 #include <string.h>
 
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// SSE2 is always available on x64 and can be enabled through compiler settings on x86
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE
+#endif
+
+// GCC/clang define these when NEON support is available
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SIMD_NEON
+#endif
+
+// On MSVC, we assume that ARM builds always target NEON-capable devices
+#if !defined(SIMD_NEON) && defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+#define SIMD_NEON
+#endif
+
+// When targeting Wasm SIMD we can't use runtime cpuid checks so we unconditionally enable SIMD
+#if defined(__wasm_simd128__)
+#define SIMD_WASM
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef SIMD_NEON
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef SIMD_WASM
+#include <wasm_simd128.h>
+#endif
+
 // This work is based on:
 // Fabian Giesen. Simple lossless index buffer compression & follow-up. 2013
 // Conor Stokes. Vertex Cache Optimised Index Buffer Compression. 2014
@@ -15,9 +56,21 @@ const unsigned char kSequenceHeader = 0xd0;
 
 static int gEncodeIndexVersion = 0;
 
+// version 2 splits the triangles into blocks that are encoded independently; each block starts with empty FIFOs, so blocks can be decoded in parallel
+const size_t kIndexBlockTriangles = 4096;
+
+// each block header contains the offset of block data from the start of the buffer and the value of next at the start of the block
+const size_t kIndexBlockHeaderSize = 8;
+
 typedef unsigned int VertexFifo[16];
 typedef unsigned int EdgeFifo[16][2];
 
+// decoder stores FIFOs as sliding windows into a larger buffer to avoid wraparound on reads and writes; the last 16 entries are moved to the front when the window fills up
+const size_t kDecodeWindowSize = 256;
+
+typedef unsigned int VertexWindow[kDecodeWindowSize + 16];
+typedef unsigned int EdgeWindow[kDecodeWindowSize + 16][2];
+
 static const unsigned int kTriangleIndexOrder[3][3] = {
     {0, 1, 2},
     {1, 2, 0},
@@ -143,20 +196,554 @@ static int getCodeAuxIndex(unsigned char v, const unsigned char* table)
 	return -1;
 }
 
-static void writeTriangle(void* destination, size_t offset, size_t index_size, unsigned int a, unsigned int b, unsigned int c)
+static void pushVertexWindow(VertexWindow window, unsigned int v, size_t& offset, int cond = 1)
+{
+	window[offset] = v;
+	offset += cond;
+}
+
+static void pushEdgeWindow(EdgeWindow window, unsigned int a, unsigned int b, size_t& offset)
 {
-	if (index_size == 2)
+	window[offset][0] = a;
+	window[offset][1] = b;
+	offset += 1;
+}
+
+static void pushEdgeWindow2(EdgeWindow window, unsigned int a0, unsigned int b0, unsigned int a1, unsigned int b1, size_t& offset)
+{
+	// two adjacent edges can be written with a single 16-byte store since the window doesn't wrap around
+#if defined(SIMD_SSE)
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(window[offset]), _mm_setr_epi32(int(a0), int(b0), int(a1), int(b1)));
+#elif defined(SIMD_NEON)
+	uint32x4_t e = vdupq_n_u32(a0);
+	e = vsetq_lane_u32(b0, e, 1);
+	e = vsetq_lane_u32(a1, e, 2);
+	e = vsetq_lane_u32(b1, e, 3);
+	vst1q_u32(window[offset], e);
+#elif defined(SIMD_WASM)
+	wasm_v128_store(window[offset], wasm_i32x4_make(int(a0), int(b0), int(a1), int(b1)));
+#else
+	window[offset][0] = a0;
+	window[offset][1] = b0;
+	window[offset + 1][0] = a1;
+	window[offset + 1][1] = b1;
+#endif
+
+	offset += 2;
+}
+
+static void rewindWindows(EdgeWindow edgewindow, size_t& edgeoffset, VertexWindow vertexwindow, size_t& vertexoffset)
+{
+	// each triangle pushes at most 3 entries into each window so we need to keep a small gap at the end
+	if (edgeoffset > kDecodeWindowSize)
+	{
+		memcpy(edgewindow, edgewindow + edgeoffset - 16, 16 * sizeof(edgewindow[0]));
+		edgeoffset = 16;
+	}
+
+	if (vertexoffset > kDecodeWindowSize)
 	{
-		static_cast<unsigned short*>(destination)[offset + 0] = (unsigned short)(a);
-		static_cast<unsigned short*>(destination)[offset + 1] = (unsigned short)(b);
-		static_cast<unsigned short*>(destination)[offset + 2] = (unsigned short)(c);
+		memcpy(vertexwindow, vertexwindow + vertexoffset - 16, 16 * sizeof(vertexwindow[0]));
+		vertexoffset = 16;
 	}
+}
+
+template <typename T>
+static void writeTriangle(T* destination, size_t offset, unsigned int a, unsigned int b, unsigned int c)
+{
+	destination[offset + 0] = T(a);
+	destination[offset + 1] = T(b);
+	destination[offset + 2] = T(c);
+}
+
+template <typename T>
+static const unsigned char* decodeIndexBlock(T* destination, size_t index_count, int version, const unsigned char* code, const unsigned char* data, const unsigned char* data_safe_end, unsigned int next, unsigned int last)
+{
+	// windows start with 16 entries of FIFO history, which is initially empty
+	EdgeWindow edgefifo;
+	memset(edgefifo, -1, 16 * sizeof(edgefifo[0]));
+
+	VertexWindow vertexfifo;
+	memset(vertexfifo, -1, 16 * sizeof(vertexfifo[0]));
+
+	size_t edgefifooffset = 16;
+	size_t vertexfifooffset = 16;
+
+	int fecmax = version >= 1 ? 13 : 15;
+
+	// since we store 16-byte codeaux table at the end, triangle data has to begin before data_safe_end
+	const unsigned char* codeaux_table = data_safe_end;
+
+	for (size_t i = 0; i < index_count; i += 3)
+	{
+		// make sure we have enough data to read for a triangle
+		// each triangle reads at most 16 bytes of data: 1b for codeaux and 5b for each free index
+		// after this we can be sure we can read without extra bounds checks
+		if (data > data_safe_end)
+			return 0;
+
+		rewindWindows(edgefifo, edgefifooffset, vertexfifo, vertexfifooffset);
+
+		unsigned char codetri = *code++;
+
+		if (codetri < 0xf0)
+		{
+			int fe = codetri >> 4;
+
+			// fifo reads are relative to the end of the window
+			unsigned int a = edgefifo[edgefifooffset - 1 - fe][0];
+			unsigned int b = edgefifo[edgefifooffset - 1 - fe][1];
+
+			int fec = codetri & 15;
+
+			// note: this is the most common path in the entire decoder
+			// inside this if we try to stay branchless (by using cmov/etc.) since these aren't predictable
+			if (fec < fecmax)
+			{
+				// fifo reads are relative to the end of the window
+				unsigned int cf = vertexfifo[vertexfifooffset - 1 - fec];
+				unsigned int c = (fec == 0) ? next : cf;
+
+				int fec0 = fec == 0;
+				next += fec0;
+
+				// output triangle
+				writeTriangle(destination, i, a, b, c);
+
+				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+				pushVertexWindow(vertexfifo, c, vertexfifooffset, fec0);
+
+				pushEdgeWindow2(edgefifo, c, b, a, c, edgefifooffset);
+			}
+			else
+			{
+				unsigned int c = 0;
+
+				// fec - (fec ^ 3) decodes 13, 14 into -1, 1
+				// note that we need to update the last index since free indices are delta-encoded
+				last = c = (fec != 15) ? last + (fec - (fec ^ 3)) : decodeIndex(data, last);
+
+				// output triangle
+				writeTriangle(destination, i, a, b, c);
+
+				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+				pushVertexWindow(vertexfifo, c, vertexfifooffset);
+
+				pushEdgeWindow2(edgefifo, c, b, a, c, edgefifooffset);
+			}
+		}
+		else
+		{
+			// fast path: read codeaux from the table
+			if (codetri < 0xfe)
+			{
+				unsigned char codeaux = codeaux_table[codetri & 15];
+
+				// note: table can't contain feb/fec=15
+				int feb = codeaux >> 4;
+				int fec = codeaux & 15;
+
+				// fifo reads are relative to the end of the window
+				// also note that we increment next for all three vertices before decoding indices - this matches encoder behavior
+				unsigned int a = next++;
+
+				unsigned int bf = vertexfifo[vertexfifooffset - feb];
+				unsigned int b = (feb == 0) ? next : bf;
+
+				int feb0 = feb == 0;
+				next += feb0;
+
+				unsigned int cf = vertexfifo[vertexfifooffset - fec];
+				unsigned int c = (fec == 0) ? next : cf;
+
+				int fec0 = fec == 0;
+				next += fec0;
+
+				// output triangle
+				writeTriangle(destination, i, a, b, c);
+
+				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+				pushVertexWindow(vertexfifo, a, vertexfifooffset);
+				pushVertexWindow(vertexfifo, b, vertexfifooffset, feb0);
+				pushVertexWindow(vertexfifo, c, vertexfifooffset, fec0);
+
+				pushEdgeWindow2(edgefifo, b, a, c, b, edgefifooffset);
+				pushEdgeWindow(edgefifo, a, c, edgefifooffset);
+			}
+			else
+			{
+				// slow path: read a full byte for codeaux instead of using a table lookup
+				unsigned char codeaux = *data++;
+
+				int fea = codetri == 0xfe ? 0 : 15;
+				int feb = codeaux >> 4;
+				int fec = codeaux & 15;
+
+				// reset: codeaux is 0 but encoded as not-a-table
+				if (codeaux == 0)
+					next = 0;
+
+				// fifo reads are relative to the end of the window
+				// also note that we increment next for all three vertices before decoding indices - this matches encoder behavior
+				unsigned int a = (fea == 0) ? next++ : 0;
+				unsigned int b = (feb == 0) ? next++ : vertexfifo[vertexfifooffset - feb];
+				unsigned int c = (fec == 0) ? next++ : vertexfifo[vertexfifooffset - fec];
+
+				// note that we need to update the last index since free indices are delta-encoded
+				if (fea == 15)
+					last = a = decodeIndex(data, last);
+
+				if (feb == 15)
+					last = b = decodeIndex(data, last);
+
+				if (fec == 15)
+					last = c = decodeIndex(data, last);
+
+				// output triangle
+				writeTriangle(destination, i, a, b, c);
+
+				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+				pushVertexWindow(vertexfifo, a, vertexfifooffset);
+				pushVertexWindow(vertexfifo, b, vertexfifooffset, (feb == 0) | (feb == 15));
+				pushVertexWindow(vertexfifo, c, vertexfifooffset, (fec == 0) | (fec == 15));
+
+				pushEdgeWindow2(edgefifo, b, a, c, b, edgefifooffset);
+				pushEdgeWindow(edgefifo, a, c, edgefifooffset);
+			}
+		}
+	}
+
+	return data;
+}
+
+template <typename T>
+static int decodeIndexBuffer(T* destination, size_t index_count, int version, const unsigned char* buffer, size_t buffer_size)
+{
+	const unsigned char* code = buffer + 1;
+	const unsigned char* data_safe_end = buffer + buffer_size - 16;
+
+	const unsigned char* data = decodeIndexBlock(destination, index_count, version, code, code + index_count / 3, data_safe_end, 0, 0);
+	if (!data)
+		return -2;
+
+	// we should've read all data bytes and stopped at the boundary between data and codeaux table
+	if (data != data_safe_end)
+		return -3;
+
+	return 0;
+}
+
+static size_t getIndexBlockCount(size_t index_count)
+{
+	return (index_count / 3 + kIndexBlockTriangles - 1) / kIndexBlockTriangles;
+}
+
+static void writeIndexBlockHeader(unsigned char* data, size_t offset, unsigned int next)
+{
+	for (int k = 0; k < 4; ++k)
+		data[k] = (unsigned char)(offset >> (k * 8));
+
+	for (int k = 0; k < 4; ++k)
+		data[4 + k] = (unsigned char)(next >> (k * 8));
+}
+
+static unsigned int readIndexBlockWord(const unsigned char* data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (unsigned(data[3]) << 24);
+}
+
+static bool getIndexBlockData(const unsigned char* buffer, size_t buffer_size, size_t index_count, size_t block_count, size_t block, size_t& data_begin, size_t& data_end, unsigned int& next)
+{
+	size_t data_first = 1 + block_count * kIndexBlockHeaderSize + index_count / 3;
+	size_t data_last = buffer_size - 16;
+
+	const unsigned char* header = buffer + 1 + block * kIndexBlockHeaderSize;
+
+	// block data must be contiguous: first block starts after the codes and last block ends at the codeaux table
+	data_begin = readIndexBlockWord(header);
+	data_end = (block + 1 < block_count) ? readIndexBlockWord(header + kIndexBlockHeaderSize) : data_last;
+	next = readIndexBlockWord(header + 4);
+
+	if (data_begin < data_first || data_begin > data_end || data_end > data_last)
+		return false;
+
+	if (block == 0 && (data_begin != data_first || next != 0))
+		return false;
+
+	return true;
+}
+
+struct IndexBlockDecoder
+{
+	void* destination;
+	size_t index_count;
+	size_t index_size;
+
+	const unsigned char* buffer;
+	size_t buffer_size;
+
+	size_t range_begin;
+	size_t range_end;
+
+	size_t block_count;
+	size_t block_first;
+	int* results;
+};
+
+template <typename T>
+static int decodeIndexBlockAt(const IndexBlockDecoder& decoder, size_t block)
+{
+	const unsigned char* buffer = decoder.buffer;
+	size_t header_size = 1 + decoder.block_count * kIndexBlockHeaderSize;
+	size_t data_last = decoder.buffer_size - 16;
+
+	size_t data_begin, data_end;
+	unsigned int next;
+	if (!getIndexBlockData(buffer, decoder.buffer_size, decoder.index_count, decoder.block_count, block, data_begin, data_end, next))
+		return -2;
+
+	size_t index_offset = block * kIndexBlockTriangles * 3;
+	size_t block_size = (index_offset + kIndexBlockTriangles * 3 < decoder.index_count) ? kIndexBlockTriangles * 3 : decoder.index_count - index_offset;
+	const unsigned char* code = buffer + header_size + index_offset / 3;
+
+	// blocks that are only partially covered by the range are decoded into a temporary buffer
+	size_t range_begin = decoder.range_begin > index_offset ? decoder.range_begin - index_offset : 0;
+	size_t range_end = decoder.range_end < index_offset + block_size ? decoder.range_end - index_offset : block_size;
+	assert(range_begin < range_end);
+
+	T* destination = static_cast<T*>(decoder.destination) + (index_offset + range_begin - decoder.range_begin);
+
+	meshopt_Allocator allocator;
+	T* target = (range_begin == 0 && range_end == block_size) ? destination : allocator.allocate<T>(block_size);
+
+	// each block starts with empty FIFOs; next is stored in the block header and last restarts from next
+	const unsigned char* data = decodeIndexBlock(target, block_size, 2, code, buffer + data_begin, buffer + data_last, next, next);
+	if (!data)
+		return -2;
+
+	if (data != buffer + data_end)
+		return -3;
+
+	if (target != destination)
+		memcpy(destination, target + range_begin, (range_end - range_begin) * sizeof(T));
+
+	return 0;
+}
+
+static int decodeIndexBlockAt(const IndexBlockDecoder& decoder, size_t block)
+{
+	if (decoder.index_size == 2)
+		return decodeIndexBlockAt<unsigned short>(decoder, block);
 	else
+		return decodeIndexBlockAt<unsigned int>(decoder, block);
+}
+
+static void decodeIndexBlockTask(void* context, size_t index)
+{
+	const IndexBlockDecoder& decoder = *static_cast<const IndexBlockDecoder*>(context);
+
+	decoder.results[index] = decodeIndexBlockAt(decoder, decoder.block_first + index);
+}
+
+static const unsigned char* skipVByte(const unsigned char* data)
+{
+	// matches decodeVByte: lead byte followed by up to 4 extra bytes, stopping after the first byte without the continuation bit
+	if (*data++ < 128)
+		return data;
+
+	for (int i = 0; i < 4; ++i)
+		if (*data++ < 128)
+			break;
+
+	return data;
+}
+
+// walks the same structure as decodeIndexBlock and performs the same bounds checks; since FIFO contents don't affect the data size, only the codes need to be parsed
+static const unsigned char* validateIndexBlock(size_t index_count, const unsigned char* code, const unsigned char* data, const unsigned char* data_safe_end)
+{
+	for (size_t i = 0; i < index_count; i += 3)
+	{
+		if (data > data_safe_end)
+			return 0;
+
+		unsigned char codetri = *code++;
+
+		if (codetri < 0xf0)
+		{
+			// only fec=15 reads a free index; 13 and 14 are either FIFO references (version 0) or deltas from the last index
+			if ((codetri & 15) == 15)
+				data = skipVByte(data);
+		}
+		else if (codetri >= 0xfe)
+		{
+			unsigned char codeaux = *data++;
+
+			if (codetri == 0xff)
+				data = skipVByte(data);
+
+			if ((codeaux >> 4) == 15)
+				data = skipVByte(data);
+
+			if ((codeaux & 15) == 15)
+				data = skipVByte(data);
+		}
+	}
+
+	return data;
+}
+
+static int validateIndexBuffer(size_t index_count, const unsigned char* buffer, size_t buffer_size)
+{
+	assert(index_count % 3 == 0);
+
+	// the minimum valid encoding is header, 1 byte per triangle and a 16-byte codeaux table
+	if (buffer_size < 1 + index_count / 3 + 16)
+		return -2;
+
+	if ((buffer[0] & 0xf0) != kIndexHeader)
+		return -1;
+
+	int version = buffer[0] & 0x0f;
+	if (version > 2)
+		return -1;
+
+	const unsigned char* data_safe_end = buffer + buffer_size - 16;
+
+	if (version < 2)
+	{
+		const unsigned char* code = buffer + 1;
+
+		const unsigned char* data = validateIndexBlock(index_count, code, code + index_count / 3, data_safe_end);
+		if (!data)
+			return -2;
+
+		return (data == data_safe_end) ? 0 : -3;
+	}
+
+	size_t block_count = getIndexBlockCount(index_count);
+	size_t header_size = 1 + block_count * kIndexBlockHeaderSize;
+
+	if (buffer_size < header_size + index_count / 3 + 16)
+		return -2;
+
+	if (block_count == 0)
+		return (buffer_size == 1 + 16) ? 0 : -3;
+
+	for (size_t i = 0; i < block_count; ++i)
+	{
+		size_t data_begin, data_end;
+		unsigned int next;
+		if (!getIndexBlockData(buffer, buffer_size, index_count, block_count, i, data_begin, data_end, next))
+			return -2;
+
+		size_t index_offset = i * kIndexBlockTriangles * 3;
+		size_t block_size = (index_offset + kIndexBlockTriangles * 3 < index_count) ? kIndexBlockTriangles * 3 : index_count - index_offset;
+
+		const unsigned char* data = validateIndexBlock(block_size, buffer + header_size + index_offset / 3, buffer + data_begin, data_safe_end);
+		if (!data)
+			return -2;
+
+		if (data != buffer + data_end)
+			return -3;
+	}
+
+	return 0;
+}
+
+static int decodeIndexBuffer(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size, size_t range_begin, size_t range_end, meshopt_Dispatch dispatch, void* context)
+{
+	assert(index_count % 3 == 0);
+	assert(index_size == 2 || index_size == 4);
+	assert(range_begin % 3 == 0 && range_end % 3 == 0);
+	assert(range_begin <= range_end && range_end <= index_count);
+
+	// the minimum valid encoding is header, 1 byte per triangle and a 16-byte codeaux table
+	if (buffer_size < 1 + index_count / 3 + 16)
+		return -2;
+
+	if ((buffer[0] & 0xf0) != kIndexHeader)
+		return -1;
+
+	int version = buffer[0] & 0x0f;
+	if (version > 2)
+		return -1;
+
+	if (version < 2)
+	{
+		// earlier versions need to decode the entire stream up to the end of the range
+		if (range_begin == 0 && range_end == index_count)
+		{
+			if (index_size == 2)
+				return decodeIndexBuffer(static_cast<unsigned short*>(destination), index_count, version, buffer, buffer_size);
+			else
+				return decodeIndexBuffer(static_cast<unsigned int*>(destination), index_count, version, buffer, buffer_size);
+		}
+
+		meshopt_Allocator allocator;
+		unsigned int* indices = allocator.allocate<unsigned int>(range_end);
+
+		const unsigned char* code = buffer + 1;
+		if (!decodeIndexBlock(indices, range_end, version, code, code + index_count / 3, buffer + buffer_size - 16, 0, 0))
+			return -2;
+
+		for (size_t i = range_begin; i < range_end; ++i)
+		{
+			if (index_size == 2)
+				static_cast<unsigned short*>(destination)[i - range_begin] = (unsigned short)(indices[i]);
+			else
+				static_cast<unsigned int*>(destination)[i - range_begin] = indices[i];
+		}
+
+		return 0;
+	}
+
+	size_t block_count = getIndexBlockCount(index_count);
+
+	if (buffer_size < 1 + block_count * kIndexBlockHeaderSize + index_count / 3 + 16)
+		return -2;
+
+	if (block_count == 0)
+		return (buffer_size == 1 + 16) ? 0 : -3;
+
+	if (range_begin == range_end)
+		return 0;
+
+	IndexBlockDecoder decoder = {};
+	decoder.destination = destination;
+	decoder.index_count = index_count;
+	decoder.index_size = index_size;
+	decoder.buffer = buffer;
+	decoder.buffer_size = buffer_size;
+	decoder.range_begin = range_begin;
+	decoder.range_end = range_end;
+	decoder.block_count = block_count;
+
+	// only blocks that intersect the range need to be decoded
+	size_t block_begin = range_begin / 3 / kIndexBlockTriangles;
+	size_t block_end = (range_end / 3 + kIndexBlockTriangles - 1) / kIndexBlockTriangles;
+
+	if (!dispatch || block_end - block_begin == 1)
 	{
-		static_cast<unsigned int*>(destination)[offset + 0] = a;
-		static_cast<unsigned int*>(destination)[offset + 1] = b;
-		static_cast<unsigned int*>(destination)[offset + 2] = c;
+		for (size_t i = block_begin; i < block_end; ++i)
+			if (int result = decodeIndexBlockAt(decoder, i))
+				return result;
+
+		return 0;
 	}
+
+	meshopt_Allocator allocator;
+
+	decoder.block_first = block_begin;
+	decoder.results = allocator.allocate<int>(block_end - block_begin);
+
+	dispatch(context, decodeIndexBlockTask, &decoder, block_end - block_begin);
+
+	// report the error from the first failing block to make the result independent of scheduling
+	for (size_t i = 0; i < block_end - block_begin; ++i)
+		if (decoder.results[i])
+			return decoder.results[i];
+
+	return 0;
 }
 
 } // namespace meshopt
@@ -167,12 +754,16 @@ size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, cons
 
 	assert(index_count % 3 == 0);
 
+	int version = gEncodeIndexVersion;
+
+	// version 2 stores a header for each block before triangle codes
+	size_t block_count = version >= 2 ? getIndexBlockCount(index_count) : 0;
+	size_t header_size = 1 + block_count * kIndexBlockHeaderSize;
+
 	// the minimum valid encoding is header, 1 byte per triangle and a 16-byte codeaux table
-	if (buffer_size < 1 + index_count / 3 + 16)
+	if (buffer_size < header_size + index_count / 3 + 16)
 		return 0;
 
-	int version = gEncodeIndexVersion;
-
 	buffer[0] = (unsigned char)(kIndexHeader | version);
 
 	EdgeFifo edgefifo;
@@ -187,7 +778,7 @@ size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, cons
 	unsigned int next = 0;
 	unsigned int last = 0;
 
-	unsigned char* code = buffer + 1;
+	unsigned char* code = buffer + header_size;
 	unsigned char* data = code + index_count / 3;
 	unsigned char* data_safe_end = buffer + buffer_size - 16;
 
@@ -205,6 +796,20 @@ size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, cons
 		if (data > data_safe_end)
 			return 0;
 
+		if (version >= 2 && i % (kIndexBlockTriangles * 3) == 0)
+		{
+			writeIndexBlockHeader(buffer + 1 + i / 3 / kIndexBlockTriangles * kIndexBlockHeaderSize, data - buffer, next);
+
+			// FIFO state is reset at block boundaries; this must match decodeIndexBlockAt
+			memset(edgefifo, -1, sizeof(edgefifo));
+			memset(vertexfifo, -1, sizeof(vertexfifo));
+
+			edgefifooffset = 0;
+			vertexfifooffset = 0;
+
+			last = next;
+		}
+
 		int fer = getEdgeFifo(edgefifo, indices[i + 0], indices[i + 1], indices[i + 2], edgefifooffset);
 
 		if (fer >= 0 && (fer >> 2) < 15)
@@ -330,7 +935,7 @@ size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, cons
 	// since we encode restarts as codeaux without a table reference, we need to make sure 00 is encoded as a table reference
 	assert(codeaux_table[0] == 0);
 
-	assert(data >= buffer + index_count / 3 + 16);
+	assert(data >= buffer + header_size + index_count / 3 + 16);
 	assert(data <= buffer + buffer_size);
 
 	return data - buffer;
@@ -349,201 +954,39 @@ size_t meshopt_encodeIndexBufferBound(size_t index_count, size_t vertex_count)
 	// worst-case encoding is 2 header bytes + 3 varint-7 encoded index deltas
 	unsigned int vertex_groups = (vertex_bits + 1 + 6) / 7;
 
-	return 1 + (index_count / 3) * (2 + 3 * vertex_groups) + 16;
+	// version 2 adds a header for each block
+	size_t block_count = meshopt::getIndexBlockCount(index_count);
+
+	return 1 + block_count * meshopt::kIndexBlockHeaderSize + (index_count / 3) * (2 + 3 * vertex_groups) + 16;
 }
 
 void meshopt_encodeIndexVersion(int version)
 {
-	assert(unsigned(version) <= 1);
+	assert(unsigned(version) <= 2);
 
 	meshopt::gEncodeIndexVersion = version;
 }
 
 int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size)
 {
-	using namespace meshopt;
-
-	assert(index_count % 3 == 0);
-	assert(index_size == 2 || index_size == 4);
-
-	// the minimum valid encoding is header, 1 byte per triangle and a 16-byte codeaux table
-	if (buffer_size < 1 + index_count / 3 + 16)
-		return -2;
-
-	if ((buffer[0] & 0xf0) != kIndexHeader)
-		return -1;
-
-	int version = buffer[0] & 0x0f;
-	if (version > 1)
-		return -1;
-
-	EdgeFifo edgefifo;
-	memset(edgefifo, -1, sizeof(edgefifo));
-
-	VertexFifo vertexfifo;
-	memset(vertexfifo, -1, sizeof(vertexfifo));
-
-	size_t edgefifooffset = 0;
-	size_t vertexfifooffset = 0;
-
-	unsigned int next = 0;
-	unsigned int last = 0;
-
-	int fecmax = version >= 1 ? 13 : 15;
-
-	// since we store 16-byte codeaux table at the end, triangle data has to begin before data_safe_end
-	const unsigned char* code = buffer + 1;
-	const unsigned char* data = code + index_count / 3;
-	const unsigned char* data_safe_end = buffer + buffer_size - 16;
-
-	const unsigned char* codeaux_table = data_safe_end;
-
-	for (size_t i = 0; i < index_count; i += 3)
-	{
-		// make sure we have enough data to read for a triangle
-		// each triangle reads at most 16 bytes of data: 1b for codeaux and 5b for each free index
-		// after this we can be sure we can read without extra bounds checks
-		if (data > data_safe_end)
-			return -2;
-
-		unsigned char codetri = *code++;
-
-		if (codetri < 0xf0)
-		{
-			int fe = codetri >> 4;
-
-			// fifo reads are wrapped around 16 entry buffer
-			unsigned int a = edgefifo[(edgefifooffset - 1 - fe) & 15][0];
-			unsigned int b = edgefifo[(edgefifooffset - 1 - fe) & 15][1];
-
-			int fec = codetri & 15;
-
-			// note: this is the most common path in the entire decoder
-			// inside this if we try to stay branchless (by using cmov/etc.) since these aren't predictable
-			if (fec < fecmax)
-			{
-				// fifo reads are wrapped around 16 entry buffer
-				unsigned int cf = vertexfifo[(vertexfifooffset - 1 - fec) & 15];
-				unsigned int c = (fec == 0) ? next : cf;
-
-				int fec0 = fec == 0;
-				next += fec0;
-
-				// output triangle
-				writeTriangle(destination, i, index_size, a, b, c);
-
-				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-				pushVertexFifo(vertexfifo, c, vertexfifooffset, fec0);
-
-				pushEdgeFifo(edgefifo, c, b, edgefifooffset);
-				pushEdgeFifo(edgefifo, a, c, edgefifooffset);
-			}
-			else
-			{
-				unsigned int c = 0;
-
-				// fec - (fec ^ 3) decodes 13, 14 into -1, 1
-				// note that we need to update the last index since free indices are delta-encoded
-				last = c = (fec != 15) ? last + (fec - (fec ^ 3)) : decodeIndex(data, last);
-
-				// output triangle
-				writeTriangle(destination, i, index_size, a, b, c);
-
-				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-				pushVertexFifo(vertexfifo, c, vertexfifooffset);
-
-				pushEdgeFifo(edgefifo, c, b, edgefifooffset);
-				pushEdgeFifo(edgefifo, a, c, edgefifooffset);
-			}
-		}
-		else
-		{
-			// fast path: read codeaux from the table
-			if (codetri < 0xfe)
-			{
-				unsigned char codeaux = codeaux_table[codetri & 15];
-
-				// note: table can't contain feb/fec=15
-				int feb = codeaux >> 4;
-				int fec = codeaux & 15;
-
-				// fifo reads are wrapped around 16 entry buffer
-				// also note that we increment next for all three vertices before decoding indices - this matches encoder behavior
-				unsigned int a = next++;
-
-				unsigned int bf = vertexfifo[(vertexfifooffset - feb) & 15];
-				unsigned int b = (feb == 0) ? next : bf;
-
-				int feb0 = feb == 0;
-				next += feb0;
-
-				unsigned int cf = vertexfifo[(vertexfifooffset - fec) & 15];
-				unsigned int c = (fec == 0) ? next : cf;
-
-				int fec0 = fec == 0;
-				next += fec0;
-
-				// output triangle
-				writeTriangle(destination, i, index_size, a, b, c);
-
-				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-				pushVertexFifo(vertexfifo, a, vertexfifooffset);
-				pushVertexFifo(vertexfifo, b, vertexfifooffset, feb0);
-				pushVertexFifo(vertexfifo, c, vertexfifooffset, fec0);
-
-				pushEdgeFifo(edgefifo, b, a, edgefifooffset);
-				pushEdgeFifo(edgefifo, c, b, edgefifooffset);
-				pushEdgeFifo(edgefifo, a, c, edgefifooffset);
-			}
-			else
-			{
-				// slow path: read a full byte for codeaux instead of using a table lookup
-				unsigned char codeaux = *data++;
-
-				int fea = codetri == 0xfe ? 0 : 15;
-				int feb = codeaux >> 4;
-				int fec = codeaux & 15;
-
-				// reset: codeaux is 0 but encoded as not-a-table
-				if (codeaux == 0)
-					next = 0;
-
-				// fifo reads are wrapped around 16 entry buffer
-				// also note that we increment next for all three vertices before decoding indices - this matches encoder behavior
-				unsigned int a = (fea == 0) ? next++ : 0;
-				unsigned int b = (feb == 0) ? next++ : vertexfifo[(vertexfifooffset - feb) & 15];
-				unsigned int c = (fec == 0) ? next++ : vertexfifo[(vertexfifooffset - fec) & 15];
-
-				// note that we need to update the last index since free indices are delta-encoded
-				if (fea == 15)
-					last = a = decodeIndex(data, last);
-
-				if (feb == 15)
-					last = b = decodeIndex(data, last);
-
-				if (fec == 15)
-					last = c = decodeIndex(data, last);
-
-				// output triangle
-				writeTriangle(destination, i, index_size, a, b, c);
+	return meshopt::decodeIndexBuffer(destination, index_count, index_size, buffer, buffer_size, 0, index_count, 0, 0);
+}
 
-				// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
-				pushVertexFifo(vertexfifo, a, vertexfifooffset);
-				pushVertexFifo(vertexfifo, b, vertexfifooffset, (feb == 0) | (feb == 15));
-				pushVertexFifo(vertexfifo, c, vertexfifooffset, (fec == 0) | (fec == 15));
+int meshopt_decodeIndexBufferParallel(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size, meshopt_Dispatch dispatch, void* context)
+{
+	return meshopt::decodeIndexBuffer(destination, index_count, index_size, buffer, buffer_size, 0, index_count, dispatch, context);
+}
 
-				pushEdgeFifo(edgefifo, b, a, edgefifooffset);
-				pushEdgeFifo(edgefifo, c, b, edgefifooffset);
-				pushEdgeFifo(edgefifo, a, c, edgefifooffset);
-			}
-		}
-	}
+int meshopt_decodeIndexRange(void* destination, size_t index_offset, size_t index_range, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size)
+{
+	assert(index_offset <= index_count && index_range <= index_count - index_offset);
 
-	// we should've read all data bytes and stopped at the boundary between data and codeaux table
-	if (data != data_safe_end)
-		return -3;
+	return meshopt::decodeIndexBuffer(destination, index_count, index_size, buffer, buffer_size, index_offset, index_offset + index_range, 0, 0);
+}
 
-	return 0;
+int meshopt_validateIndexBuffer(size_t index_count, const unsigned char* buffer, size_t buffer_size)
+{
+	return meshopt::validateIndexBuffer(index_count, buffer, buffer_size);
 }
 
 size_t meshopt_encodeIndexSequence(unsigned char* buffer, size_t buffer_size, const unsigned int* indices, size_t index_count)
@@ -554,7 +997,8 @@ size_t meshopt_encodeIndexSequence(unsigned char* buffer, size_t buffer_size, co
 	if (buffer_size < 1 + index_count + 4)
 		return 0;
 
-	int version = gEncodeIndexVersion;
+	// version 2 only changes the index buffer format
+	int version = gEncodeIndexVersion > 1 ? 1 : gEncodeIndexVersion;
 
 	buffer[0] = (unsigned char)(kSequenceHeader | version);
 
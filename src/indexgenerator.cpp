@@ -160,6 +160,16 @@ static T* hashLookup(T* table, size_t buckets, const Hash& hash, const T& key, c
 	return 0;
 }
 
+static unsigned int hashPartition(unsigned int h, size_t partition_count)
+{
+	// partition is selected using the upper bits of the finalized hash so that it's independent of the bucket selection
+	h ^= h >> 13;
+	h *= 0x5bd1e995;
+	h ^= h >> 15;
+
+	return unsigned((static_cast<unsigned long long>(h) * partition_count) >> 32);
+}
+
 static void buildPositionRemap(unsigned int* remap, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Allocator& allocator)
 {
 	VertexHasher vertex_hasher = {reinterpret_cast<const unsigned char*>(vertex_positions), 3 * sizeof(float), vertex_positions_stride};
@@ -180,9 +190,372 @@ static void buildPositionRemap(unsigned int* remap, const float* vertex_position
 	}
 }
 
+static void getVertexRemapStreamLayout(const meshopt_VertexRemapStream* stream, unsigned int*& table, size_t& table_size, unsigned int*& ids, unsigned char*& vertices)
+{
+	unsigned char* data = static_cast<unsigned char*>(stream->data);
+
+	// table with hashBuckets(capacity) entries, followed by new vertex ids and vertex data; the last vertex slot is used for lookups
+	table_size = hashBuckets(stream->vertex_capacity);
+	table = reinterpret_cast<unsigned int*>(data);
+	ids = table + table_size;
+	vertices = reinterpret_cast<unsigned char*>(ids + stream->vertex_capacity);
+}
+
+const size_t kRemapBlockSize = 16384;
+const size_t kRemapPartitions = 256;
+
+struct VertexSequenceHasher
+{
+	const unsigned int* sequence;
+	const unsigned char* vertices;
+	size_t vertex_size;
+	size_t vertex_stride;
+
+	size_t hash(unsigned int key) const
+	{
+		unsigned int index = sequence ? sequence[key] : key;
+
+		return hashUpdate4(0, vertices + index * vertex_stride, vertex_size);
+	}
+
+	bool equal(unsigned int lhs, unsigned int rhs) const
+	{
+		unsigned int li = sequence ? sequence[lhs] : lhs;
+		unsigned int ri = sequence ? sequence[rhs] : rhs;
+
+		return memcmp(vertices + li * vertex_stride, vertices + ri * vertex_stride, vertex_size) == 0;
+	}
+};
+
+static unsigned int getEdgeNext(unsigned int key)
+{
+	unsigned int corner = key % 3;
+
+	return key - corner + (corner == 2 ? 0 : corner + 1);
+}
+
+struct EdgeKeyHasher
+{
+	const unsigned int* indices;
+	const unsigned int* remap;
+
+	unsigned long long edge(unsigned int key) const
+	{
+		return ((unsigned long long)indices[key] << 32) | indices[getEdgeNext(key)];
+	}
+
+	size_t hash(unsigned int key) const
+	{
+		EdgeHasher hasher = {remap};
+		return hasher.hash(edge(key));
+	}
+
+	bool equal(unsigned int lhs, unsigned int rhs) const
+	{
+		EdgeHasher hasher = {remap};
+		return hasher.equal(edge(lhs), edge(rhs));
+	}
+};
+
+struct EdgeQueryHasher
+{
+	const EdgeKeyHasher* keys;
+	unsigned long long edge;
+	unsigned int edge_hash;
+
+	size_t hash(unsigned int) const
+	{
+		return edge_hash;
+	}
+
+	bool equal(unsigned int lhs, unsigned int) const
+	{
+		EdgeHasher hasher = {keys->remap};
+		return hasher.equal(keys->edge(lhs), edge);
+	}
+};
+
+template <typename Hash>
+struct PartitionHasher
+{
+	const Hash* keys;
+	const unsigned int* hashes;
+
+	size_t hash(unsigned int key) const
+	{
+		return hashes[key];
+	}
+
+	bool equal(unsigned int lhs, unsigned int rhs) const
+	{
+		return keys->equal(lhs, rhs);
+	}
+};
+
+struct RemapPartitions
+{
+	size_t count;
+	size_t block_count;
+	const void* keys;
+
+	unsigned int* hashes;
+	unsigned int* hist;
+	unsigned int* order;
+	unsigned int* tables;
+
+	// representative (smallest equivalent) key for every key
+	unsigned int* result;
+
+	size_t offsets[kRemapPartitions + 1];
+	size_t table_offsets[kRemapPartitions + 1];
+};
+
+template <typename Hash>
+static void remapHashTask(void* context, size_t task_index)
+{
+	RemapPartitions& parts = *static_cast<RemapPartitions*>(context);
+	const Hash& keys = *static_cast<const Hash*>(parts.keys);
+
+	size_t begin = task_index * kRemapBlockSize;
+	size_t end = parts.count - begin < kRemapBlockSize ? parts.count : begin + kRemapBlockSize;
+
+	unsigned int* hist = parts.hist + task_index * kRemapPartitions;
+	memset(hist, 0, kRemapPartitions * sizeof(unsigned int));
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		unsigned int h = unsigned(keys.hash(unsigned(i)));
+
+		parts.hashes[i] = h;
+		hist[hashPartition(h, kRemapPartitions)]++;
+	}
+}
+
+static void remapScatterTask(void* context, size_t task_index)
+{
+	RemapPartitions& parts = *static_cast<RemapPartitions*>(context);
+
+	size_t begin = task_index * kRemapBlockSize;
+	size_t end = parts.count - begin < kRemapBlockSize ? parts.count : begin + kRemapBlockSize;
+
+	unsigned int* hist = parts.hist + task_index * kRemapPartitions;
+
+	for (size_t i = begin; i < end; ++i)
+		parts.order[hist[hashPartition(parts.hashes[i], kRemapPartitions)]++] = unsigned(i);
+}
+
+template <typename Hash>
+static void remapTableTask(void* context, size_t task_index)
+{
+	RemapPartitions& parts = *static_cast<RemapPartitions*>(context);
+	PartitionHasher<Hash> hasher = {static_cast<const Hash*>(parts.keys), parts.hashes};
+
+	unsigned int* table = parts.tables + parts.table_offsets[task_index];
+	size_t table_size = parts.table_offsets[task_index + 1] - parts.table_offsets[task_index];
+	memset(table, -1, table_size * sizeof(unsigned int));
+
+	// keys of each partition are listed in increasing order, so the first key of each equivalence class becomes its representative
+	for (size_t i = parts.offsets[task_index]; i < parts.offsets[task_index + 1]; ++i)
+	{
+		unsigned int key = parts.order[i];
+		unsigned int* entry = hashLookup(table, table_size, hasher, key, ~0u);
+
+		if (*entry == ~0u)
+			*entry = key;
+
+		parts.result[key] = *entry;
+	}
+}
+
+template <typename Hash>
+static void buildRemapPartitions(RemapPartitions& parts, const Hash& keys, size_t count, meshopt_Dispatch dispatch, void* context, meshopt_Allocator& allocator)
+{
+	parts.count = count;
+	parts.block_count = (count + kRemapBlockSize - 1) / kRemapBlockSize;
+	parts.keys = &keys;
+
+	parts.hashes = allocator.allocate<unsigned int>(count);
+	parts.hist = allocator.allocate<unsigned int>(parts.block_count * kRemapPartitions);
+	dispatch(context, remapHashTask<Hash>, &parts, parts.block_count);
+
+	// replace per-block histograms with offsets in partition-major, block-minor order, which keeps keys sorted within each partition
+	size_t offset = 0;
+	size_t table_offset = 0;
+
+	for (size_t p = 0; p < kRemapPartitions; ++p)
+	{
+		parts.offsets[p] = offset;
+		parts.table_offsets[p] = table_offset;
+
+		for (size_t b = 0; b < parts.block_count; ++b)
+		{
+			unsigned int h = parts.hist[b * kRemapPartitions + p];
+
+			parts.hist[b * kRemapPartitions + p] = unsigned(offset);
+			offset += h;
+		}
+
+		table_offset += hashBuckets(offset - parts.offsets[p]);
+	}
+
+	parts.offsets[kRemapPartitions] = offset;
+	parts.table_offsets[kRemapPartitions] = table_offset;
+
+	parts.order = allocator.allocate<unsigned int>(count);
+	dispatch(context, remapScatterTask, &parts, parts.block_count);
+
+	parts.tables = allocator.allocate<unsigned int>(table_offset);
+	parts.result = allocator.allocate<unsigned int>(count);
+	dispatch(context, remapTableTask<Hash>, &parts, kRemapPartitions);
+}
+
+static unsigned int findPartitionedEdge(const RemapPartitions& parts, const EdgeKeyHasher& keys, unsigned long long edge)
+{
+	EdgeHasher edge_hasher = {keys.remap};
+	EdgeQueryHasher hasher = {&keys, edge, unsigned(edge_hasher.hash(edge))};
+
+	size_t p = hashPartition(hasher.edge_hash, kRemapPartitions);
+
+	unsigned int* table = parts.tables + parts.table_offsets[p];
+	size_t table_size = parts.table_offsets[p + 1] - parts.table_offsets[p];
+
+	return *hashLookup(table, table_size, hasher, 0u, ~0u);
+}
+
+static size_t buildVertexSequence(unsigned int* sequence, unsigned int* visited, const unsigned int* indices, size_t index_count, size_t vertex_count)
+{
+	memset(visited, -1, vertex_count * sizeof(unsigned int));
+
+	size_t sequence_count = 0;
+
+	// vertices are listed in the order of their first reference, which is the order in which serial algorithms insert them into the hash table
+	for (size_t i = 0; i < index_count; ++i)
+	{
+		unsigned int index = indices ? indices[i] : unsigned(i);
+		assert(index < vertex_count);
+
+		if (visited[index] == ~0u)
+		{
+			visited[index] = unsigned(sequence_count);
+			sequence[sequence_count++] = index;
+		}
+	}
+
+	return sequence_count;
+}
+
+struct PatchTask
+{
+	const unsigned int* indices;
+	size_t index_count;
+
+	unsigned int* destination;
+
+	const EdgeKeyHasher* edges;
+	const RemapPartitions* parts;
+};
+
+static void adjacencyPatchTask(void* context, size_t task_index)
+{
+	const PatchTask& task = *static_cast<PatchTask*>(context);
+
+	static const int next[4] = {1, 2, 0, 1};
+
+	size_t begin = task_index * kRemapBlockSize * 3;
+	size_t end = task.index_count - begin < kRemapBlockSize * 3 ? task.index_count : begin + kRemapBlockSize * 3;
+
+	for (size_t i = begin; i < end; i += 3)
+	{
+		unsigned int patch[6];
+
+		for (int e = 0; e < 3; ++e)
+		{
+			unsigned int i0 = task.indices[i + e];
+			unsigned int i1 = task.indices[i + next[e]];
+
+			// note: this refers to the opposite edge!
+			unsigned long long edge = ((unsigned long long)i1 << 32) | i0;
+			unsigned int oppe = findPartitionedEdge(*task.parts, *task.edges, edge);
+
+			// the vertex opposite to the edge is the third vertex of the triangle that has the first instance of the edge
+			patch[e * 2 + 0] = i0;
+			patch[e * 2 + 1] = (oppe == ~0u) ? i0 : task.indices[getEdgeNext(getEdgeNext(oppe))];
+		}
+
+		memcpy(task.destination + i * 2, patch, sizeof(patch));
+	}
+}
+
+static void tessellationPatchTask(void* context, size_t task_index)
+{
+	const PatchTask& task = *static_cast<PatchTask*>(context);
+
+	static const int next[3] = {1, 2, 0};
+
+	size_t begin = task_index * kRemapBlockSize * 3;
+	size_t end = task.index_count - begin < kRemapBlockSize * 3 ? task.index_count : begin + kRemapBlockSize * 3;
+
+	for (size_t i = begin; i < end; i += 3)
+	{
+		unsigned int patch[12];
+
+		for (int e = 0; e < 3; ++e)
+		{
+			unsigned int i0 = task.indices[i + e];
+			unsigned int i1 = task.indices[i + next[e]];
+
+			// note: this refers to the opposite edge!
+			unsigned long long edge = ((unsigned long long)i1 << 32) | i0;
+			unsigned int oppk = findPartitionedEdge(*task.parts, *task.edges, edge);
+
+			// use the same edge if opposite edge doesn't exist (border)
+			unsigned long long oppe = (oppk == ~0u) ? edge : task.edges->edge(oppk);
+
+			// triangle index (0, 1, 2)
+			patch[e] = i0;
+
+			// opposite edge (3, 4; 5, 6; 7, 8)
+			patch[3 + e * 2 + 0] = unsigned(oppe);
+			patch[3 + e * 2 + 1] = unsigned(oppe >> 32);
+
+			// dominant vertex (9, 10, 11)
+			patch[9 + e] = task.edges->remap[i0];
+		}
+
+		memcpy(task.destination + i * 4, patch, sizeof(patch));
+	}
+}
+
+static void buildPatchesParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, void (*patch_task)(void*, size_t), meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_Allocator allocator;
+
+	// build position remap: for each vertex, which other (canonical) vertex does it map to?
+	VertexSequenceHasher vertex_keys = {NULL, reinterpret_cast<const unsigned char*>(vertex_positions), 3 * sizeof(float), vertex_positions_stride};
+
+	RemapPartitions vertex_parts = {};
+	buildRemapPartitions(vertex_parts, vertex_keys, vertex_count, dispatch, context, allocator);
+
+	// build edge set; edges are identified by the index of their first corner, and the first instance of each edge is used as a representative
+	EdgeKeyHasher edge_keys = {indices, vertex_parts.result};
+
+	RemapPartitions edge_parts = {};
+	buildRemapPartitions(edge_parts, edge_keys, index_count, dispatch, context, allocator);
+
+	PatchTask task = {indices, index_count, destination, &edge_keys, &edge_parts};
+
+	size_t triangle_count = index_count / 3;
+	dispatch(context, patch_task, &task, (triangle_count + kRemapBlockSize - 1) / kRemapBlockSize);
+}
+
 } // namespace meshopt
 
 size_t meshopt_generateVertexRemap(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size)
+{
+	return meshopt_generateVertexRemapWithContext(destination, indices, index_count, vertices, vertex_count, vertex_size, NULL);
+}
+
+size_t meshopt_generateVertexRemapWithContext(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Context* context)
 {
 	using namespace meshopt;
 
@@ -190,7 +563,7 @@ size_t meshopt_generateVertexRemap(unsigned int* destination, const unsigned int
 	assert(!indices || index_count % 3 == 0);
 	assert(vertex_size > 0 && vertex_size <= 256);
 
-	meshopt_Allocator allocator;
+	meshopt_Allocator allocator(context);
 
 	memset(destination, -1, vertex_count * sizeof(unsigned int));
 
@@ -231,6 +604,128 @@ size_t meshopt_generateVertexRemap(unsigned int* destination, const unsigned int
 	return next_vertex;
 }
 
+size_t meshopt_generateVertexRemapParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(indices || index_count == vertex_count);
+	assert(!indices || index_count % 3 == 0);
+	assert(vertex_size > 0 && vertex_size <= 256);
+
+	if (!dispatch || vertex_count <= kRemapBlockSize)
+		return meshopt_generateVertexRemap(destination, indices, index_count, vertices, vertex_count, vertex_size);
+
+	meshopt_Allocator allocator;
+
+	// destination is used to track visited vertices until the final ids are known
+	unsigned int* sequence = allocator.allocate<unsigned int>(vertex_count);
+	size_t sequence_count = buildVertexSequence(sequence, destination, indices, index_count, vertex_count);
+
+	VertexSequenceHasher keys = {sequence, static_cast<const unsigned char*>(vertices), vertex_size, vertex_size};
+
+	RemapPartitions parts = {};
+	buildRemapPartitions(parts, keys, sequence_count, dispatch, context, allocator);
+
+	unsigned int* result = parts.result;
+	unsigned int next_vertex = 0;
+
+	// representatives precede all other vertices in their class, so their ids are assigned by the time they are needed
+	for (size_t i = 0; i < sequence_count; ++i)
+	{
+		result[i] = (result[i] == i) ? next_vertex++ : result[result[i]];
+
+		destination[sequence[i]] = result[i];
+	}
+
+	assert(next_vertex <= vertex_count);
+
+	return next_vertex;
+}
+
+size_t meshopt_generateVertexRemapScratchBound(size_t vertex_count)
+{
+	using namespace meshopt;
+
+	return meshopt_Allocator::scratch<unsigned int>(hashBuckets(vertex_count));
+}
+
+size_t meshopt_vertexRemapStreamBound(size_t vertex_capacity, size_t vertex_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+
+	return hashBuckets(vertex_capacity) * sizeof(unsigned int) + vertex_capacity * sizeof(unsigned int) + (vertex_capacity + 1) * vertex_size;
+}
+
+void meshopt_vertexRemapStreamBegin(meshopt_VertexRemapStream* stream, unsigned int partition)
+{
+	using namespace meshopt;
+
+	assert(stream->data && stream->vertex_capacity > 0);
+	assert(stream->vertex_size > 0 && stream->vertex_size <= 256);
+	assert(partition < stream->partition_count);
+
+	unsigned int* table = 0;
+	size_t table_size = 0;
+	unsigned int* ids = 0;
+	unsigned char* vertices = 0;
+	getVertexRemapStreamLayout(stream, table, table_size, ids, vertices);
+
+	memset(table, -1, table_size * sizeof(unsigned int));
+
+	stream->partition = partition;
+	stream->vertex_count = 0;
+}
+
+int meshopt_vertexRemapStreamAdd(meshopt_VertexRemapStream* stream, unsigned int* destination, const void* vertices, size_t vertex_count)
+{
+	using namespace meshopt;
+
+	assert(stream->partition < stream->partition_count);
+
+	unsigned int* table = 0;
+	size_t table_size = 0;
+	unsigned int* ids = 0;
+	unsigned char* data = 0;
+	getVertexRemapStreamLayout(stream, table, table_size, ids, data);
+
+	size_t vertex_size = stream->vertex_size;
+	VertexHasher hasher = {data, vertex_size, vertex_size};
+
+	const unsigned char* vertex_data = static_cast<const unsigned char*>(vertices);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		const unsigned char* vertex = vertex_data + i * vertex_size;
+
+		if (hashPartition(hashUpdate4(0, vertex, vertex_size), stream->partition_count) != stream->partition)
+			continue;
+
+		// copy the vertex into the spare slot so that it can be compared with the vertices stored in the table
+		unsigned int index = unsigned(stream->vertex_count);
+		memcpy(data + index * vertex_size, vertex, vertex_size);
+
+		unsigned int* entry = hashLookup(table, table_size, hasher, index, ~0u);
+
+		if (*entry == ~0u)
+		{
+			if (stream->vertex_count == stream->vertex_capacity)
+				return -1;
+
+			*entry = index;
+			ids[index] = unsigned(stream->unique_count);
+
+			stream->vertex_count++;
+			stream->unique_count++;
+		}
+
+		destination[i] = ids[*entry];
+	}
+
+	return 0;
+}
+
 size_t meshopt_generateVertexRemapMulti(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count)
 {
 	using namespace meshopt;
@@ -363,6 +858,33 @@ void meshopt_generateShadowIndexBuffer(unsigned int* destination, const unsigned
 	}
 }
 
+void meshopt_generateShadowIndexBufferParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, size_t vertex_stride, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(indices);
+	assert(index_count % 3 == 0);
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size <= vertex_stride);
+
+	if (!dispatch || vertex_count <= kRemapBlockSize)
+		return meshopt_generateShadowIndexBuffer(destination, indices, index_count, vertices, vertex_count, vertex_size, vertex_stride);
+
+	meshopt_Allocator allocator;
+
+	unsigned int* visited = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* sequence = allocator.allocate<unsigned int>(vertex_count);
+	size_t sequence_count = buildVertexSequence(sequence, visited, indices, index_count, vertex_count);
+
+	VertexSequenceHasher keys = {sequence, static_cast<const unsigned char*>(vertices), vertex_size, vertex_stride};
+
+	RemapPartitions parts = {};
+	buildRemapPartitions(parts, keys, sequence_count, dispatch, context, allocator);
+
+	for (size_t i = 0; i < index_count; ++i)
+		destination[i] = sequence[parts.result[visited[indices[i]]]];
+}
+
 void meshopt_generateShadowIndexBufferMulti(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count)
 {
 	using namespace meshopt;
@@ -478,6 +1000,23 @@ void meshopt_generateAdjacencyIndexBuffer(unsigned int* destination, const unsig
 	}
 }
 
+void meshopt_generateAdjacencyIndexBufferParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	if (!dispatch || index_count <= kRemapBlockSize * 3)
+		return meshopt_generateAdjacencyIndexBuffer(destination, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride);
+
+	for (size_t i = 0; i < index_count; ++i)
+		assert(indices[i] < vertex_count);
+
+	buildPatchesParallel(destination, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, adjacencyPatchTask, dispatch, context);
+}
+
 void meshopt_generateTessellationIndexBuffer(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
 	using namespace meshopt;
@@ -549,3 +1088,20 @@ void meshopt_generateTessellationIndexBuffer(unsigned int* destination, const un
 		memcpy(destination + i * 4, patch, sizeof(patch));
 	}
 }
+
+void meshopt_generateTessellationIndexBufferParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	if (!dispatch || index_count <= kRemapBlockSize * 3)
+		return meshopt_generateTessellationIndexBuffer(destination, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride);
+
+	for (size_t i = 0; i < index_count; ++i)
+		assert(indices[i] < vertex_count);
+
+	buildPatchesParallel(destination, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, tessellationPatchTask, dispatch, context);
+}
@@ -0,0 +1,421 @@
+// This file is part of meshoptimizer library; see meshoptimizer.h for version/license details
+#include "meshoptimizer.h"
+
+#include <assert.h>
+#include <string.h>
+
+// This work is based on:
+// Fabian Giesen. Simple lossless index buffer compression & follow-up. 2013
+// Conor Stokes. Vertex Cache Optimised Index Buffer Compression. 2014
+namespace meshopt
+{
+
+const unsigned char kMeshletHeader = 0xc0;
+
+// meshlet vertices fit into a byte so FIFOs and decoding windows store bytes instead of full indices
+typedef unsigned char MeshletVertexFifo[16];
+typedef unsigned char MeshletEdgeFifo[16][2];
+
+// decoder stores FIFOs as sliding windows into a larger buffer to avoid wraparound on reads and writes; the last 16 entries are moved to the front when the window fills up
+const size_t kMeshletDecodeWindowSize = 256;
+
+typedef unsigned char MeshletVertexWindow[kMeshletDecodeWindowSize + 16];
+typedef unsigned char MeshletEdgeWindow[kMeshletDecodeWindowSize + 16][2];
+
+static const unsigned int kMeshletTriangleOrder[3][3] = {
+    {0, 1, 2},
+    {1, 2, 0},
+    {2, 0, 1},
+};
+
+static int getMeshletEdgeFifo(MeshletEdgeFifo fifo, unsigned int a, unsigned int b, unsigned int c, size_t offset)
+{
+	for (int i = 0; i < 16; ++i)
+	{
+		size_t index = (offset - 1 - i) & 15;
+
+		unsigned int e0 = fifo[index][0];
+		unsigned int e1 = fifo[index][1];
+
+		if (e0 == a && e1 == b)
+			return (i << 2) | 0;
+		if (e0 == b && e1 == c)
+			return (i << 2) | 1;
+		if (e0 == c && e1 == a)
+			return (i << 2) | 2;
+	}
+
+	return -1;
+}
+
+static void pushMeshletEdgeFifo(MeshletEdgeFifo fifo, unsigned int a, unsigned int b, size_t& offset)
+{
+	fifo[offset][0] = (unsigned char)a;
+	fifo[offset][1] = (unsigned char)b;
+	offset = (offset + 1) & 15;
+}
+
+static int getMeshletVertexFifo(MeshletVertexFifo fifo, unsigned int v, size_t offset)
+{
+	for (int i = 0; i < 16; ++i)
+	{
+		size_t index = (offset - 1 - i) & 15;
+
+		if (fifo[index] == v)
+			return i;
+	}
+
+	return -1;
+}
+
+static void pushMeshletVertexFifo(MeshletVertexFifo fifo, unsigned int v, size_t& offset)
+{
+	fifo[offset] = (unsigned char)v;
+	offset = (offset + 1) & 15;
+}
+
+static int encodeMeshletVertex(unsigned int v, unsigned int& next, MeshletVertexFifo fifo, size_t offset)
+{
+	// 0 encodes the next unseen vertex, 1..14 encode recently used vertices, 15 encodes an explicit local index
+	if (v == next)
+		return next++, 0;
+
+	int fv = getMeshletVertexFifo(fifo, v, offset);
+
+	return (fv >= 0 && fv < 14) ? fv + 1 : 15;
+}
+
+static void encodeMeshletVByte(unsigned char*& data, unsigned int v)
+{
+	// encode 32-bit value in up to 5 7-bit groups
+	do
+	{
+		*data++ = (v & 127) | (v > 127 ? 128 : 0);
+		v >>= 7;
+	} while (v);
+}
+
+static int decodeMeshletVByte(unsigned int& result, const unsigned char*& data, const unsigned char* data_end)
+{
+	result = 0;
+
+	// note that this loop always terminates, which is important for malformed data
+	for (unsigned int shift = 0; shift < 35; shift += 7)
+	{
+		if (data == data_end)
+			return -2;
+
+		unsigned char group = *data++;
+		result |= unsigned(group & 127) << shift;
+
+		if (group < 128)
+			return 0;
+	}
+
+	return -2;
+}
+
+static void pushMeshletVertexWindow(MeshletVertexWindow window, unsigned int v, size_t& offset, int cond = 1)
+{
+	window[offset] = (unsigned char)v;
+	offset += cond;
+}
+
+static void pushMeshletEdgeWindow(MeshletEdgeWindow window, unsigned int a, unsigned int b, size_t& offset)
+{
+	window[offset][0] = (unsigned char)a;
+	window[offset][1] = (unsigned char)b;
+	offset += 1;
+}
+
+static void rewindMeshletWindows(MeshletEdgeWindow edgewindow, size_t& edgeoffset, MeshletVertexWindow vertexwindow, size_t& vertexoffset)
+{
+	// each triangle pushes at most 3 entries into each window so we need to keep a small gap at the end
+	if (edgeoffset > kMeshletDecodeWindowSize)
+	{
+		memcpy(edgewindow, edgewindow + edgeoffset - 16, 16 * sizeof(edgewindow[0]));
+		edgeoffset = 16;
+	}
+
+	if (vertexoffset > kMeshletDecodeWindowSize)
+	{
+		memcpy(vertexwindow, vertexwindow + vertexoffset - 16, 16 * sizeof(vertexwindow[0]));
+		vertexoffset = 16;
+	}
+}
+
+static unsigned int decodeMeshletVertex(int fv, unsigned int& next, const MeshletVertexWindow window, size_t offset, const unsigned char*& data)
+{
+	// fifo reads are relative to the end of the window; explicit indices are read from the data stream which the caller has bounds checked
+	unsigned int vf = window[offset - fv];
+	unsigned int v = (fv == 0) ? next : (fv == 15) ? *data : vf;
+
+	next += (fv == 0);
+	data += (fv == 15);
+
+	return v;
+}
+
+} // namespace meshopt
+
+size_t meshopt_encodeMeshlet(unsigned char* buffer, size_t buffer_size, const unsigned int* vertices, size_t vertex_count, const unsigned char* triangles, size_t triangle_count)
+{
+	using namespace meshopt;
+
+	assert(vertex_count <= 256);
+
+	// the minimum valid encoding is header, 1 byte per triangle and 1 byte per vertex
+	if (buffer_size < 1 + triangle_count + vertex_count)
+		return 0;
+
+	buffer[0] = kMeshletHeader;
+
+	unsigned char* code = buffer + 1;
+	unsigned char* data = code + triangle_count;
+	unsigned char* data_end = buffer + buffer_size;
+
+	// vertex indices are delta-encoded from the previous index plus one, since meshlets referencing vertices from a fetch-optimized mesh are mostly sequential
+	unsigned int last = ~0u;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int d = vertices[i] - last - 1;
+		unsigned int v = (d << 1) ^ (int(d) >> 31);
+
+		// each index writes at most 5 bytes of data; we encode it separately to make sure we have enough space
+		unsigned char group[5];
+		unsigned char* group_end = group;
+		encodeMeshletVByte(group_end, v);
+
+		if (data_end - data < group_end - group)
+			return 0;
+
+		memcpy(data, group, group_end - group);
+		data += group_end - group;
+
+		last = vertices[i];
+	}
+
+	MeshletEdgeFifo edgefifo;
+	memset(edgefifo, -1, sizeof(edgefifo));
+
+	MeshletVertexFifo vertexfifo;
+	memset(vertexfifo, -1, sizeof(vertexfifo));
+
+	size_t edgefifooffset = 0;
+	size_t vertexfifooffset = 0;
+
+	unsigned int next = 0;
+
+	for (size_t i = 0; i < triangle_count; ++i)
+	{
+		const unsigned char* tri = &triangles[i * 3];
+
+		assert(tri[0] < vertex_count && tri[1] < vertex_count && tri[2] < vertex_count);
+
+		int fer = getMeshletEdgeFifo(edgefifo, tri[0], tri[1], tri[2], edgefifooffset);
+
+		if (fer >= 0 && (fer >> 2) < 15)
+		{
+			const unsigned int* order = kMeshletTriangleOrder[fer & 3];
+
+			unsigned int a = tri[order[0]], b = tri[order[1]], c = tri[order[2]];
+
+			// encode edge index and vertex code for the third vertex
+			int fe = fer >> 2;
+			int fec = encodeMeshletVertex(c, next, vertexfifo, vertexfifooffset);
+
+			if (data_end - data < (fec == 15))
+				return 0;
+
+			*code++ = (unsigned char)((fe << 4) | fec);
+
+			if (fec == 15)
+				*data++ = (unsigned char)c;
+
+			// we only need to push third vertex since first two are likely already in the vertex fifo
+			if (fec == 0 || fec == 15)
+				pushMeshletVertexFifo(vertexfifo, c, vertexfifooffset);
+
+			// we only need to push two new edges to edge fifo since the third one is already there
+			pushMeshletEdgeFifo(edgefifo, c, b, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, a, c, edgefifooffset);
+		}
+		else
+		{
+			// rotate the triangle so that the next vertex comes first, which makes fea=0 the common case
+			int rotation = (tri[1] == next) ? 1 : (tri[2] == next) ? 2 : 0;
+			const unsigned int* order = kMeshletTriangleOrder[rotation];
+
+			unsigned int a = tri[order[0]], b = tri[order[1]], c = tri[order[2]];
+
+			int fea = encodeMeshletVertex(a, next, vertexfifo, vertexfifooffset);
+			int feb = encodeMeshletVertex(b, next, vertexfifo, vertexfifooffset);
+			int fec = encodeMeshletVertex(c, next, vertexfifo, vertexfifooffset);
+
+			// each free triangle writes at most 4 bytes of data in addition to the code byte: 1b for codeaux and 1b for each explicit index
+			if (data_end - data < 1 + (fea == 15) + (feb == 15) + (fec == 15))
+				return 0;
+
+			// high nibble 15 marks a triangle that doesn't share an edge with the fifo; the low nibble encodes the first vertex
+			*code++ = (unsigned char)((15 << 4) | fea);
+			*data++ = (unsigned char)((feb << 4) | fec);
+
+			if (fea == 15)
+				*data++ = (unsigned char)a;
+
+			if (feb == 15)
+				*data++ = (unsigned char)b;
+
+			if (fec == 15)
+				*data++ = (unsigned char)c;
+
+			// only push vertices that weren't already in fifo
+			if (fea == 0 || fea == 15)
+				pushMeshletVertexFifo(vertexfifo, a, vertexfifooffset);
+
+			if (feb == 0 || feb == 15)
+				pushMeshletVertexFifo(vertexfifo, b, vertexfifooffset);
+
+			if (fec == 0 || fec == 15)
+				pushMeshletVertexFifo(vertexfifo, c, vertexfifooffset);
+
+			// all three edges aren't in the fifo; pushing all of them is important so that we can match them for later triangles
+			pushMeshletEdgeFifo(edgefifo, b, a, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, c, b, edgefifooffset);
+			pushMeshletEdgeFifo(edgefifo, a, c, edgefifooffset);
+		}
+	}
+
+	assert(data >= buffer + 1 + triangle_count + vertex_count);
+	assert(data <= buffer + buffer_size);
+
+	return data - buffer;
+}
+
+size_t meshopt_encodeMeshletBound(size_t max_vertices, size_t max_triangles)
+{
+	assert(max_vertices <= 256);
+
+	// worst-case encoding is 5 bytes per vertex index and 5 bytes per triangle (code, codeaux and 3 explicit indices) on top of the header
+	return 1 + max_vertices * 5 + max_triangles * 5;
+}
+
+int meshopt_decodeMeshlet(unsigned int* vertices, size_t vertex_count, unsigned char* triangles, size_t triangle_count, const unsigned char* buffer, size_t buffer_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_count <= 256);
+
+	// the minimum valid encoding is header, 1 byte per triangle and 1 byte per vertex
+	if (buffer_size < 1 + triangle_count + vertex_count)
+		return -2;
+
+	if (buffer[0] != kMeshletHeader)
+		return -1;
+
+	const unsigned char* code = buffer + 1;
+	const unsigned char* data = code + triangle_count;
+	const unsigned char* data_end = buffer + buffer_size;
+
+	unsigned int last = ~0u;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int v = 0;
+		if (decodeMeshletVByte(v, data, data_end) < 0)
+			return -2;
+
+		unsigned int d = (v >> 1) ^ -int(v & 1);
+
+		last += d + 1;
+		vertices[i] = last;
+	}
+
+	// windows start with 16 entries of FIFO history, which is initially empty
+	MeshletEdgeWindow edgefifo;
+	memset(edgefifo, -1, 16 * sizeof(edgefifo[0]));
+
+	MeshletVertexWindow vertexfifo;
+	memset(vertexfifo, -1, 16 * sizeof(vertexfifo[0]));
+
+	size_t edgefifooffset = 16;
+	size_t vertexfifooffset = 16;
+
+	unsigned int next = 0;
+
+	for (size_t i = 0; i < triangle_count; ++i)
+	{
+		rewindMeshletWindows(edgefifo, edgefifooffset, vertexfifo, vertexfifooffset);
+
+		unsigned char codetri = *code++;
+		unsigned char* tri = &triangles[i * 3];
+
+		if (codetri < 0xf0)
+		{
+			int fe = codetri >> 4;
+			int fec = codetri & 15;
+
+			// each edge triangle reads at most 1 byte of data
+			if (data_end - data < (fec == 15))
+				return -2;
+
+			// fifo reads are relative to the end of the window
+			unsigned int a = edgefifo[edgefifooffset - 1 - fe][0];
+			unsigned int b = edgefifo[edgefifooffset - 1 - fe][1];
+
+			// note: this is the most common path in the entire decoder
+			// inside decodeMeshletVertex we try to stay branchless (by using cmov/etc.) since these aren't predictable
+			unsigned int c = decodeMeshletVertex(fec, next, vertexfifo, vertexfifooffset, data);
+
+			tri[0] = (unsigned char)a;
+			tri[1] = (unsigned char)b;
+			tri[2] = (unsigned char)c;
+
+			// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+			pushMeshletVertexWindow(vertexfifo, c, vertexfifooffset, (fec == 0) | (fec == 15));
+
+			pushMeshletEdgeWindow(edgefifo, c, b, edgefifooffset);
+			pushMeshletEdgeWindow(edgefifo, a, c, edgefifooffset);
+		}
+		else
+		{
+			if (data == data_end)
+				return -2;
+
+			unsigned char codeaux = *data++;
+
+			int fea = codetri & 15;
+			int feb = codeaux >> 4;
+			int fec = codeaux & 15;
+
+			// each free triangle reads 1 byte of data for each explicit index after codeaux
+			if (data_end - data < (fea == 15) + (feb == 15) + (fec == 15))
+				return -2;
+
+			// vertices are decoded in the same order as they were encoded so that next and explicit indices match the encoder
+			unsigned int a = decodeMeshletVertex(fea, next, vertexfifo, vertexfifooffset, data);
+			unsigned int b = decodeMeshletVertex(feb, next, vertexfifo, vertexfifooffset, data);
+			unsigned int c = decodeMeshletVertex(fec, next, vertexfifo, vertexfifooffset, data);
+
+			tri[0] = (unsigned char)a;
+			tri[1] = (unsigned char)b;
+			tri[2] = (unsigned char)c;
+
+			// push vertex/edge fifo must match the encoding step *exactly* otherwise the data will not be decoded correctly
+			pushMeshletVertexWindow(vertexfifo, a, vertexfifooffset, (fea == 0) | (fea == 15));
+			pushMeshletVertexWindow(vertexfifo, b, vertexfifooffset, (feb == 0) | (feb == 15));
+			pushMeshletVertexWindow(vertexfifo, c, vertexfifooffset, (fec == 0) | (fec == 15));
+
+			pushMeshletEdgeWindow(edgefifo, b, a, edgefifooffset);
+			pushMeshletEdgeWindow(edgefifo, c, b, edgefifooffset);
+			pushMeshletEdgeWindow(edgefifo, a, c, edgefifooffset);
+		}
+	}
+
+	// we should've read all data bytes
+	if (data != data_end)
+		return -3;
+
+	return 0;
+}
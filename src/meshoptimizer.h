@@ -47,6 +47,30 @@ struct meshopt_Stream
 	size_t stride;
 };
 
+/**
+ * Experimental: Parallel task dispatcher
+ * Functions that can split their work into independent tasks accept a dispatcher callback along with an opaque context pointer.
+ * The dispatcher must call task(task_context, i) exactly once for every i in [0, task_count), in any order and potentially on multiple threads concurrently,
+ * and return only after all tasks have finished. A valid (serial) dispatcher simply calls all tasks in a loop.
+ */
+typedef void (*meshopt_Dispatch)(void* context, void (*task)(void* task_context, size_t task_index), void* task_context, size_t task_count);
+
+/**
+ * Experimental: Scratch memory context
+ * Functions with a WithContext suffix allocate temporary memory from the context buffer instead of using the allocation callbacks; this makes repeated calls allocation-free.
+ * To initialize a context, point data to a buffer of capacity bytes (aligned to 16 bytes; use *ScratchBound functions to size it) and set size and peak to 0.
+ * A context can be reused for any number of calls, but it must not be used by multiple threads at the same time.
+ * When the buffer is too small, remaining temporary allocations fall back to the allocation callbacks; peak records the largest scratch size that any call required.
+ */
+struct meshopt_Context
+{
+	void* data;
+	size_t capacity;
+
+	size_t size;
+	size_t peak;
+};
+
 /**
  * Generates a vertex remap table from the vertex buffer and an optional index buffer and returns number of unique vertices
  * As a result, all vertices that are binary equivalent map to the same (new) location, with no gaps in the resulting sequence.
@@ -70,6 +94,42 @@ MESHOPTIMIZER_API size_t meshopt_generateVertexRemap(unsigned int* destination,
  */
 MESHOPTIMIZER_API size_t meshopt_generateVertexRemapMulti(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count);
 
+/**
+ * Experimental: Streaming vertex remap state
+ * Used to generate a vertex remap table for vertex data that doesn't fit in memory; see meshopt_vertexRemapStreamAdd.
+ * To initialize the stream, point data to a buffer of meshopt_vertexRemapStreamBound(vertex_capacity, vertex_size) bytes (aligned to 4 bytes), set vertex_capacity, vertex_size and partition_count, and set unique_count to 0.
+ */
+struct meshopt_VertexRemapStream
+{
+	void* data;
+	size_t vertex_capacity;
+	size_t vertex_size;
+	unsigned int partition_count;
+
+	/* total number of unique vertices found so far; after all partitions have been processed, this is the number of unique vertices */
+	size_t unique_count;
+
+	/* state of the current partition, managed by meshopt_vertexRemapStreamBegin/Add */
+	unsigned int partition;
+	size_t vertex_count;
+};
+
+/**
+ * Experimental: Streaming vertex remap generator
+ * Vertices are split into partition_count partitions based on their hash; each partition is processed by calling meshopt_vertexRemapStreamBegin with the partition index (in order, starting from 0),
+ * followed by feeding the entire vertex buffer in chunks of any size through meshopt_vertexRemapStreamAdd. Only the unique vertices of a single partition are kept in memory at any given time.
+ * For each vertex in the chunk that belongs to the current partition, the corresponding element of destination receives the new vertex location; other elements are left untouched,
+ * so after all partitions have been processed destination contains a complete remap table that can be used in meshopt_remapVertexBuffer/meshopt_remapIndexBuffer, with unique_count unique vertices.
+ * Unlike meshopt_generateVertexRemap, all vertices are assumed to be referenced, and the order of the new vertices is determined by the partitioning.
+ * Returns 0 on success and -1 if the current partition has more unique vertices than vertex_capacity; in that case, the process needs to be restarted with a larger partition_count.
+ *
+ * destination must contain enough space for the remap entries of the chunk (vertex_count elements)
+ * vertex_size must match the value in the stream
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_vertexRemapStreamBound(size_t vertex_capacity, size_t vertex_size);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_vertexRemapStreamBegin(struct meshopt_VertexRemapStream* stream, unsigned int partition);
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_vertexRemapStreamAdd(struct meshopt_VertexRemapStream* stream, unsigned int* destination, const void* vertices, size_t vertex_count);
+
 /**
  * Generates vertex buffer from the source vertex buffer and remap table generated by meshopt_generateVertexRemap
  *
@@ -135,6 +195,17 @@ MESHOPTIMIZER_API void meshopt_generateAdjacencyIndexBuffer(unsigned int* destin
  */
 MESHOPTIMIZER_API void meshopt_generateTessellationIndexBuffer(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+/**
+ * Experimental: Parallel index generators
+ * Produce the same results as meshopt_generateVertexRemap, meshopt_generateShadowIndexBuffer, meshopt_generateAdjacencyIndexBuffer and meshopt_generateTessellationIndexBuffer.
+ * Vertices (and edges) are hashed in blocks and deduplicated in hash-partitioned tables that are built in parallel using the supplied dispatcher; small meshes are processed serially.
+ * These functions need more temporary memory than the serial versions, as hashes and partitioned keys are stored for all vertices (and edges).
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateVertexRemapParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Dispatch dispatch, void* context);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_generateShadowIndexBufferParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, size_t vertex_stride, meshopt_Dispatch dispatch, void* context);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_generateAdjacencyIndexBufferParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_generateTessellationIndexBufferParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Vertex transform cache optimizer
  * Reorders indices to reduce the number of GPU vertex shader invocations
@@ -144,6 +215,49 @@ MESHOPTIMIZER_API void meshopt_generateTessellationIndexBuffer(unsigned int* des
  */
 MESHOPTIMIZER_API void meshopt_optimizeVertexCache(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count);
 
+/**
+ * Experimental: Parallel vertex transform cache optimizer
+ * Sorts triangles spatially, splits them into partitions of consecutive triangles and optimizes each partition in parallel using the supplied dispatcher; the results are concatenated in spatial order.
+ * Cache state restarts at partition boundaries, so the result is slightly less efficient than the one produced by meshopt_optimizeVertexCache; meshes that are too small to be partitioned are processed serially and produce the same result.
+ * Note that the allocation callbacks may be called from multiple threads concurrently.
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements)
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeVertexCacheParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Vertex score table for meshopt_optimizeVertexCacheTable
+ * cache[i] is the score of a vertex at position i in the simulated 16-entry LRU cache (0 is the most recently used entry)
+ * live[i] is the score of a vertex with i+1 remaining triangles; vertices with more than 8 remaining triangles use live[7]
+ * Vertices outside of the cache and vertices without remaining triangles score 0; scores should be in [0..1] range, and live scores must be positive.
+ * Tables can be tuned for a specific GPU cache profile using tools/vcachetuner.cpp.
+ */
+struct meshopt_VertexScoreTable
+{
+	float cache[16];
+	float live[8];
+};
+
+/**
+ * Experimental: Vertex transform cache optimizer with a custom score table
+ * Reorders indices like meshopt_optimizeVertexCache, but uses the supplied table to score vertices; this can be used to target GPUs with a cache behavior that the default table isn't tuned for.
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements)
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_VertexScoreTable* table);
+
+/**
+ * Experimental: Incremental vertex transform cache optimizer
+ * Reoptimizes the triangles around dirty triangles of an index buffer that was previously optimized with meshopt_optimizeVertexCache, and copies the remaining triangles as is; this is useful to keep the order efficient after local edits.
+ * Dirty triangles are merged into windows of consecutive triangles that include a small margin on each side; each window is optimized independently and triangles don't move between windows.
+ * Returns the number of reoptimized triangles; the cost of the function is proportional to that number, except for a linear pass over the triangles.
+ *
+ * destination must contain enough space for the resulting index buffer (index_count elements)
+ * dirty_triangles contains indices of the triangles (in [0..index_count/3) range) that were added or modified since the index buffer was optimized
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_optimizeVertexCacheIncremental(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const unsigned int* dirty_triangles, size_t dirty_count);
+
 /**
  * Vertex transform cache optimizer for strip-like caches
  * Produces inferior results to meshopt_optimizeVertexCache from the GPU vertex cache perspective
@@ -180,7 +294,7 @@ MESHOPTIMIZER_API void meshopt_optimizeOverdraw(unsigned int* destination, const
  * Vertex fetch cache optimizer
  * Reorders vertices and changes indices to reduce the amount of GPU memory fetches during vertex processing
  * Returns the number of unique vertices, which is the same as input vertex count unless some vertices are unused
- * This functions works for a single vertex stream; for multiple vertex streams, use meshopt_optimizeVertexFetchRemap + meshopt_remapVertexBuffer for each stream.
+ * This functions works for a single vertex stream; for multiple vertex streams, use meshopt_optimizeVertexFetchMulti or meshopt_optimizeVertexFetchRemap + meshopt_remapVertexBuffer for each stream.
  *
  * destination must contain enough space for the resulting vertex buffer (vertex_count elements)
  * indices is used both as an input and as an output index buffer
@@ -197,6 +311,28 @@ MESHOPTIMIZER_API size_t meshopt_optimizeVertexFetch(void* destination, unsigned
  */
 MESHOPTIMIZER_API size_t meshopt_optimizeVertexFetchRemap(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count);
 
+/**
+ * Experimental: Incremental vertex fetch cache optimizer
+ * Generates vertex remap that reorders dirty vertices among the positions they already occupy, in the order of their first use in the index buffer; all other vertices keep their positions.
+ * This keeps vertex fetch locality after local edits while only changing the vertices that need to be updated (e.g. uploaded to GPU memory) along with the indices that refer to them.
+ * Returns the number of vertices that change their position; the resulting remap table should be used with meshopt_remapVertexBuffer/meshopt_remapIndexBuffer.
+ *
+ * destination must contain enough space for the resulting remap table (vertex_count elements)
+ * dirty_vertices contains vertices that were added or are referenced by reoptimized triangles (for example, the triangles in the windows reoptimized by meshopt_optimizeVertexCacheIncremental)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_optimizeVertexFetchRemapIncremental(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const unsigned int* dirty_vertices, size_t dirty_count);
+
+/**
+ * Experimental: Vertex fetch cache optimizer for multiple vertex streams
+ * Reorders vertices of all streams and changes indices in a single pass, producing the same result as meshopt_optimizeVertexFetchRemap followed by meshopt_remapVertexBuffer for each stream.
+ * Returns the number of unique vertices, which is the same as input vertex count unless some vertices are unused
+ *
+ * destinations must contain stream_count pointers; each destination must contain enough space for vertex_count elements of the corresponding stream size (elements are written without gaps)
+ * destination can be equal to the stream data for in-place optimization if the stream stride is equal to its size
+ * indices is used both as an input and as an output index buffer
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_optimizeVertexFetchMulti(void* const* destinations, unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count);
+
 /**
  * Index buffer encoder
  * Encodes index data into an array of bytes that is generally much smaller (<1.5 bytes/triangle) and compresses better (<1 bytes/triangle) compared to original.
@@ -212,6 +348,7 @@ MESHOPTIMIZER_API size_t meshopt_encodeIndexBufferBound(size_t index_count, size
 /**
  * Set index encoder format version
  * version must specify the data format version to encode; valid values are 0 (decodable by all library versions) and 1 (decodable by 0.14+)
+ * Experimental: version 2 splits the index buffer into blocks of 4096 triangles that are encoded independently, which allows parallel and range decoding at a small cost in size; only index buffers are affected, and index sequences are encoded with version 1.
  */
 MESHOPTIMIZER_API void meshopt_encodeIndexVersion(int version);
 
@@ -225,6 +362,32 @@ MESHOPTIMIZER_API void meshopt_encodeIndexVersion(int version);
  */
 MESHOPTIMIZER_API int meshopt_decodeIndexBuffer(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size);
 
+/**
+ * Experimental: Parallel index buffer decoder
+ * Produces the same result as meshopt_decodeIndexBuffer, decoding blocks of the stream in parallel using the supplied dispatcher.
+ * Only data encoded with encoder version 2 can be decoded in parallel; earlier versions are decoded serially.
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeIndexBufferParallel(void* destination, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Index buffer range decoder
+ * Decodes indices [index_offset, index_offset + index_range) from an array of bytes generated by meshopt_encodeIndexBuffer with index_count indices; index_offset and index_range must be divisible by 3.
+ * Returns 0 if decoding was successful, and an error code otherwise; only the part of the stream that is necessary to decode the range is validated.
+ * For data encoded with encoder version 2, decoding cost is proportional to the range size, as the decoder can seek to the block that contains the first triangle.
+ * For data encoded with earlier versions, all triangles before the range need to be decoded as well.
+ *
+ * destination must contain enough space for the resulting index range (index_range elements)
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeIndexRange(void* destination, size_t index_offset, size_t index_range, size_t index_count, size_t index_size, const unsigned char* buffer, size_t buffer_size);
+
+/**
+ * Experimental: Index buffer validator
+ * Checks whether an array of bytes can be decoded by meshopt_decodeIndexBuffer with index_count indices, without decoding it or allocating memory.
+ * Returns the same result as meshopt_decodeIndexBuffer: 0 if the data is valid, and an error code otherwise; like the decoder, it doesn't check the range of the encoded indices.
+ * This is substantially faster than decoding since only the triangle codes need to be parsed, which is useful to reject malformed data early.
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_validateIndexBuffer(size_t index_count, const unsigned char* buffer, size_t buffer_size);
+
 /**
  * Index sequence encoder
  * Encodes index sequence into an array of bytes that is generally smaller and compresses better compared to original.
@@ -260,10 +423,20 @@ MESHOPTIMIZER_API size_t meshopt_encodeVertexBufferBound(size_t vertex_count, si
 
 /**
  * Set vertex encoder format version
- * version must specify the data format version to encode; valid values are 0 (decodable by all library versions)
+ * version must specify the data format version to encode; valid values are 0 (decodable by all library versions), 1 (decodable by 0.19+) and 2 (experimental)
+ * Version 1 splits the stream into independently decodable chunks, which allows parallel encoding and decoding at a very small cost in compression ratio.
+ * Version 2 uses the same chunks and additionally selects a predictor (8-bit or 16-bit, first or second order delta) for each 4-byte channel of each block; this improves compression for smooth data at the cost of slower encoding and decoding.
+ * Note that EXT_meshopt_compression requires version 0.
  */
 MESHOPTIMIZER_API void meshopt_encodeVertexVersion(int version);
 
+/**
+ * Experimental: Parallel vertex buffer encoder
+ * Produces the same result as meshopt_encodeVertexBuffer, encoding chunks of the stream in parallel using the supplied dispatcher.
+ * Parallel encoding requires encoder version 1 and a buffer of at least meshopt_encodeVertexBufferBound bytes; otherwise, the data is encoded serially.
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeVertexBufferParallel(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Vertex buffer decoder
  * Decodes vertex data from an array of bytes generated by meshopt_encodeVertexBuffer
@@ -274,6 +447,42 @@ MESHOPTIMIZER_API void meshopt_encodeVertexVersion(int version);
  */
 MESHOPTIMIZER_API int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size);
 
+/**
+ * Experimental: Parallel vertex buffer decoder
+ * Produces the same result as meshopt_decodeVertexBuffer, decoding chunks of the stream in parallel using the supplied dispatcher.
+ * Only data encoded with encoder version 1 can be decoded in parallel; version 0 data is decoded serially.
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBufferParallel(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Vertex buffer range decoder
+ * Decodes vertices [vertex_offset, vertex_offset + vertex_range) from an array of bytes generated by meshopt_encodeVertexBuffer with vertex_count vertices
+ * Returns 0 if decoding was successful, and an error code otherwise; only the part of the stream that is necessary to decode the range is validated.
+ * For data encoded with encoder version 1, decoding cost is proportional to the range size, as the decoder can seek to the chunk that contains the first vertex.
+ * For data encoded with encoder version 0, all vertices before the range need to be decoded as well.
+ *
+ * destination must contain enough space for the resulting vertex range (vertex_range * vertex_size bytes)
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexRange(void* destination, size_t vertex_offset, size_t vertex_range, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size);
+
+/**
+ * Experimental: Vertex buffer validator
+ * Checks whether an array of bytes can be decoded by meshopt_decodeVertexBuffer with vertex_count vertices of vertex_size bytes, without decoding it or allocating memory.
+ * Returns the same result as meshopt_decodeVertexBuffer: 0 if the data is valid, and an error code otherwise.
+ * This is substantially faster than decoding since only block headers and byte group sizes need to be parsed, which is useful to reject malformed data early.
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_validateVertexBuffer(size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size);
+
+/**
+ * Experimental: Strided vertex buffer decoder
+ * Produces the same result as meshopt_decodeVertexBuffer, but writes each vertex destination_stride bytes apart; this can be used to decode directly into an interleaved (e.g. mapped GPU) buffer.
+ * Bytes between vertices are not modified, so several streams can be decoded into the same buffer at different offsets.
+ *
+ * destination must contain enough space for the resulting vertex buffer ((vertex_count - 1) * destination_stride + vertex_size bytes)
+ * destination_stride must be >= vertex_size
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBufferStrided(void* destination, size_t vertex_count, size_t vertex_size, size_t destination_stride, const unsigned char* buffer, size_t buffer_size);
+
 /**
  * Vertex buffer filters
  * These functions can be used to filter output of meshopt_decodeVertexBuffer in-place.
@@ -291,6 +500,14 @@ MESHOPTIMIZER_EXPERIMENTAL void meshopt_decodeFilterOct(void* buffer, size_t cou
 MESHOPTIMIZER_EXPERIMENTAL void meshopt_decodeFilterQuat(void* buffer, size_t count, size_t stride);
 MESHOPTIMIZER_EXPERIMENTAL void meshopt_decodeFilterExp(void* buffer, size_t count, size_t stride);
 
+/**
+ * Experimental: Filtered vertex buffer decoder
+ * Produces the same result as meshopt_decodeVertexBuffer followed by filter(destination, vertex_count, vertex_size), but applies the filter to each block of decoded vertices while it's still in cache, which avoids an extra pass over the output.
+ * filter is typically one of meshopt_decodeFilterOct, meshopt_decodeFilterQuat or meshopt_decodeFilterExp, and must accept vertex_size as a stride.
+ * Note that if decoding fails, destination may contain partially filtered data.
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeVertexBufferFiltered(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, void (*filter)(void* buffer, size_t count, size_t stride));
+
 /**
  * Vertex buffer filter encoders
  * These functions can be used to encode data in a format that meshopt_decodeFilter can decode
@@ -338,6 +555,30 @@ enum
  */
 MESHOPTIMIZER_API size_t meshopt_simplify(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* result_error);
 
+/**
+ * Experimental: Mesh simplifier for LOD chains
+ * Produces lod_count levels of detail in one call; each level continues simplification from the previous one, so mesh analysis and quadric computation only happen once.
+ * Returns the total number of indices in all levels, with destination containing index data for each level back to back; lod_index_counts[i] receives the number of indices in level i.
+ * The resulting index buffers reference vertices from the original vertex buffer.
+ *
+ * destination must contain enough space for all levels, worst case is index_count * lod_count elements
+ * target_index_counts and target_errors specify the goal for each level; levels are simplified in order, so counts should be decreasing and errors should be increasing
+ * lod_errors can be NULL; when it's not NULL, it will contain the resulting (relative) error for each level
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyLods(unsigned int* destination, size_t* lod_index_counts, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options, float* lod_errors);
+
+/**
+ * Experimental: Parallel mesh simplifier
+ * Splits the mesh into spatially coherent partitions and simplifies each partition in parallel using the supplied dispatcher, with vertices on partition borders locked;
+ * a final serial pass then simplifies the combined result, including the partition borders, to reach the target.
+ * The result is similar to, but not the same as, the one produced by meshopt_simplify; meshes that are too small to be partitioned are processed serially and produce the same result.
+ * result_error is an estimate that combines partition errors with the error of the final pass.
+ * The allocation callbacks may be called from multiple threads concurrently.
+ *
+ * destination must contain enough space for the target index buffer, worst case is index_count elements (*not* target_index_count)!
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* result_error, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Experimental: Mesh simplifier (sloppy)
  * Reduces the number of triangles in the mesh, sacrificing mesh appearance for simplification performance
@@ -353,6 +594,18 @@ MESHOPTIMIZER_API size_t meshopt_simplify(unsigned int* destination, const unsig
  */
 MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error);
 
+/**
+ * Experimental: Mesh simplifier (sloppy) for LOD chains
+ * Produces lod_count levels of detail in one call; the first level matches meshopt_simplifySloppy, and each subsequent level is clustered from the vertices of the previous level, so its cost depends on the previous level size instead of the source mesh size.
+ * Returns the total number of indices in all levels, with destination containing index data for each level back to back; lod_index_counts[i] receives the number of indices in level i.
+ * The resulting index buffers reference vertices from the original vertex buffer.
+ *
+ * destination must contain enough space for all levels, worst case is index_count * lod_count elements
+ * target_index_counts and target_errors specify the goal for each level; levels are simplified in order, so counts should be decreasing and errors should be increasing
+ * lod_errors can be NULL; when it's not NULL, it will contain a conservative estimate of the (relative) error for each level with respect to the source mesh
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifySloppyLods(unsigned int* destination, size_t* lod_index_counts, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, float* lod_errors);
+
 /**
  * Experimental: Point cloud simplifier
  * Reduces the number of points in the cloud to reach the given target
@@ -365,6 +618,45 @@ MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifySloppy(unsigned int* destinati
  */
 MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_vertex_count);
 
+/**
+ * Experimental: Streaming point cloud simplifier state
+ * Used to simplify point clouds that don't fit in memory; see meshopt_simplifyPointsStreamAdd.
+ * To initialize the stream, point data to a buffer of meshopt_simplifyPointsStreamBound(cell_capacity) bytes (aligned to 4 bytes), set cell_capacity, target_vertex_count and the bounds of all points.
+ * cell_capacity limits the number of cells accumulated during the first pass and must be at least target_vertex_count; larger values make the result closer to meshopt_simplifyPoints.
+ */
+struct meshopt_SimplifyPointsStream
+{
+	void* data;
+	size_t cell_capacity;
+	size_t target_vertex_count;
+
+	float bounds_min[3];
+	float bounds_max[3];
+
+	/* state managed by meshopt_simplifyPointsStreamBegin/Add */
+	unsigned int pass;
+	unsigned int level;
+	size_t cell_count;
+	size_t group_count;
+	size_t vertex_count;
+};
+
+/**
+ * Experimental: Streaming point cloud simplifier
+ * Points are processed in two passes; each pass is started by calling meshopt_simplifyPointsStreamBegin with the pass index (0, then 1), followed by feeding all points in the same order in batches of any size through meshopt_simplifyPointsStreamAdd.
+ * The first pass accumulates points into cells of a grid that is coarsened as needed to stay within cell_capacity; the second pass groups the cells to reach the target and selects the best point for each group.
+ * Only per-cell data is kept in memory; temporary memory proportional to the batch size is allocated by each meshopt_simplifyPointsStreamAdd call. The result doesn't depend on the batch size or the dispatcher.
+ * meshopt_simplifyPointsStreamEnd returns the number of points after simplification (at most target_vertex_count), with destination containing indices of the points in the order they were fed.
+ *
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ * dispatch can be NULL; when it's not NULL, it is used to quantize and evaluate points of each batch using multiple tasks (see meshopt_Dispatch)
+ * destination must contain enough space for the resulting index buffer (target_vertex_count elements)
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyPointsStreamBound(size_t cell_capacity);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_simplifyPointsStreamBegin(struct meshopt_SimplifyPointsStream* stream, unsigned int pass);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_simplifyPointsStreamAdd(struct meshopt_SimplifyPointsStream* stream, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyPointsStreamEnd(const struct meshopt_SimplifyPointsStream* stream, unsigned int* destination);
+
 /**
  * Returns the error scaling factor used by the simplifier to convert between absolute and relative extents
  *
@@ -386,6 +678,18 @@ MESHOPTIMIZER_API float meshopt_simplifyScale(const float* vertex_positions, siz
 MESHOPTIMIZER_API size_t meshopt_stripify(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index);
 MESHOPTIMIZER_API size_t meshopt_stripifyBound(size_t index_count);
 
+/**
+ * Experimental: Mesh stripifier with triangle adjacency
+ * Converts a triangle list to triangle strip, similarly to meshopt_stripify, but finds strip continuations among all remaining triangles using full triangle adjacency instead of a small window of input triangles
+ * Returns the number of indices in the resulting strip, with destination containing new index data
+ * This produces longer strips, and as such fewer restart indices or degenerate triangles, regardless of input triangle order, at the cost of reordering triangles more aggressively; runs in linear time.
+ * The input doesn't need to be optimized for vertex cache, but the resulting strip is typically less vertex cache efficient than the output of meshopt_stripify on vertex cache optimized input.
+ *
+ * destination must contain enough space for the target index buffer, worst case can be computed with meshopt_stripifyBound
+ * restart_index should be 0xffff or 0xffffffff depending on index size, or 0 to use degenerate triangles
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_stripifyAdjacency(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index);
+
 /**
  * Mesh unstripifier
  * Converts a triangle strip to a triangle list
@@ -427,6 +731,17 @@ struct meshopt_OverdrawStatistics
  */
 MESHOPTIMIZER_API struct meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+/**
+ * Experimental: Parallel overdraw analyzer
+ * Returns overdraw statistics using a software rasterizer with a configurable resolution; each of the three axial views is rasterized in parallel using the supplied dispatcher.
+ * With resolution=256, produces the same result as meshopt_analyzeOverdraw; lower resolutions are faster but less accurate. dispatch may be NULL, in which case all views are processed serially.
+ * Note that the allocation callbacks may be called from multiple threads concurrently.
+ *
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ * resolution must be in [1..1024] range
+ */
+MESHOPTIMIZER_EXPERIMENTAL struct meshopt_OverdrawStatistics meshopt_analyzeOverdrawParallel(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int resolution, meshopt_Dispatch dispatch, void* context);
+
 struct meshopt_VertexFetchStatistics
 {
 	unsigned int bytes_fetched;
@@ -440,6 +755,24 @@ struct meshopt_VertexFetchStatistics
  */
 MESHOPTIMIZER_API struct meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const unsigned int* indices, size_t index_count, size_t vertex_count, size_t vertex_size);
 
+struct meshopt_MeshStatistics
+{
+	struct meshopt_VertexCacheStatistics vertex_cache;
+	struct meshopt_VertexFetchStatistics vertex_fetch;
+	struct meshopt_OverdrawStatistics overdraw;
+};
+
+/**
+ * Experimental: Combined mesh analyzer
+ * Returns the same statistics as meshopt_analyzeVertexCache, meshopt_analyzeVertexFetch and meshopt_analyzeOverdraw, computed in a single traversal of the index buffer.
+ * Results may not match actual GPU performance
+ *
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ * warp_vertex_histogram can be NULL; otherwise it must contain warp_size+1 elements and receives the number of warps that transformed each number of vertices (requires warp_size > 0)
+ * warp_triangle_histogram can be NULL; otherwise it must contain primgroup_size+1 elements and receives the number of warps that processed each number of triangles (requires primgroup_size > 0)
+ */
+MESHOPTIMIZER_EXPERIMENTAL struct meshopt_MeshStatistics meshopt_analyzeMesh(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t vertex_size, unsigned int cache_size, unsigned int warp_size, unsigned int primgroup_size, unsigned int* warp_vertex_histogram, unsigned int* warp_triangle_histogram);
+
 struct meshopt_Meshlet
 {
 	/* offsets within meshlet_vertices and meshlet_triangles arrays with meshlet data */
@@ -469,6 +802,30 @@ MESHOPTIMIZER_API size_t meshopt_buildMeshlets(struct meshopt_Meshlet* meshlets,
 MESHOPTIMIZER_API size_t meshopt_buildMeshletsScan(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, size_t vertex_count, size_t max_vertices, size_t max_triangles);
 MESHOPTIMIZER_API size_t meshopt_buildMeshletsBound(size_t index_count, size_t max_vertices, size_t max_triangles);
 
+/**
+ * Experimental: Incremental meshlet builder
+ * Replaces dirty meshlets with new meshlets built using meshopt_buildMeshlets from the supplied triangles, and keeps all other meshlets; this is useful to update meshlets after local edits without rebuilding the entire mesh.
+ * When indices is NULL, the triangles of the dirty meshlets are reused, which keeps the meshlets valid after position-only edits while restoring their spatial coherence.
+ * Remaining meshlets are moved to the beginning of the arrays in their original order, followed by new meshlets; returns the new meshlet count.
+ *
+ * meshlets, meshlet_vertices and meshlet_triangles must contain meshlet data laid out in meshlet order (as produced by meshopt_buildMeshlets) and must have enough space for meshlet_count + meshopt_buildMeshletsBound(index_count, max_vertices, max_triangles) meshlets (see meshopt_buildMeshlets);
+ * when indices is NULL, index_count is ignored and the triangle count of all dirty meshlets is used instead
+ * max_vertices, max_triangles and cone_weight have the same meaning as in meshopt_buildMeshlets and should match the values used to build the existing meshlets
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsIncremental(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, size_t meshlet_count, const unsigned int* dirty_meshlets, size_t dirty_count, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight);
+
+/**
+ * Experimental: Parallel meshlet builder
+ * Splits the mesh into spatially coherent partitions and builds meshlets for each partition in parallel using the supplied dispatcher; the results are concatenated using the same layout as meshopt_buildMeshlets.
+ * Meshlets don't cross partition boundaries, so the result is slightly less efficient than the one produced by meshopt_buildMeshlets; meshes that are too small to be partitioned are processed serially and produce the same result.
+ * The allocation callbacks may be called from multiple threads concurrently.
+ *
+ * meshlets must contain enough space for all meshlets, worst case size can be computed with meshopt_buildMeshletsParallelBound
+ * meshlet_vertices and meshlet_triangles must contain enough space for all meshlets (see meshopt_buildMeshlets), using max_meshlets computed with meshopt_buildMeshletsParallelBound
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsParallel(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, meshopt_Dispatch dispatch, void* context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsParallelBound(size_t index_count, size_t max_vertices, size_t max_triangles);
+
 struct meshopt_Bounds
 {
 	/* bounding sphere, useful for frustum and occlusion culling */
@@ -509,6 +866,104 @@ struct meshopt_Bounds
 MESHOPTIMIZER_API struct meshopt_Bounds meshopt_computeClusterBounds(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 MESHOPTIMIZER_API struct meshopt_Bounds meshopt_computeMeshletBounds(const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, size_t triangle_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+/**
+ * Experimental: Batched meshlet bounds generator
+ * Computes bounds for all meshlets, producing the same results as calling meshopt_computeMeshletBounds for each meshlet; meshlets are processed in blocks in parallel using the supplied dispatcher, or serially if dispatch is NULL.
+ *
+ * bounds must contain enough space for meshlet_count elements
+ * vertex_positions should have float3 position in the first 12 bytes of each vertex
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_computeMeshletBoundsBatch(struct meshopt_Bounds* bounds, const struct meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Compact meshlet culling data
+ * Bounding sphere is quantized to 16-bit UNORM relative to a box that contains the mesh (box_min, box_min + box_size in every axis); normal cone uses 8-bit SNORM.
+ * To decode, use center = box_min + center_u16 * (box_size / 65535) and radius = radius_u16 * (box_size / 65535); the decoded sphere always contains the original bounding sphere when radius_u16 < 65535.
+ * Radii that don't fit (which requires the sphere radius to be close to box_size, e.g. for a meshlet that spans most of the box) are clamped to 65535; such meshlets should be treated as always visible by sphere culling.
+ * The cone apex is not stored, so backface culling needs to use the cone_axis/cone_cutoff formulas that use the bounding sphere instead (see meshopt_computeClusterBounds).
+ */
+struct meshopt_MeshletCullData
+{
+	unsigned short center[3];
+	unsigned short radius;
+
+	signed char cone_axis_s8[3];
+	signed char cone_cutoff_s8;
+};
+
+/**
+ * Experimental: Batched meshlet culling data generator
+ * Computes bounds for all meshlets like meshopt_computeMeshletBoundsBatch, and writes them directly in the compact meshopt_MeshletCullData format (12 bytes per meshlet).
+ *
+ * cull_data must contain enough space for meshlet_count elements
+ * box_min and box_size should define a box that contains all vertex positions, for example box_size can be the largest dimension of the mesh bounding box
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_computeMeshletCullData(struct meshopt_MeshletCullData* cull_data, const struct meshopt_Meshlet* meshlets, size_t meshlet_count, const unsigned int* meshlet_vertices, const unsigned char* meshlet_triangles, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const float box_min[3], float box_size, meshopt_Dispatch dispatch, void* context);
+
+/**
+ * Experimental: Hierarchical cluster level of detail
+ * Each cluster is a meshlet with culling bounds; lod_bounds/lod_error describe the level of detail the cluster belongs to, and parent_bounds/parent_error describe the coarser level it was simplified into.
+ * Errors are absolute (in the units of vertex positions), and are monotonic: parent_error >= lod_error and parent_bounds contains lod_bounds.
+ * To select a consistent cut through the hierarchy, render every cluster where the projected error of lod_bounds/lod_error is acceptable and the projected error of parent_bounds/parent_error isn't.
+ */
+struct meshopt_ClusterLod
+{
+	struct meshopt_Meshlet meshlet;
+	struct meshopt_Bounds bounds;
+
+	/* level 0 contains clusters of the original mesh */
+	unsigned int level;
+
+	/* group of clusters this cluster was simplified with, ~0u if the cluster wasn't simplified further */
+	unsigned int group;
+
+	/* group this cluster was produced from, ~0u for clusters of the original mesh */
+	unsigned int refined;
+
+	float lod_bounds[4]; /* center and radius */
+	float lod_error;
+
+	float parent_bounds[4]; /* center and radius */
+	float parent_error;     /* FLT_MAX if the cluster wasn't simplified further */
+};
+
+/**
+ * Experimental: Cluster hierarchy builder
+ * Splits the mesh into clusters, then repeatedly merges neighboring clusters into groups, simplifies each group with the group border locked, and splits the result into new clusters.
+ * The clusters of all levels form a DAG, where the clusters of each group are replaced by the clusters produced from it (with refined equal to the group index); see meshopt_ClusterLod for details.
+ * Returns the total number of clusters; cluster_vertices and cluster_triangles use the same layout as the output of meshopt_buildMeshlets.
+ *
+ * clusters must contain enough space for all clusters, worst case size can be computed with meshopt_buildClusterLodBound
+ * cluster_vertices must contain enough space for all clusters, worst case size is equal to max_clusters * max_vertices
+ * cluster_triangles must contain enough space for all clusters, worst case size is equal to max_clusters * max_triangles * 3
+ * max_vertices and max_triangles have the same limits as in meshopt_buildMeshlets
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildClusterLod(struct meshopt_ClusterLod* clusters, unsigned int* cluster_vertices, unsigned char* cluster_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildClusterLodBound(size_t index_count, size_t max_vertices, size_t max_triangles);
+
+/**
+ * Experimental: Meshlet encoder
+ * Encodes vertex and triangle data of a single meshlet into an array of bytes that is generally much smaller (~1-1.5 bytes/triangle for triangles, ~1 byte/vertex for vertices) and compresses better compared to original.
+ * Vertex indices are delta-encoded, and triangles are encoded using a FIFO of recent edges and local vertices; decoding preserves vertex order and triangle order but may rotate vertices within each triangle (preserving winding).
+ * Returns encoded data size on success, 0 on error; the only error condition is if buffer doesn't have enough space
+ * For maximum efficiency the mesh should be optimized for vertex fetch before building meshlets, and meshlet vertices should be ordered by first use (which meshopt_buildMeshlets does).
+ *
+ * buffer must contain enough space for the encoded meshlet (use meshopt_encodeMeshletBound to compute worst case size)
+ * vertex_count must be <= 256, and triangles must contain triangle_count*3 local vertex indices
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeMeshlet(unsigned char* buffer, size_t buffer_size, const unsigned int* vertices, size_t vertex_count, const unsigned char* triangles, size_t triangle_count);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_encodeMeshletBound(size_t max_vertices, size_t max_triangles);
+
+/**
+ * Experimental: Meshlet decoder
+ * Decodes meshlet data from an array of bytes generated by meshopt_encodeMeshlet; vertex_count and triangle_count must match the values used for encoding.
+ * Returns 0 if decoding was successful, and an error code otherwise
+ * The decoder is safe to use for untrusted input, but it may produce garbage data (e.g. out of range indices).
+ *
+ * vertices must contain enough space for vertex_count elements, triangles must contain enough space for triangle_count*3 elements
+ */
+MESHOPTIMIZER_EXPERIMENTAL int meshopt_decodeMeshlet(unsigned int* vertices, size_t vertex_count, unsigned char* triangles, size_t triangle_count, const unsigned char* buffer, size_t buffer_size);
+
 /**
  * Experimental: Spatial sorter
  * Generates a remap table that can be used to reorder points for spatial locality.
@@ -518,6 +973,12 @@ MESHOPTIMIZER_API struct meshopt_Bounds meshopt_computeMeshletBounds(const unsig
  */
 MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortRemap(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+/**
+ * Experimental: Parallel spatial sorter
+ * Produces the same result as meshopt_spatialSortRemap, computing Morton codes and running radix sort passes over blocks of points in parallel using the supplied dispatcher.
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortRemapParallel(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Experimental: Spatial sorter
  * Reorders triangles for spatial locality, and generates a new index buffer. The resulting index buffer can be used with other functions like optimizeVertexCache.
@@ -527,6 +988,51 @@ MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortRemap(unsigned int* destinati
  */
 MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortTriangles(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 
+/**
+ * Experimental: Context-based variants of common algorithms
+ * These functions produce the same results as the functions without the WithContext suffix, but allocate temporary memory from the context (see meshopt_Context).
+ * context may be NULL, in which case the allocation callbacks are used.
+ * The matching *ScratchBound functions return the scratch size (in bytes) that is sufficient to process a mesh of the given size without heap allocations.
+ */
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateVertexRemapWithContext(unsigned int* destination, const unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, struct meshopt_Context* context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_generateVertexRemapScratchBound(size_t vertex_count);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeVertexCacheWithContext(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, struct meshopt_Context* context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_optimizeVertexCacheScratchBound(size_t index_count, size_t vertex_count);
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeOverdrawWithContext(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold, struct meshopt_Context* context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_optimizeOverdrawScratchBound(size_t index_count, size_t vertex_count);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_optimizeVertexFetchWithContext(void* destination, unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, struct meshopt_Context* context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_optimizeVertexFetchScratchBound(size_t vertex_count, size_t vertex_size);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsWithContext(struct meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, struct meshopt_Context* context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_buildMeshletsScratchBound(size_t index_count, size_t vertex_count);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyWithContext(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* result_error, struct meshopt_Context* context);
+MESHOPTIMIZER_EXPERIMENTAL size_t meshopt_simplifyScratchBound(size_t index_count, size_t vertex_count);
+
+/**
+ * Experimental: Mesh description for batch optimization
+ * Each mesh uses a 32-bit index buffer and a single interleaved vertex buffer with float3 positions at vertex_positions_offset bytes into each vertex.
+ */
+struct meshopt_BatchMesh
+{
+	unsigned int* indices;
+	size_t index_count;
+
+	void* vertices;
+	size_t vertex_count;
+	size_t vertex_size;
+	size_t vertex_positions_offset;
+};
+
+/**
+ * Experimental: Batch mesh optimizer
+ * Runs the standard optimization pipeline (meshopt_optimizeVertexCache, meshopt_optimizeOverdraw and meshopt_optimizeVertexFetch) in place for each mesh, which is much faster than calling these functions for each small mesh separately.
+ * Meshes are split into groups of similar total size that reuse one scratch allocation; when dispatch is not NULL, groups are processed in parallel using the supplied dispatcher.
+ * After optimization, vertex_count of each mesh is set to the number of vertices referenced by its index buffer; contents of the vertex buffer past that count are unspecified.
+ *
+ * overdraw_threshold is passed to meshopt_optimizeOverdraw (e.g. 1.05); overdraw optimization is skipped if it's 0
+ * vertex_size must be a multiple of 4 and vertex_positions_offset + 12 must not exceed it
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_optimizeMeshBatch(struct meshopt_BatchMesh* meshes, size_t mesh_count, float overdraw_threshold, meshopt_Dispatch dispatch, void* context);
+
 /**
  * Set allocation callbacks
  * These callbacks will be used instead of the default operator new/operator delete for all temporary allocations in the library.
@@ -535,6 +1041,25 @@ MESHOPTIMIZER_EXPERIMENTAL void meshopt_spatialSortTriangles(unsigned int* desti
  */
 MESHOPTIMIZER_API void meshopt_setAllocator(void* (MESHOPTIMIZER_ALLOC_CALLCONV *allocate)(size_t), void (MESHOPTIMIZER_ALLOC_CALLCONV *deallocate)(void*));
 
+enum
+{
+    /* Start of an internal phase; name identifies the phase */
+    meshopt_ProfileBegin,
+    /* End of an internal phase; always matches the preceding meshopt_ProfileBegin with the same name */
+    meshopt_ProfileEnd,
+    /* Work counter for the enclosing phase; value contains the counter value */
+    meshopt_ProfileCounter,
+};
+
+/**
+ * Experimental: Set profiling callback
+ * When the library is compiled with MESHOPTIMIZER_PROFILE=1, simplification and clustering algorithms report the begin/end of their internal phases (such as "simplify.classifyVertices") and work counters (such as "simplify.passes") via this callback, which makes it possible to attribute time in external tracing tools.
+ * By default the instrumentation is compiled out and the callback is never invoked.
+ * name is a static string; value is the counter value for meshopt_ProfileCounter events and 0 otherwise.
+ * The callback may be invoked concurrently from multiple threads by functions that accept meshopt_Dispatch. callback may be NULL to disable profiling.
+ */
+MESHOPTIMIZER_EXPERIMENTAL void meshopt_setProfiler(void (*callback)(void* context, int event, const char* name, size_t value), void* context);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -595,8 +1120,22 @@ inline void meshopt_generateAdjacencyIndexBuffer(T* destination, const T* indice
 template <typename T>
 inline void meshopt_generateTessellationIndexBuffer(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 template <typename T>
+inline size_t meshopt_generateVertexRemapParallel(unsigned int* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Dispatch dispatch, void* context);
+template <typename T>
+inline void meshopt_generateShadowIndexBufferParallel(T* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, size_t vertex_stride, meshopt_Dispatch dispatch, void* context);
+template <typename T>
+inline void meshopt_generateAdjacencyIndexBufferParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+template <typename T>
+inline void meshopt_generateTessellationIndexBufferParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+template <typename T>
 inline void meshopt_optimizeVertexCache(T* destination, const T* indices, size_t index_count, size_t vertex_count);
 template <typename T>
+inline void meshopt_optimizeVertexCacheParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context);
+template <typename T>
+inline void meshopt_optimizeVertexCacheTable(T* destination, const T* indices, size_t index_count, size_t vertex_count, const meshopt_VertexScoreTable* table);
+template <typename T>
+inline size_t meshopt_optimizeVertexCacheIncremental(T* destination, const T* indices, size_t index_count, size_t vertex_count, const unsigned int* dirty_triangles, size_t dirty_count);
+template <typename T>
 inline void meshopt_optimizeVertexCacheStrip(T* destination, const T* indices, size_t index_count, size_t vertex_count);
 template <typename T>
 inline void meshopt_optimizeVertexCacheFifo(T* destination, const T* indices, size_t index_count, size_t vertex_count, unsigned int cache_size);
@@ -605,8 +1144,12 @@ inline void meshopt_optimizeOverdraw(T* destination, const T* indices, size_t in
 template <typename T>
 inline size_t meshopt_optimizeVertexFetchRemap(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count);
 template <typename T>
+inline size_t meshopt_optimizeVertexFetchRemapIncremental(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count, const unsigned int* dirty_vertices, size_t dirty_count);
+template <typename T>
 inline size_t meshopt_optimizeVertexFetch(void* destination, T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size);
 template <typename T>
+inline size_t meshopt_optimizeVertexFetchMulti(void* const* destinations, T* indices, size_t index_count, size_t vertex_count, const meshopt_Stream* streams, size_t stream_count);
+template <typename T>
 inline size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, const T* indices, size_t index_count);
 template <typename T>
 inline int meshopt_decodeIndexBuffer(T* destination, size_t index_count, const unsigned char* buffer, size_t buffer_size);
@@ -617,22 +1160,38 @@ inline int meshopt_decodeIndexSequence(T* destination, size_t index_count, const
 template <typename T>
 inline size_t meshopt_simplify(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options = 0, float* result_error = 0);
 template <typename T>
+inline size_t meshopt_simplifyLods(T* destination, size_t* lod_index_counts, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options = 0, float* lod_errors = 0);
+template <typename T>
+inline size_t meshopt_simplifyParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* result_error, meshopt_Dispatch dispatch, void* context);
+template <typename T>
 inline size_t meshopt_simplifySloppy(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error = 0);
 template <typename T>
+inline size_t meshopt_simplifySloppyLods(T* destination, size_t* lod_index_counts, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, float* lod_errors = 0);
+template <typename T>
 inline size_t meshopt_stripify(T* destination, const T* indices, size_t index_count, size_t vertex_count, T restart_index);
 template <typename T>
+inline size_t meshopt_stripifyAdjacency(T* destination, const T* indices, size_t index_count, size_t vertex_count, T restart_index);
+template <typename T>
 inline size_t meshopt_unstripify(T* destination, const T* indices, size_t index_count, T restart_index);
 template <typename T>
 inline meshopt_VertexCacheStatistics meshopt_analyzeVertexCache(const T* indices, size_t index_count, size_t vertex_count, unsigned int cache_size, unsigned int warp_size, unsigned int buffer_size);
 template <typename T>
 inline meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 template <typename T>
+inline meshopt_OverdrawStatistics meshopt_analyzeOverdrawParallel(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int resolution, meshopt_Dispatch dispatch, void* context);
+template <typename T>
 inline meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const T* indices, size_t index_count, size_t vertex_count, size_t vertex_size);
 template <typename T>
+inline meshopt_MeshStatistics meshopt_analyzeMesh(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t vertex_size, unsigned int cache_size, unsigned int warp_size, unsigned int primgroup_size, unsigned int* warp_vertex_histogram = 0, unsigned int* warp_triangle_histogram = 0);
+template <typename T>
 inline size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight);
 template <typename T>
+inline size_t meshopt_buildMeshletsParallel(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, meshopt_Dispatch dispatch, void* context);
+template <typename T>
 inline size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, size_t vertex_count, size_t max_vertices, size_t max_triangles);
 template <typename T>
+inline size_t meshopt_buildClusterLod(meshopt_ClusterLod* clusters, unsigned int* cluster_vertices, unsigned char* cluster_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles);
+template <typename T>
 inline meshopt_Bounds meshopt_computeClusterBounds(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
 template <typename T>
 inline void meshopt_spatialSortTriangles(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride);
@@ -724,6 +1283,16 @@ public:
 	meshopt_Allocator()
 		: blocks()
 		, count(0)
+		, context(0)
+		, mark(0)
+	{
+	}
+
+	explicit meshopt_Allocator(meshopt_Context* context_)
+		: blocks()
+		, count(0)
+		, context(context_)
+		, mark(context_ ? context_->size : 0)
 	{
 	}
 
@@ -731,24 +1300,87 @@ public:
 	{
 		for (size_t i = count; i > 0; --i)
 			Storage::deallocate(blocks[i - 1]);
+
+		// scratch memory is released in stack order as well
+		if (context)
+			context->size = mark;
 	}
 
 	template <typename T> T* allocate(size_t size)
 	{
+		size_t bytes = size > size_t(-1) / sizeof(T) ? size_t(-1) : size * sizeof(T);
+
+		if (context)
+		{
+			size_t offset = context->size > size_t(-1) - 15 ? size_t(-1) : scratch<unsigned char>(context->size);
+
+			// note: size keeps growing past capacity to make sure peak reflects the total amount of memory required
+			context->size = bytes > size_t(-1) - offset ? size_t(-1) : offset + bytes;
+			context->peak = context->size > context->peak ? context->size : context->peak;
+
+			if (offset <= context->capacity && bytes <= context->capacity - offset)
+				return reinterpret_cast<T*>(static_cast<unsigned char*>(context->data) + offset);
+		}
+
 		assert(count < sizeof(blocks) / sizeof(blocks[0]));
-		T* result = static_cast<T*>(Storage::allocate(size > size_t(-1) / sizeof(T) ? size_t(-1) : size * sizeof(T)));
+		T* result = static_cast<T*>(Storage::allocate(bytes));
 		blocks[count++] = result;
 		return result;
 	}
 
+	// returns the amount of scratch memory that an allocation of size elements requires
+	template <typename T> static size_t scratch(size_t size)
+	{
+		return (size * sizeof(T) + 15) & ~size_t(15);
+	}
+
 private:
 	void* blocks[24];
 	size_t count;
+
+	meshopt_Context* context;
+	size_t mark;
 };
 
 // This makes sure that allocate/deallocate are lazily generated in translation units that need them and are deduplicated by the linker
 template <typename T> void* (MESHOPTIMIZER_ALLOC_CALLCONV *meshopt_Allocator::StorageT<T>::allocate)(size_t) = operator new;
 template <typename T> void (MESHOPTIMIZER_ALLOC_CALLCONV *meshopt_Allocator::StorageT<T>::deallocate)(void*) = operator delete;
+
+#ifndef MESHOPTIMIZER_PROFILE
+#define MESHOPTIMIZER_PROFILE 0
+#endif
+
+class meshopt_Profiler
+{
+public:
+	template <typename T>
+	struct StorageT
+	{
+		static void (*callback)(void*, int, const char*, size_t);
+		static void* context;
+	};
+
+	typedef StorageT<void> Storage;
+
+	static void emit(int event, const char* name, size_t value)
+	{
+		if (Storage::callback)
+			Storage::callback(Storage::context, event, name, value);
+	}
+};
+
+template <typename T> void (*meshopt_Profiler::StorageT<T>::callback)(void*, int, const char*, size_t) = 0;
+template <typename T> void* meshopt_Profiler::StorageT<T>::context = 0;
+
+#if MESHOPTIMIZER_PROFILE
+#define MESHOPTIMIZER_PROFILE_BEGIN(name) meshopt_Profiler::emit(meshopt_ProfileBegin, name, 0)
+#define MESHOPTIMIZER_PROFILE_END(name) meshopt_Profiler::emit(meshopt_ProfileEnd, name, 0)
+#define MESHOPTIMIZER_PROFILE_COUNTER(name, value) meshopt_Profiler::emit(meshopt_ProfileCounter, name, value)
+#else
+#define MESHOPTIMIZER_PROFILE_BEGIN(name) (void)0
+#define MESHOPTIMIZER_PROFILE_END(name) (void)0
+#define MESHOPTIMIZER_PROFILE_COUNTER(name, value) (void)0
+#endif
 #endif
 
 /* Inline implementation for C++ templated wrappers */
@@ -863,6 +1495,41 @@ inline void meshopt_generateTessellationIndexBuffer(T* destination, const T* ind
 	meshopt_generateTessellationIndexBuffer(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride);
 }
 
+template <typename T>
+inline size_t meshopt_generateVertexRemapParallel(unsigned int* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_IndexAdapter<T> in(0, indices, indices ? index_count : 0);
+
+	return meshopt_generateVertexRemapParallel(destination, indices ? in.data : 0, index_count, vertices, vertex_count, vertex_size, dispatch, context);
+}
+
+template <typename T>
+inline void meshopt_generateShadowIndexBufferParallel(T* destination, const T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, size_t vertex_stride, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count);
+
+	meshopt_generateShadowIndexBufferParallel(out.data, in.data, index_count, vertices, vertex_count, vertex_size, vertex_stride, dispatch, context);
+}
+
+template <typename T>
+inline void meshopt_generateAdjacencyIndexBufferParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count * 2);
+
+	meshopt_generateAdjacencyIndexBufferParallel(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, dispatch, context);
+}
+
+template <typename T>
+inline void meshopt_generateTessellationIndexBufferParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count * 4);
+
+	meshopt_generateTessellationIndexBufferParallel(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, dispatch, context);
+}
+
 template <typename T>
 inline void meshopt_optimizeVertexCache(T* destination, const T* indices, size_t index_count, size_t vertex_count)
 {
@@ -872,6 +1539,33 @@ inline void meshopt_optimizeVertexCache(T* destination, const T* indices, size_t
 	meshopt_optimizeVertexCache(out.data, in.data, index_count, vertex_count);
 }
 
+template <typename T>
+inline void meshopt_optimizeVertexCacheParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count);
+
+	meshopt_optimizeVertexCacheParallel(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, dispatch, context);
+}
+
+template <typename T>
+inline void meshopt_optimizeVertexCacheTable(T* destination, const T* indices, size_t index_count, size_t vertex_count, const meshopt_VertexScoreTable* table)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count);
+
+	meshopt_optimizeVertexCacheTable(out.data, in.data, index_count, vertex_count, table);
+}
+
+template <typename T>
+inline size_t meshopt_optimizeVertexCacheIncremental(T* destination, const T* indices, size_t index_count, size_t vertex_count, const unsigned int* dirty_triangles, size_t dirty_count)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count);
+
+	return meshopt_optimizeVertexCacheIncremental(out.data, in.data, index_count, vertex_count, dirty_triangles, dirty_count);
+}
+
 template <typename T>
 inline void meshopt_optimizeVertexCacheStrip(T* destination, const T* indices, size_t index_count, size_t vertex_count)
 {
@@ -907,6 +1601,14 @@ inline size_t meshopt_optimizeVertexFetchRemap(unsigned int* destination, const
 	return meshopt_optimizeVertexFetchRemap(destination, in.data, index_count, vertex_count);
 }
 
+template <typename T>
+inline size_t meshopt_optimizeVertexFetchRemapIncremental(unsigned int* destination, const T* indices, size_t index_count, size_t vertex_count, const unsigned int* dirty_vertices, size_t dirty_count)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+
+	return meshopt_optimizeVertexFetchRemapIncremental(destination, in.data, index_count, vertex_count, dirty_vertices, dirty_count);
+}
+
 template <typename T>
 inline size_t meshopt_optimizeVertexFetch(void* destination, T* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size)
 {
@@ -915,6 +1617,14 @@ inline size_t meshopt_optimizeVertexFetch(void* destination, T* indices, size_t
 	return meshopt_optimizeVertexFetch(destination, inout.data, index_count, vertices, vertex_count, vertex_size);
 }
 
+template <typename T>
+inline size_t meshopt_optimizeVertexFetchMulti(void* const* destinations, T* indices, size_t index_count, size_t vertex_count, const meshopt_Stream* streams, size_t stream_count)
+{
+	meshopt_IndexAdapter<T> inout(indices, indices, index_count);
+
+	return meshopt_optimizeVertexFetchMulti(destinations, inout.data, index_count, vertex_count, streams, stream_count);
+}
+
 template <typename T>
 inline size_t meshopt_encodeIndexBuffer(unsigned char* buffer, size_t buffer_size, const T* indices, size_t index_count)
 {
@@ -958,6 +1668,24 @@ inline size_t meshopt_simplify(T* destination, const T* indices, size_t index_co
 	return meshopt_simplify(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, target_index_count, target_error, options, result_error);
 }
 
+template <typename T>
+inline size_t meshopt_simplifyLods(T* destination, size_t* lod_index_counts, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options, float* lod_errors)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count * lod_count);
+
+	return meshopt_simplifyLods(out.data, lod_index_counts, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, target_index_counts, target_errors, lod_count, options, lod_errors);
+}
+
+template <typename T>
+inline size_t meshopt_simplifyParallel(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* result_error, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count);
+
+	return meshopt_simplifyParallel(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, target_index_count, target_error, options, result_error, dispatch, context);
+}
+
 template <typename T>
 inline size_t meshopt_simplifySloppy(T* destination, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* result_error)
 {
@@ -967,6 +1695,15 @@ inline size_t meshopt_simplifySloppy(T* destination, const T* indices, size_t in
 	return meshopt_simplifySloppy(out.data, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, target_index_count, target_error, result_error);
 }
 
+template <typename T>
+inline size_t meshopt_simplifySloppyLods(T* destination, size_t* lod_index_counts, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, float* lod_errors)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, index_count * lod_count);
+
+	return meshopt_simplifySloppyLods(out.data, lod_index_counts, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, target_index_counts, target_errors, lod_count, lod_errors);
+}
+
 template <typename T>
 inline size_t meshopt_stripify(T* destination, const T* indices, size_t index_count, size_t vertex_count, T restart_index)
 {
@@ -976,6 +1713,15 @@ inline size_t meshopt_stripify(T* destination, const T* indices, size_t index_co
 	return meshopt_stripify(out.data, in.data, index_count, vertex_count, unsigned(restart_index));
 }
 
+template <typename T>
+inline size_t meshopt_stripifyAdjacency(T* destination, const T* indices, size_t index_count, size_t vertex_count, T restart_index)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+	meshopt_IndexAdapter<T> out(destination, 0, (index_count / 3) * 5);
+
+	return meshopt_stripifyAdjacency(out.data, in.data, index_count, vertex_count, unsigned(restart_index));
+}
+
 template <typename T>
 inline size_t meshopt_unstripify(T* destination, const T* indices, size_t index_count, T restart_index)
 {
@@ -1001,6 +1747,14 @@ inline meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const T* indices, size
 	return meshopt_analyzeOverdraw(in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride);
 }
 
+template <typename T>
+inline meshopt_OverdrawStatistics meshopt_analyzeOverdrawParallel(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int resolution, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+
+	return meshopt_analyzeOverdrawParallel(in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, resolution, dispatch, context);
+}
+
 template <typename T>
 inline meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const T* indices, size_t index_count, size_t vertex_count, size_t vertex_size)
 {
@@ -1009,6 +1763,14 @@ inline meshopt_VertexFetchStatistics meshopt_analyzeVertexFetch(const T* indices
 	return meshopt_analyzeVertexFetch(in.data, index_count, vertex_count, vertex_size);
 }
 
+template <typename T>
+inline meshopt_MeshStatistics meshopt_analyzeMesh(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t vertex_size, unsigned int cache_size, unsigned int warp_size, unsigned int primgroup_size, unsigned int* warp_vertex_histogram, unsigned int* warp_triangle_histogram)
+{
+	meshopt_IndexAdapter<T> in(NULL, indices, index_count);
+
+	return meshopt_analyzeMesh(in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, vertex_size, cache_size, warp_size, primgroup_size, warp_vertex_histogram, warp_triangle_histogram);
+}
+
 template <typename T>
 inline size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight)
 {
@@ -1017,6 +1779,14 @@ inline size_t meshopt_buildMeshlets(meshopt_Meshlet* meshlets, unsigned int* mes
 	return meshopt_buildMeshlets(meshlets, meshlet_vertices, meshlet_triangles, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight);
 }
 
+template <typename T>
+inline size_t meshopt_buildMeshletsParallel(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles, float cone_weight, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+
+	return meshopt_buildMeshletsParallel(meshlets, meshlet_vertices, meshlet_triangles, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles, cone_weight, dispatch, context);
+}
+
 template <typename T>
 inline size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int* meshlet_vertices, unsigned char* meshlet_triangles, const T* indices, size_t index_count, size_t vertex_count, size_t max_vertices, size_t max_triangles)
 {
@@ -1025,6 +1795,14 @@ inline size_t meshopt_buildMeshletsScan(meshopt_Meshlet* meshlets, unsigned int*
 	return meshopt_buildMeshletsScan(meshlets, meshlet_vertices, meshlet_triangles, in.data, index_count, vertex_count, max_vertices, max_triangles);
 }
 
+template <typename T>
+inline size_t meshopt_buildClusterLod(meshopt_ClusterLod* clusters, unsigned int* cluster_vertices, unsigned char* cluster_triangles, const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t max_vertices, size_t max_triangles)
+{
+	meshopt_IndexAdapter<T> in(0, indices, index_count);
+
+	return meshopt_buildClusterLod(clusters, cluster_vertices, cluster_triangles, in.data, index_count, vertex_positions, vertex_count, vertex_positions_stride, max_vertices, max_triangles);
+}
+
 template <typename T>
 inline meshopt_Bounds meshopt_computeClusterBounds(const T* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
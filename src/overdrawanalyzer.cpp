@@ -5,17 +5,64 @@
 #include <float.h>
 #include <string.h>
 
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// SSE2 is always available on x64 and can be enabled through compiler settings on x86
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE
+#endif
+
+// GCC/clang define these when NEON support is available
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SIMD_NEON
+#endif
+
+// On MSVC, we assume that ARM builds always target NEON-capable devices
+#if !defined(SIMD_NEON) && defined(_MSC_VER) && (defined(_M_ARM) || defined(_M_ARM64))
+#define SIMD_NEON
+#endif
+
+// When targeting Wasm SIMD we can't use runtime cpuid checks so we unconditionally enable SIMD
+#if defined(__wasm_simd128__)
+#define SIMD_WASM
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef SIMD_NEON
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef SIMD_WASM
+#include <wasm_simd128.h>
+#endif
+
 // This work is based on:
 // Nicolas Capens. Advanced Rasterization. 2004
 namespace meshopt
 {
 
-const int kViewport = 256;
+const unsigned int kViewport = 256;
+
+// fixed point edge equations overflow for larger viewports
+const unsigned int kViewportMax = 1024;
 
+// buffer rows are padded so that the rasterizer can process 4 pixels at a time; sign selects front-facing (0) or back-facing (1) triangles
 struct OverdrawBuffer
 {
-	float z[kViewport][kViewport][2];
-	unsigned int overdraw[kViewport][kViewport][2];
+	float* z[2];
+	unsigned int* overdraw[2];
+
+	int stride;
 };
 
 #ifndef min
@@ -42,29 +89,136 @@ static float computeDepthGradients(float& dzdx, float& dzdy, float x1, float y1,
 	return det;
 }
 
-// half-space fixed point triangle rasterizer
-static void rasterize(OverdrawBuffer* buffer, float v1x, float v1y, float v1z, float v2x, float v2y, float v2z, float v3x, float v3y, float v3z)
+static void rasterizeSpan(float* zrow, unsigned int* overdrawrow, int minx, int maxx, int CX1, int CX2, int CX3, int DX1, int DX2, int DX3, float ZX, float DZx)
 {
-	// compute depth gradients
-	float DZx, DZy;
-	float det = computeDepthGradients(DZx, DZy, v1x, v1y, v1z, v2x, v2y, v2z, v3x, v3y, v3z);
-	int sign = det > 0;
+	// depth is computed relative to the span start for every pixel (instead of incrementally) so that all code paths produce the same result
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	// rows are padded to a multiple of 4 pixels, so we can process aligned groups of 4 pixels and mask out the pixels outside of the span
+	int startx = minx & ~3;
+	int k = startx - minx;
 
-	// flip backfacing triangles to simplify rasterization logic
-	if (sign)
+#if defined(SIMD_SSE)
+	__m128i offset = _mm_setr_epi32(k, k + 1, k + 2, k + 3);
+	__m128i count = _mm_set1_epi32(maxx - minx);
+
+	__m128i e1 = _mm_setr_epi32(CX1 - DX1 * k, CX1 - DX1 * (k + 1), CX1 - DX1 * (k + 2), CX1 - DX1 * (k + 3));
+	__m128i e2 = _mm_setr_epi32(CX2 - DX2 * k, CX2 - DX2 * (k + 1), CX2 - DX2 * (k + 2), CX2 - DX2 * (k + 3));
+	__m128i e3 = _mm_setr_epi32(CX3 - DX3 * k, CX3 - DX3 * (k + 1), CX3 - DX3 * (k + 2), CX3 - DX3 * (k + 3));
+
+	__m128i e1step = _mm_set1_epi32(DX1 * 4), e2step = _mm_set1_epi32(DX2 * 4), e3step = _mm_set1_epi32(DX3 * 4);
+
+	for (int x = startx; x < maxx; x += 4)
 	{
-		// flipping v2 & v3 preserves depth gradients since they're based on v1
-		float t;
-		t = v2x, v2x = v3x, v3x = t;
-		t = v2y, v2y = v3y, v3y = t;
-		t = v2z, v2z = v3z, v3z = t;
+		// check if all edge values are non-negative and the pixel is inside the span
+		__m128i inside = _mm_cmpgt_epi32(_mm_or_si128(_mm_or_si128(e1, e2), e3), _mm_set1_epi32(-1));
+		inside = _mm_and_si128(inside, _mm_cmpgt_epi32(offset, _mm_set1_epi32(-1)));
+		inside = _mm_and_si128(inside, _mm_cmplt_epi32(offset, count));
 
-		// flip depth since we rasterize backfacing triangles to second buffer with reverse Z; only v1z is used below
-		v1z = kViewport - v1z;
-		DZx = -DZx;
-		DZy = -DZy;
+		__m128 z = _mm_add_ps(_mm_set1_ps(ZX), _mm_mul_ps(_mm_set1_ps(DZx), _mm_cvtepi32_ps(offset)));
+		__m128 zold = _mm_loadu_ps(zrow + x);
+
+		__m128 mask = _mm_and_ps(_mm_castsi128_ps(inside), _mm_cmpge_ps(z, zold));
+
+		_mm_storeu_ps(zrow + x, _mm_or_ps(_mm_and_ps(mask, z), _mm_andnot_ps(mask, zold)));
+
+		// mask is -1 for pixels that pass the depth test
+		__m128i overdraw = _mm_loadu_si128(reinterpret_cast<__m128i*>(overdrawrow + x));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(overdrawrow + x), _mm_sub_epi32(overdraw, _mm_castps_si128(mask)));
+
+		e1 = _mm_sub_epi32(e1, e1step);
+		e2 = _mm_sub_epi32(e2, e2step);
+		e3 = _mm_sub_epi32(e3, e3step);
+		offset = _mm_add_epi32(offset, _mm_set1_epi32(4));
 	}
+#elif defined(SIMD_NEON)
+	int32_t lanes[4] = {k, k + 1, k + 2, k + 3};
+	int32x4_t offset = vld1q_s32(lanes);
+	int32x4_t count = vdupq_n_s32(maxx - minx);
+
+	int32x4_t e1 = vsubq_s32(vdupq_n_s32(CX1), vmulq_n_s32(offset, DX1));
+	int32x4_t e2 = vsubq_s32(vdupq_n_s32(CX2), vmulq_n_s32(offset, DX2));
+	int32x4_t e3 = vsubq_s32(vdupq_n_s32(CX3), vmulq_n_s32(offset, DX3));
+
+	int32x4_t e1step = vdupq_n_s32(DX1 * 4), e2step = vdupq_n_s32(DX2 * 4), e3step = vdupq_n_s32(DX3 * 4);
+
+	for (int x = startx; x < maxx; x += 4)
+	{
+		// check if all edge values are non-negative and the pixel is inside the span
+		uint32x4_t inside = vcgeq_s32(vorrq_s32(vorrq_s32(e1, e2), e3), vdupq_n_s32(0));
+		inside = vandq_u32(inside, vcgeq_s32(offset, vdupq_n_s32(0)));
+		inside = vandq_u32(inside, vcltq_s32(offset, count));
+
+		float32x4_t z = vaddq_f32(vdupq_n_f32(ZX), vmulq_f32(vdupq_n_f32(DZx), vcvtq_f32_s32(offset)));
+		float32x4_t zold = vld1q_f32(zrow + x);
+
+		uint32x4_t mask = vandq_u32(inside, vcgeq_f32(z, zold));
+
+		vst1q_f32(zrow + x, vbslq_f32(mask, z, zold));
+
+		// mask is -1 for pixels that pass the depth test
+		vst1q_u32(overdrawrow + x, vsubq_u32(vld1q_u32(overdrawrow + x), mask));
+
+		e1 = vsubq_s32(e1, e1step);
+		e2 = vsubq_s32(e2, e2step);
+		e3 = vsubq_s32(e3, e3step);
+		offset = vaddq_s32(offset, vdupq_n_s32(4));
+	}
+#elif defined(SIMD_WASM)
+	v128_t offset = wasm_i32x4_make(k, k + 1, k + 2, k + 3);
+	v128_t count = wasm_i32x4_splat(maxx - minx);
+
+	v128_t e1 = wasm_i32x4_sub(wasm_i32x4_splat(CX1), wasm_i32x4_mul(offset, wasm_i32x4_splat(DX1)));
+	v128_t e2 = wasm_i32x4_sub(wasm_i32x4_splat(CX2), wasm_i32x4_mul(offset, wasm_i32x4_splat(DX2)));
+	v128_t e3 = wasm_i32x4_sub(wasm_i32x4_splat(CX3), wasm_i32x4_mul(offset, wasm_i32x4_splat(DX3)));
+
+	v128_t e1step = wasm_i32x4_splat(DX1 * 4), e2step = wasm_i32x4_splat(DX2 * 4), e3step = wasm_i32x4_splat(DX3 * 4);
+
+	for (int x = startx; x < maxx; x += 4)
+	{
+		// check if all edge values are non-negative and the pixel is inside the span
+		v128_t inside = wasm_i32x4_ge(wasm_v128_or(wasm_v128_or(e1, e2), e3), wasm_i32x4_splat(0));
+		inside = wasm_v128_and(inside, wasm_i32x4_ge(offset, wasm_i32x4_splat(0)));
+		inside = wasm_v128_and(inside, wasm_i32x4_lt(offset, count));
+
+		v128_t z = wasm_f32x4_add(wasm_f32x4_splat(ZX), wasm_f32x4_mul(wasm_f32x4_splat(DZx), wasm_f32x4_convert_i32x4(offset)));
+		v128_t zold = wasm_v128_load(zrow + x);
+
+		v128_t mask = wasm_v128_and(inside, wasm_f32x4_ge(z, zold));
+
+		wasm_v128_store(zrow + x, wasm_v128_bitselect(z, zold, mask));
 
+		// mask is -1 for pixels that pass the depth test
+		wasm_v128_store(overdrawrow + x, wasm_i32x4_sub(wasm_v128_load(overdrawrow + x), mask));
+
+		e1 = wasm_i32x4_sub(e1, e1step);
+		e2 = wasm_i32x4_sub(e2, e2step);
+		e3 = wasm_i32x4_sub(e3, e3step);
+		offset = wasm_i32x4_add(offset, wasm_i32x4_splat(4));
+	}
+#endif
+#else
+	for (int x = minx; x < maxx; x++)
+	{
+		int k = x - minx;
+
+		// check if all edge values are non-negative
+		if (((CX1 - DX1 * k) | (CX2 - DX2 * k) | (CX3 - DX3 * k)) >= 0)
+		{
+			float z = ZX + DZx * float(k);
+
+			if (z >= zrow[x])
+			{
+				zrow[x] = z;
+				overdrawrow[x]++;
+			}
+		}
+	}
+#endif
+}
+
+// half-space fixed point triangle rasterizer
+static void rasterize(const OverdrawBuffer& buffer, int viewport, float v1x, float v1y, float v1z, float v2x, float v2y, float v2z, float v3x, float v3y, float v3z)
+{
 	// coordinates, 28.4 fixed point
 	int X1 = int(16.0f * v1x + 0.5f);
 	int X2 = int(16.0f * v2x + 0.5f);
@@ -79,9 +233,32 @@ static void rasterize(OverdrawBuffer* buffer, float v1x, float v1y, float v1z, f
 	// as for max, due to top-left filling convention we will never rasterize right/bottom edges
 	// so max >= 0.5 should round down
 	int minx = max((min(X1, min(X2, X3)) + 7) >> 4, 0);
-	int maxx = min((max(X1, max(X2, X3)) + 7) >> 4, kViewport);
+	int maxx = min((max(X1, max(X2, X3)) + 7) >> 4, viewport);
 	int miny = max((min(Y1, min(Y2, Y3)) + 7) >> 4, 0);
-	int maxy = min((max(Y1, max(Y2, Y3)) + 7) >> 4, kViewport);
+	int maxy = min((max(Y1, max(Y2, Y3)) + 7) >> 4, viewport);
+
+	// most triangles of dense meshes don't cover any pixel centers, so we skip the rest of the setup for them
+	if (minx >= maxx || miny >= maxy)
+		return;
+
+	// compute depth gradients
+	float DZx, DZy;
+	float det = computeDepthGradients(DZx, DZy, v1x, v1y, v1z, v2x, v2y, v2z, v3x, v3y, v3z);
+	int sign = det > 0;
+
+	// flip backfacing triangles to simplify rasterization logic
+	if (sign)
+	{
+		// flipping v2 & v3 preserves depth gradients since they're based on v1
+		int t;
+		t = X2, X2 = X3, X3 = t;
+		t = Y2, Y2 = Y3, Y3 = t;
+
+		// flip depth since we rasterize backfacing triangles to second buffer with reverse Z; only v1z is used below
+		v1z = float(viewport) - v1z;
+		DZx = -DZx;
+		DZy = -DZy;
+	}
 
 	// deltas, 28.4 fixed point
 	int DX12 = X1 - X2;
@@ -106,59 +283,105 @@ static void rasterize(OverdrawBuffer* buffer, float v1x, float v1y, float v1z, f
 	int CY3 = DX31 * (FY - Y3) - DY31 * (FX - X3) + TL3 - 1;
 	float ZY = v1z + (DZx * float(FX - X1) + DZy * float(FY - Y1)) * (1 / 16.f);
 
+	// signed left shift is UB for negative numbers so use unsigned-signed casts
+	int SX1 = int(unsigned(DY12) << 4), SY1 = int(unsigned(DX12) << 4);
+	int SX2 = int(unsigned(DY23) << 4), SY2 = int(unsigned(DX23) << 4);
+	int SX3 = int(unsigned(DY31) << 4), SY3 = int(unsigned(DX31) << 4);
+
+	float* zbuffer = buffer.z[sign];
+	unsigned int* overdraw = buffer.overdraw[sign];
+
 	for (int y = miny; y < maxy; y++)
 	{
-		int CX1 = CY1;
-		int CX2 = CY2;
-		int CX3 = CY3;
-		float ZX = ZY;
+		size_t row = size_t(y) * buffer.stride;
 
-		for (int x = minx; x < maxx; x++)
-		{
-			// check if all CXn are non-negative
-			if ((CX1 | CX2 | CX3) >= 0)
-			{
-				if (ZX >= buffer->z[y][x][sign])
-				{
-					buffer->z[y][x][sign] = ZX;
-					buffer->overdraw[y][x][sign]++;
-				}
-			}
+		rasterizeSpan(zbuffer + row, overdraw + row, minx, maxx, CY1, CY2, CY3, SX1, SX2, SX3, ZY, DZx);
 
-			// signed left shift is UB for negative numbers so use unsigned-signed casts
-			CX1 -= int(unsigned(DY12) << 4);
-			CX2 -= int(unsigned(DY23) << 4);
-			CX3 -= int(unsigned(DY31) << 4);
-			ZX += DZx;
-		}
-
-		// signed left shift is UB for negative numbers so use unsigned-signed casts
-		CY1 += int(unsigned(DX12) << 4);
-		CY2 += int(unsigned(DX23) << 4);
-		CY3 += int(unsigned(DX31) << 4);
+		CY1 += SY1;
+		CY2 += SY2;
+		CY3 += SY3;
 		ZY += DZy;
 	}
 }
 
-} // namespace meshopt
+struct OverdrawStatisticsBuilder
+{
+	meshopt_OverdrawStatistics* results;
 
-meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
+	const float* triangles;
+	size_t index_count;
+
+	unsigned int viewport;
+};
+
+static void analyzeOverdrawTask(void* context, size_t task_index)
 {
-	using namespace meshopt;
+	const OverdrawStatisticsBuilder& builder = *static_cast<const OverdrawStatisticsBuilder*>(context);
 
-	assert(index_count % 3 == 0);
-	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
-	assert(vertex_positions_stride % sizeof(float) == 0);
+	int axis = int(task_index);
+	int viewport = int(builder.viewport);
+
+	OverdrawBuffer buffer = {};
+	buffer.stride = (viewport + 3) & ~3;
+
+	size_t buffer_size = size_t(viewport) * buffer.stride;
 
 	meshopt_Allocator allocator;
 
-	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+	for (int s = 0; s < 2; ++s)
+	{
+		buffer.z[s] = allocator.allocate<float>(buffer_size);
+		buffer.overdraw[s] = allocator.allocate<unsigned int>(buffer_size);
+
+		memset(buffer.z[s], 0, buffer_size * sizeof(float));
+		memset(buffer.overdraw[s], 0, buffer_size * sizeof(unsigned int));
+	}
+
+	const float* triangles = builder.triangles;
+
+	for (size_t i = 0; i < builder.index_count; i += 3)
+	{
+		const float* vn0 = &triangles[3 * (i + 0)];
+		const float* vn1 = &triangles[3 * (i + 1)];
+		const float* vn2 = &triangles[3 * (i + 2)];
+
+		switch (axis)
+		{
+		case 0:
+			rasterize(buffer, viewport, vn0[2], vn0[1], vn0[0], vn1[2], vn1[1], vn1[0], vn2[2], vn2[1], vn2[0]);
+			break;
+		case 1:
+			rasterize(buffer, viewport, vn0[0], vn0[2], vn0[1], vn1[0], vn1[2], vn1[1], vn2[0], vn2[2], vn2[1]);
+			break;
+		case 2:
+			rasterize(buffer, viewport, vn0[1], vn0[0], vn0[2], vn1[1], vn1[0], vn1[2], vn2[1], vn2[0], vn2[2]);
+			break;
+		}
+	}
 
 	meshopt_OverdrawStatistics result = {};
 
-	float minv[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+	for (int y = 0; y < viewport; ++y)
+		for (int x = 0; x < viewport; ++x)
+			for (int s = 0; s < 2; ++s)
+			{
+				unsigned int overdraw = buffer.overdraw[s][size_t(y) * buffer.stride + x];
+
+				result.pixels_covered += overdraw > 0;
+				result.pixels_shaded += overdraw;
+			}
+
+	builder.results[task_index] = result;
+}
+
+static float computeOverdrawScale(float* minv, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int viewport)
+{
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
 	float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
 
+	minv[0] = minv[1] = minv[2] = FLT_MAX;
+
 	for (size_t i = 0; i < vertex_count; ++i)
 	{
 		const float* v = vertex_positions + i * vertex_stride_float;
@@ -171,7 +394,49 @@ meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const unsigned int* indices,
 	}
 
 	float extent = max(maxv[0] - minv[0], max(maxv[1] - minv[1], maxv[2] - minv[2]));
-	float scale = kViewport / extent;
+
+	return float(viewport) / extent;
+}
+
+static meshopt_OverdrawStatistics rasterizeOverdraw(const float* triangles, size_t index_count, unsigned int viewport, meshopt_Dispatch dispatch, void* context)
+{
+	meshopt_OverdrawStatistics result = {};
+
+	// each of the 3 axial views rasterizes front and back faces into separate buffers and is independent of other views
+	meshopt_OverdrawStatistics results[3] = {};
+
+	OverdrawStatisticsBuilder builder = {results, triangles, index_count, viewport};
+
+	if (dispatch)
+		dispatch(context, analyzeOverdrawTask, &builder, 3);
+	else
+		for (size_t axis = 0; axis < 3; ++axis)
+			analyzeOverdrawTask(&builder, axis);
+
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		result.pixels_covered += results[axis].pixels_covered;
+		result.pixels_shaded += results[axis].pixels_shaded;
+	}
+
+	result.overdraw = result.pixels_covered ? float(result.pixels_shaded) / float(result.pixels_covered) : 0.f;
+
+	return result;
+}
+
+static meshopt_OverdrawStatistics analyzeOverdraw(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int viewport, meshopt_Dispatch dispatch, void* context)
+{
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(viewport >= 1 && viewport <= kViewportMax);
+
+	meshopt_Allocator allocator;
+
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	float minv[3];
+	float scale = computeOverdrawScale(minv, vertex_positions, vertex_count, vertex_positions_stride, viewport);
 
 	float* triangles = allocator.allocate<float>(index_count * 3);
 
@@ -187,44 +452,155 @@ meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const unsigned int* indices,
 		triangles[i * 3 + 2] = (v[2] - minv[2]) * scale;
 	}
 
-	OverdrawBuffer* buffer = allocator.allocate<OverdrawBuffer>(1);
+	return rasterizeOverdraw(triangles, index_count, viewport, dispatch, context);
+}
 
-	for (int axis = 0; axis < 3; ++axis)
+} // namespace meshopt
+
+meshopt_OverdrawStatistics meshopt_analyzeOverdraw(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
+{
+	return meshopt::analyzeOverdraw(indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, meshopt::kViewport, NULL, NULL);
+}
+
+meshopt_OverdrawStatistics meshopt_analyzeOverdrawParallel(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, unsigned int resolution, meshopt_Dispatch dispatch, void* context)
+{
+	return meshopt::analyzeOverdraw(indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, resolution, dispatch, context);
+}
+
+meshopt_MeshStatistics meshopt_analyzeMesh(const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, size_t vertex_size, unsigned int cache_size, unsigned int warp_size, unsigned int primgroup_size, unsigned int* warp_vertex_histogram, unsigned int* warp_triangle_histogram)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(cache_size >= 3);
+	assert(warp_size == 0 || warp_size >= 3);
+	assert(!warp_vertex_histogram || warp_size);
+	assert(!warp_triangle_histogram || primgroup_size);
+
+	meshopt_Allocator allocator;
+
+	meshopt_MeshStatistics result = {};
+
+	if (warp_vertex_histogram)
+		memset(warp_vertex_histogram, 0, (warp_size + 1) * sizeof(unsigned int));
+
+	if (warp_triangle_histogram)
+		memset(warp_triangle_histogram, 0, (primgroup_size + 1) * sizeof(unsigned int));
+
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	float minv[3];
+	float scale = computeOverdrawScale(minv, vertex_positions, vertex_count, vertex_positions_stride, kViewport);
+
+	float* triangles = allocator.allocate<float>(index_count * 3);
+
+	// vertex cache timestamps double as the visited flags for vertex fetch: every referenced vertex is transformed at least once
+	unsigned int* cache_timestamps = allocator.allocate<unsigned int>(vertex_count);
+	memset(cache_timestamps, 0, vertex_count * sizeof(unsigned int));
+
+	unsigned int timestamp = cache_size + 1;
+
+	unsigned int warp_offset = 0;
+	unsigned int primgroup_offset = 0;
+
+	const size_t kCacheLine = 64;
+	const size_t kCacheSize = 128 * 1024;
+
+	// simple direct mapped cache, same model as meshopt_analyzeVertexFetch
+	size_t cache[kCacheSize / kCacheLine] = {};
+
+	for (size_t i = 0; i < index_count; i += 3)
 	{
-		memset(buffer, 0, sizeof(OverdrawBuffer));
+		unsigned int a = indices[i + 0], b = indices[i + 1], c = indices[i + 2];
+		assert(a < vertex_count && b < vertex_count && c < vertex_count);
+
+		bool ac = (timestamp - cache_timestamps[a]) > cache_size;
+		bool bc = (timestamp - cache_timestamps[b]) > cache_size;
+		bool cc = (timestamp - cache_timestamps[c]) > cache_size;
 
-		for (size_t i = 0; i < index_count; i += 3)
+		// flush cache if triangle doesn't fit into warp or into the primitive buffer
+		if ((primgroup_size && primgroup_offset == primgroup_size) || (warp_size && warp_offset + ac + bc + cc > warp_size))
 		{
-			const float* vn0 = &triangles[3 * (i + 0)];
-			const float* vn1 = &triangles[3 * (i + 1)];
-			const float* vn2 = &triangles[3 * (i + 2)];
+			if (warp_offset > 0)
+			{
+				result.vertex_cache.warps_executed++;
+
+				if (warp_vertex_histogram)
+					warp_vertex_histogram[warp_offset]++;
+				if (warp_triangle_histogram)
+					warp_triangle_histogram[primgroup_offset]++;
+			}
+
+			warp_offset = 0;
+			primgroup_offset = 0;
+
+			// reset cache
+			timestamp += cache_size + 1;
+		}
+
+		for (int j = 0; j < 3; ++j)
+		{
+			unsigned int index = indices[i + j];
+
+			// update cache and add vertices to warp
+			if (timestamp - cache_timestamps[index] > cache_size)
+			{
+				cache_timestamps[index] = timestamp++;
+				result.vertex_cache.vertices_transformed++;
+				warp_offset++;
+			}
+
+			// fetch vertex data through the memory cache
+			size_t start_address = index * vertex_size;
+			size_t end_address = start_address + vertex_size;
 
-			switch (axis)
+			size_t start_tag = start_address / kCacheLine;
+			size_t end_tag = (end_address + kCacheLine - 1) / kCacheLine;
+
+			for (size_t tag = start_tag; tag < end_tag; ++tag)
 			{
-			case 0:
-				rasterize(buffer, vn0[2], vn0[1], vn0[0], vn1[2], vn1[1], vn1[0], vn2[2], vn2[1], vn2[0]);
-				break;
-			case 1:
-				rasterize(buffer, vn0[0], vn0[2], vn0[1], vn1[0], vn1[2], vn1[1], vn2[0], vn2[2], vn2[1]);
-				break;
-			case 2:
-				rasterize(buffer, vn0[1], vn0[0], vn0[2], vn1[1], vn1[0], vn1[2], vn2[1], vn2[0], vn2[2]);
-				break;
+				size_t line = tag % (sizeof(cache) / sizeof(cache[0]));
+
+				// we store +1 since cache is filled with 0 by default
+				result.vertex_fetch.bytes_fetched += (cache[line] != tag + 1) * kCacheLine;
+				cache[line] = tag + 1;
 			}
+
+			// project vertex for overdraw rasterization
+			const float* v = vertex_positions + index * vertex_stride_float;
+
+			triangles[(i + j) * 3 + 0] = (v[0] - minv[0]) * scale;
+			triangles[(i + j) * 3 + 1] = (v[1] - minv[1]) * scale;
+			triangles[(i + j) * 3 + 2] = (v[2] - minv[2]) * scale;
 		}
 
-		for (int y = 0; y < kViewport; ++y)
-			for (int x = 0; x < kViewport; ++x)
-				for (int s = 0; s < 2; ++s)
-				{
-					unsigned int overdraw = buffer->overdraw[y][x][s];
+		primgroup_offset++;
+	}
+
+	if (warp_offset > 0)
+	{
+		result.vertex_cache.warps_executed++;
 
-					result.pixels_covered += overdraw > 0;
-					result.pixels_shaded += overdraw;
-				}
+		if (warp_vertex_histogram)
+			warp_vertex_histogram[warp_offset]++;
+		if (warp_triangle_histogram)
+			warp_triangle_histogram[primgroup_offset]++;
 	}
 
-	result.overdraw = result.pixels_covered ? float(result.pixels_shaded) / float(result.pixels_covered) : 0.f;
+	size_t unique_vertex_count = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		unique_vertex_count += cache_timestamps[i] > 0;
+
+	result.vertex_cache.acmr = index_count == 0 ? 0 : float(result.vertex_cache.vertices_transformed) / float(index_count / 3);
+	result.vertex_cache.atvr = unique_vertex_count == 0 ? 0 : float(result.vertex_cache.vertices_transformed) / float(unique_vertex_count);
+
+	result.vertex_fetch.overfetch = unique_vertex_count == 0 ? 0 : float(result.vertex_fetch.bytes_fetched) / float(unique_vertex_count * vertex_size);
+
+	result.overdraw = rasterizeOverdraw(triangles, index_count, kViewport, NULL, NULL);
 
 	return result;
 }
@@ -268,6 +268,23 @@ static size_t generateSoftBoundaries(unsigned int* destination, const unsigned i
 } // namespace meshopt
 
 void meshopt_optimizeOverdraw(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold)
+{
+	meshopt_optimizeOverdrawWithContext(destination, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride, threshold, NULL);
+}
+
+size_t meshopt_optimizeOverdrawScratchBound(size_t index_count, size_t vertex_count)
+{
+	size_t face_count = index_count / 3;
+
+	// indices copy (for in-place optimization), cache timestamps, hard and soft clusters, sort data, keys and order
+	return meshopt_Allocator::scratch<unsigned int>(index_count) +
+	       meshopt_Allocator::scratch<unsigned int>(vertex_count) +
+	       meshopt_Allocator::scratch<unsigned int>(face_count) + meshopt_Allocator::scratch<unsigned int>(face_count + 1) +
+	       meshopt_Allocator::scratch<float>(face_count + 1) +
+	       meshopt_Allocator::scratch<unsigned short>(face_count + 1) + meshopt_Allocator::scratch<unsigned int>(face_count + 1);
+}
+
+void meshopt_optimizeOverdrawWithContext(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, float threshold, meshopt_Context* context)
 {
 	using namespace meshopt;
 
@@ -275,7 +292,7 @@ void meshopt_optimizeOverdraw(unsigned int* destination, const unsigned int* ind
 	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
 	assert(vertex_positions_stride % sizeof(float) == 0);
 
-	meshopt_Allocator allocator;
+	meshopt_Allocator allocator(context);
 
 	// guard for empty meshes
 	if (index_count == 0 || vertex_count == 0)
@@ -6,6 +6,51 @@
 #include <math.h>
 #include <string.h>
 
+// The block below auto-detects SIMD ISA that can be used on the target platform
+#ifndef MESHOPTIMIZER_NO_SIMD
+
+// The SIMD implementation requires SSE2, which can be enabled unconditionally through compiler settings
+#if defined(__SSE2__)
+#define SIMD_SSE
+#endif
+
+// MSVC supports compiling SSE2 code regardless of compile options; we assume all 32-bit CPUs support SSE2
+#if !defined(SIMD_SSE) && defined(_MSC_VER) && !defined(__clang__) && (defined(_M_IX86) || defined(_M_X64))
+#define SIMD_SSE
+#endif
+
+// The NEON implementation requires vector division which is only available on AArch64
+#if (defined(__ARM_NEON__) || defined(__ARM_NEON)) && defined(__aarch64__)
+#define SIMD_NEON
+#endif
+
+#if !defined(SIMD_NEON) && defined(_MSC_VER) && defined(_M_ARM64)
+#define SIMD_NEON
+#endif
+
+// When targeting Wasm SIMD we can't use runtime cpuid checks so we unconditionally enable SIMD
+#if defined(__wasm_simd128__)
+#define SIMD_WASM
+#endif
+
+#endif // !MESHOPTIMIZER_NO_SIMD
+
+#ifdef SIMD_SSE
+#include <emmintrin.h>
+#endif
+
+#ifdef SIMD_NEON
+#if defined(_MSC_VER) && defined(_M_ARM64)
+#include <arm64_neon.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef SIMD_WASM
+#include <wasm_simd128.h>
+#endif
+
 #ifndef TRACE
 #define TRACE 0
 #endif
@@ -29,6 +74,9 @@
 namespace meshopt
 {
 
+// Parallel simplifier splits the mesh into partitions of approximately this many triangles; borders between partitions are only simplified in the final serial pass
+const size_t kSimplifyPartitionSize = 65536;
+
 struct EdgeAdjacency
 {
 	struct Edge
@@ -169,6 +217,27 @@ static T* hashLookup2(T* table, size_t buckets, const Hash& hash, const T& key,
 	return 0;
 }
 
+#if MESHOPTIMIZER_PROFILE
+template <typename T, typename Hash>
+static size_t hashProbes2(const T* table, size_t buckets, const Hash& hash, const T& key, const T* entry)
+{
+	size_t hashmod = buckets - 1;
+	size_t bucket = hash.hash(key) & hashmod;
+	size_t target = size_t(entry - table);
+
+	// replays the probe sequence of hashLookup2 to find the number of collisions for the key
+	size_t probe = 0;
+
+	while (bucket != target)
+	{
+		bucket = (bucket + probe + 1) & hashmod;
+		probe++;
+	}
+
+	return probe;
+}
+#endif
+
 static void buildPositionRemap(unsigned int* remap, unsigned int* wedge, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, meshopt_Allocator& allocator)
 {
 	PositionHasher hasher = {vertex_positions_data, vertex_positions_stride / sizeof(float)};
@@ -177,6 +246,10 @@ static void buildPositionRemap(unsigned int* remap, unsigned int* wedge, const f
 	unsigned int* table = allocator.allocate<unsigned int>(table_size);
 	memset(table, -1, table_size * sizeof(unsigned int));
 
+#if MESHOPTIMIZER_PROFILE
+	size_t probes = 0;
+#endif
+
 	// build forward remap: for each vertex, which other (canonical) vertex does it map to?
 	// we use position equivalence for this, and remap vertices to other existing vertices
 	for (size_t i = 0; i < vertex_count; ++i)
@@ -184,12 +257,18 @@ static void buildPositionRemap(unsigned int* remap, unsigned int* wedge, const f
 		unsigned int index = unsigned(i);
 		unsigned int* entry = hashLookup2(table, table_size, hasher, index, ~0u);
 
+#if MESHOPTIMIZER_PROFILE
+		probes += hashProbes2(table, table_size, hasher, index, entry);
+#endif
+
 		if (*entry == ~0u)
 			*entry = index;
 
 		remap[index] = *entry;
 	}
 
+	MESHOPTIMIZER_PROFILE_COUNTER("simplify.hashProbes", probes);
+
 	// build wedge table: for each vertex, which other vertex is the next wedge that also maps to the same vertex?
 	// entries in table form a (cyclic) wedge loop per vertex; for manifold vertices, wedge[i] == remap[i] == i
 	for (size_t i = 0; i < vertex_count; ++i)
@@ -252,7 +331,7 @@ static bool hasEdge(const EdgeAdjacency& adjacency, unsigned int a, unsigned int
 	return false;
 }
 
-static void classifyVertices(unsigned char* result, unsigned int* loop, unsigned int* loopback, size_t vertex_count, const EdgeAdjacency& adjacency, const unsigned int* remap, const unsigned int* wedge, unsigned int options)
+static void classifyVertices(unsigned char* result, unsigned int* loop, unsigned int* loopback, size_t vertex_count, const EdgeAdjacency& adjacency, const unsigned int* remap, const unsigned int* wedge, unsigned int options, const unsigned char* vertex_lock)
 {
 	memset(loop, -1, vertex_count * sizeof(unsigned int));
 	memset(loopback, -1, vertex_count * sizeof(unsigned int));
@@ -367,6 +446,17 @@ static void classifyVertices(unsigned char* result, unsigned int* loop, unsigned
 			if (result[i] == Kind_Border)
 				result[i] = Kind_Locked;
 
+	if (vertex_lock)
+	{
+		// locking a vertex locks all vertices with the same position so that the kinds stay consistent
+		for (size_t i = 0; i < vertex_count; ++i)
+			if (vertex_lock[i])
+				result[remap[i]] = Kind_Locked;
+
+		for (size_t i = 0; i < vertex_count; ++i)
+			result[i] = result[remap[i]];
+	}
+
 #if TRACE
 	printf("locked: many open edges %d, disconnected seam %d, many seam edges %d, many wedges %d\n",
 	    int(stats[0]), int(stats[1]), int(stats[2]), int(stats[3]));
@@ -739,9 +829,206 @@ static size_t pickEdgeCollapses(Collapse* collapses, const unsigned int* indices
 	return collapse_count;
 }
 
+// the batched versions below evaluate quadricError for 4 quadric/position pairs at once
+// quadrics are gathered and transposed in registers; a Quadric is 11 floats so fields 0-3, 4-7 and 7-10 can be loaded without reading out of bounds
+// the order of operations matches the scalar version, so the results are identical as long as the compiler doesn't contract quadricError into FMAs;
+// clang (by default) and gcc (in GNU modes) do that when FMA is available, e.g. on AArch64, while separate SIMD multiplies and adds are never fused,
+// so in these builds errors may differ in the last bits between the kernels and the scalar tail; simplification is still deterministic for a given build
+#ifdef SIMD_SSE
+static __m128 loadPosition(const Vector3& v)
+{
+	__m128 xy = _mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&v.x)));
+	return _mm_movelh_ps(xy, _mm_load_ss(&v.z));
+}
+
+static void quadricErrorBatch(float* result, const Quadric* const* Q, const Vector3* const* v)
+{
+	__m128 a00 = _mm_loadu_ps(&Q[0]->a00), a11 = _mm_loadu_ps(&Q[1]->a00), a22 = _mm_loadu_ps(&Q[2]->a00), a10 = _mm_loadu_ps(&Q[3]->a00);
+	_MM_TRANSPOSE4_PS(a00, a11, a22, a10);
+
+	__m128 a20 = _mm_loadu_ps(&Q[0]->a20), a21 = _mm_loadu_ps(&Q[1]->a20), b0 = _mm_loadu_ps(&Q[2]->a20), b1 = _mm_loadu_ps(&Q[3]->a20);
+	_MM_TRANSPOSE4_PS(a20, a21, b0, b1);
+
+	__m128 b1d = _mm_loadu_ps(&Q[0]->b1), b2 = _mm_loadu_ps(&Q[1]->b1), c = _mm_loadu_ps(&Q[2]->b1), w = _mm_loadu_ps(&Q[3]->b1);
+	_MM_TRANSPOSE4_PS(b1d, b2, c, w);
+
+	__m128 x = loadPosition(*v[0]), y = loadPosition(*v[1]), z = loadPosition(*v[2]), p3 = loadPosition(*v[3]);
+	_MM_TRANSPOSE4_PS(x, y, z, p3);
+
+	__m128 rx = _mm_add_ps(b0, _mm_mul_ps(a10, y));
+	__m128 ry = _mm_add_ps(b1, _mm_mul_ps(a21, z));
+	__m128 rz = _mm_add_ps(b2, _mm_mul_ps(a20, x));
+
+	rx = _mm_add_ps(_mm_add_ps(rx, rx), _mm_mul_ps(a00, x));
+	ry = _mm_add_ps(_mm_add_ps(ry, ry), _mm_mul_ps(a11, y));
+	rz = _mm_add_ps(_mm_add_ps(rz, rz), _mm_mul_ps(a22, z));
+
+	__m128 r = c;
+	r = _mm_add_ps(r, _mm_mul_ps(rx, x));
+	r = _mm_add_ps(r, _mm_mul_ps(ry, y));
+	r = _mm_add_ps(r, _mm_mul_ps(rz, z));
+
+	__m128 s = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.f), w), _mm_cmpneq_ps(w, _mm_setzero_ps()));
+
+	_mm_storeu_ps(result, _mm_mul_ps(_mm_andnot_ps(_mm_set1_ps(-0.f), r), s));
+}
+#endif
+
+#ifdef SIMD_NEON
+static void transpose4(float32x4_t& r0, float32x4_t& r1, float32x4_t& r2, float32x4_t& r3)
+{
+	float32x4x2_t t0 = vzipq_f32(r0, r2);
+	float32x4x2_t t1 = vzipq_f32(r1, r3);
+	float32x4x2_t u0 = vzipq_f32(t0.val[0], t1.val[0]);
+	float32x4x2_t u1 = vzipq_f32(t0.val[1], t1.val[1]);
+
+	r0 = u0.val[0];
+	r1 = u0.val[1];
+	r2 = u1.val[0];
+	r3 = u1.val[1];
+}
+
+static float32x4_t loadPosition(const Vector3& v)
+{
+	return vcombine_f32(vld1_f32(&v.x), vld1_dup_f32(&v.z));
+}
+
+static void quadricErrorBatch(float* result, const Quadric* const* Q, const Vector3* const* v)
+{
+	float32x4_t a00 = vld1q_f32(&Q[0]->a00), a11 = vld1q_f32(&Q[1]->a00), a22 = vld1q_f32(&Q[2]->a00), a10 = vld1q_f32(&Q[3]->a00);
+	transpose4(a00, a11, a22, a10);
+
+	float32x4_t a20 = vld1q_f32(&Q[0]->a20), a21 = vld1q_f32(&Q[1]->a20), b0 = vld1q_f32(&Q[2]->a20), b1 = vld1q_f32(&Q[3]->a20);
+	transpose4(a20, a21, b0, b1);
+
+	float32x4_t b1d = vld1q_f32(&Q[0]->b1), b2 = vld1q_f32(&Q[1]->b1), c = vld1q_f32(&Q[2]->b1), w = vld1q_f32(&Q[3]->b1);
+	transpose4(b1d, b2, c, w);
+
+	float32x4_t x = loadPosition(*v[0]), y = loadPosition(*v[1]), z = loadPosition(*v[2]), p3 = loadPosition(*v[3]);
+	transpose4(x, y, z, p3);
+
+	// note: we use separate multiply and add instead of vmlaq/vfmaq to match the uncontracted scalar version; see above
+	float32x4_t rx = vaddq_f32(b0, vmulq_f32(a10, y));
+	float32x4_t ry = vaddq_f32(b1, vmulq_f32(a21, z));
+	float32x4_t rz = vaddq_f32(b2, vmulq_f32(a20, x));
+
+	rx = vaddq_f32(vaddq_f32(rx, rx), vmulq_f32(a00, x));
+	ry = vaddq_f32(vaddq_f32(ry, ry), vmulq_f32(a11, y));
+	rz = vaddq_f32(vaddq_f32(rz, rz), vmulq_f32(a22, z));
+
+	float32x4_t r = c;
+	r = vaddq_f32(r, vmulq_f32(rx, x));
+	r = vaddq_f32(r, vmulq_f32(ry, y));
+	r = vaddq_f32(r, vmulq_f32(rz, z));
+
+	uint32x4_t nz = vmvnq_u32(vceqq_f32(w, vdupq_n_f32(0.f)));
+	float32x4_t s = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(vdivq_f32(vdupq_n_f32(1.f), w)), nz));
+
+	vst1q_f32(result, vmulq_f32(vabsq_f32(r), s));
+}
+#endif
+
+#ifdef SIMD_WASM
+static void transpose4(v128_t& r0, v128_t& r1, v128_t& r2, v128_t& r3)
+{
+	v128_t t0 = wasm_i32x4_shuffle(r0, r1, 0, 4, 1, 5);
+	v128_t t1 = wasm_i32x4_shuffle(r2, r3, 0, 4, 1, 5);
+	v128_t t2 = wasm_i32x4_shuffle(r0, r1, 2, 6, 3, 7);
+	v128_t t3 = wasm_i32x4_shuffle(r2, r3, 2, 6, 3, 7);
+
+	r0 = wasm_i64x2_shuffle(t0, t1, 0, 2);
+	r1 = wasm_i64x2_shuffle(t0, t1, 1, 3);
+	r2 = wasm_i64x2_shuffle(t2, t3, 0, 2);
+	r3 = wasm_i64x2_shuffle(t2, t3, 1, 3);
+}
+
+static v128_t loadPosition(const Vector3& v)
+{
+	return wasm_f32x4_replace_lane(wasm_v128_load64_zero(&v.x), 2, v.z);
+}
+
+static void quadricErrorBatch(float* result, const Quadric* const* Q, const Vector3* const* v)
+{
+	v128_t a00 = wasm_v128_load(&Q[0]->a00), a11 = wasm_v128_load(&Q[1]->a00), a22 = wasm_v128_load(&Q[2]->a00), a10 = wasm_v128_load(&Q[3]->a00);
+	transpose4(a00, a11, a22, a10);
+
+	v128_t a20 = wasm_v128_load(&Q[0]->a20), a21 = wasm_v128_load(&Q[1]->a20), b0 = wasm_v128_load(&Q[2]->a20), b1 = wasm_v128_load(&Q[3]->a20);
+	transpose4(a20, a21, b0, b1);
+
+	v128_t b1d = wasm_v128_load(&Q[0]->b1), b2 = wasm_v128_load(&Q[1]->b1), c = wasm_v128_load(&Q[2]->b1), w = wasm_v128_load(&Q[3]->b1);
+	transpose4(b1d, b2, c, w);
+
+	v128_t x = loadPosition(*v[0]), y = loadPosition(*v[1]), z = loadPosition(*v[2]), p3 = loadPosition(*v[3]);
+	transpose4(x, y, z, p3);
+
+	v128_t rx = wasm_f32x4_add(b0, wasm_f32x4_mul(a10, y));
+	v128_t ry = wasm_f32x4_add(b1, wasm_f32x4_mul(a21, z));
+	v128_t rz = wasm_f32x4_add(b2, wasm_f32x4_mul(a20, x));
+
+	rx = wasm_f32x4_add(wasm_f32x4_add(rx, rx), wasm_f32x4_mul(a00, x));
+	ry = wasm_f32x4_add(wasm_f32x4_add(ry, ry), wasm_f32x4_mul(a11, y));
+	rz = wasm_f32x4_add(wasm_f32x4_add(rz, rz), wasm_f32x4_mul(a22, z));
+
+	v128_t r = c;
+	r = wasm_f32x4_add(r, wasm_f32x4_mul(rx, x));
+	r = wasm_f32x4_add(r, wasm_f32x4_mul(ry, y));
+	r = wasm_f32x4_add(r, wasm_f32x4_mul(rz, z));
+
+	v128_t s = wasm_v128_and(wasm_f32x4_div(wasm_f32x4_splat(1.f), w), wasm_f32x4_ne(w, wasm_f32x4_splat(0.f)));
+
+	wasm_v128_store(result, wasm_f32x4_mul(wasm_f32x4_abs(r), s));
+}
+#endif
+
 static void rankEdgeCollapses(Collapse* collapses, size_t collapse_count, const Vector3* vertex_positions, const Quadric* vertex_quadrics, const unsigned int* remap)
 {
-	for (size_t i = 0; i < collapse_count; ++i)
+	size_t i = 0;
+
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	// evaluate both directions of 4 collapses at a time
+	for (; i + 4 <= collapse_count; i += 4)
+	{
+		const Quadric* qi[4];
+		const Quadric* qj[4];
+		const Vector3* vi[4];
+		const Vector3* vj[4];
+
+		for (int k = 0; k < 4; ++k)
+		{
+			const Collapse& c = collapses[i + k];
+
+			unsigned int i0 = c.v0;
+			unsigned int i1 = c.v1;
+			unsigned int j0 = c.bidi ? i1 : i0;
+			unsigned int j1 = c.bidi ? i0 : i1;
+
+			qi[k] = &vertex_quadrics[remap[i0]];
+			qj[k] = &vertex_quadrics[remap[j0]];
+			vi[k] = &vertex_positions[i1];
+			vj[k] = &vertex_positions[j1];
+		}
+
+		float ei[4], ej[4];
+		quadricErrorBatch(ei, qi, vi);
+		quadricErrorBatch(ej, qj, vj);
+
+		for (int k = 0; k < 4; ++k)
+		{
+			Collapse& c = collapses[i + k];
+
+			unsigned int i0 = c.v0;
+			unsigned int i1 = c.v1;
+			unsigned int j0 = c.bidi ? i1 : i0;
+			unsigned int j1 = c.bidi ? i0 : i1;
+
+			c.v0 = ei[k] <= ej[k] ? i0 : j0;
+			c.v1 = ei[k] <= ej[k] ? i1 : j1;
+			c.error = ei[k] <= ej[k] ? ei[k] : ej[k];
+		}
+	}
+#endif
+
+	for (; i < collapse_count; ++i)
 	{
 		Collapse& c = collapses[i];
 
@@ -1278,34 +1565,63 @@ MESHOPTIMIZER_API unsigned int* meshopt_simplifyDebugLoopBack = 0;
 #endif
 
 size_t meshopt_simplify(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* out_result_error)
+{
+	return meshopt_simplifyWithContext(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, target_index_count, target_error, options, out_result_error, NULL);
+}
+
+size_t meshopt_simplifyScratchBound(size_t index_count, size_t vertex_count)
 {
 	using namespace meshopt;
 
+	// edge adjacency, position remap and wedge, position hash table, vertex kind and loops, positions, quadrics, edge collapses and collapse state
+	return meshopt_Allocator::scratch<unsigned int>(vertex_count) * 2 + meshopt_Allocator::scratch<EdgeAdjacency::Edge>(index_count) +
+	       meshopt_Allocator::scratch<unsigned int>(vertex_count) * 2 +
+	       meshopt_Allocator::scratch<unsigned int>(hashBuckets2(vertex_count)) +
+	       meshopt_Allocator::scratch<unsigned char>(vertex_count) + meshopt_Allocator::scratch<unsigned int>(vertex_count) * 2 +
+	       meshopt_Allocator::scratch<Vector3>(vertex_count) +
+	       meshopt_Allocator::scratch<Quadric>(vertex_count) +
+	       meshopt_Allocator::scratch<Collapse>(index_count) + meshopt_Allocator::scratch<unsigned int>(index_count) +
+	       meshopt_Allocator::scratch<unsigned int>(vertex_count) + meshopt_Allocator::scratch<unsigned char>(vertex_count);
+}
+
+namespace meshopt
+{
+
+static size_t simplify(unsigned int* destination, size_t* lod_index_counts, float* lod_errors, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options, const unsigned char* vertex_lock, meshopt_Context* context)
+{
 	assert(index_count % 3 == 0);
 	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
 	assert(vertex_positions_stride % sizeof(float) == 0);
-	assert(target_index_count <= index_count);
+	assert(lod_count > 0);
 	assert((options & ~(meshopt_SimplifyLockBorder)) == 0);
 
-	meshopt_Allocator allocator;
+	MESHOPTIMIZER_PROFILE_BEGIN("simplify");
+
+	meshopt_Allocator allocator(context);
 
 	unsigned int* result = destination;
 
 	// build adjacency information
+	MESHOPTIMIZER_PROFILE_BEGIN("simplify.updateEdgeAdjacency");
 	EdgeAdjacency adjacency = {};
 	prepareEdgeAdjacency(adjacency, index_count, vertex_count, allocator);
 	updateEdgeAdjacency(adjacency, indices, index_count, vertex_count, NULL);
+	MESHOPTIMIZER_PROFILE_END("simplify.updateEdgeAdjacency");
 
 	// build position remap that maps each vertex to the one with identical position
+	MESHOPTIMIZER_PROFILE_BEGIN("simplify.buildPositionRemap");
 	unsigned int* remap = allocator.allocate<unsigned int>(vertex_count);
 	unsigned int* wedge = allocator.allocate<unsigned int>(vertex_count);
 	buildPositionRemap(remap, wedge, vertex_positions_data, vertex_count, vertex_positions_stride, allocator);
+	MESHOPTIMIZER_PROFILE_END("simplify.buildPositionRemap");
 
 	// classify vertices; vertex kind determines collapse rules, see kCanCollapse
+	MESHOPTIMIZER_PROFILE_BEGIN("simplify.classifyVertices");
 	unsigned char* vertex_kind = allocator.allocate<unsigned char>(vertex_count);
 	unsigned int* loop = allocator.allocate<unsigned int>(vertex_count);
 	unsigned int* loopback = allocator.allocate<unsigned int>(vertex_count);
-	classifyVertices(vertex_kind, loop, loopback, vertex_count, adjacency, remap, wedge, options);
+	classifyVertices(vertex_kind, loop, loopback, vertex_count, adjacency, remap, wedge, options, vertex_lock);
+	MESHOPTIMIZER_PROFILE_END("simplify.classifyVertices");
 
 #if TRACE
 	size_t unique_positions = 0;
@@ -1328,13 +1644,18 @@ size_t meshopt_simplify(unsigned int* destination, const unsigned int* indices,
 	Quadric* vertex_quadrics = allocator.allocate<Quadric>(vertex_count);
 	memset(vertex_quadrics, 0, vertex_count * sizeof(Quadric));
 
+	MESHOPTIMIZER_PROFILE_BEGIN("simplify.fillFaceQuadrics");
 	fillFaceQuadrics(vertex_quadrics, indices, index_count, vertex_positions, remap);
+	MESHOPTIMIZER_PROFILE_END("simplify.fillFaceQuadrics");
+
+	MESHOPTIMIZER_PROFILE_BEGIN("simplify.fillEdgeQuadrics");
 	fillEdgeQuadrics(vertex_quadrics, indices, index_count, vertex_positions, remap, vertex_kind, loop, loopback);
+	MESHOPTIMIZER_PROFILE_END("simplify.fillEdgeQuadrics");
 
 	if (result != indices)
 		memcpy(result, indices, index_count * sizeof(unsigned int));
 
-#if TRACE
+#if TRACE || MESHOPTIMIZER_PROFILE
 	size_t pass_count = 0;
 #endif
 
@@ -1346,62 +1667,98 @@ size_t meshopt_simplify(unsigned int* destination, const unsigned int* indices,
 	size_t result_count = index_count;
 	float result_error = 0;
 
-	// target_error input is linear; we need to adjust it to match quadricError units
-	float error_limit = target_error * target_error;
-
-	while (result_count > target_index_count)
+	for (size_t lod = 0; lod < lod_count; ++lod)
 	{
-		// note: throughout the simplification process adjacency structure reflects welded topology for result-in-progress
-		updateEdgeAdjacency(adjacency, result, result_count, vertex_count, remap);
+		size_t target_index_count = target_index_counts[lod];
+		assert(target_index_count <= index_count);
 
-		size_t edge_collapse_count = pickEdgeCollapses(edge_collapses, result, result_count, remap, vertex_kind, loop);
+		// target_error input is linear; we need to adjust it to match quadricError units
+		float error_limit = target_errors[lod] * target_errors[lod];
 
-		// no edges can be collapsed any more due to topology restrictions
-		if (edge_collapse_count == 0)
-			break;
+		// each level continues simplification from the previous one, reusing adjacency, vertex classification and accumulated quadrics
+		if (lod > 0)
+		{
+			memcpy(result + result_count, result, result_count * sizeof(unsigned int));
+			result += result_count;
+		}
+
+		while (result_count > target_index_count)
+		{
+			// note: throughout the simplification process adjacency structure reflects welded topology for result-in-progress
+			MESHOPTIMIZER_PROFILE_BEGIN("simplify.updateEdgeAdjacency");
+			updateEdgeAdjacency(adjacency, result, result_count, vertex_count, remap);
+			MESHOPTIMIZER_PROFILE_END("simplify.updateEdgeAdjacency");
+
+			MESHOPTIMIZER_PROFILE_BEGIN("simplify.pickEdgeCollapses");
+			size_t edge_collapse_count = pickEdgeCollapses(edge_collapses, result, result_count, remap, vertex_kind, loop);
+			MESHOPTIMIZER_PROFILE_END("simplify.pickEdgeCollapses");
+
+			// no edges can be collapsed any more due to topology restrictions
+			if (edge_collapse_count == 0)
+				break;
 
-		rankEdgeCollapses(edge_collapses, edge_collapse_count, vertex_positions, vertex_quadrics, remap);
+			MESHOPTIMIZER_PROFILE_BEGIN("simplify.rankEdgeCollapses");
+			rankEdgeCollapses(edge_collapses, edge_collapse_count, vertex_positions, vertex_quadrics, remap);
+			MESHOPTIMIZER_PROFILE_END("simplify.rankEdgeCollapses");
 
 #if TRACE > 1
-		dumpEdgeCollapses(edge_collapses, edge_collapse_count, vertex_kind);
+			dumpEdgeCollapses(edge_collapses, edge_collapse_count, vertex_kind);
 #endif
 
-		sortEdgeCollapses(collapse_order, edge_collapses, edge_collapse_count);
+			MESHOPTIMIZER_PROFILE_BEGIN("simplify.sortEdgeCollapses");
+			sortEdgeCollapses(collapse_order, edge_collapses, edge_collapse_count);
+			MESHOPTIMIZER_PROFILE_END("simplify.sortEdgeCollapses");
 
-		size_t triangle_collapse_goal = (result_count - target_index_count) / 3;
+			size_t triangle_collapse_goal = (result_count - target_index_count) / 3;
 
-		for (size_t i = 0; i < vertex_count; ++i)
-			collapse_remap[i] = unsigned(i);
+			for (size_t i = 0; i < vertex_count; ++i)
+				collapse_remap[i] = unsigned(i);
 
-		memset(collapse_locked, 0, vertex_count);
+			memset(collapse_locked, 0, vertex_count);
 
 #if TRACE
-		printf("pass %d: ", int(pass_count++));
+			printf("pass %d: ", int(pass_count));
 #endif
 
-		size_t collapses = performEdgeCollapses(collapse_remap, collapse_locked, vertex_quadrics, edge_collapses, edge_collapse_count, collapse_order, remap, wedge, vertex_kind, vertex_positions, adjacency, triangle_collapse_goal, error_limit, result_error);
+#if TRACE || MESHOPTIMIZER_PROFILE
+			pass_count++;
+#endif
 
-		// no edges can be collapsed any more due to hitting the error limit or triangle collapse limit
-		if (collapses == 0)
-			break;
+			MESHOPTIMIZER_PROFILE_BEGIN("simplify.performEdgeCollapses");
+			size_t collapses = performEdgeCollapses(collapse_remap, collapse_locked, vertex_quadrics, edge_collapses, edge_collapse_count, collapse_order, remap, wedge, vertex_kind, vertex_positions, adjacency, triangle_collapse_goal, error_limit, result_error);
+			MESHOPTIMIZER_PROFILE_COUNTER("simplify.collapses", collapses);
+			MESHOPTIMIZER_PROFILE_END("simplify.performEdgeCollapses");
 
-		remapEdgeLoops(loop, vertex_count, collapse_remap);
-		remapEdgeLoops(loopback, vertex_count, collapse_remap);
+			// no edges can be collapsed any more due to hitting the error limit or triangle collapse limit
+			if (collapses == 0)
+				break;
 
-		size_t new_count = remapIndexBuffer(result, result_count, collapse_remap);
-		assert(new_count < result_count);
+			MESHOPTIMIZER_PROFILE_BEGIN("simplify.remapIndexBuffer");
+			remapEdgeLoops(loop, vertex_count, collapse_remap);
+			remapEdgeLoops(loopback, vertex_count, collapse_remap);
 
-		result_count = new_count;
-	}
+			size_t new_count = remapIndexBuffer(result, result_count, collapse_remap);
+			assert(new_count < result_count);
+			MESHOPTIMIZER_PROFILE_END("simplify.remapIndexBuffer");
+
+			result_count = new_count;
+		}
 
 #if TRACE
-	printf("result: %d triangles, error: %e; total %d passes\n", int(result_count), sqrtf(result_error), int(pass_count));
+		printf("result: %d triangles, error: %e; total %d passes\n", int(result_count), sqrtf(result_error), int(pass_count));
 #endif
 
 #if TRACE > 1
-	dumpLockedCollapses(result, result_count, vertex_kind);
+		dumpLockedCollapses(result, result_count, vertex_kind);
 #endif
 
+		lod_index_counts[lod] = result_count;
+
+		// result_error is quadratic; we need to remap it back to linear
+		if (lod_errors)
+			lod_errors[lod] = sqrtf(result_error);
+	}
+
 #ifndef NDEBUG
 	if (meshopt_simplifyDebugKind)
 		memcpy(meshopt_simplifyDebugKind, vertex_kind, vertex_count);
@@ -1413,14 +1770,99 @@ size_t meshopt_simplify(unsigned int* destination, const unsigned int* indices,
 		memcpy(meshopt_simplifyDebugLoopBack, loopback, vertex_count * sizeof(unsigned int));
 #endif
 
-	// result_error is quadratic; we need to remap it back to linear
-	if (out_result_error)
-		*out_result_error = sqrtf(result_error);
+	MESHOPTIMIZER_PROFILE_COUNTER("simplify.passes", pass_count);
+	MESHOPTIMIZER_PROFILE_END("simplify");
+
+	return size_t(result - destination) + result_count;
+}
+
+struct SimplifyPartition
+{
+	size_t index_offset;
+	size_t index_count;
+
+	size_t vertex_offset;
+	size_t vertex_count;
+
+	size_t border_count;
+
+	size_t result_count;
+	float result_error;
+};
+
+struct SimplifyPartitionBuilder
+{
+	SimplifyPartition* partitions;
+
+	unsigned int* partition_indices;
+	const unsigned int* partition_vertices;
+	const unsigned char* partition_locks;
+
+	const float* vertex_positions;
+	size_t vertex_positions_stride;
+
+	size_t index_count;
+	size_t target_index_count;
+	float target_error;
+	float extent;
+	unsigned int options;
+};
+
+static void simplifyPartitionTask(void* context, size_t task_index)
+{
+	const SimplifyPartitionBuilder& builder = *static_cast<const SimplifyPartitionBuilder*>(context);
+	SimplifyPartition& partition = builder.partitions[task_index];
+
+	meshopt_Allocator allocator;
+
+	const unsigned int* vertices = builder.partition_vertices + partition.vertex_offset;
+	size_t vertex_stride_float = builder.vertex_positions_stride / sizeof(float);
+
+	// gather partition vertex positions so that all per-vertex data is proportional to the partition size
+	float* positions = allocator.allocate<float>(partition.vertex_count * 3);
+
+	for (size_t i = 0; i < partition.vertex_count; ++i)
+		memcpy(&positions[i * 3], builder.vertex_positions + vertices[i] * vertex_stride_float, 3 * sizeof(float));
+
+	// errors are relative to the mesh extents, so we need to convert them between the partition and the entire mesh
+	float extent = rescalePositions(NULL, positions, partition.vertex_count, sizeof(float) * 3);
+	float error_scale = extent == 0 ? 0.f : builder.extent / extent;
+
+	// triangles that touch locked vertices can't be simplified until the final pass, so we exclude them from the target to avoid oversimplifying the interior
+	size_t target_index_count = size_t(double(builder.target_index_count) * double(partition.index_count) / double(builder.index_count)) + partition.border_count;
+	target_index_count = target_index_count < partition.index_count ? target_index_count : partition.index_count;
+	float target_error = builder.target_error * error_scale;
+
+	unsigned int* indices = builder.partition_indices + partition.index_offset;
+
+	float result_error = 0;
+	size_t result_count = 0;
+	simplify(indices, &result_count, &result_error, indices, partition.index_count, positions, partition.vertex_count, sizeof(float) * 3, &target_index_count, &target_error, 1, builder.options, builder.partition_locks + partition.vertex_offset, NULL);
+
+	// remap partition-local vertex indices back to the original vertex buffer
+	for (size_t i = 0; i < result_count; ++i)
+		indices[i] = vertices[indices[i]];
+
+	partition.result_count = result_count;
+	partition.result_error = error_scale == 0 ? 0.f : result_error / error_scale;
+}
+
+} // namespace meshopt
+
+size_t meshopt_simplifyWithContext(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* out_result_error, meshopt_Context* context)
+{
+	size_t result_count = 0;
+	meshopt::simplify(destination, &result_count, out_result_error, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, &target_index_count, &target_error, 1, options, NULL, context);
 
 	return result_count;
 }
 
-size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* out_result_error)
+size_t meshopt_simplifyLods(unsigned int* destination, size_t* lod_index_counts, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, unsigned int options, float* lod_errors)
+{
+	return meshopt::simplify(destination, lod_index_counts, lod_errors, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, target_index_counts, target_errors, lod_count, options, NULL, NULL);
+}
+
+size_t meshopt_simplifyParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, unsigned int options, float* out_result_error, meshopt_Dispatch dispatch, void* context)
 {
 	using namespace meshopt;
 
@@ -1428,21 +1870,155 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
 	assert(vertex_positions_stride % sizeof(float) == 0);
 	assert(target_index_count <= index_count);
+	assert((options & ~(meshopt_SimplifyLockBorder)) == 0);
+
+	size_t face_count = index_count / 3;
+
+	// small meshes can't be split into multiple partitions so we use the serial simplifier which produces the same result
+	if (!dispatch || face_count <= kSimplifyPartitionSize)
+		return meshopt_simplify(destination, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride, target_index_count, target_error, options, out_result_error);
+
+	meshopt_Allocator allocator;
+
+	// spatial order makes consecutive triangle ranges spatially coherent, so we can split the mesh into equally sized partitions
+	unsigned int* sorted = allocator.allocate<unsigned int>(index_count);
+	meshopt_spatialSortTriangles(sorted, indices, index_count, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+	size_t partition_count = (face_count + kSimplifyPartitionSize - 1) / kSimplifyPartitionSize;
+	SimplifyPartition* partitions = allocator.allocate<SimplifyPartition>(partition_count);
 
+	// vertices that are shared between partitions (directly or via other vertices with the same position) are locked
+	unsigned int* remap = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* wedge = allocator.allocate<unsigned int>(vertex_count);
+	buildPositionRemap(remap, wedge, vertex_positions_data, vertex_count, vertex_positions_stride, allocator);
+
+	unsigned int* position_partition = wedge; // wedge is not needed any more
+	memset(position_partition, -1, vertex_count * sizeof(unsigned int));
+
+	unsigned char* position_border = allocator.allocate<unsigned char>(vertex_count);
+	memset(position_border, 0, vertex_count);
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		size_t begin = face_count * i / partition_count * 3;
+		size_t end = face_count * (i + 1) / partition_count * 3;
+
+		partitions[i].index_offset = begin;
+		partitions[i].index_count = end - begin;
+
+		for (size_t j = begin; j < end; ++j)
+		{
+			unsigned int r = remap[sorted[j]];
+
+			if (position_partition[r] == ~0u)
+				position_partition[r] = unsigned(i);
+			else if (position_partition[r] != i)
+				position_border[r] = 1;
+		}
+	}
+
+	// build partition-local index buffers; each partition references a compact list of vertices
+	unsigned int* partition_indices = sorted;
+	unsigned int* partition_vertices = allocator.allocate<unsigned int>(index_count);
+	unsigned char* partition_locks = allocator.allocate<unsigned char>(index_count);
+
+	unsigned int* vertex_partition = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* vertex_local = allocator.allocate<unsigned int>(vertex_count);
+	memset(vertex_partition, -1, vertex_count * sizeof(unsigned int));
+
+	size_t vertex_offset = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		SimplifyPartition& partition = partitions[i];
+
+		size_t partition_vertex_count = 0;
+
+		for (size_t j = 0; j < partition.index_count; ++j)
+		{
+			unsigned int v = sorted[partition.index_offset + j];
+
+			if (vertex_partition[v] != i)
+			{
+				vertex_partition[v] = unsigned(i);
+				vertex_local[v] = unsigned(partition_vertex_count);
+				partition_vertices[vertex_offset + partition_vertex_count] = v;
+				partition_locks[vertex_offset + partition_vertex_count] = position_border[remap[v]];
+				partition_vertex_count++;
+			}
+
+			partition_indices[partition.index_offset + j] = vertex_local[v];
+		}
+
+		const unsigned char* locks = partition_locks + vertex_offset;
+		const unsigned int* local = partition_indices + partition.index_offset;
+		size_t border_count = 0;
+
+		for (size_t j = 0; j < partition.index_count; j += 3)
+			border_count += (locks[local[j + 0]] | locks[local[j + 1]] | locks[local[j + 2]]) ? 3 : 0;
+
+		partition.vertex_offset = vertex_offset;
+		partition.vertex_count = partition_vertex_count;
+		partition.border_count = border_count;
+		partition.result_count = 0;
+		partition.result_error = 0;
+
+		vertex_offset += partition_vertex_count;
+	}
+
+	float extent = rescalePositions(NULL, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+	SimplifyPartitionBuilder builder = {partitions, partition_indices, partition_vertices, partition_locks, vertex_positions_data, vertex_positions_stride, index_count, target_index_count, target_error, extent, options};
+
+	dispatch(context, simplifyPartitionTask, &builder, partition_count);
+
+	// concatenate partition results; note that destination may alias indices which aren't used after sorting
+	size_t result_count = 0;
+	float result_error = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		const SimplifyPartition& partition = partitions[i];
+
+		memcpy(destination + result_count, partition_indices + partition.index_offset, partition.result_count * sizeof(unsigned int));
+		result_count += partition.result_count;
+
+		result_error = result_error < partition.result_error ? partition.result_error : result_error;
+	}
+
+	// final pass simplifies the entire mesh, which collapses the previously locked partition borders
+	float final_error = 0;
+	size_t final_count = 0;
+	size_t final_target = target_index_count < result_count ? target_index_count : result_count;
+	simplify(destination, &final_count, &final_error, destination, result_count, vertex_positions_data, vertex_count, vertex_positions_stride, &final_target, &target_error, 1, options, NULL, NULL);
+
+	result_error = result_error < final_error ? final_error : result_error;
+
+	if (out_result_error)
+		*out_result_error = result_error;
+
+	return final_count;
+}
+
+namespace meshopt
+{
+
+// clusters vertices on the largest grid that reaches the target triangle count; vertex_positions must already be rescaled to [0..1]
+static size_t simplifySloppyGrid(unsigned int* destination, const unsigned int* indices, size_t index_count, const Vector3* vertex_positions, size_t vertex_count, size_t target_index_count, float target_error, float* out_result_error)
+{
 	// we expect to get ~2 triangles/vertex in the output
 	size_t target_cell_count = target_index_count / 6;
 
 	meshopt_Allocator allocator;
 
-	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
-	rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride);
-
 	// find the optimal grid size using guided binary search
 #if TRACE
 	printf("source: %d vertices, %d triangles\n", int(vertex_count), int(index_count / 3));
 	printf("target: %d cells, %d triangles\n", int(target_cell_count), int(target_index_count / 3));
 #endif
 
+	MESHOPTIMIZER_PROFILE_BEGIN("simplifySloppy.gridSearch");
+
 	unsigned int* vertex_ids = allocator.allocate<unsigned int>(vertex_count);
 
 	const int kInterpolationPasses = 5;
@@ -1463,7 +2039,9 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 	// instead of starting in the middle, let's guess as to what the answer might be! triangle count usually grows as a square of grid size...
 	int next_grid_size = int(sqrtf(float(target_cell_count)) + 0.5f);
 
-	for (int pass = 0; pass < 10 + kInterpolationPasses; ++pass)
+	int pass = 0;
+
+	for (; pass < 10 + kInterpolationPasses; ++pass)
 	{
 		if (min_triangles >= target_index_count / 3 || max_grid - min_grid <= 1)
 			break;
@@ -1500,15 +2078,17 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 		next_grid_size = (pass < kInterpolationPasses) ? int(tip + 0.5f) : (min_grid + max_grid) / 2;
 	}
 
+	MESHOPTIMIZER_PROFILE_COUNTER("simplifySloppy.passes", size_t(pass));
+	MESHOPTIMIZER_PROFILE_END("simplifySloppy.gridSearch");
+
 	if (min_triangles == 0)
 	{
-		if (out_result_error)
-			*out_result_error = 1.f;
-
+		*out_result_error = 1.f;
 		return 0;
 	}
 
 	// build vertex->cell association by mapping all vertices with the same quantized position to the same cell
+	MESHOPTIMIZER_PROFILE_BEGIN("simplifySloppy.fillVertexCells");
 	size_t table_size = hashBuckets2(vertex_count);
 	unsigned int* table = allocator.allocate<unsigned int>(table_size);
 
@@ -1516,18 +2096,23 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 
 	computeVertexIds(vertex_ids, vertex_positions, vertex_count, min_grid);
 	size_t cell_count = fillVertexCells(table, table_size, vertex_cells, vertex_ids, vertex_count);
+	MESHOPTIMIZER_PROFILE_END("simplifySloppy.fillVertexCells");
 
 	// build a quadric for each target cell
+	MESHOPTIMIZER_PROFILE_BEGIN("simplifySloppy.fillCellQuadrics");
 	Quadric* cell_quadrics = allocator.allocate<Quadric>(cell_count);
 	memset(cell_quadrics, 0, cell_count * sizeof(Quadric));
 
 	fillCellQuadrics(cell_quadrics, indices, index_count, vertex_positions, vertex_cells);
+	MESHOPTIMIZER_PROFILE_END("simplifySloppy.fillCellQuadrics");
 
 	// for each target cell, find the vertex with the minimal error
+	MESHOPTIMIZER_PROFILE_BEGIN("simplifySloppy.fillCellRemap");
 	unsigned int* cell_remap = allocator.allocate<unsigned int>(cell_count);
 	float* cell_errors = allocator.allocate<float>(cell_count);
 
 	fillCellRemap(cell_remap, cell_errors, cell_count, vertex_cells, cell_quadrics, vertex_positions, vertex_count);
+	MESHOPTIMIZER_PROFILE_END("simplifySloppy.fillCellRemap");
 
 	// compute error
 	float result_error = 0.f;
@@ -1540,80 +2125,174 @@ size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* ind
 	size_t tritable_size = hashBuckets2(min_triangles);
 	unsigned int* tritable = allocator.allocate<unsigned int>(tritable_size);
 
+	MESHOPTIMIZER_PROFILE_BEGIN("simplifySloppy.filterTriangles");
 	size_t write = filterTriangles(destination, tritable, tritable_size, indices, index_count, vertex_cells, cell_remap);
+	MESHOPTIMIZER_PROFILE_END("simplifySloppy.filterTriangles");
 
 #if TRACE
 	printf("result: %d cells, %d triangles (%d unfiltered), error %e\n", int(cell_count), int(write / 3), int(min_triangles), sqrtf(result_error));
 #endif
 
-	if (out_result_error)
-		*out_result_error = sqrtf(result_error);
+	*out_result_error = sqrtf(result_error);
 
 	return write;
 }
 
-size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_vertex_count)
-{
-	using namespace meshopt;
+} // namespace meshopt
+
+size_t meshopt_simplifySloppy(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_index_count, float target_error, float* out_result_error)
+{
+	using namespace meshopt;
 
+	assert(index_count % 3 == 0);
 	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
 	assert(vertex_positions_stride % sizeof(float) == 0);
-	assert(target_vertex_count <= vertex_count);
+	assert(target_index_count <= index_count);
 
-	size_t target_cell_count = target_vertex_count;
+	MESHOPTIMIZER_PROFILE_BEGIN("simplifySloppy");
 
-	if (target_cell_count == 0)
-		return 0;
+	meshopt_Allocator allocator;
+
+	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
+	rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+	float result_error = 0.f;
+	size_t result = simplifySloppyGrid(destination, indices, index_count, vertex_positions, vertex_count, target_index_count, target_error, &result_error);
+
+	if (out_result_error)
+		*out_result_error = result_error;
+
+	MESHOPTIMIZER_PROFILE_END("simplifySloppy");
+	return result;
+}
+
+size_t meshopt_simplifySloppyLods(unsigned int* destination, size_t* lod_index_counts, const unsigned int* indices, size_t index_count, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, const size_t* target_index_counts, const float* target_errors, size_t lod_count, float* lod_errors)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	MESHOPTIMIZER_PROFILE_BEGIN("simplifySloppyLods");
 
 	meshopt_Allocator allocator;
 
+	// positions are rescaled once using the extents of the full mesh, so that grids of all levels are aligned to the same space
 	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
 	rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride);
 
-	// find the optimal grid size using guided binary search
-#if TRACE
-	printf("source: %d vertices\n", int(vertex_count));
-	printf("target: %d cells\n", int(target_cell_count));
-#endif
+	// subsequent levels are built from the compacted previous level; local_remap maps original vertices to compacted vertices and is ~0 outside of the current level
+	unsigned int* local_remap = allocator.allocate<unsigned int>(vertex_count);
+	memset(local_remap, -1, vertex_count * sizeof(unsigned int));
 
-	unsigned int* vertex_ids = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* local_vertices = allocator.allocate<unsigned int>(vertex_count);
+	Vector3* local_positions = allocator.allocate<Vector3>(vertex_count);
+	unsigned int* local_indices = allocator.allocate<unsigned int>(index_count);
 
-	size_t table_size = hashBuckets2(vertex_count);
-	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+	size_t offset = 0;
+	float error = 0.f;
 
+	for (size_t lod = 0; lod < lod_count; ++lod)
+	{
+		assert(target_index_counts[lod] <= index_count);
+
+		size_t size = 0;
+		float lod_error = 0.f;
+
+		// each level is measured against the previous level, so the error relative to the original mesh is bounded by the sum of errors; the previous levels consume part of the error budget
+		float target_error = target_errors[lod] > error ? target_errors[lod] - error : 0.f;
+
+		if (lod == 0)
+		{
+			size = simplifySloppyGrid(destination, indices, index_count, vertex_positions, vertex_count, target_index_counts[lod], target_error, &lod_error);
+		}
+		else
+		{
+			const unsigned int* source = destination + offset - lod_index_counts[lod - 1];
+			size_t source_count = lod_index_counts[lod - 1];
+
+			size_t local_count = 0;
+
+			for (size_t i = 0; i < source_count; ++i)
+			{
+				unsigned int v = source[i];
+
+				if (local_remap[v] == ~0u)
+				{
+					local_remap[v] = unsigned(local_count);
+					local_vertices[local_count] = v;
+					local_positions[local_count] = vertex_positions[v];
+					local_count++;
+				}
+
+				local_indices[i] = local_remap[v];
+			}
+
+			unsigned int* target = destination + offset;
+			size = simplifySloppyGrid(target, local_indices, source_count, local_positions, local_count, target_index_counts[lod], target_error, &lod_error);
+
+			for (size_t i = 0; i < size; ++i)
+				target[i] = local_vertices[target[i]];
+
+			for (size_t i = 0; i < local_count; ++i)
+				local_remap[local_vertices[i]] = ~0u;
+		}
+
+		error = (size == 0) ? 1.f : error + lod_error;
+		error = error > 1.f ? 1.f : error;
+
+		lod_index_counts[lod] = size;
+
+		if (lod_errors)
+			lod_errors[lod] = error;
+
+		offset += size;
+	}
+
+	MESHOPTIMIZER_PROFILE_END("simplifySloppyLods");
+	return offset;
+}
+
+namespace meshopt
+{
+
+// finds the largest grid size that produces at most target_count cells using guided binary search; returns 0 if the target can't be reached
+static int findPointGrid(size_t* out_cells, unsigned int* vertex_ids, unsigned int* table, size_t table_size, const Vector3* vertex_positions, size_t point_count, size_t target_count)
+{
 	const int kInterpolationPasses = 5;
 
 	// invariant: # of vertices in min_grid <= target_count
 	int min_grid = 0;
 	int max_grid = 1025;
 	size_t min_vertices = 0;
-	size_t max_vertices = vertex_count;
+	size_t max_vertices = point_count;
 
 	// instead of starting in the middle, let's guess as to what the answer might be! triangle count usually grows as a square of grid size...
-	int next_grid_size = int(sqrtf(float(target_cell_count)) + 0.5f);
+	int next_grid_size = int(sqrtf(float(target_count)) + 0.5f);
 
 	for (int pass = 0; pass < 10 + kInterpolationPasses; ++pass)
 	{
-		assert(min_vertices < target_vertex_count);
+		assert(min_vertices < target_count);
 		assert(max_grid - min_grid > 1);
 
 		// we clamp the prediction of the grid size to make sure that the search converges
 		int grid_size = next_grid_size;
 		grid_size = (grid_size <= min_grid) ? min_grid + 1 : (grid_size >= max_grid) ? max_grid - 1 : grid_size;
 
-		computeVertexIds(vertex_ids, vertex_positions, vertex_count, grid_size);
-		size_t vertices = countVertexCells(table, table_size, vertex_ids, vertex_count);
+		computeVertexIds(vertex_ids, vertex_positions, point_count, grid_size);
+		size_t vertices = countVertexCells(table, table_size, vertex_ids, point_count);
 
 #if TRACE
 		printf("pass %d (%s): grid size %d, vertices %d, %s\n",
 		    pass, (pass == 0) ? "guess" : (pass <= kInterpolationPasses) ? "lerp" : "binary",
 		    grid_size, int(vertices),
-		    (vertices <= target_vertex_count) ? "under" : "over");
+		    (vertices <= target_count) ? "under" : "over");
 #endif
 
-		float tip = interpolate(float(target_vertex_count), float(min_grid), float(min_vertices), float(grid_size), float(vertices), float(max_grid), float(max_vertices));
+		float tip = interpolate(float(target_count), float(min_grid), float(min_vertices), float(grid_size), float(vertices), float(max_grid), float(max_vertices));
 
-		if (vertices <= target_vertex_count)
+		if (vertices <= target_count)
 		{
 			min_grid = grid_size;
 			min_vertices = vertices;
@@ -1624,7 +2303,7 @@ size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_pos
 			max_vertices = vertices;
 		}
 
-		if (vertices == target_vertex_count || max_grid - min_grid <= 1)
+		if (vertices == target_count || max_grid - min_grid <= 1)
 			break;
 
 		// we start by using interpolation search - it usually converges faster
@@ -1632,6 +2311,44 @@ size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_pos
 		next_grid_size = (pass < kInterpolationPasses) ? int(tip + 0.5f) : (min_grid + max_grid) / 2;
 	}
 
+	*out_cells = min_vertices;
+	return min_vertices == 0 ? 0 : min_grid;
+}
+
+} // namespace meshopt
+
+size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride, size_t target_vertex_count)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+	assert(target_vertex_count <= vertex_count);
+
+	size_t target_cell_count = target_vertex_count;
+
+	if (target_cell_count == 0)
+		return 0;
+
+	meshopt_Allocator allocator;
+
+	Vector3* vertex_positions = allocator.allocate<Vector3>(vertex_count);
+	rescalePositions(vertex_positions, vertex_positions_data, vertex_count, vertex_positions_stride);
+
+	// find the optimal grid size using guided binary search
+#if TRACE
+	printf("source: %d vertices\n", int(vertex_count));
+	printf("target: %d cells\n", int(target_cell_count));
+#endif
+
+	unsigned int* vertex_ids = allocator.allocate<unsigned int>(vertex_count);
+
+	size_t table_size = hashBuckets2(vertex_count);
+	unsigned int* table = allocator.allocate<unsigned int>(table_size);
+
+	size_t min_vertices = 0;
+	int min_grid = findPointGrid(&min_vertices, vertex_ids, table, table_size, vertex_positions, vertex_count, target_vertex_count);
+
 	if (min_vertices == 0)
 		return 0;
 
@@ -1664,6 +2381,412 @@ size_t meshopt_simplifyPoints(unsigned int* destination, const float* vertex_pos
 	return cell_count;
 }
 
+namespace meshopt
+{
+
+// the stream quantizes points on a 1024^3 grid; cells of level L cover 2^L x 2^L x 2^L grid points, so coarser levels nest exactly
+const int kPointStreamGridBits = 10;
+
+// number of points processed by a single task in parallel parts of meshopt_simplifyPointsStreamAdd
+const size_t kPointStreamTaskSize = 16384;
+
+struct PointStreamLayout
+{
+	unsigned int* table;
+	size_t table_size;
+
+	unsigned int* cell_ids;
+	Quadric* cell_quadrics;
+	unsigned int* cell_groups;
+
+	Quadric* group_quadrics;
+	unsigned int* group_remap;
+	float* group_errors;
+};
+
+static void getPointStreamLayout(const meshopt_SimplifyPointsStream* stream, PointStreamLayout& layout)
+{
+	unsigned char* data = static_cast<unsigned char*>(stream->data);
+	size_t capacity = stream->cell_capacity;
+
+	// quadrics go first to keep them aligned; the last cell slot is used for insertions before the cell count is checked against the capacity
+	layout.cell_quadrics = reinterpret_cast<Quadric*>(data);
+	layout.group_quadrics = layout.cell_quadrics + capacity + 1;
+
+	layout.table_size = hashBuckets2(capacity + 1);
+	layout.table = reinterpret_cast<unsigned int*>(layout.group_quadrics + capacity);
+	layout.cell_ids = layout.table + layout.table_size;
+	layout.cell_groups = layout.cell_ids + capacity + 1;
+	layout.group_remap = layout.cell_groups + capacity;
+	layout.group_errors = reinterpret_cast<float*>(layout.group_remap + capacity);
+}
+
+static unsigned int getPointStreamCell(unsigned int id, unsigned int level)
+{
+	const unsigned int mask = (1 << kPointStreamGridBits) - 1;
+
+	unsigned int x = ((id >> (kPointStreamGridBits * 2)) & mask) >> level;
+	unsigned int y = ((id >> kPointStreamGridBits) & mask) >> level;
+	unsigned int z = (id & mask) >> level;
+
+	return (x << (kPointStreamGridBits * 2)) | (y << kPointStreamGridBits) | z;
+}
+
+static unsigned int findPointStreamCell(const unsigned int* table, size_t table_size, const unsigned int* cell_ids, unsigned int id)
+{
+	IdHasher hasher;
+
+	// same probe sequence as hashLookup2 with CellHasher, but reads the table without using the spare cell slot so that it can run concurrently
+	size_t hashmod = table_size - 1;
+	size_t bucket = hasher.hash(id) & hashmod;
+
+	for (size_t probe = 0; probe <= hashmod; ++probe)
+	{
+		unsigned int item = table[bucket];
+
+		if (item == ~0u || cell_ids[item] == id)
+			return item;
+
+		bucket = (bucket + probe + 1) & hashmod;
+	}
+
+	return ~0u;
+}
+
+// merges cells into their parents on the next level until the cell count fits into capacity
+static void coarsenPointStream(meshopt_SimplifyPointsStream* stream, const PointStreamLayout& layout)
+{
+	CellHasher hasher = {layout.cell_ids};
+
+	while (stream->cell_count > stream->cell_capacity)
+	{
+		assert(stream->level < unsigned(kPointStreamGridBits));
+		stream->level++;
+
+		memset(layout.table, -1, layout.table_size * sizeof(unsigned int));
+
+		size_t cell_count = 0;
+
+		for (size_t i = 0; i < stream->cell_count; ++i)
+		{
+			// compact the cell into the next free slot first; since cell_count <= i, this never overwrites cells that haven't been processed yet
+			layout.cell_ids[cell_count] = getPointStreamCell(layout.cell_ids[i], 1);
+			layout.cell_quadrics[cell_count] = layout.cell_quadrics[i];
+
+			unsigned int* entry = hashLookup2(layout.table, layout.table_size, hasher, unsigned(cell_count), ~0u);
+
+			if (*entry == ~0u)
+			{
+				*entry = unsigned(cell_count);
+				cell_count++;
+			}
+			else
+			{
+				quadricAdd(layout.cell_quadrics[*entry], layout.cell_quadrics[cell_count]);
+			}
+		}
+
+		stream->cell_count = cell_count;
+	}
+}
+
+struct PointStreamTask
+{
+	const meshopt_SimplifyPointsStream* stream;
+	PointStreamLayout layout;
+
+	const float* vertex_positions;
+	size_t vertex_count;
+	size_t vertex_stride_float;
+	float scale;
+
+	Vector3* points;
+	unsigned int* point_ids;
+	unsigned int* point_groups;
+	float* point_errors;
+};
+
+static float getPointStreamScale(const meshopt_SimplifyPointsStream* stream)
+{
+	float extent = 0.f;
+
+	for (int k = 0; k < 3; ++k)
+		extent = (stream->bounds_max[k] - stream->bounds_min[k]) < extent ? extent : (stream->bounds_max[k] - stream->bounds_min[k]);
+
+	return extent == 0 ? 0.f : 1.f / extent;
+}
+
+static void getPointStreamPosition(Vector3& result, const meshopt_SimplifyPointsStream* stream, float scale, const float* v)
+{
+	result.x = (v[0] - stream->bounds_min[0]) * scale;
+	result.y = (v[1] - stream->bounds_min[1]) * scale;
+	result.z = (v[2] - stream->bounds_min[2]) * scale;
+}
+
+static unsigned int getPointStreamId(const Vector3& v)
+{
+	const float grid = float(1 << kPointStreamGridBits);
+	const int maxi = (1 << kPointStreamGridBits) - 1;
+
+	// points outside of the bounds are clamped to the boundary cells
+	int xi = int(v.x * grid);
+	int yi = int(v.y * grid);
+	int zi = int(v.z * grid);
+
+	xi = xi < 0 ? 0 : (xi > maxi ? maxi : xi);
+	yi = yi < 0 ? 0 : (yi > maxi ? maxi : yi);
+	zi = zi < 0 ? 0 : (zi > maxi ? maxi : zi);
+
+	return (unsigned(xi) << (kPointStreamGridBits * 2)) | (unsigned(yi) << kPointStreamGridBits) | unsigned(zi);
+}
+
+static void quantizePointStreamTask(void* context, size_t task_index)
+{
+	const PointStreamTask& task = *static_cast<const PointStreamTask*>(context);
+
+	size_t begin = task_index * kPointStreamTaskSize;
+	size_t end = begin + kPointStreamTaskSize < task.vertex_count ? begin + kPointStreamTaskSize : task.vertex_count;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		getPointStreamPosition(task.points[i], task.stream, task.scale, task.vertex_positions + i * task.vertex_stride_float);
+
+		task.point_ids[i] = getPointStreamId(task.points[i]);
+	}
+}
+
+static void evaluatePointStreamTask(void* context, size_t task_index)
+{
+	const PointStreamTask& task = *static_cast<const PointStreamTask*>(context);
+	const PointStreamLayout& layout = task.layout;
+
+	size_t begin = task_index * kPointStreamTaskSize;
+	size_t end = begin + kPointStreamTaskSize < task.vertex_count ? begin + kPointStreamTaskSize : task.vertex_count;
+
+	for (size_t i = begin; i < end; ++i)
+	{
+		Vector3 v;
+		getPointStreamPosition(v, task.stream, task.scale, task.vertex_positions + i * task.vertex_stride_float);
+
+		unsigned int id = getPointStreamCell(getPointStreamId(v), task.stream->level);
+		unsigned int cell = findPointStreamCell(layout.table, layout.table_size, layout.cell_ids, id);
+
+		// points that weren't seen during the first pass are ignored
+		unsigned int group = cell == ~0u ? ~0u : layout.cell_groups[cell];
+
+		task.point_groups[i] = group;
+		task.point_errors[i] = group == ~0u ? 0.f : quadricError(layout.group_quadrics[group], v);
+	}
+}
+
+static void dispatchPointStream(void (*task)(void*, size_t), PointStreamTask& context, meshopt_Dispatch dispatch, void* dispatch_context)
+{
+	size_t task_count = (context.vertex_count + kPointStreamTaskSize - 1) / kPointStreamTaskSize;
+
+	if (dispatch && task_count > 1)
+	{
+		dispatch(dispatch_context, task, &context, task_count);
+	}
+	else
+	{
+		for (size_t i = 0; i < task_count; ++i)
+			task(&context, i);
+	}
+}
+
+// clusters cells into at most target_vertex_count groups using cell centroids
+static void groupPointStream(meshopt_SimplifyPointsStream* stream, const PointStreamLayout& layout)
+{
+	size_t cell_count = stream->cell_count;
+
+	stream->group_count = 0;
+
+	if (cell_count == 0 || stream->target_vertex_count == 0)
+		return;
+
+	if (cell_count <= stream->target_vertex_count)
+	{
+		for (size_t i = 0; i < cell_count; ++i)
+			layout.cell_groups[i] = unsigned(i);
+
+		stream->group_count = cell_count;
+	}
+	else
+	{
+		meshopt_Allocator allocator;
+
+		// the quadric of a point cluster encodes its centroid (see quadricFromPoint)
+		Vector3* centroids = allocator.allocate<Vector3>(cell_count);
+
+		for (size_t i = 0; i < cell_count; ++i)
+		{
+			const Quadric& Q = layout.cell_quadrics[i];
+
+			centroids[i].x = -0.5f * Q.b0 / Q.w;
+			centroids[i].y = -0.5f * Q.b1 / Q.w;
+			centroids[i].z = -0.5f * Q.b2 / Q.w;
+		}
+
+		unsigned int* ids = allocator.allocate<unsigned int>(cell_count);
+
+		size_t table_size = hashBuckets2(cell_count);
+		unsigned int* table = allocator.allocate<unsigned int>(table_size);
+
+		size_t group_count = 0;
+		int grid_size = findPointGrid(&group_count, ids, table, table_size, centroids, cell_count, stream->target_vertex_count);
+
+		if (grid_size == 0)
+			return;
+
+		computeVertexIds(ids, centroids, cell_count, grid_size);
+		stream->group_count = fillVertexCells(table, table_size, layout.cell_groups, ids, cell_count);
+	}
+
+	memset(layout.group_quadrics, 0, stream->group_count * sizeof(Quadric));
+
+	for (size_t i = 0; i < cell_count; ++i)
+		quadricAdd(layout.group_quadrics[layout.cell_groups[i]], layout.cell_quadrics[i]);
+
+	for (size_t i = 0; i < stream->group_count; ++i)
+	{
+		layout.group_remap[i] = ~0u;
+		layout.group_errors[i] = FLT_MAX;
+	}
+}
+
+} // namespace meshopt
+
+size_t meshopt_simplifyPointsStreamBound(size_t cell_capacity)
+{
+	using namespace meshopt;
+
+	return (cell_capacity * 2 + 1) * sizeof(Quadric) + hashBuckets2(cell_capacity + 1) * sizeof(unsigned int) + (cell_capacity * 4 + 1) * sizeof(unsigned int);
+}
+
+void meshopt_simplifyPointsStreamBegin(meshopt_SimplifyPointsStream* stream, unsigned int pass)
+{
+	using namespace meshopt;
+
+	assert(stream->data && stream->cell_capacity > 0);
+	assert(stream->target_vertex_count <= stream->cell_capacity);
+	assert(pass <= 1);
+	assert(pass == 0 || stream->pass == 0);
+
+	PointStreamLayout layout;
+	getPointStreamLayout(stream, layout);
+
+	if (pass == 0)
+	{
+		memset(layout.table, -1, layout.table_size * sizeof(unsigned int));
+
+		stream->level = 0;
+		stream->cell_count = 0;
+		stream->group_count = 0;
+	}
+	else
+	{
+		groupPointStream(stream, layout);
+	}
+
+	stream->pass = pass;
+	stream->vertex_count = 0;
+}
+
+void meshopt_simplifyPointsStreamAdd(meshopt_SimplifyPointsStream* stream, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	meshopt_Allocator allocator;
+
+	PointStreamTask task = {};
+	task.stream = stream;
+	getPointStreamLayout(stream, task.layout);
+	task.vertex_positions = vertex_positions;
+	task.vertex_count = vertex_count;
+	task.vertex_stride_float = vertex_positions_stride / sizeof(float);
+	task.scale = getPointStreamScale(stream);
+
+	const PointStreamLayout& layout = task.layout;
+
+	if (stream->pass == 0)
+	{
+		// quantization runs in parallel; accumulation is serial so that the result doesn't depend on the batch size or dispatch
+		task.points = allocator.allocate<Vector3>(vertex_count);
+		task.point_ids = allocator.allocate<unsigned int>(vertex_count);
+		dispatchPointStream(quantizePointStreamTask, task, dispatch, context);
+
+		CellHasher hasher = {layout.cell_ids};
+
+		for (size_t i = 0; i < vertex_count; ++i)
+		{
+			const Vector3& v = task.points[i];
+
+			Quadric Q;
+			quadricFromPoint(Q, v.x, v.y, v.z, 1.f);
+
+			// the new cell goes into the spare slot; if it's unique, the cell count may exceed capacity until the stream is coarsened
+			unsigned int index = unsigned(stream->cell_count);
+			layout.cell_ids[index] = getPointStreamCell(task.point_ids[i], stream->level);
+
+			unsigned int* entry = hashLookup2(layout.table, layout.table_size, hasher, index, ~0u);
+
+			if (*entry == ~0u)
+			{
+				*entry = index;
+				layout.cell_quadrics[index] = Q;
+				stream->cell_count++;
+
+				coarsenPointStream(stream, layout);
+			}
+			else
+			{
+				quadricAdd(layout.cell_quadrics[*entry], Q);
+			}
+		}
+	}
+	else
+	{
+		// cell lookup and error evaluation run in parallel; the selection of the best point for each group is serial
+		task.point_groups = allocator.allocate<unsigned int>(vertex_count);
+		task.point_errors = allocator.allocate<float>(vertex_count);
+		dispatchPointStream(evaluatePointStreamTask, task, dispatch, context);
+
+		for (size_t i = 0; i < vertex_count; ++i)
+		{
+			unsigned int group = task.point_groups[i];
+
+			if (group != ~0u && task.point_errors[i] < layout.group_errors[group])
+			{
+				layout.group_remap[group] = unsigned(stream->vertex_count + i);
+				layout.group_errors[group] = task.point_errors[i];
+			}
+		}
+	}
+
+	stream->vertex_count += vertex_count;
+}
+
+size_t meshopt_simplifyPointsStreamEnd(const meshopt_SimplifyPointsStream* stream, unsigned int* destination)
+{
+	using namespace meshopt;
+
+	assert(stream->pass == 1);
+
+	PointStreamLayout layout;
+	getPointStreamLayout(stream, layout);
+
+	size_t result = 0;
+
+	for (size_t i = 0; i < stream->group_count; ++i)
+		if (layout.group_remap[i] != ~0u)
+			destination[result++] = layout.group_remap[i];
+
+	return result;
+}
+
 float meshopt_simplifyScale(const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
 	using namespace meshopt;
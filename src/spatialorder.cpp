@@ -21,13 +21,8 @@ inline unsigned int part1By2(unsigned int x)
 	return x;
 }
 
-static void computeOrder(unsigned int* result, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride)
+static void computeBounds(float minv[3], float maxv[3], const float* vertex_positions_data, size_t vertex_count, size_t vertex_stride_float)
 {
-	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
-
-	float minv[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
-	float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
-
 	for (size_t i = 0; i < vertex_count; ++i)
 	{
 		const float* v = vertex_positions_data + i * vertex_stride_float;
@@ -40,15 +35,21 @@ static void computeOrder(unsigned int* result, const float* vertex_positions_dat
 			maxv[j] = maxv[j] < vj ? vj : maxv[j];
 		}
 	}
+}
 
+static float computeScale(const float minv[3], const float maxv[3])
+{
 	float extent = 0.f;
 
 	extent = (maxv[0] - minv[0]) < extent ? extent : (maxv[0] - minv[0]);
 	extent = (maxv[1] - minv[1]) < extent ? extent : (maxv[1] - minv[1]);
 	extent = (maxv[2] - minv[2]) < extent ? extent : (maxv[2] - minv[2]);
 
-	float scale = extent == 0 ? 0.f : 1.f / extent;
+	return extent == 0 ? 0.f : 1.f / extent;
+}
 
+static void computeKeys(unsigned int* result, const float* vertex_positions_data, size_t vertex_count, size_t vertex_stride_float, const float minv[3], float scale)
+{
 	// generate Morton order based on the position inside a unit cube
 	for (size_t i = 0; i < vertex_count; ++i)
 	{
@@ -62,6 +63,20 @@ static void computeOrder(unsigned int* result, const float* vertex_positions_dat
 	}
 }
 
+static void computeOrder(unsigned int* result, const float* vertex_positions_data, size_t vertex_count, size_t vertex_positions_stride)
+{
+	size_t vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	float minv[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+	float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+	computeBounds(minv, maxv, vertex_positions_data, vertex_count, vertex_stride_float);
+
+	float scale = computeScale(minv, maxv);
+
+	computeKeys(result, vertex_positions_data, vertex_count, vertex_stride_float, minv, scale);
+}
+
 static void computeHistogram(unsigned int (&hist)[1024][3], const unsigned int* data, size_t count)
 {
 	memset(hist, 0, sizeof(hist));
@@ -107,6 +122,119 @@ static void radixPass(unsigned int* destination, const unsigned int* source, con
 	}
 }
 
+// Parallel sort splits the data into blocks of this many elements; each block has its own histograms
+const size_t kSortBlockSize = 65536;
+
+struct SortBlocks
+{
+	size_t count;
+	size_t block_count;
+
+	const float* vertex_positions;
+	size_t vertex_stride_float;
+
+	float* bounds; // 6 floats per block
+	float minv[3];
+	float scale;
+
+	unsigned int* keys;
+	unsigned int* hist; // 1024 counts/offsets per block
+
+	const unsigned int* source;
+	unsigned int* destination;
+	int pass;
+};
+
+static void sortBoundsTask(void* context, size_t task_index)
+{
+	SortBlocks& blocks = *static_cast<SortBlocks*>(context);
+
+	size_t begin = task_index * kSortBlockSize;
+	size_t count = blocks.count - begin < kSortBlockSize ? blocks.count - begin : kSortBlockSize;
+
+	float* bounds = blocks.bounds + task_index * 6;
+
+	for (int j = 0; j < 3; ++j)
+	{
+		bounds[j] = FLT_MAX;
+		bounds[3 + j] = -FLT_MAX;
+	}
+
+	computeBounds(bounds, bounds + 3, blocks.vertex_positions + begin * blocks.vertex_stride_float, count, blocks.vertex_stride_float);
+}
+
+static void sortKeysTask(void* context, size_t task_index)
+{
+	SortBlocks& blocks = *static_cast<SortBlocks*>(context);
+
+	size_t begin = task_index * kSortBlockSize;
+	size_t count = blocks.count - begin < kSortBlockSize ? blocks.count - begin : kSortBlockSize;
+
+	computeKeys(blocks.keys + begin, blocks.vertex_positions + begin * blocks.vertex_stride_float, count, blocks.vertex_stride_float, blocks.minv, blocks.scale);
+}
+
+static void sortHistogramTask(void* context, size_t task_index)
+{
+	SortBlocks& blocks = *static_cast<SortBlocks*>(context);
+
+	size_t begin = task_index * kSortBlockSize;
+	size_t end = blocks.count - begin < kSortBlockSize ? blocks.count : begin + kSortBlockSize;
+
+	unsigned int* hist = blocks.hist + task_index * 1024;
+	memset(hist, 0, 1024 * sizeof(unsigned int));
+
+	int bitoff = blocks.pass * 10;
+
+	for (size_t i = begin; i < end; ++i)
+		hist[(blocks.keys[blocks.source[i]] >> bitoff) & 1023]++;
+}
+
+static void sortScatterTask(void* context, size_t task_index)
+{
+	SortBlocks& blocks = *static_cast<SortBlocks*>(context);
+
+	size_t begin = task_index * kSortBlockSize;
+	size_t end = blocks.count - begin < kSortBlockSize ? blocks.count : begin + kSortBlockSize;
+
+	unsigned int* hist = blocks.hist + task_index * 1024;
+
+	int bitoff = blocks.pass * 10;
+
+	// each block scatters its elements in order starting from its own offsets, which keeps the sort stable
+	for (size_t i = begin; i < end; ++i)
+	{
+		unsigned int id = (blocks.keys[blocks.source[i]] >> bitoff) & 1023;
+
+		blocks.destination[hist[id]++] = blocks.source[i];
+	}
+}
+
+static void sortReverseTask(void* context, size_t task_index)
+{
+	SortBlocks& blocks = *static_cast<SortBlocks*>(context);
+
+	size_t begin = task_index * kSortBlockSize;
+	size_t end = blocks.count - begin < kSortBlockSize ? blocks.count : begin + kSortBlockSize;
+
+	for (size_t i = begin; i < end; ++i)
+		blocks.destination[blocks.source[i]] = unsigned(i);
+}
+
+static void computeBlockOffsets(unsigned int* hist, size_t block_count)
+{
+	unsigned int sum = 0;
+
+	// replace per-block histograms with offsets in digit-major, block-minor order, matching the serial scatter order
+	for (size_t d = 0; d < 1024; ++d)
+		for (size_t b = 0; b < block_count; ++b)
+		{
+			unsigned int h = hist[b * 1024 + d];
+
+			hist[b * 1024 + d] = sum;
+			sum += h;
+		}
+}
+
 } // namespace meshopt
 
 void meshopt_spatialSortRemap(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
@@ -139,6 +267,74 @@ void meshopt_spatialSortRemap(unsigned int* destination, const float* vertex_pos
 		destination[scratch[i]] = unsigned(i);
 }
 
+void meshopt_spatialSortRemapParallel(unsigned int* destination, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	if (!dispatch || vertex_count <= kSortBlockSize)
+		return meshopt_spatialSortRemap(destination, vertex_positions, vertex_count, vertex_positions_stride);
+
+	meshopt_Allocator allocator;
+
+	size_t block_count = (vertex_count + kSortBlockSize - 1) / kSortBlockSize;
+
+	SortBlocks blocks = {};
+	blocks.count = vertex_count;
+	blocks.block_count = block_count;
+	blocks.vertex_positions = vertex_positions;
+	blocks.vertex_stride_float = vertex_positions_stride / sizeof(float);
+
+	// compute bounds for each block and merge them; min/max are exact so this matches the serial result
+	blocks.bounds = allocator.allocate<float>(block_count * 6);
+	dispatch(context, sortBoundsTask, &blocks, block_count);
+
+	float maxv[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+	for (int j = 0; j < 3; ++j)
+		blocks.minv[j] = FLT_MAX;
+
+	for (size_t b = 0; b < block_count; ++b)
+		for (int j = 0; j < 3; ++j)
+		{
+			float bmin = blocks.bounds[b * 6 + j], bmax = blocks.bounds[b * 6 + 3 + j];
+
+			blocks.minv[j] = blocks.minv[j] > bmin ? bmin : blocks.minv[j];
+			maxv[j] = maxv[j] < bmax ? bmax : maxv[j];
+		}
+
+	blocks.scale = computeScale(blocks.minv, maxv);
+
+	blocks.keys = allocator.allocate<unsigned int>(vertex_count);
+	dispatch(context, sortKeysTask, &blocks, block_count);
+
+	blocks.hist = allocator.allocate<unsigned int>(block_count * 1024);
+
+	unsigned int* scratch = allocator.allocate<unsigned int>(vertex_count);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		destination[i] = unsigned(i);
+
+	// 3-pass radix sort computes the resulting order into scratch; histograms depend on the order after the previous pass so they are recomputed for every pass
+	for (int pass = 0; pass < 3; ++pass)
+	{
+		blocks.source = (pass & 1) ? scratch : destination;
+		blocks.destination = (pass & 1) ? destination : scratch;
+		blocks.pass = pass;
+
+		dispatch(context, sortHistogramTask, &blocks, block_count);
+		computeBlockOffsets(blocks.hist, block_count);
+		dispatch(context, sortScatterTask, &blocks, block_count);
+	}
+
+	// since our remap table is mapping old=>new, we need to reverse it
+	blocks.source = scratch;
+	blocks.destination = destination;
+	dispatch(context, sortReverseTask, &blocks, block_count);
+}
+
 void meshopt_spatialSortTriangles(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride)
 {
 	using namespace meshopt;
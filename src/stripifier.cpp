@@ -47,6 +47,173 @@ static int findStripNext(const unsigned int buffer[][3], unsigned int buffer_siz
 	return -1;
 }
 
+
+struct StripAdjacency
+{
+	unsigned int* counts;
+	unsigned int* offsets;
+	unsigned int* data;
+};
+
+static void buildStripAdjacency(StripAdjacency& adjacency, const unsigned int* indices, size_t index_count, size_t vertex_count, meshopt_Allocator& allocator)
+{
+	size_t face_count = index_count / 3;
+
+	adjacency.counts = allocator.allocate<unsigned int>(vertex_count);
+	adjacency.offsets = allocator.allocate<unsigned int>(vertex_count);
+	adjacency.data = allocator.allocate<unsigned int>(index_count);
+
+	memset(adjacency.counts, 0, vertex_count * sizeof(unsigned int));
+
+	for (size_t i = 0; i < index_count; ++i)
+	{
+		assert(indices[i] < vertex_count);
+
+		adjacency.counts[indices[i]]++;
+	}
+
+	unsigned int offset = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		adjacency.offsets[i] = offset;
+		offset += adjacency.counts[i];
+	}
+
+	assert(offset == index_count);
+
+	for (size_t i = 0; i < face_count; ++i)
+	{
+		unsigned int a = indices[i * 3 + 0], b = indices[i * 3 + 1], c = indices[i * 3 + 2];
+
+		adjacency.data[adjacency.offsets[a]++] = unsigned(i);
+		adjacency.data[adjacency.offsets[b]++] = unsigned(i);
+		adjacency.data[adjacency.offsets[c]++] = unsigned(i);
+	}
+
+	// fix offsets that have been disturbed by the previous pass
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		assert(adjacency.offsets[i] >= adjacency.counts[i]);
+
+		adjacency.offsets[i] -= adjacency.counts[i];
+	}
+}
+
+static void buildStripNeighbors(unsigned int* adjacent, const StripAdjacency& adjacency, const unsigned int* indices, size_t index_count)
+{
+	size_t face_count = index_count / 3;
+
+	// for every triangle edge [a b], find the triangle that contains the opposite edge [b a]
+	for (size_t i = 0; i < face_count; ++i)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			unsigned int a = indices[i * 3 + k], b = indices[i * 3 + (k == 2 ? 0 : k + 1)];
+
+			const unsigned int* triangles = &adjacency.data[adjacency.offsets[b]];
+			size_t triangle_count = adjacency.counts[b];
+
+			unsigned int result = ~0u;
+
+			for (size_t j = 0; j < triangle_count && result == ~0u; ++j)
+			{
+				unsigned int tri = triangles[j];
+				unsigned int ta = indices[tri * 3 + 0], tb = indices[tri * 3 + 1], tc = indices[tri * 3 + 2];
+
+				if (tri != i && ((ta == b && tb == a) || (tb == b && tc == a) || (tc == b && ta == a)))
+					result = tri;
+			}
+
+			adjacent[i * 3 + k] = result;
+		}
+	}
+}
+
+// same as findStripNext, but looks for the triangle with edge [e0 e1] among neighbors of triangle tri that contains [e1 e0]
+static int findStripNextAdjacent(const unsigned int* adjacent, const unsigned char* emitted, const unsigned int* indices, unsigned int tri, unsigned int e0, unsigned int e1)
+{
+	for (int k = 0; k < 3; ++k)
+	{
+		if (indices[tri * 3 + k] != e1 || indices[tri * 3 + (k == 2 ? 0 : k + 1)] != e0)
+			continue;
+
+		unsigned int next = adjacent[tri * 3 + k];
+
+		if (next == ~0u || emitted[next])
+			return -1;
+
+		unsigned int a = indices[next * 3 + 0], b = indices[next * 3 + 1], c = indices[next * 3 + 2];
+
+		if (e0 == a && e1 == b)
+			return (int(next) << 2) | 2;
+		else if (e0 == b && e1 == c)
+			return (int(next) << 2) | 0;
+		else if (e0 == c && e1 == a)
+			return (int(next) << 2) | 1;
+	}
+
+	return -1;
+}
+
+static void emitStripTriangle(unsigned char* emitted, unsigned int* neighbors, const unsigned int* adjacent, unsigned int tri)
+{
+	emitted[tri] = 1;
+
+	// update neighbor counts for strip start heuristic
+	for (int k = 0; k < 3; ++k)
+	{
+		unsigned int next = adjacent[tri * 3 + k];
+
+		if (next != ~0u && !emitted[next] && neighbors[next])
+			neighbors[next]--;
+	}
+}
+
+static unsigned int findStripStartAdjacent(const StripAdjacency& adjacency, const unsigned char* emitted, const unsigned int* neighbors, const unsigned int* vertices, size_t vertex_count)
+{
+	unsigned int result = ~0u;
+	unsigned int best = ~0u;
+
+	// prefer triangles with fewest remaining neighbors; these are the most likely to be left isolated otherwise
+	for (size_t k = 0; k < vertex_count; ++k)
+	{
+		const unsigned int* triangles = &adjacency.data[adjacency.offsets[vertices[k]]];
+		size_t triangle_count = adjacency.counts[vertices[k]];
+
+		for (size_t i = 0; i < triangle_count; ++i)
+		{
+			unsigned int tri = triangles[i];
+
+			if (!emitted[tri] && (neighbors[tri] < best || (neighbors[tri] == best && tri < result)))
+			{
+				result = tri;
+				best = neighbors[tri];
+			}
+		}
+	}
+
+	return result;
+}
+
+static int pickStripNext(const unsigned int* neighbors, int ea, int eb, int ec)
+{
+	// pick the continuation with the fewest remaining neighbors, breaking ties by triangle order
+	int result = -1;
+
+	int edges[3] = {ea, eb, ec};
+
+	for (int k = 0; k < 3; ++k)
+	{
+		int e = edges[k];
+
+		if (e >= 0 && (result < 0 || neighbors[e >> 2] < neighbors[result >> 2] || (neighbors[e >> 2] == neighbors[result >> 2] && e < result)))
+			result = e;
+	}
+
+	return result;
+}
+
 } // namespace meshopt
 
 size_t meshopt_stripify(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index)
@@ -240,6 +407,165 @@ size_t meshopt_stripify(unsigned int* destination, const unsigned int* indices,
 	return strip_size;
 }
 
+size_t meshopt_stripifyAdjacency(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int restart_index)
+{
+	assert(destination != indices);
+	assert(index_count % 3 == 0);
+
+	using namespace meshopt;
+
+	meshopt_Allocator allocator;
+
+	size_t face_count = index_count / 3;
+	assert(face_count < (1u << 29));
+
+	StripAdjacency adjacency = {};
+	buildStripAdjacency(adjacency, indices, index_count, vertex_count, allocator);
+
+	unsigned int* adjacent = allocator.allocate<unsigned int>(index_count);
+	buildStripNeighbors(adjacent, adjacency, indices, index_count);
+
+	// count edge neighbors of each triangle; this is used to prioritize starting triangle for strips
+	unsigned int* neighbors = allocator.allocate<unsigned int>(face_count);
+
+	for (size_t i = 0; i < face_count; ++i)
+		neighbors[i] = (adjacent[i * 3 + 0] != ~0u) + (adjacent[i * 3 + 1] != ~0u) + (adjacent[i * 3 + 2] != ~0u);
+
+	unsigned char* emitted = allocator.allocate<unsigned char>(face_count);
+	memset(emitted, 0, face_count);
+
+	size_t cursor = 0;
+
+	unsigned int strip[2] = {};
+	unsigned int parity = 0;
+
+	size_t strip_size = 0;
+
+	int next = -1;
+
+	for (size_t emitted_count = 0; emitted_count < face_count; ++emitted_count)
+	{
+		if (next >= 0)
+		{
+			unsigned int i = next >> 2;
+			unsigned int v = indices[i * 3 + (next & 3)];
+
+			emitStripTriangle(emitted, neighbors, adjacent, i);
+
+			// find next triangle (note that edge order flips on every iteration)
+			// in some cases we need to perform a swap to pick a different outgoing triangle edge
+			// for [a b c], the default strip edge is [b c], but we might want to use [a c]
+			int cont = findStripNextAdjacent(adjacent, emitted, indices, i, parity ? strip[1] : v, parity ? v : strip[1]);
+			int swap = cont < 0 ? findStripNextAdjacent(adjacent, emitted, indices, i, parity ? v : strip[0], parity ? strip[0] : v) : -1;
+
+			if (cont < 0 && swap >= 0)
+			{
+				// [a b c] => [a b a c]
+				destination[strip_size++] = strip[0];
+				destination[strip_size++] = v;
+
+				// next strip has same winding
+				// ? a b => b a v
+				strip[1] = v;
+
+				next = swap;
+			}
+			else
+			{
+				// emit the next vertex in the strip
+				destination[strip_size++] = v;
+
+				// next strip has flipped winding
+				strip[0] = strip[1];
+				strip[1] = v;
+				parity ^= 1;
+
+				next = cont;
+			}
+		}
+		else
+		{
+			// start the next strip next to the end of the previous one, falling back to the first remaining triangle in input order
+			unsigned int i = strip_size ? findStripStartAdjacent(adjacency, emitted, neighbors, strip, 2) : ~0u;
+
+			if (i == ~0u)
+			{
+				while (emitted[cursor])
+					cursor++;
+
+				i = unsigned(cursor);
+			}
+
+			assert(i < face_count && !emitted[i]);
+
+			unsigned int a = indices[i * 3 + 0], b = indices[i * 3 + 1], c = indices[i * 3 + 2];
+
+			emitStripTriangle(emitted, neighbors, adjacent, i);
+
+			// we need to pre-rotate the triangle so that the outgoing edge has a neighbor to continue the strip with
+			int ea = findStripNextAdjacent(adjacent, emitted, indices, i, c, b);
+			int eb = findStripNextAdjacent(adjacent, emitted, indices, i, a, c);
+			int ec = findStripNextAdjacent(adjacent, emitted, indices, i, b, a);
+
+			next = pickStripNext(neighbors, ea, eb, ec);
+
+			if (next >= 0 && next == eb)
+			{
+				// abc -> bca
+				unsigned int t = a;
+				a = b, b = c, c = t;
+			}
+			else if (next >= 0 && next == ec)
+			{
+				// abc -> cab
+				unsigned int t = c;
+				c = b, b = a, a = t;
+			}
+
+			if (restart_index)
+			{
+				if (strip_size)
+					destination[strip_size++] = restart_index;
+
+				destination[strip_size++] = a;
+				destination[strip_size++] = b;
+				destination[strip_size++] = c;
+
+				// new strip always starts with the same edge winding
+				strip[0] = b;
+				strip[1] = c;
+				parity = 1;
+			}
+			else
+			{
+				if (strip_size)
+				{
+					// connect last strip using degenerate triangles
+					destination[strip_size++] = strip[1];
+					destination[strip_size++] = a;
+				}
+
+				// note that we may need to flip the emitted triangle based on parity
+				// we always end up with outgoing edge "cb" in the end
+				unsigned int e0 = parity ? c : b;
+				unsigned int e1 = parity ? b : c;
+
+				destination[strip_size++] = a;
+				destination[strip_size++] = e0;
+				destination[strip_size++] = e1;
+
+				strip[0] = e0;
+				strip[1] = e1;
+				parity ^= 1;
+			}
+		}
+	}
+
+	assert(strip_size <= meshopt_stripifyBound(index_count));
+
+	return strip_size;
+}
+
 size_t meshopt_stripifyBound(size_t index_count)
 {
 	assert(index_count % 3 == 0);
@@ -13,6 +13,12 @@ namespace meshopt
 const size_t kCacheSizeMax = 16;
 const size_t kValenceMax = 8;
 
+// partitions need to be large enough that the cache restarts at partition boundaries don't affect the efficiency, and small enough that per-partition data fits into CPU cache
+const size_t kVertexCachePartitionSize = 65536;
+
+// incremental optimization reoptimizes dirty triangles together with this many triangles on each side, so that the cache state around the edit converges
+const size_t kVertexCacheIncrementalMargin = 64;
+
 struct VertexScoreTable
 {
 	float cache[1 + kCacheSizeMax];
@@ -164,15 +170,11 @@ static unsigned int getNextTriangleDeadEnd(unsigned int& input_cursor, const uns
 	return ~0u;
 }
 
-} // namespace meshopt
-
-void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const meshopt::VertexScoreTable* table)
+static void optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const VertexScoreTable* table, meshopt_Context* context)
 {
-	using namespace meshopt;
-
 	assert(index_count % 3 == 0);
 
-	meshopt_Allocator allocator;
+	meshopt_Allocator allocator(context);
 
 	// guard for empty meshes
 	if (index_count == 0 || vertex_count == 0)
@@ -348,14 +350,247 @@ void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned
 	assert(output_triangle == face_count);
 }
 
+struct VertexCachePartition
+{
+	size_t index_offset;
+	size_t index_count;
+
+	size_t vertex_offset;
+	size_t vertex_count;
+};
+
+struct VertexCachePartitionBuilder
+{
+	const VertexCachePartition* partitions;
+
+	unsigned int* destination;
+	const unsigned int* partition_indices;
+	const unsigned int* partition_vertices;
+};
+
+static void optimizeVertexCachePartitionTask(void* context, size_t task_index)
+{
+	const VertexCachePartitionBuilder& builder = *static_cast<const VertexCachePartitionBuilder*>(context);
+	const VertexCachePartition& partition = builder.partitions[task_index];
+
+	unsigned int* destination = builder.destination + partition.index_offset;
+	const unsigned int* vertices = builder.partition_vertices + partition.vertex_offset;
+
+	optimizeVertexCacheTable(destination, builder.partition_indices + partition.index_offset, partition.index_count, partition.vertex_count, &kVertexScoreTable, NULL);
+
+	// remap partition-local vertex indices back to the original vertex buffer
+	for (size_t i = 0; i < partition.index_count; ++i)
+		destination[i] = vertices[destination[i]];
+}
+
+} // namespace meshopt
+
+void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const meshopt_VertexScoreTable* table)
+{
+	using namespace meshopt;
+
+	assert(sizeof(table->cache) == kCacheSizeMax * sizeof(float));
+	assert(sizeof(table->live) == kValenceMax * sizeof(float));
+
+	// internal table reserves the first entry for vertices outside of the cache and vertices without remaining triangles
+	VertexScoreTable internal = {};
+	memcpy(internal.cache + 1, table->cache, sizeof(table->cache));
+	memcpy(internal.live + 1, table->live, sizeof(table->live));
+
+	optimizeVertexCacheTable(destination, indices, index_count, vertex_count, &internal, NULL);
+}
+
 void meshopt_optimizeVertexCache(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count)
 {
-	meshopt_optimizeVertexCacheTable(destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTable);
+	meshopt::optimizeVertexCacheTable(destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTable, NULL);
+}
+
+void meshopt_optimizeVertexCacheParallel(unsigned int* destination, const unsigned int* indices, size_t index_count, const float* vertex_positions, size_t vertex_count, size_t vertex_positions_stride, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(vertex_positions_stride >= 12 && vertex_positions_stride <= 256);
+	assert(vertex_positions_stride % sizeof(float) == 0);
+
+	size_t face_count = index_count / 3;
+
+	// small meshes can't be split into multiple partitions so we use the serial optimizer which produces the same result
+	if (!dispatch || face_count <= kVertexCachePartitionSize)
+		return meshopt_optimizeVertexCache(destination, indices, index_count, vertex_count);
+
+	meshopt_Allocator allocator;
+
+	// spatial order makes consecutive triangle ranges spatially coherent, so we can split the mesh into equally sized partitions
+	unsigned int* sorted = allocator.allocate<unsigned int>(index_count);
+	meshopt_spatialSortTriangles(sorted, indices, index_count, vertex_positions, vertex_count, vertex_positions_stride);
+
+	size_t partition_count = (face_count + kVertexCachePartitionSize - 1) / kVertexCachePartitionSize;
+	VertexCachePartition* partitions = allocator.allocate<VertexCachePartition>(partition_count);
+
+	// build partition-local index buffers; each partition references a compact list of vertices
+	unsigned int* partition_indices = sorted;
+	unsigned int* partition_vertices = allocator.allocate<unsigned int>(index_count);
+
+	unsigned int* vertex_partition = allocator.allocate<unsigned int>(vertex_count);
+	unsigned int* vertex_local = allocator.allocate<unsigned int>(vertex_count);
+	memset(vertex_partition, -1, vertex_count * sizeof(unsigned int));
+
+	size_t vertex_offset = 0;
+
+	for (size_t i = 0; i < partition_count; ++i)
+	{
+		VertexCachePartition& partition = partitions[i];
+
+		partition.index_offset = face_count * i / partition_count * 3;
+		partition.index_count = face_count * (i + 1) / partition_count * 3 - partition.index_offset;
+
+		size_t partition_vertex_count = 0;
+
+		for (size_t j = 0; j < partition.index_count; ++j)
+		{
+			unsigned int v = sorted[partition.index_offset + j];
+			assert(v < vertex_count);
+
+			if (vertex_partition[v] != i)
+			{
+				vertex_partition[v] = unsigned(i);
+				vertex_local[v] = unsigned(partition_vertex_count);
+				partition_vertices[vertex_offset + partition_vertex_count] = v;
+				partition_vertex_count++;
+			}
+
+			partition_indices[partition.index_offset + j] = vertex_local[v];
+		}
+
+		partition.vertex_offset = vertex_offset;
+		partition.vertex_count = partition_vertex_count;
+
+		vertex_offset += partition_vertex_count;
+	}
+
+	// note that destination may alias indices which aren't used after sorting
+	VertexCachePartitionBuilder builder = {partitions, destination, partition_indices, partition_vertices};
+
+	dispatch(context, optimizeVertexCachePartitionTask, &builder, partition_count);
+}
+
+size_t meshopt_optimizeVertexCacheIncremental(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const unsigned int* dirty_triangles, size_t dirty_count)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+
+	size_t face_count = index_count / 3;
+
+	if (destination != indices)
+		memcpy(destination, indices, index_count * sizeof(unsigned int));
+
+	if (face_count == 0 || dirty_count == 0)
+		return 0;
+
+	meshopt_Allocator allocator;
+
+	unsigned char* dirty = allocator.allocate<unsigned char>(face_count);
+	memset(dirty, 0, face_count);
+
+	for (size_t i = 0; i < dirty_count; ++i)
+	{
+		assert(dirty_triangles[i] < face_count);
+		dirty[dirty_triangles[i]] = 1;
+	}
+
+	// merge dirty triangles into windows of consecutive triangles; windows that would overlap after adding the margins are merged
+	unsigned int* windows = allocator.allocate<unsigned int>(dirty_count * 2);
+	size_t window_count = 0;
+	size_t window_max = 0;
+
+	for (size_t i = 0; i < face_count; ++i)
+	{
+		if (!dirty[i])
+			continue;
+
+		size_t begin = i > kVertexCacheIncrementalMargin ? i - kVertexCacheIncrementalMargin : 0;
+		size_t end = i + 1 + kVertexCacheIncrementalMargin < face_count ? i + 1 + kVertexCacheIncrementalMargin : face_count;
+
+		if (window_count && windows[window_count * 2 - 1] >= begin)
+			windows[window_count * 2 - 1] = unsigned(end);
+		else
+		{
+			windows[window_count * 2 + 0] = unsigned(begin);
+			windows[window_count * 2 + 1] = unsigned(end);
+			window_count++;
+		}
+
+		size_t size = windows[window_count * 2 - 1] - windows[window_count * 2 - 2];
+		window_max = window_max < size ? size : window_max;
+	}
+
+	// each window is optimized as an independent mesh that references a compact list of vertices
+	unsigned int* window_indices = allocator.allocate<unsigned int>(window_max * 3);
+	unsigned int* window_vertices = allocator.allocate<unsigned int>(window_max * 3);
+
+	unsigned int* vertex_local = allocator.allocate<unsigned int>(vertex_count);
+	memset(vertex_local, -1, vertex_count * sizeof(unsigned int));
+
+	size_t result = 0;
+
+	for (size_t i = 0; i < window_count; ++i)
+	{
+		unsigned int* target = destination + windows[i * 2 + 0] * 3;
+		size_t window_index_count = (windows[i * 2 + 1] - windows[i * 2 + 0]) * 3;
+
+		size_t window_vertex_count = 0;
+
+		for (size_t j = 0; j < window_index_count; ++j)
+		{
+			unsigned int v = target[j];
+			assert(v < vertex_count);
+
+			if (vertex_local[v] == ~0u)
+			{
+				vertex_local[v] = unsigned(window_vertex_count);
+				window_vertices[window_vertex_count++] = v;
+			}
+
+			window_indices[j] = vertex_local[v];
+		}
+
+		optimizeVertexCacheTable(window_indices, window_indices, window_index_count, window_vertex_count, &kVertexScoreTable, NULL);
+
+		for (size_t j = 0; j < window_index_count; ++j)
+			target[j] = window_vertices[window_indices[j]];
+
+		for (size_t j = 0; j < window_vertex_count; ++j)
+			vertex_local[window_vertices[j]] = ~0u;
+
+		result += window_index_count / 3;
+	}
+
+	return result;
+}
+
+void meshopt_optimizeVertexCacheWithContext(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, meshopt_Context* context)
+{
+	meshopt::optimizeVertexCacheTable(destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTable, context);
+}
+
+size_t meshopt_optimizeVertexCacheScratchBound(size_t index_count, size_t vertex_count)
+{
+	size_t face_count = index_count / 3;
+
+	// indices copy (for in-place optimization), triangle adjacency, live triangles, emitted flags, vertex and triangle scores
+	return meshopt_Allocator::scratch<unsigned int>(index_count) +
+	       meshopt_Allocator::scratch<unsigned int>(vertex_count) * 2 + meshopt_Allocator::scratch<unsigned int>(index_count) +
+	       meshopt_Allocator::scratch<unsigned int>(vertex_count) +
+	       meshopt_Allocator::scratch<unsigned char>(face_count) +
+	       meshopt_Allocator::scratch<float>(vertex_count) +
+	       meshopt_Allocator::scratch<float>(face_count);
 }
 
 void meshopt_optimizeVertexCacheStrip(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count)
 {
-	meshopt_optimizeVertexCacheTable(destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTableStrip);
+	meshopt::optimizeVertexCacheTable(destination, indices, index_count, vertex_count, &meshopt::kVertexScoreTableStrip, NULL);
 }
 
 void meshopt_optimizeVertexCacheFifo(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, unsigned int cache_size)
@@ -46,10 +46,28 @@
 #define SIMD_WASM
 #endif
 
+// GCC 8+, clang 6+ and MSVC 2019+ support targeting AVX-512 VBMI2 from individual functions; we use a cpuid-based fallback to SSSE3 code
+// This applies both to builds that select SSSE3 at runtime and to builds that enable SSSE3/AVX2 through compiler settings, as long as AVX-512 VBMI2 isn't enabled globally
+#if defined(SIMD_SSE) && !defined(SIMD_AVX) && (defined(__x86_64__) || defined(_M_X64)) && ((defined(__clang__) && __clang_major__ >= 6) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 8) || (!defined(__clang__) && defined(_MSC_VER) && _MSC_VER >= 1920))
+#define SIMD_AVX_FALLBACK
+#ifdef __GNUC__
+#define SIMD_TARGET_AVX __attribute__((target("avx512vbmi2,avx512vbmi,avx512vl,avx512bw,popcnt")))
+#define SIMD_FLATTEN __attribute__((flatten))
+#endif
+#endif
+
 #ifndef SIMD_TARGET
 #define SIMD_TARGET
 #endif
 
+#ifndef SIMD_TARGET_AVX
+#define SIMD_TARGET_AVX
+#endif
+
+#ifndef SIMD_FLATTEN
+#define SIMD_FLATTEN
+#endif
+
 // When targeting AArch64/x64, optimize for latency to allow decoding of individual 16-byte groups to overlap
 // We don't do this for 32-bit systems because we need 64-bit math for this and this will hurt in-order CPUs
 #if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64)
@@ -62,7 +80,7 @@
 #include <tmmintrin.h>
 #endif
 
-#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
+#if (defined(SIMD_SSE) && defined(SIMD_FALLBACK)) || defined(SIMD_AVX_FALLBACK)
 #ifdef _MSC_VER
 #include <intrin.h> // __cpuid
 #else
@@ -70,7 +88,10 @@
 #endif
 #endif
 
-#ifdef SIMD_AVX
+#if defined(SIMD_AVX) || defined(SIMD_AVX_FALLBACK)
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 12
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized" // false positive for _mm_undefined_si128 in AVX-512 intrinsics
+#endif
 #include <immintrin.h>
 #endif
 
@@ -111,6 +132,24 @@ const size_t kByteGroupSize = 16;
 const size_t kByteGroupDecodeLimit = 24;
 const size_t kTailMaxSize = 32;
 
+// version 1 resets the predictor every kVertexChunkBlocks blocks so that chunks can be encoded and decoded independently
+const size_t kVertexChunkBlocks = 16;
+const size_t kVertexChunkOffsetSize = 4;
+
+// version 2 selects a predictor for every 4-byte channel of each block; modes are stored as 2-bit values in the block header
+enum VertexChannelMode
+{
+	kChannelByteDelta = 0,
+	kChannelByteDelta2 = 1,
+	kChannelWordDelta = 2,
+	kChannelWordDelta2 = 3,
+};
+
+static size_t getVertexBlockModeSize(size_t vertex_size, int version)
+{
+	return version >= 2 ? (vertex_size / 4 + 3) / 4 : 0;
+}
+
 static size_t getVertexBlockSize(size_t vertex_size)
 {
 	// make sure the entire block fits into the scratch buffer
@@ -123,43 +162,58 @@ static size_t getVertexBlockSize(size_t vertex_size)
 	return (result < kVertexBlockMaxSize) ? result : kVertexBlockMaxSize;
 }
 
-inline unsigned char zigzag8(unsigned char v)
+static size_t getVertexChunkCount(size_t vertex_count, size_t vertex_block_size)
 {
-	return ((signed char)(v) >> 7) ^ (v << 1);
-}
+	size_t vertex_chunk_size = vertex_block_size * kVertexChunkBlocks;
 
-inline unsigned char unzigzag8(unsigned char v)
-{
-	return -(v & 1) ^ (v >> 1);
+	return (vertex_count + vertex_chunk_size - 1) / vertex_chunk_size;
 }
 
-static bool encodeBytesGroupZero(const unsigned char* buffer)
+inline size_t countBytesAtLeast(unsigned long long v, int threshold)
 {
-	for (size_t i = 0; i < kByteGroupSize; ++i)
-		if (buffer[i])
-			return false;
+	const unsigned long long ones = 0x0101010101010101ull;
 
-	return true;
+	// the top bit of each byte is set iff the byte is >= threshold; adding 128-threshold to the low 7 bits can't carry into the next byte
+	unsigned long long mask = (((v & (ones * 0x7f)) + ones * (0x80 - threshold)) | v) & (ones * 0x80);
+
+	// horizontal sum of 0/1 bytes accumulates in the top byte
+	return size_t(((mask >> 7) * ones) >> 56);
 }
 
-static size_t encodeBytesGroupMeasure(const unsigned char* buffer, int bits)
+// picks the bit width with the smallest encoded size; instead of measuring every width separately, the group is processed as two 64-bit words in one pass
+static int encodeBytesGroupPick(const unsigned char* buffer, size_t& best_size)
 {
-	assert(bits >= 1 && bits <= 8);
+	unsigned long long v0, v1;
+	memcpy(&v0, buffer, 8);
+	memcpy(&v1, buffer + 8, 8);
 
-	if (bits == 1)
-		return encodeBytesGroupZero(buffer) ? 0 : size_t(-1);
+	if ((v0 | v1) == 0)
+	{
+		best_size = 0;
+		return 1;
+	}
 
-	if (bits == 8)
-		return kByteGroupSize;
+	// fixed portion is 16*bits/8 bytes, and each value that doesn't fit below the sentinel needs an extra byte
+	size_t size2 = 4 + countBytesAtLeast(v0, 3) + countBytesAtLeast(v1, 3);
+	size_t size4 = 8 + countBytesAtLeast(v0, 15) + countBytesAtLeast(v1, 15);
 
-	size_t result = kByteGroupSize * bits / 8;
+	// ties are resolved in favor of smaller widths, excluding 8 which is picked only if it's strictly smaller
+	int best_bits = 8;
+	best_size = kByteGroupSize;
 
-	unsigned char sentinel = (1 << bits) - 1;
+	if (size2 < best_size)
+	{
+		best_bits = 2;
+		best_size = size2;
+	}
 
-	for (size_t i = 0; i < kByteGroupSize; ++i)
-		result += buffer[i] >= sentinel;
+	if (size4 < best_size)
+	{
+		best_bits = 4;
+		best_size = size4;
+	}
 
-	return result;
+	return best_bits;
 }
 
 static unsigned char* encodeBytesGroup(unsigned char* data, const unsigned char* buffer, int bits)
@@ -229,19 +283,8 @@ static unsigned char* encodeBytes(unsigned char* data, unsigned char* data_end,
 		if (size_t(data_end - data) < kByteGroupDecodeLimit)
 			return 0;
 
-		int best_bits = 8;
-		size_t best_size = encodeBytesGroupMeasure(buffer + i, 8);
-
-		for (int bits = 1; bits < 8; bits *= 2)
-		{
-			size_t size = encodeBytesGroupMeasure(buffer + i, bits);
-
-			if (size < best_size)
-			{
-				best_bits = bits;
-				best_size = size;
-			}
-		}
+		size_t best_size = 0;
+		int best_bits = encodeBytesGroupPick(buffer + i, best_size);
 
 		int bitslog2 = (best_bits == 1) ? 0 : (best_bits == 2) ? 1 : (best_bits == 4) ? 2 : 3;
 		assert((1 << bitslog2) == best_bits);
@@ -259,34 +302,171 @@ static unsigned char* encodeBytes(unsigned char* data, unsigned char* data_end,
 	return data;
 }
 
-static unsigned char* encodeVertexBlock(unsigned char* data, unsigned char* data_end, const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256])
+// channels are processed as 32-bit words with SWAR arithmetic on 8-bit or 16-bit lanes; this avoids a serial dependency on the previous byte
+struct ByteLanes
+{
+	static const unsigned int high = 0x80808080;
+	static const unsigned int shift = 7;
+	static const unsigned int mask = 0xff;
+};
+
+struct WordLanes
+{
+	static const unsigned int high = 0x80008000;
+	static const unsigned int shift = 15;
+	static const unsigned int mask = 0xffff;
+};
+
+template <typename L>
+inline unsigned int lanesAdd(unsigned int a, unsigned int b)
+{
+	return ((a & ~L::high) + (b & ~L::high)) ^ ((a ^ b) & L::high);
+}
+
+template <typename L>
+inline unsigned int lanesSub(unsigned int a, unsigned int b)
+{
+	return ((a | L::high) - (b & ~L::high)) ^ ((a ^ ~b) & L::high);
+}
+
+template <typename L>
+inline unsigned int lanesZigzag(unsigned int v)
+{
+	return ((v << 1) & ~(L::high >> L::shift)) ^ (((v & L::high) >> L::shift) * L::mask);
+}
+
+template <typename L>
+inline unsigned int lanesUnzigzag(unsigned int v)
+{
+	return ((v >> 1) & ~(L::high)) ^ ((v & (L::high >> L::shift)) * L::mask);
+}
+
+inline unsigned int readChannel(const unsigned char* data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (unsigned(data[3]) << 24);
+}
+
+inline void writeChannel(unsigned char* data, unsigned int v)
+{
+	data[0] = (unsigned char)(v >> 0);
+	data[1] = (unsigned char)(v >> 8);
+	data[2] = (unsigned char)(v >> 16);
+	data[3] = (unsigned char)(v >> 24);
+}
+
+// splits a 4-byte channel into 4 byte streams of zigzag-encoded prediction residuals; Second selects delta-of-delta prediction
+template <typename L, bool Second>
+static void encodeVertexChannel(unsigned char* buffer, const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, const unsigned char last_vertex[4])
+{
+	unsigned int p = readChannel(last_vertex);
+	unsigned int pd = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int v = readChannel(vertex_data + i * vertex_size);
+		unsigned int d = lanesSub<L>(v, p);
+		unsigned int z = lanesZigzag<L>(Second ? lanesSub<L>(d, pd) : d);
+
+		buffer[i + kVertexBlockMaxSize * 0] = (unsigned char)(z >> 0);
+		buffer[i + kVertexBlockMaxSize * 1] = (unsigned char)(z >> 8);
+		buffer[i + kVertexBlockMaxSize * 2] = (unsigned char)(z >> 16);
+		buffer[i + kVertexBlockMaxSize * 3] = (unsigned char)(z >> 24);
+
+		p = v;
+		pd = d;
+	}
+}
+
+static void encodeVertexChannel(unsigned char* buffer, const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, const unsigned char last_vertex[4], int mode)
+{
+	switch (mode)
+	{
+	case kChannelByteDelta:
+		return encodeVertexChannel<ByteLanes, false>(buffer, vertex_data, vertex_count, vertex_size, last_vertex);
+	case kChannelByteDelta2:
+		return encodeVertexChannel<ByteLanes, true>(buffer, vertex_data, vertex_count, vertex_size, last_vertex);
+	case kChannelWordDelta:
+		return encodeVertexChannel<WordLanes, false>(buffer, vertex_data, vertex_count, vertex_size, last_vertex);
+	case kChannelWordDelta2:
+		return encodeVertexChannel<WordLanes, true>(buffer, vertex_data, vertex_count, vertex_size, last_vertex);
+	default:
+		assert(!"Unexpected channel mode");
+	}
+}
+
+static size_t measureBytes(const unsigned char* buffer, size_t buffer_size)
+{
+	size_t result = (buffer_size / kByteGroupSize + 3) / 4;
+
+	for (size_t i = 0; i < buffer_size; i += kByteGroupSize)
+	{
+		size_t size = 0;
+		encodeBytesGroupPick(buffer + i, size);
+		result += size;
+	}
+
+	return result;
+}
+
+static unsigned char* encodeVertexBlock(unsigned char* data, unsigned char* data_end, const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256], int version)
 {
 	assert(vertex_count > 0 && vertex_count <= kVertexBlockMaxSize);
+	assert(vertex_size % 4 == 0);
+
+	size_t vertex_count_aligned = (vertex_count + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
+
+	unsigned char* modes = data;
+	size_t mode_size = getVertexBlockModeSize(vertex_size, version);
+
+	if (size_t(data_end - data) < mode_size)
+		return 0;
+
+	memset(modes, 0, mode_size);
+	data += mode_size;
 
-	unsigned char buffer[kVertexBlockMaxSize];
-	assert(sizeof(buffer) % kByteGroupSize == 0);
+	// one set of byte streams per channel mode; version 2 picks the mode that results in the smallest encoding
+	unsigned char buffer[4][kVertexBlockMaxSize * 4];
+	assert(kVertexBlockMaxSize % kByteGroupSize == 0);
 
 	// we sometimes encode elements we didn't fill when rounding to kByteGroupSize
-	memset(buffer, 0, sizeof(buffer));
+	memset(buffer, 0, version >= 2 ? sizeof(buffer) : sizeof(buffer[0]));
 
-	for (size_t k = 0; k < vertex_size; ++k)
+	for (size_t k = 0; k < vertex_size; k += 4)
 	{
-		size_t vertex_offset = k;
-
-		unsigned char p = last_vertex[k];
+		int mode = kChannelByteDelta;
 
-		for (size_t i = 0; i < vertex_count; ++i)
+		if (version >= 2)
 		{
-			buffer[i] = zigzag8(vertex_data[vertex_offset] - p);
+			size_t best_size = ~size_t(0);
+
+			for (int m = 0; m < 4; ++m)
+			{
+				encodeVertexChannel(buffer[m], vertex_data + k, vertex_count, vertex_size, last_vertex + k, m);
 
-			p = vertex_data[vertex_offset];
+				size_t size = 0;
+				for (size_t j = 0; j < 4; ++j)
+					size += measureBytes(buffer[m] + j * kVertexBlockMaxSize, vertex_count_aligned);
 
-			vertex_offset += vertex_size;
+				if (size < best_size)
+				{
+					mode = m;
+					best_size = size;
+				}
+			}
+
+			modes[k / 16] |= mode << ((k / 4 % 4) * 2);
+		}
+		else
+		{
+			encodeVertexChannel(buffer[mode], vertex_data + k, vertex_count, vertex_size, last_vertex + k, mode);
 		}
 
-		data = encodeBytes(data, data_end, buffer, (vertex_count + kByteGroupSize - 1) & ~(kByteGroupSize - 1));
-		if (!data)
-			return 0;
+		for (size_t j = 0; j < 4; ++j)
+		{
+			data = encodeBytes(data, data_end, buffer[mode] + j * kVertexBlockMaxSize, vertex_count_aligned);
+			if (!data)
+				return 0;
+		}
 	}
 
 	memcpy(last_vertex, &vertex_data[vertex_size * (vertex_count - 1)], vertex_size);
@@ -294,6 +474,44 @@ static unsigned char* encodeVertexBlock(unsigned char* data, unsigned char* data
 	return data;
 }
 
+// reconstructs a 4-byte channel from 4 byte streams, each buffer_stride bytes apart
+template <typename L, bool Second>
+static void decodeVertexChannel(unsigned char* transposed, const unsigned char* buffer, size_t buffer_stride, size_t vertex_count, size_t vertex_size, const unsigned char last_vertex[4])
+{
+	unsigned int p = readChannel(last_vertex);
+	unsigned int pd = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		unsigned int z = buffer[i] | (buffer[i + buffer_stride] << 8) | (buffer[i + buffer_stride * 2] << 16) | (unsigned(buffer[i + buffer_stride * 3]) << 24);
+		unsigned int r = lanesUnzigzag<L>(z);
+		unsigned int d = Second ? lanesAdd<L>(pd, r) : r;
+		unsigned int v = lanesAdd<L>(p, d);
+
+		writeChannel(transposed + i * vertex_size, v);
+
+		p = v;
+		pd = d;
+	}
+}
+
+static void decodeVertexChannel(unsigned char* transposed, const unsigned char* buffer, size_t buffer_stride, size_t vertex_count, size_t vertex_size, const unsigned char last_vertex[4], int mode)
+{
+	switch (mode)
+	{
+	case kChannelByteDelta:
+		return decodeVertexChannel<ByteLanes, false>(transposed, buffer, buffer_stride, vertex_count, vertex_size, last_vertex);
+	case kChannelByteDelta2:
+		return decodeVertexChannel<ByteLanes, true>(transposed, buffer, buffer_stride, vertex_count, vertex_size, last_vertex);
+	case kChannelWordDelta:
+		return decodeVertexChannel<WordLanes, false>(transposed, buffer, buffer_stride, vertex_count, vertex_size, last_vertex);
+	case kChannelWordDelta2:
+		return decodeVertexChannel<WordLanes, true>(transposed, buffer, buffer_stride, vertex_count, vertex_size, last_vertex);
+	default:
+		assert(!"Unexpected channel mode"); // unreachable since mode is a 2-bit value
+	}
+}
+
 #if defined(SIMD_FALLBACK) || (!defined(SIMD_SSE) && !defined(SIMD_NEON) && !defined(SIMD_AVX))
 static const unsigned char* decodeBytesGroup(const unsigned char* data, unsigned char* buffer, int bitslog2)
 {
@@ -373,34 +591,35 @@ static const unsigned char* decodeBytes(const unsigned char* data, const unsigne
 	return data;
 }
 
-static const unsigned char* decodeVertexBlock(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256])
+static const unsigned char* decodeVertexBlock(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256], int version)
 {
 	assert(vertex_count > 0 && vertex_count <= kVertexBlockMaxSize);
 
-	unsigned char buffer[kVertexBlockMaxSize];
+	unsigned char buffer[kVertexBlockMaxSize * 4];
 	unsigned char transposed[kVertexBlockSizeBytes];
 
 	size_t vertex_count_aligned = (vertex_count + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
 
-	for (size_t k = 0; k < vertex_size; ++k)
-	{
-		data = decodeBytes(data, data_end, buffer, vertex_count_aligned);
-		if (!data)
-			return 0;
+	const unsigned char* modes = data;
+	size_t mode_size = getVertexBlockModeSize(vertex_size, version);
 
-		size_t vertex_offset = k;
+	if (size_t(data_end - data) < mode_size)
+		return 0;
 
-		unsigned char p = last_vertex[k];
+	data += mode_size;
 
-		for (size_t i = 0; i < vertex_count; ++i)
+	for (size_t k = 0; k < vertex_size; k += 4)
+	{
+		for (size_t j = 0; j < 4; ++j)
 		{
-			unsigned char v = unzigzag8(buffer[i]) + p;
+			data = decodeBytes(data, data_end, buffer + j * vertex_count_aligned, vertex_count_aligned);
+			if (!data)
+				return 0;
+		}
 
-			transposed[vertex_offset] = v;
-			p = v;
+		int mode = mode_size ? (modes[k / 16] >> ((k / 4 % 4) * 2)) & 3 : kChannelByteDelta;
 
-			vertex_offset += vertex_size;
-		}
+		decodeVertexChannel(transposed + k, buffer, vertex_count_aligned, vertex_count, vertex_size, last_vertex + k, mode);
 	}
 
 	memcpy(vertex_data, transposed, vertex_count * vertex_size);
@@ -567,15 +786,16 @@ static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsi
 }
 #endif
 
-#ifdef SIMD_AVX
-static const __m128i decodeBytesGroupConfig[] = {
-    _mm_set1_epi8(3),
-    _mm_set1_epi8(15),
-    _mm_setr_epi8(6, 4, 2, 0, 14, 12, 10, 8, 22, 20, 18, 16, 30, 28, 26, 24),
-    _mm_setr_epi8(4, 0, 12, 8, 20, 16, 28, 24, 36, 32, 44, 40, 52, 48, 60, 56),
+#if defined(SIMD_AVX) || defined(SIMD_AVX_FALLBACK)
+static const unsigned char kDecodeBytesGroupConfig[4][16] = {
+    {3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3},
+    {15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15},
+    {6, 4, 2, 0, 14, 12, 10, 8, 22, 20, 18, 16, 30, 28, 26, 24},
+    {4, 0, 12, 8, 20, 16, 28, 24, 36, 32, 44, 40, 52, 48, 60, 56},
 };
 
-static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsigned char* buffer, int bitslog2)
+SIMD_TARGET_AVX
+static const unsigned char* decodeBytesGroupSimdAvx(const unsigned char* data, unsigned char* buffer, int bitslog2)
 {
 	switch (bitslog2)
 	{
@@ -596,8 +816,8 @@ static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsi
 		__m128i selb = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(data));
 		__m128i rest = _mm_loadu_si128(reinterpret_cast<const __m128i*>(skip));
 
-		__m128i sent = decodeBytesGroupConfig[bitslog2 - 1];
-		__m128i ctrl = decodeBytesGroupConfig[bitslog2 + 1];
+		__m128i sent = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeBytesGroupConfig[bitslog2 - 1]));
+		__m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kDecodeBytesGroupConfig[bitslog2 + 1]));
 
 		__m128i selw = _mm_shuffle_epi32(selb, 0x44);
 		__m128i sel = _mm_and_si128(sent, _mm_multishift_epi64_epi8(ctrl, selw));
@@ -626,6 +846,13 @@ static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsi
 }
 #endif
 
+#ifdef SIMD_AVX
+static const unsigned char* decodeBytesGroupSimd(const unsigned char* data, unsigned char* buffer, int bitslog2)
+{
+	return decodeBytesGroupSimdAvx(data, buffer, bitslog2);
+}
+#endif
+
 #ifdef SIMD_NEON
 static uint8x16_t shuffleBytes(unsigned char mask0, unsigned char mask1, uint8x8_t rest0, uint8x8_t rest1)
 {
@@ -926,9 +1153,93 @@ static v128_t unzigzag8(v128_t v)
 }
 #endif
 
+#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
+static unsigned int getCpuFeatures()
+{
+	int cpuinfo[4] = {};
+#ifdef _MSC_VER
+	__cpuid(cpuinfo, 1);
+#else
+	__cpuid(1, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+#endif
+	return cpuinfo[2];
+}
+
+static unsigned int cpuid = getCpuFeatures();
+#endif
+
+#ifdef SIMD_AVX_FALLBACK
+static bool getCpuFeaturesAvx()
+{
+	int cpuinfo[4] = {};
+	int cpuinfo7[4] = {};
+	unsigned long long xcr0 = 0;
+
+#ifdef _MSC_VER
+	__cpuid(cpuinfo, 0);
+	if (cpuinfo[0] < 7)
+		return false;
+
+	__cpuid(cpuinfo, 1);
+	__cpuidex(cpuinfo7, 7, 0);
+#else
+	if (__get_cpuid_max(0, 0) < 7)
+		return false;
+
+	__cpuid(1, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+	__cpuid_count(7, 0, cpuinfo7[0], cpuinfo7[1], cpuinfo7[2], cpuinfo7[3]);
+#endif
+
+	// OSXSAVE (27) and POPCNT (23)
+	if ((cpuinfo[2] & ((1 << 27) | (1 << 23))) != ((1 << 27) | (1 << 23)))
+		return false;
+
+#ifdef _MSC_VER
+	xcr0 = _xgetbv(0);
+#else
+	unsigned int xcr0lo = 0, xcr0hi = 0;
+	__asm__("xgetbv"
+	        : "=a"(xcr0lo), "=d"(xcr0hi)
+	        : "c"(0));
+	xcr0 = xcr0lo | ((unsigned long long)xcr0hi << 32);
+#endif
+
+	// OS must preserve SSE, AVX and AVX-512 (opmask and both halves of zmm) state
+	if ((xcr0 & 0xe6) != 0xe6)
+		return false;
+
+	// AVX512F (16), AVX512BW (30), AVX512VL (31); AVX512_VBMI (1), AVX512_VBMI2 (6)
+	unsigned int ebx = unsigned(cpuinfo7[1]), ecx = unsigned(cpuinfo7[2]);
+
+	return (ebx & (1u << 16)) && (ebx & (1u << 30)) && (ebx & (1u << 31)) && (ecx & (1u << 1)) && (ecx & (1u << 6));
+}
+
+static bool cpuidavx = getCpuFeaturesAvx();
+#endif
+
 #if defined(SIMD_SSE) || defined(SIMD_AVX) || defined(SIMD_NEON) || defined(SIMD_WASM)
-SIMD_TARGET
-static const unsigned char* decodeBytesSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size)
+struct BytesGroupSimd
+{
+	static const unsigned char* decode(const unsigned char* data, unsigned char* buffer, int bitslog2)
+	{
+		return decodeBytesGroupSimd(data, buffer, bitslog2);
+	}
+};
+
+#ifdef SIMD_AVX_FALLBACK
+struct BytesGroupSimdAvx
+{
+	static const unsigned char* decode(const unsigned char* data, unsigned char* buffer, int bitslog2)
+	{
+		return decodeBytesGroupSimdAvx(data, buffer, bitslog2);
+	}
+};
+#endif
+
+// shared by all byte decoders; G supplies the group decoder, and each caller inlines this into a function that targets the ISA G needs
+// note: gcc won't inline a group decoder with a wider target into the untargeted template body, so the AVX-512 caller is flattened
+template <typename G>
+static const unsigned char* decodeBytesSimdImpl(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size)
 {
 	assert(buffer_size % kByteGroupSize == 0);
 	assert(kByteGroupSize == 16);
@@ -951,10 +1262,10 @@ static const unsigned char* decodeBytesSimd(const unsigned char* data, const uns
 		size_t header_offset = i / kByteGroupSize;
 		unsigned char header_byte = header[header_offset / 4];
 
-		data = decodeBytesGroupSimd(data, buffer + i + kByteGroupSize * 0, (header_byte >> 0) & 3);
-		data = decodeBytesGroupSimd(data, buffer + i + kByteGroupSize * 1, (header_byte >> 2) & 3);
-		data = decodeBytesGroupSimd(data, buffer + i + kByteGroupSize * 2, (header_byte >> 4) & 3);
-		data = decodeBytesGroupSimd(data, buffer + i + kByteGroupSize * 3, (header_byte >> 6) & 3);
+		data = G::decode(data, buffer + i + kByteGroupSize * 0, (header_byte >> 0) & 3);
+		data = G::decode(data, buffer + i + kByteGroupSize * 1, (header_byte >> 2) & 3);
+		data = G::decode(data, buffer + i + kByteGroupSize * 2, (header_byte >> 4) & 3);
+		data = G::decode(data, buffer + i + kByteGroupSize * 3, (header_byte >> 6) & 3);
 	}
 
 	// slow-path: process remaining groups
@@ -967,14 +1278,28 @@ static const unsigned char* decodeBytesSimd(const unsigned char* data, const uns
 
 		int bitslog2 = (header[header_offset / 4] >> ((header_offset % 4) * 2)) & 3;
 
-		data = decodeBytesGroupSimd(data, buffer + i, bitslog2);
+		data = G::decode(data, buffer + i, bitslog2);
 	}
 
 	return data;
 }
 
 SIMD_TARGET
-static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256])
+static const unsigned char* decodeBytesSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size)
+{
+	return decodeBytesSimdImpl<BytesGroupSimd>(data, data_end, buffer, buffer_size);
+}
+
+#ifdef SIMD_AVX_FALLBACK
+SIMD_TARGET_AVX SIMD_FLATTEN
+static const unsigned char* decodeBytesSimdAvx(const unsigned char* data, const unsigned char* data_end, unsigned char* buffer, size_t buffer_size)
+{
+	return decodeBytesSimdImpl<BytesGroupSimdAvx>(data, data_end, buffer, buffer_size);
+}
+#endif
+
+SIMD_TARGET
+static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, unsigned char last_vertex[256], int version)
 {
 	assert(vertex_count > 0 && vertex_count <= kVertexBlockMaxSize);
 
@@ -983,15 +1308,37 @@ static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, con
 
 	size_t vertex_count_aligned = (vertex_count + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
 
+	const unsigned char* modes = data;
+	size_t mode_size = getVertexBlockModeSize(vertex_size, version);
+
+	if (size_t(data_end - data) < mode_size)
+		return 0;
+
+	data += mode_size;
+
 	for (size_t k = 0; k < vertex_size; k += 4)
 	{
 		for (size_t j = 0; j < 4; ++j)
 		{
+#ifdef SIMD_AVX_FALLBACK
+			// note: AVX-512 byte decoding is outlined as the function targets a different ISA; this call is amortized over the entire byte stream
+			data = cpuidavx ? decodeBytesSimdAvx(data, data_end, buffer + j * vertex_count_aligned, vertex_count_aligned) : decodeBytesSimd(data, data_end, buffer + j * vertex_count_aligned, vertex_count_aligned);
+#else
 			data = decodeBytesSimd(data, data_end, buffer + j * vertex_count_aligned, vertex_count_aligned);
+#endif
 			if (!data)
 				return 0;
 		}
 
+		int mode = mode_size ? (modes[k / 16] >> ((k / 4 % 4) * 2)) & 3 : kChannelByteDelta;
+
+		// byte streams are decoded with SIMD for all modes, but only the default predictor has a SIMD reconstruction path
+		if (mode != kChannelByteDelta)
+		{
+			decodeVertexChannel(transposed + k, buffer, vertex_count_aligned, vertex_count, vertex_size, last_vertex + k, mode);
+			continue;
+		}
+
 #if defined(SIMD_SSE) || defined(SIMD_AVX)
 #define TEMP __m128i
 #define PREP() __m128i pi = _mm_cvtsi32_si128(*reinterpret_cast<const int*>(last_vertex + k))
@@ -1072,46 +1419,27 @@ static const unsigned char* decodeVertexBlockSimd(const unsigned char* data, con
 }
 #endif
 
-#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
-static unsigned int getCpuFeatures()
+typedef const unsigned char* (*DecodeVertexBlockFn)(const unsigned char*, const unsigned char*, unsigned char*, size_t, size_t, unsigned char[256], int);
+typedef void (*DecodeFilterFn)(void*, size_t, size_t);
+
+static DecodeVertexBlockFn getDecodeVertexBlock()
 {
-	int cpuinfo[4] = {};
-#ifdef _MSC_VER
-	__cpuid(cpuinfo, 1);
-#else
-	__cpuid(1, cpuinfo[0], cpuinfo[1], cpuinfo[2], cpuinfo[3]);
+#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	assert(gDecodeBytesGroupInitialized);
+	(void)gDecodeBytesGroupInitialized;
 #endif
-	return cpuinfo[2];
-}
 
-static unsigned int cpuid = getCpuFeatures();
+#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
+	return (cpuid & (1 << 9)) ? decodeVertexBlockSimd : decodeVertexBlock;
+#elif defined(SIMD_SSE) || defined(SIMD_AVX) || defined(SIMD_NEON) || defined(SIMD_WASM)
+	return decodeVertexBlockSimd;
+#else
+	return decodeVertexBlock;
 #endif
+}
 
-} // namespace meshopt
-
-size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size)
+static unsigned char* encodeVertexChunk(unsigned char* data, unsigned char* data_end, const unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, const unsigned char first_vertex[256], int version)
 {
-	using namespace meshopt;
-
-	assert(vertex_size > 0 && vertex_size <= 256);
-	assert(vertex_size % 4 == 0);
-
-	const unsigned char* vertex_data = static_cast<const unsigned char*>(vertices);
-
-	unsigned char* data = buffer;
-	unsigned char* data_end = buffer + buffer_size;
-
-	if (size_t(data_end - data) < 1 + vertex_size)
-		return 0;
-
-	int version = gEncodeVertexVersion;
-
-	*data++ = (unsigned char)(kVertexHeader | version);
-
-	unsigned char first_vertex[256] = {};
-	if (vertex_count > 0)
-		memcpy(first_vertex, vertex_data, vertex_size);
-
 	unsigned char last_vertex[256] = {};
 	memcpy(last_vertex, first_vertex, vertex_size);
 
@@ -1123,13 +1451,210 @@ size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, con
 	{
 		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
 
-		data = encodeVertexBlock(data, data_end, vertex_data + vertex_offset * vertex_size, block_size, vertex_size, last_vertex);
+		data = encodeVertexBlock(data, data_end, vertex_data + vertex_offset * vertex_size, block_size, vertex_size, last_vertex, version);
 		if (!data)
 			return 0;
 
 		vertex_offset += block_size;
 	}
 
+	return data;
+}
+
+// decodes vertices [range_begin, range_end) of a chunk with vertex_count vertices; blocks before the range still need to be decoded to compute the predictor
+// returns the pointer to the data after the last decoded block, which is the end of the chunk if the range extends to the end of the chunk
+// when filter is specified, it's applied to each block right after decoding while the block is still in cache; the predictor state doesn't depend on the output so this is safe
+// decoded vertices are written to vertex_data with vertex_stride, which can exceed vertex_size to decode directly into interleaved buffers
+static const unsigned char* decodeVertexChunk(DecodeVertexBlockFn decode, int version, DecodeFilterFn filter, const unsigned char* data, const unsigned char* data_end, unsigned char* vertex_data, size_t vertex_count, size_t vertex_size, size_t vertex_stride, const unsigned char first_vertex[256], size_t range_begin, size_t range_end)
+{
+	assert(range_begin <= range_end && range_end <= vertex_count);
+
+	unsigned char last_vertex[256];
+	memcpy(last_vertex, first_vertex, vertex_size);
+
+	unsigned char scratch[kVertexBlockSizeBytes];
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+
+	size_t vertex_offset = 0;
+
+	while (vertex_offset < range_end)
+	{
+		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
+
+		// blocks that are only partially covered by the range, or that need to be written with a stride, are decoded into scratch memory
+		bool inside = vertex_offset >= range_begin && vertex_offset + block_size <= range_end && vertex_stride == vertex_size;
+		unsigned char* target = inside ? vertex_data + (vertex_offset - range_begin) * vertex_size : scratch;
+
+		data = decode(data, data_end, target, block_size, vertex_size, last_vertex, version);
+		if (!data)
+			return 0;
+
+		if (inside && filter)
+			filter(target, block_size, vertex_size);
+
+		if (!inside)
+		{
+			size_t copy_begin = vertex_offset < range_begin ? range_begin : vertex_offset;
+			size_t copy_end = vertex_offset + block_size < range_end ? vertex_offset + block_size : range_end;
+
+			if (copy_begin < copy_end)
+			{
+				unsigned char* copy_source = scratch + (copy_begin - vertex_offset) * vertex_size;
+				unsigned char* copy_target = vertex_data + (copy_begin - range_begin) * vertex_stride;
+
+				if (filter)
+					filter(copy_source, copy_end - copy_begin, vertex_size);
+
+				if (vertex_stride == vertex_size)
+					memcpy(copy_target, copy_source, (copy_end - copy_begin) * vertex_size);
+				else
+					for (size_t i = copy_begin; i < copy_end; ++i)
+					{
+						memcpy(copy_target, copy_source, vertex_size);
+						copy_source += vertex_size;
+						copy_target += vertex_stride;
+					}
+			}
+		}
+
+		vertex_offset += block_size;
+	}
+
+	return data;
+}
+
+static void writeVertexChunkOffset(unsigned char* data, size_t offset)
+{
+	data[0] = (unsigned char)(offset >> 0);
+	data[1] = (unsigned char)(offset >> 8);
+	data[2] = (unsigned char)(offset >> 16);
+	data[3] = (unsigned char)(offset >> 24);
+}
+
+static size_t readVertexChunkOffset(const unsigned char* data)
+{
+	return data[0] | (data[1] << 8) | (data[2] << 16) | (size_t(data[3]) << 24);
+}
+
+static bool getVertexChunkData(const unsigned char* buffer, size_t buffer_size, size_t chunk_count, size_t vertex_size, size_t chunk, size_t& data_begin, size_t& data_end)
+{
+	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
+	size_t header_size = 1 + chunk_count * kVertexChunkOffsetSize;
+
+	// chunk data must be contiguous: first chunk starts after the offset table and last chunk ends at the tail
+	data_begin = readVertexChunkOffset(buffer + 1 + chunk * kVertexChunkOffsetSize);
+	data_end = (chunk + 1 < chunk_count) ? readVertexChunkOffset(buffer + 1 + (chunk + 1) * kVertexChunkOffsetSize) : buffer_size - tail_size;
+
+	if (data_begin < header_size || data_begin > data_end || data_end > buffer_size - tail_size)
+		return false;
+
+	if (chunk == 0 && data_begin != header_size)
+		return false;
+
+	return true;
+}
+
+struct VertexChunkDecoder
+{
+	DecodeVertexBlockFn decode;
+	int version;
+	DecodeFilterFn filter;
+
+	const unsigned char* buffer;
+	size_t buffer_size;
+
+	unsigned char* vertex_data;
+	size_t vertex_count;
+	size_t vertex_size;
+	size_t vertex_stride;
+
+	size_t range_begin;
+	size_t range_end;
+
+	size_t chunk_count;
+	size_t chunk_first;
+	int* results;
+};
+
+static int decodeVertexChunkAt(const VertexChunkDecoder& decoder, size_t chunk)
+{
+	size_t vertex_size = decoder.vertex_size;
+	size_t vertex_chunk_size = getVertexBlockSize(vertex_size) * kVertexChunkBlocks;
+
+	size_t data_begin, data_end;
+	if (!getVertexChunkData(decoder.buffer, decoder.buffer_size, decoder.chunk_count, vertex_size, chunk, data_begin, data_end))
+		return -2;
+
+	size_t vertex_offset = chunk * vertex_chunk_size;
+	size_t chunk_size = (vertex_offset + vertex_chunk_size < decoder.vertex_count) ? vertex_chunk_size : decoder.vertex_count - vertex_offset;
+
+	// decode the part of the chunk that intersects the requested range
+	size_t range_begin = decoder.range_begin > vertex_offset ? decoder.range_begin - vertex_offset : 0;
+	size_t range_end = decoder.range_end < vertex_offset + chunk_size ? decoder.range_end - vertex_offset : chunk_size;
+	assert(range_begin < range_end);
+
+	unsigned char* vertex_data = decoder.vertex_data + (vertex_offset + range_begin - decoder.range_begin) * decoder.vertex_stride;
+
+	// note: bounds checks use the end of the buffer since decoding a byte group may read past the end of the chunk data
+	const unsigned char* data = decodeVertexChunk(decoder.decode, decoder.version, decoder.filter, decoder.buffer + data_begin, decoder.buffer + decoder.buffer_size, vertex_data, chunk_size, vertex_size, decoder.vertex_stride, decoder.buffer + decoder.buffer_size - vertex_size, range_begin, range_end);
+	if (!data)
+		return -2;
+
+	// we can only validate chunk size if we decoded all of its blocks
+	if (range_end == chunk_size && data != decoder.buffer + data_end)
+		return -3;
+
+	return 0;
+}
+
+static void decodeVertexChunkTask(void* context, size_t index)
+{
+	const VertexChunkDecoder& decoder = *static_cast<const VertexChunkDecoder*>(context);
+
+	decoder.results[index] = decodeVertexChunkAt(decoder, decoder.chunk_first + index);
+}
+
+struct VertexChunkEncoder
+{
+	const unsigned char* vertex_data;
+	size_t vertex_count;
+	size_t vertex_size;
+	int version;
+
+	unsigned char* buffer;
+	size_t buffer_size;
+	size_t chunk_data_begin;
+	size_t chunk_data_bound;
+
+	size_t* results;
+};
+
+static void encodeVertexChunkTask(void* context, size_t index)
+{
+	const VertexChunkEncoder& encoder = *static_cast<const VertexChunkEncoder*>(context);
+
+	size_t vertex_size = encoder.vertex_size;
+	size_t vertex_chunk_size = getVertexBlockSize(vertex_size) * kVertexChunkBlocks;
+
+	size_t vertex_offset = index * vertex_chunk_size;
+	size_t chunk_size = (vertex_offset + vertex_chunk_size < encoder.vertex_count) ? vertex_chunk_size : encoder.vertex_count - vertex_offset;
+
+	unsigned char* data = encoder.buffer + encoder.chunk_data_begin + index * encoder.chunk_data_bound;
+
+	// each chunk is encoded into a worst-case sized region; the encoder needs a little bit of extra space to perform bounds checks conservatively
+	// this space is guaranteed to exist since the buffer is at least meshopt_encodeVertexBufferBound bytes, which includes the tail
+	size_t data_limit = encoder.buffer_size - (data - encoder.buffer);
+	unsigned char* data_end = data + (encoder.chunk_data_bound + kTailMaxSize < data_limit ? encoder.chunk_data_bound + kTailMaxSize : data_limit);
+
+	unsigned char* next = encodeVertexChunk(data, data_end, encoder.vertex_data + vertex_offset * vertex_size, chunk_size, vertex_size, encoder.vertex_data, encoder.version);
+	assert(next && next <= data + encoder.chunk_data_bound);
+
+	encoder.results[index] = next - data;
+}
+
+static size_t encodeVertexTail(unsigned char* buffer, unsigned char* data, unsigned char* data_end, size_t vertex_size, const unsigned char first_vertex[256])
+{
 	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
 
 	if (size_t(data_end - data) < tail_size)
@@ -1146,57 +1671,170 @@ size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, con
 	data += vertex_size;
 
 	assert(data >= buffer + tail_size);
-	assert(data <= buffer + buffer_size);
+	assert(data <= data_end);
 
 	return data - buffer;
 }
 
-size_t meshopt_encodeVertexBufferBound(size_t vertex_count, size_t vertex_size)
+// returns the number of bytes decodeBytesGroup consumes: packed codes followed by one byte for every code that has all bits set
+static size_t getBytesGroupSize(const unsigned char* data, int bitslog2)
 {
-	using namespace meshopt;
-
-	assert(vertex_size > 0 && vertex_size <= 256);
-	assert(vertex_size % 4 == 0);
+	switch (bitslog2)
+	{
+	case 0:
+		return 0;
+	case 1:
+	{
+		unsigned int v;
+		memcpy(&v, data, 4);
 
-	size_t vertex_block_size = getVertexBlockSize(vertex_size);
-	size_t vertex_block_count = (vertex_count + vertex_block_size - 1) / vertex_block_size;
+		// count 2-bit codes equal to 3
+		unsigned int m = v & (v >> 1) & 0x55555555;
+		m = (m & 0x33333333) + ((m >> 2) & 0x33333333);
+		m = (m + (m >> 4)) & 0x0f0f0f0f;
 
-	size_t vertex_block_header_size = (vertex_block_size / kByteGroupSize + 3) / 4;
-	size_t vertex_block_data_size = vertex_block_size;
+		return 4 + ((m * 0x01010101) >> 24);
+	}
+	case 2:
+	{
+		unsigned long long v;
+		memcpy(&v, data, 8);
 
-	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
+		// count 4-bit codes equal to 15
+		unsigned long long m = v & (v >> 1) & (v >> 2) & (v >> 3) & 0x1111111111111111ull;
+		m = (m + (m >> 4)) & 0x0f0f0f0f0f0f0f0full;
 
-	return 1 + vertex_block_count * vertex_size * (vertex_block_header_size + vertex_block_data_size) + tail_size;
+		return 8 + size_t((m * 0x0101010101010101ull) >> 56);
+	}
+	default:
+		return kByteGroupSize;
+	}
 }
 
-void meshopt_encodeVertexVersion(int version)
+// walks the same structure as decodeBytes and performs the same bounds checks, but only computes the group sizes
+static const unsigned char* validateBytes(const unsigned char* data, const unsigned char* data_end, size_t buffer_size)
 {
-	assert(unsigned(version) <= 0);
+	assert(buffer_size % kByteGroupSize == 0);
 
-	meshopt::gEncodeVertexVersion = version;
+	const unsigned char* header = data;
+
+	// round number of groups to 4 to get number of header bytes
+	size_t header_size = (buffer_size / kByteGroupSize + 3) / 4;
+
+	if (size_t(data_end - data) < header_size)
+		return 0;
+
+	data += header_size;
+
+	for (size_t i = 0; i < buffer_size / kByteGroupSize; ++i)
+	{
+		if (size_t(data_end - data) < kByteGroupDecodeLimit)
+			return 0;
+
+		int bitslog2 = (header[i / 4] >> ((i % 4) * 2)) & 3;
+
+		data += getBytesGroupSize(data, bitslog2);
+	}
+
+	return data;
 }
 
-int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+static const unsigned char* validateVertexChunk(const unsigned char* data, const unsigned char* data_end, size_t vertex_count, size_t vertex_size, int version)
 {
-	using namespace meshopt;
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t mode_size = getVertexBlockModeSize(vertex_size, version);
+
+	for (size_t vertex_offset = 0; vertex_offset < vertex_count; vertex_offset += vertex_block_size)
+	{
+		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
+		size_t block_size_aligned = (block_size + kByteGroupSize - 1) & ~(kByteGroupSize - 1);
+
+		// all 2-bit channel modes are valid, so the mode bytes only need to be present
+		if (size_t(data_end - data) < mode_size)
+			return 0;
+
+		data += mode_size;
+
+		for (size_t k = 0; k < vertex_size; ++k)
+		{
+			data = validateBytes(data, data_end, block_size_aligned);
+			if (!data)
+				return 0;
+		}
+	}
 
+	return data;
+}
+
+static int validateVertexBuffer(size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+{
 	assert(vertex_size > 0 && vertex_size <= 256);
 	assert(vertex_size % 4 == 0);
 
-	const unsigned char* (*decode)(const unsigned char*, const unsigned char*, unsigned char*, size_t, size_t, unsigned char[256]) = 0;
+	const unsigned char* data = buffer;
+	const unsigned char* data_end = buffer + buffer_size;
 
-#if defined(SIMD_SSE) && defined(SIMD_FALLBACK)
-	decode = (cpuid & (1 << 9)) ? decodeVertexBlockSimd : decodeVertexBlock;
-#elif defined(SIMD_SSE) || defined(SIMD_AVX) || defined(SIMD_NEON) || defined(SIMD_WASM)
-	decode = decodeVertexBlockSimd;
-#else
-	decode = decodeVertexBlock;
-#endif
+	if (size_t(data_end - data) < 1 + vertex_size)
+		return -2;
 
-#if defined(SIMD_SSE) || defined(SIMD_NEON) || defined(SIMD_WASM)
-	assert(gDecodeBytesGroupInitialized);
-	(void)gDecodeBytesGroupInitialized;
-#endif
+	unsigned char data_header = *data++;
+
+	if ((data_header & 0xf0) != kVertexHeader)
+		return -1;
+
+	int version = data_header & 0x0f;
+	if (version > 2)
+		return -1;
+
+	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
+
+	if (version == 0)
+	{
+		data = validateVertexChunk(data, data_end, vertex_count, vertex_size, 0);
+		if (!data)
+			return -2;
+
+		return (size_t(data_end - data) == tail_size) ? 0 : -3;
+	}
+
+	size_t vertex_chunk_size = getVertexBlockSize(vertex_size) * kVertexChunkBlocks;
+	size_t chunk_count = getVertexChunkCount(vertex_count, getVertexBlockSize(vertex_size));
+
+	if (size_t(data_end - data) < chunk_count * kVertexChunkOffsetSize + tail_size)
+		return -2;
+
+	if (chunk_count == 0)
+		return (size_t(data_end - data) == tail_size) ? 0 : -3;
+
+	for (size_t i = 0; i < chunk_count; ++i)
+	{
+		size_t chunk_begin, chunk_end;
+		if (!getVertexChunkData(buffer, buffer_size, chunk_count, vertex_size, i, chunk_begin, chunk_end))
+			return -2;
+
+		size_t vertex_offset = i * vertex_chunk_size;
+		size_t chunk_size = (vertex_offset + vertex_chunk_size < vertex_count) ? vertex_chunk_size : vertex_count - vertex_offset;
+
+		// note: bounds checks use the end of the buffer to match the decoder
+		data = validateVertexChunk(buffer + chunk_begin, data_end, chunk_size, vertex_size, version);
+		if (!data)
+			return -2;
+
+		if (data != buffer + chunk_end)
+			return -3;
+	}
+
+	return 0;
+}
+
+static int decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, size_t vertex_stride, const unsigned char* buffer, size_t buffer_size, size_t range_begin, size_t range_end, DecodeFilterFn filter, meshopt_Dispatch dispatch, void* context)
+{
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+	assert(vertex_stride >= vertex_size);
+	assert(range_begin <= range_end && range_end <= vertex_count);
+
+	DecodeVertexBlockFn decode = getDecodeVertexBlock();
 
 	unsigned char* vertex_data = static_cast<unsigned char*>(destination);
 
@@ -1212,33 +1850,250 @@ int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t ve
 		return -1;
 
 	int version = data_header & 0x0f;
-	if (version > 0)
+	if (version > 2)
 		return -1;
 
-	unsigned char last_vertex[256];
-	memcpy(last_vertex, data_end - vertex_size, vertex_size);
+	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
 
-	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	if (version == 0)
+	{
+		data = decodeVertexChunk(decode, 0, filter, data, data_end, vertex_data, vertex_count, vertex_size, vertex_stride, data_end - vertex_size, range_begin, range_end);
+		if (!data)
+			return -2;
 
-	size_t vertex_offset = 0;
+		// we can only validate stream size if we decoded all of its blocks
+		if (range_end == vertex_count && size_t(data_end - data) != tail_size)
+			return -3;
 
-	while (vertex_offset < vertex_count)
+		return 0;
+	}
+
+	size_t vertex_chunk_size = getVertexBlockSize(vertex_size) * kVertexChunkBlocks;
+	size_t chunk_count = getVertexChunkCount(vertex_count, getVertexBlockSize(vertex_size));
+
+	if (size_t(data_end - data) < chunk_count * kVertexChunkOffsetSize + tail_size)
+		return -2;
+
+	if (chunk_count == 0)
+		return (size_t(data_end - data) == tail_size) ? 0 : -3;
+
+	if (range_begin == range_end)
+		return 0;
+
+	VertexChunkDecoder decoder = {};
+	decoder.decode = decode;
+	decoder.version = version;
+	decoder.filter = filter;
+	decoder.buffer = buffer;
+	decoder.buffer_size = buffer_size;
+	decoder.vertex_data = vertex_data;
+	decoder.vertex_count = vertex_count;
+	decoder.vertex_size = vertex_size;
+	decoder.vertex_stride = vertex_stride;
+	decoder.range_begin = range_begin;
+	decoder.range_end = range_end;
+	decoder.chunk_count = chunk_count;
+
+	// only chunks that intersect the range need to be decoded
+	size_t chunk_begin = range_begin / vertex_chunk_size;
+	size_t chunk_end = (range_end + vertex_chunk_size - 1) / vertex_chunk_size;
+
+	if (!dispatch || chunk_end - chunk_begin == 1)
 	{
-		size_t block_size = (vertex_offset + vertex_block_size < vertex_count) ? vertex_block_size : vertex_count - vertex_offset;
+		for (size_t i = chunk_begin; i < chunk_end; ++i)
+			if (int result = decodeVertexChunkAt(decoder, i))
+				return result;
+
+		return 0;
+	}
+
+	meshopt_Allocator allocator;
+
+	decoder.chunk_first = chunk_begin;
+	decoder.results = allocator.allocate<int>(chunk_end - chunk_begin);
+
+	dispatch(context, decodeVertexChunkTask, &decoder, chunk_end - chunk_begin);
+
+	// report the error from the first failing chunk to make the result independent of scheduling
+	for (size_t i = 0; i < chunk_end - chunk_begin; ++i)
+		if (decoder.results[i])
+			return decoder.results[i];
+
+	return 0;
+}
+
+} // namespace meshopt
+
+size_t meshopt_encodeVertexBuffer(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	const unsigned char* vertex_data = static_cast<const unsigned char*>(vertices);
+
+	unsigned char* data = buffer;
+	unsigned char* data_end = buffer + buffer_size;
+
+	if (size_t(data_end - data) < 1 + vertex_size)
+		return 0;
+
+	int version = gEncodeVertexVersion;
+
+	*data++ = (unsigned char)(kVertexHeader | version);
+
+	unsigned char first_vertex[256] = {};
+	if (vertex_count > 0)
+		memcpy(first_vertex, vertex_data, vertex_size);
 
-		data = decode(data, data_end, vertex_data + vertex_offset * vertex_size, block_size, vertex_size, last_vertex);
+	if (version == 0)
+	{
+		data = encodeVertexChunk(data, data_end, vertex_data, vertex_count, vertex_size, first_vertex, 0);
 		if (!data)
-			return -2;
+			return 0;
+	}
+	else
+	{
+		size_t vertex_chunk_size = getVertexBlockSize(vertex_size) * kVertexChunkBlocks;
+		size_t chunk_count = getVertexChunkCount(vertex_count, getVertexBlockSize(vertex_size));
 
-		vertex_offset += block_size;
+		if (size_t(data_end - data) < chunk_count * kVertexChunkOffsetSize)
+			return 0;
+
+		unsigned char* offsets = data;
+		data += chunk_count * kVertexChunkOffsetSize;
+
+		for (size_t i = 0; i < chunk_count; ++i)
+		{
+			size_t vertex_offset = i * vertex_chunk_size;
+			size_t chunk_size = (vertex_offset + vertex_chunk_size < vertex_count) ? vertex_chunk_size : vertex_count - vertex_offset;
+
+			// chunk offsets are stored as 32-bit integers
+			if (size_t(data - buffer) > 0xffffffff)
+				return 0;
+
+			writeVertexChunkOffset(offsets + i * kVertexChunkOffsetSize, data - buffer);
+
+			data = encodeVertexChunk(data, data_end, vertex_data + vertex_offset * vertex_size, chunk_size, vertex_size, first_vertex, version);
+			if (!data)
+				return 0;
+		}
+	}
+
+	return encodeVertexTail(buffer, data, data_end, vertex_size, first_vertex);
+}
+
+size_t meshopt_encodeVertexBufferParallel(unsigned char* buffer, size_t buffer_size, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Dispatch dispatch, void* context)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t chunk_count = getVertexChunkCount(vertex_count, vertex_block_size);
+
+	// version 0 has a single chunk, and parallel encoding needs worst case space for each chunk
+	if (gEncodeVertexVersion == 0 || chunk_count <= 1 || buffer_size < meshopt_encodeVertexBufferBound(vertex_count, vertex_size))
+		return meshopt_encodeVertexBuffer(buffer, buffer_size, vertices, vertex_count, vertex_size);
+
+	meshopt_Allocator allocator;
+
+	size_t vertex_block_header_size = (vertex_block_size / kByteGroupSize + 3) / 4;
+
+	VertexChunkEncoder encoder = {};
+	encoder.vertex_data = static_cast<const unsigned char*>(vertices);
+	encoder.vertex_count = vertex_count;
+	encoder.vertex_size = vertex_size;
+	encoder.version = gEncodeVertexVersion;
+	encoder.buffer = buffer;
+	encoder.buffer_size = buffer_size;
+	encoder.chunk_data_begin = 1 + chunk_count * kVertexChunkOffsetSize;
+	encoder.chunk_data_bound = kVertexChunkBlocks * (vertex_size * (vertex_block_header_size + vertex_block_size) + getVertexBlockModeSize(vertex_size, gEncodeVertexVersion));
+	encoder.results = allocator.allocate<size_t>(chunk_count);
+
+	dispatch(context, encodeVertexChunkTask, &encoder, chunk_count);
+
+	buffer[0] = (unsigned char)(kVertexHeader | gEncodeVertexVersion);
+
+	// compact chunk data; chunks only move towards the beginning of the buffer so this is safe to do in order
+	unsigned char* data = buffer + encoder.chunk_data_begin;
+
+	for (size_t i = 0; i < chunk_count; ++i)
+	{
+		// chunk offsets are stored as 32-bit integers
+		if (size_t(data - buffer) > 0xffffffff)
+			return 0;
+
+		writeVertexChunkOffset(buffer + 1 + i * kVertexChunkOffsetSize, data - buffer);
+
+		memmove(data, buffer + encoder.chunk_data_begin + i * encoder.chunk_data_bound, encoder.results[i]);
+		data += encoder.results[i];
 	}
 
+	return encodeVertexTail(buffer, data, buffer + buffer_size, vertex_size, encoder.vertex_data);
+}
+
+size_t meshopt_encodeVertexBufferBound(size_t vertex_count, size_t vertex_size)
+{
+	using namespace meshopt;
+
+	assert(vertex_size > 0 && vertex_size <= 256);
+	assert(vertex_size % 4 == 0);
+
+	size_t vertex_block_size = getVertexBlockSize(vertex_size);
+	size_t vertex_block_count = (vertex_count + vertex_block_size - 1) / vertex_block_size;
+
+	size_t vertex_block_header_size = (vertex_block_size / kByteGroupSize + 3) / 4;
+	size_t vertex_block_data_size = vertex_block_size;
+
+	// version 1 stores an offset for every chunk and version 2 stores channel modes for every block; we account for these regardless of the version since the bound must be valid for all versions
+	size_t vertex_chunk_header_size = getVertexChunkCount(vertex_count, vertex_block_size) * kVertexChunkOffsetSize;
+	size_t vertex_block_mode_size = getVertexBlockModeSize(vertex_size, 2);
+
 	size_t tail_size = vertex_size < kTailMaxSize ? kTailMaxSize : vertex_size;
 
-	if (size_t(data_end - data) != tail_size)
-		return -3;
+	return 1 + vertex_chunk_header_size + vertex_block_count * (vertex_size * (vertex_block_header_size + vertex_block_data_size) + vertex_block_mode_size) + tail_size;
+}
 
-	return 0;
+void meshopt_encodeVertexVersion(int version)
+{
+	assert(unsigned(version) <= 2);
+
+	meshopt::gEncodeVertexVersion = version;
+}
+
+int meshopt_decodeVertexBuffer(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+{
+	return meshopt::decodeVertexBuffer(destination, vertex_count, vertex_size, vertex_size, buffer, buffer_size, 0, vertex_count, 0, 0, 0);
+}
+
+int meshopt_decodeVertexBufferFiltered(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, void (*filter)(void* buffer, size_t count, size_t stride))
+{
+	return meshopt::decodeVertexBuffer(destination, vertex_count, vertex_size, vertex_size, buffer, buffer_size, 0, vertex_count, filter, 0, 0);
+}
+
+int meshopt_decodeVertexBufferStrided(void* destination, size_t vertex_count, size_t vertex_size, size_t destination_stride, const unsigned char* buffer, size_t buffer_size)
+{
+	return meshopt::decodeVertexBuffer(destination, vertex_count, vertex_size, destination_stride, buffer, buffer_size, 0, vertex_count, 0, 0, 0);
+}
+
+int meshopt_decodeVertexBufferParallel(void* destination, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size, meshopt_Dispatch dispatch, void* context)
+{
+	return meshopt::decodeVertexBuffer(destination, vertex_count, vertex_size, vertex_size, buffer, buffer_size, 0, vertex_count, 0, dispatch, context);
+}
+
+int meshopt_decodeVertexRange(void* destination, size_t vertex_offset, size_t vertex_range, size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+{
+	assert(vertex_offset <= vertex_count && vertex_range <= vertex_count - vertex_offset);
+
+	return meshopt::decodeVertexBuffer(destination, vertex_count, vertex_size, vertex_size, buffer, buffer_size, vertex_offset, vertex_offset + vertex_range, 0, 0, 0);
+}
+
+int meshopt_validateVertexBuffer(size_t vertex_count, size_t vertex_size, const unsigned char* buffer, size_t buffer_size)
+{
+	return meshopt::validateVertexBuffer(vertex_count, vertex_size, buffer, buffer_size);
 }
 
 #undef SIMD_NEON
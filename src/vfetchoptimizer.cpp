@@ -4,6 +4,33 @@
 #include <assert.h>
 #include <string.h>
 
+namespace meshopt
+{
+
+static void copyElement(unsigned char* destination, const unsigned char* source, size_t size)
+{
+	// fixed size copies for common attribute sizes are inlined, which is much faster than calling memcpy for every element
+	switch (size)
+	{
+	case 4:
+		memcpy(destination, source, 4);
+		break;
+	case 8:
+		memcpy(destination, source, 8);
+		break;
+	case 12:
+		memcpy(destination, source, 12);
+		break;
+	case 16:
+		memcpy(destination, source, 16);
+		break;
+	default:
+		memcpy(destination, source, size);
+	}
+}
+
+} // namespace meshopt
+
 size_t meshopt_optimizeVertexFetchRemap(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count)
 {
 	assert(index_count % 3 == 0);
@@ -28,12 +55,80 @@ size_t meshopt_optimizeVertexFetchRemap(unsigned int* destination, const unsigne
 	return next_vertex;
 }
 
+size_t meshopt_optimizeVertexFetchRemapIncremental(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const unsigned int* dirty_vertices, size_t dirty_count)
+{
+	assert(index_count % 3 == 0);
+
+	meshopt_Allocator allocator;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		destination[i] = unsigned(i);
+
+	// 0 = fixed, 1 = dirty, 2 = dirty and placed
+	unsigned char* state = allocator.allocate<unsigned char>(vertex_count);
+	memset(state, 0, vertex_count);
+
+	for (size_t i = 0; i < dirty_count; ++i)
+	{
+		assert(dirty_vertices[i] < vertex_count);
+		state[dirty_vertices[i]] = 1;
+	}
+
+	// dirty vertices are redistributed between the slots that they occupy, in ascending slot order
+	unsigned int* slots = allocator.allocate<unsigned int>(dirty_count);
+	size_t slot_count = 0;
+
+	for (size_t i = 0; i < vertex_count; ++i)
+		if (state[i])
+			slots[slot_count++] = unsigned(i);
+
+	size_t next_slot = 0;
+
+	// dirty vertices are placed in the order of first use, which is the order meshopt_optimizeVertexFetchRemap produces for the same subset of vertices
+	for (size_t i = 0; i < index_count; ++i)
+	{
+		unsigned int index = indices[i];
+		assert(index < vertex_count);
+
+		if (state[index] == 1)
+		{
+			destination[index] = slots[next_slot++];
+			state[index] = 2;
+		}
+	}
+
+	// unreferenced dirty vertices take the remaining slots so that the result remains a permutation
+	for (size_t i = 0; i < slot_count; ++i)
+		if (state[slots[i]] == 1)
+			destination[slots[i]] = slots[next_slot++];
+
+	assert(next_slot == slot_count);
+
+	size_t result = 0;
+
+	for (size_t i = 0; i < slot_count; ++i)
+		result += destination[slots[i]] != slots[i];
+
+	return result;
+}
+
 size_t meshopt_optimizeVertexFetch(void* destination, unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size)
+{
+	return meshopt_optimizeVertexFetchWithContext(destination, indices, index_count, vertices, vertex_count, vertex_size, NULL);
+}
+
+size_t meshopt_optimizeVertexFetchScratchBound(size_t vertex_count, size_t vertex_size)
+{
+	// vertices copy (for in-place optimization) and vertex remap
+	return meshopt_Allocator::scratch<unsigned char>(vertex_count * vertex_size) + meshopt_Allocator::scratch<unsigned int>(vertex_count);
+}
+
+size_t meshopt_optimizeVertexFetchWithContext(void* destination, unsigned int* indices, size_t index_count, const void* vertices, size_t vertex_count, size_t vertex_size, meshopt_Context* context)
 {
 	assert(index_count % 3 == 0);
 	assert(vertex_size > 0 && vertex_size <= 256);
 
-	meshopt_Allocator allocator;
+	meshopt_Allocator allocator(context);
 
 	// support in-place optimization
 	if (destination == vertices)
@@ -72,3 +167,71 @@ size_t meshopt_optimizeVertexFetch(void* destination, unsigned int* indices, siz
 
 	return next_vertex;
 }
+
+size_t meshopt_optimizeVertexFetchMulti(void* const* destinations, unsigned int* indices, size_t index_count, size_t vertex_count, const struct meshopt_Stream* streams, size_t stream_count)
+{
+	using namespace meshopt;
+
+	assert(index_count % 3 == 0);
+	assert(stream_count > 0 && stream_count <= 16);
+
+	for (size_t i = 0; i < stream_count; ++i)
+	{
+		assert(streams[i].size > 0 && streams[i].size <= 256);
+		assert(streams[i].size <= streams[i].stride);
+	}
+
+	meshopt_Allocator allocator;
+
+	const unsigned char* sources[16];
+	unsigned char* targets[16];
+
+	for (size_t i = 0; i < stream_count; ++i)
+	{
+		const meshopt_Stream& s = streams[i];
+
+		sources[i] = static_cast<const unsigned char*>(s.data);
+		targets[i] = static_cast<unsigned char*>(destinations[i]);
+
+		// support in-place optimization
+		if (destinations[i] == s.data)
+		{
+			assert(s.size == s.stride);
+
+			unsigned char* vertices_copy = allocator.allocate<unsigned char>(vertex_count * s.size);
+			memcpy(vertices_copy, s.data, vertex_count * s.size);
+			sources[i] = vertices_copy;
+		}
+	}
+
+	// build vertex remap table
+	unsigned int* vertex_remap = allocator.allocate<unsigned int>(vertex_count);
+	memset(vertex_remap, -1, vertex_count * sizeof(unsigned int));
+
+	unsigned int next_vertex = 0;
+
+	for (size_t i = 0; i < index_count; ++i)
+	{
+		unsigned int index = indices[i];
+		assert(index < vertex_count);
+
+		unsigned int& remap = vertex_remap[index];
+
+		if (remap == ~0u) // vertex was not added to destination VB
+		{
+			// add vertex to all streams; all destinations are written sequentially, so regular stores fill complete cache lines
+			// note: non-temporal stores don't help here since the cost is dominated by source reads, and callers typically read the output right away
+			for (size_t k = 0; k < stream_count; ++k)
+				copyElement(targets[k] + next_vertex * streams[k].size, sources[k] + index * streams[k].stride, streams[k].size);
+
+			remap = next_vertex++;
+		}
+
+		// modify indices in place
+		indices[i] = remap;
+	}
+
+	assert(next_vertex <= vertex_count);
+
+	return next_vertex;
+}
@@ -0,0 +1,975 @@
+// This file is a benchmark for all meshoptimizer algorithms; run without arguments for usage
+#include "../src/meshoptimizer.h"
+#include "../extern/fast_obj.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+struct LARGE_INTEGER
+{
+	__int64 QuadPart;
+};
+extern "C" __declspec(dllimport) int __stdcall QueryPerformanceCounter(LARGE_INTEGER* lpPerformanceCount);
+extern "C" __declspec(dllimport) int __stdcall QueryPerformanceFrequency(LARGE_INTEGER* lpFrequency);
+
+double timestamp()
+{
+	LARGE_INTEGER freq, counter;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&counter);
+	return double(counter.QuadPart) / double(freq.QuadPart);
+}
+#else
+double timestamp()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return double(ts.tv_sec) + 1e-9 * double(ts.tv_nsec);
+}
+#endif
+
+struct Vertex
+{
+	float px, py, pz;
+	float nx, ny, nz;
+	float tx, ty;
+};
+
+struct Mesh
+{
+	std::string name;
+
+	std::vector<Vertex> vertices;
+	std::vector<unsigned int> indices;
+};
+
+struct State
+{
+	const Mesh* mesh;
+
+	std::vector<Vertex> unindexed;
+
+	std::vector<unsigned int> remap;
+	std::vector<unsigned int> ib;
+	std::vector<unsigned int> lods;
+	std::vector<unsigned int> strip;
+	std::vector<unsigned int> dirty;
+	std::vector<Vertex> vb;
+
+	std::vector<unsigned char> vbuf;
+	std::vector<unsigned char> ibuf;
+	std::vector<unsigned char> sbuf;
+	std::vector<unsigned char> vencoded;
+	std::vector<unsigned char> vencoded2;
+	std::vector<unsigned char> iencoded;
+	std::vector<unsigned char> sencoded;
+
+	std::vector<meshopt_Meshlet> meshlets;
+	std::vector<unsigned int> meshlet_vertices;
+	std::vector<unsigned char> meshlet_triangles;
+	size_t meshlet_count;
+
+	std::vector<meshopt_Meshlet> meshlets_scratch;
+	std::vector<unsigned int> meshlet_vertices_scratch;
+	std::vector<unsigned char> meshlet_triangles_scratch;
+
+	std::vector<meshopt_Bounds> meshlet_bounds;
+	std::vector<meshopt_MeshletCullData> meshlet_cull;
+
+	std::vector<unsigned char> meshlet_encoded;
+	std::vector<size_t> meshlet_offsets;
+
+	std::vector<meshopt_ClusterLod> clusters;
+	std::vector<unsigned int> cluster_vertices;
+	std::vector<unsigned char> cluster_triangles;
+
+	std::vector<float> normals;
+	std::vector<float> rotations;
+	std::vector<float> positions;
+
+	std::vector<unsigned char> filter4;
+	std::vector<unsigned char> filter8;
+	std::vector<unsigned char> foct4;
+	std::vector<unsigned char> foct8;
+	std::vector<unsigned char> fquat8;
+	std::vector<unsigned char> fexp;
+	std::vector<unsigned char> foct8encoded;
+
+	size_t sink;
+};
+
+typedef void (*BenchFunction)(State& state);
+
+struct Benchmark
+{
+	const char* name;
+	BenchFunction function;
+};
+
+struct Result
+{
+	const char* name;
+
+	double min, p50, p90, max, mean;
+};
+
+static void dispatchSerial(void*, void (*task)(void*, size_t), void* task_context, size_t task_count)
+{
+	// parallel entry points are measured with inline task execution to make results independent of the thread count
+	for (size_t i = 0; i < task_count; ++i)
+		task(task_context, i);
+}
+
+static void benchRemap(State& s)
+{
+	s.sink += meshopt_generateVertexRemap(&s.remap[0], NULL, s.unindexed.size(), &s.unindexed[0], s.unindexed.size(), sizeof(Vertex));
+}
+
+static void benchRemapParallel(State& s)
+{
+	s.sink += meshopt_generateVertexRemapParallel(&s.remap[0], NULL, s.unindexed.size(), &s.unindexed[0], s.unindexed.size(), sizeof(Vertex), dispatchSerial, NULL);
+}
+
+static void benchShadow(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_generateShadowIndexBuffer(&s.ib[0], &m.indices[0], m.indices.size(), &m.vertices[0], m.vertices.size(), sizeof(float) * 3, sizeof(Vertex));
+}
+
+static void benchVertexCache(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_optimizeVertexCache(&s.ib[0], &m.indices[0], m.indices.size(), m.vertices.size());
+}
+
+static void benchVertexCacheStrip(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_optimizeVertexCacheStrip(&s.ib[0], &m.indices[0], m.indices.size(), m.vertices.size());
+}
+
+static void benchVertexCacheFifo(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_optimizeVertexCacheFifo(&s.ib[0], &m.indices[0], m.indices.size(), m.vertices.size(), 16);
+}
+
+static void benchVertexCacheParallel(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_optimizeVertexCacheParallel(&s.ib[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), dispatchSerial, NULL);
+}
+
+static void benchVertexCacheIncremental(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_optimizeVertexCacheIncremental(&s.ib[0], &m.indices[0], m.indices.size(), m.vertices.size(), &s.dirty[0], s.dirty.size());
+}
+
+static void benchOverdraw(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_optimizeOverdraw(&s.ib[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), 1.05f);
+}
+
+static void benchVertexFetch(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.ib = m.indices; // optimizeVertexFetch updates indices in place
+	s.sink += meshopt_optimizeVertexFetch(&s.vb[0], &s.ib[0], s.ib.size(), &m.vertices[0], m.vertices.size(), sizeof(Vertex));
+}
+
+static void benchVertexFetchMulti(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.ib = m.indices;
+
+	// deinterleave position, normal and texture coordinates into consecutive arrays of the vb storage
+	meshopt_Stream streams[] = {
+	    {&m.vertices[0].px, sizeof(float) * 3, sizeof(Vertex)},
+	    {&m.vertices[0].nx, sizeof(float) * 3, sizeof(Vertex)},
+	    {&m.vertices[0].tx, sizeof(float) * 2, sizeof(Vertex)},
+	};
+
+	float* data = &s.vb[0].px;
+	void* destinations[] = {data, data + m.vertices.size() * 3, data + m.vertices.size() * 6};
+
+	s.sink += meshopt_optimizeVertexFetchMulti(destinations, &s.ib[0], s.ib.size(), m.vertices.size(), streams, 3);
+}
+
+static void benchAnalyzeVertexCache(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_analyzeVertexCache(&m.indices[0], m.indices.size(), m.vertices.size(), 16, 0, 0).vertices_transformed;
+}
+
+static void benchAnalyzeVertexFetch(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_analyzeVertexFetch(&m.indices[0], m.indices.size(), m.vertices.size(), sizeof(Vertex)).bytes_fetched;
+}
+
+static void benchAnalyzeOverdraw(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_analyzeOverdraw(&m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex)).pixels_shaded;
+}
+
+static void benchAnalyzeMesh(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_analyzeMesh(&m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), sizeof(Vertex), 16, 0, 0, NULL, NULL).overdraw.pixels_shaded;
+}
+
+static void benchSimplify(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_simplify(&s.ib[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), m.indices.size() / 12 * 3, 1e-2f, 0, NULL);
+}
+
+static void benchSimplifyParallel(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_simplifyParallel(&s.ib[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), m.indices.size() / 12 * 3, 1e-2f, 0, NULL, dispatchSerial, NULL);
+}
+
+static void benchSimplifySloppy(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_simplifySloppy(&s.ib[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), m.indices.size() / 12 * 3, 1e-2f, NULL);
+}
+
+static void benchSimplifySloppyLods(State& s)
+{
+	const Mesh& m = *s.mesh;
+	const size_t targets[] = {m.indices.size() / 4 / 3 * 3, m.indices.size() / 12 * 3, m.indices.size() / 48 * 3, m.indices.size() / 192 * 3};
+	const float errors[] = {1e-2f, 2e-2f, 5e-2f, 1e-1f};
+
+	size_t counts[4];
+	s.sink += meshopt_simplifySloppyLods(&s.lods[0], counts, &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), targets, errors, 4, NULL);
+}
+
+static void benchSimplifyPoints(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_simplifyPoints(&s.ib[0], &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), m.vertices.size() / 4);
+}
+
+static void benchStripify(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_stripify(&s.strip[0], &m.indices[0], m.indices.size(), m.vertices.size(), ~0u);
+}
+
+static void benchStripifyAdjacency(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_stripifyAdjacency(&s.strip[0], &m.indices[0], m.indices.size(), m.vertices.size(), ~0u);
+}
+
+static void benchUnstripify(State& s)
+{
+	const Mesh& m = *s.mesh;
+	size_t strip_size = meshopt_stripify(&s.strip[0], &m.indices[0], m.indices.size(), m.vertices.size(), ~0u);
+	s.sink += meshopt_unstripify(&s.ib[0], &s.strip[0], strip_size, ~0u);
+}
+
+static void benchSpatialSort(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_spatialSortRemap(&s.remap[0], &m.vertices[0].px, m.vertices.size(), sizeof(Vertex));
+}
+
+static void benchSpatialSortTriangles(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_spatialSortTriangles(&s.ib[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex));
+}
+
+static void benchMeshlets(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_buildMeshlets(&s.meshlets_scratch[0], &s.meshlet_vertices_scratch[0], &s.meshlet_triangles_scratch[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), 64, 124, 0.25f);
+}
+
+static void benchMeshletsScan(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_buildMeshletsScan(&s.meshlets_scratch[0], &s.meshlet_vertices_scratch[0], &s.meshlet_triangles_scratch[0], &m.indices[0], m.indices.size(), m.vertices.size(), 64, 124);
+}
+
+static void benchMeshletsParallel(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_buildMeshletsParallel(&s.meshlets_scratch[0], &s.meshlet_vertices_scratch[0], &s.meshlet_triangles_scratch[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), 64, 124, 0.25f, dispatchSerial, NULL);
+}
+
+static void benchMeshletBounds(State& s)
+{
+	const Mesh& m = *s.mesh;
+
+	for (size_t i = 0; i < s.meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& ml = s.meshlets[i];
+		meshopt_Bounds bounds = meshopt_computeMeshletBounds(&s.meshlet_vertices[ml.vertex_offset], &s.meshlet_triangles[ml.triangle_offset], ml.triangle_count, &m.vertices[0].px, m.vertices.size(), sizeof(Vertex));
+		s.sink += bounds.cone_cutoff_s8;
+	}
+}
+
+static void benchMeshletBoundsBatch(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_computeMeshletBoundsBatch(&s.meshlet_bounds[0], &s.meshlets[0], s.meshlet_count, &s.meshlet_vertices[0], &s.meshlet_triangles[0], &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), dispatchSerial, NULL);
+	s.sink += s.meshlet_bounds[0].cone_cutoff_s8;
+}
+
+static void benchMeshletCullData(State& s)
+{
+	const Mesh& m = *s.mesh;
+	const float box_min[3] = {-1.f, -1.f, -1.f};
+	meshopt_computeMeshletCullData(&s.meshlet_cull[0], &s.meshlets[0], s.meshlet_count, &s.meshlet_vertices[0], &s.meshlet_triangles[0], &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), box_min, 2.f, dispatchSerial, NULL);
+	s.sink += s.meshlet_cull[0].cone_cutoff_s8;
+}
+
+static void benchClusterLod(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_buildClusterLod(&s.clusters[0], &s.cluster_vertices[0], &s.cluster_triangles[0], &m.indices[0], m.indices.size(), &m.vertices[0].px, m.vertices.size(), sizeof(Vertex), 64, 124);
+}
+
+static void benchEncodeMeshlet(State& s)
+{
+	unsigned char* buffer = &s.meshlet_encoded[0];
+	size_t capacity = s.meshlet_encoded.size();
+
+	for (size_t i = 0; i < s.meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& ml = s.meshlets[i];
+		size_t size = meshopt_encodeMeshlet(buffer, capacity, &s.meshlet_vertices[ml.vertex_offset], ml.vertex_count, &s.meshlet_triangles[ml.triangle_offset], ml.triangle_count);
+
+		buffer += size;
+		capacity -= size;
+	}
+
+	s.sink += s.meshlet_encoded.size() - capacity;
+}
+
+static void benchDecodeMeshlet(State& s)
+{
+	for (size_t i = 0; i < s.meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& ml = s.meshlets[i];
+		int rc = meshopt_decodeMeshlet(&s.meshlet_vertices_scratch[0], ml.vertex_count, &s.meshlet_triangles_scratch[0], ml.triangle_count, &s.meshlet_encoded[s.meshlet_offsets[i]], s.meshlet_offsets[i + 1] - s.meshlet_offsets[i]);
+		assert(rc == 0);
+		s.sink += rc;
+	}
+}
+
+static void benchEncodeVertex(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_encodeVertexBuffer(&s.vbuf[0], s.vbuf.size(), &m.vertices[0], m.vertices.size(), sizeof(Vertex));
+}
+
+static void benchDecodeVertex(State& s)
+{
+	const Mesh& m = *s.mesh;
+	int rc = meshopt_decodeVertexBuffer(&s.vb[0], m.vertices.size(), sizeof(Vertex), &s.vencoded[0], s.vencoded.size());
+	assert(rc == 0);
+	s.sink += rc;
+}
+
+static void benchValidateVertex(State& s)
+{
+	const Mesh& m = *s.mesh;
+	int rc = meshopt_validateVertexBuffer(m.vertices.size(), sizeof(Vertex), &s.vencoded[0], s.vencoded.size());
+	assert(rc == 0);
+	s.sink += rc;
+}
+
+static void benchEncodeVertexV2(State& s)
+{
+	const Mesh& m = *s.mesh;
+	meshopt_encodeVertexVersion(2);
+	s.sink += meshopt_encodeVertexBuffer(&s.vbuf[0], s.vbuf.size(), &m.vertices[0], m.vertices.size(), sizeof(Vertex));
+	meshopt_encodeVertexVersion(0);
+}
+
+static void benchDecodeVertexV2(State& s)
+{
+	const Mesh& m = *s.mesh;
+	int rc = meshopt_decodeVertexBuffer(&s.vb[0], m.vertices.size(), sizeof(Vertex), &s.vencoded2[0], s.vencoded2.size());
+	assert(rc == 0);
+	s.sink += rc;
+}
+
+static void benchEncodeIndex(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_encodeIndexBuffer(&s.ibuf[0], s.ibuf.size(), &m.indices[0], m.indices.size());
+}
+
+static void benchDecodeIndex(State& s)
+{
+	const Mesh& m = *s.mesh;
+	int rc = meshopt_decodeIndexBuffer(&s.ib[0], m.indices.size(), 4, &s.iencoded[0], s.iencoded.size());
+	assert(rc == 0);
+	s.sink += rc;
+}
+
+static void benchValidateIndex(State& s)
+{
+	const Mesh& m = *s.mesh;
+	int rc = meshopt_validateIndexBuffer(m.indices.size(), &s.iencoded[0], s.iencoded.size());
+	assert(rc == 0);
+	s.sink += rc;
+}
+
+static void benchEncodeIndexSequence(State& s)
+{
+	const Mesh& m = *s.mesh;
+	s.sink += meshopt_encodeIndexSequence(&s.sbuf[0], s.sbuf.size(), &m.indices[0], m.indices.size());
+}
+
+static void benchDecodeIndexSequence(State& s)
+{
+	const Mesh& m = *s.mesh;
+	int rc = meshopt_decodeIndexSequence(&s.ib[0], m.indices.size(), 4, &s.sencoded[0], s.sencoded.size());
+	assert(rc == 0);
+	s.sink += rc;
+}
+
+static void benchEncodeFilterOct(State& s)
+{
+	meshopt_encodeFilterOct(&s.filter8[0], s.mesh->vertices.size(), 8, 12, &s.normals[0]);
+}
+
+static void benchEncodeFilterQuat(State& s)
+{
+	meshopt_encodeFilterQuat(&s.filter8[0], s.mesh->vertices.size(), 8, 12, &s.rotations[0]);
+}
+
+static void benchEncodeFilterExp(State& s)
+{
+	meshopt_encodeFilterExp(&s.filter8[0], s.mesh->vertices.size() * 3 / 2, 8, 15, &s.positions[0]);
+}
+
+static void benchDecodeFilterOct8(State& s)
+{
+	// filters decode in place, so each iteration starts from a fresh copy of the encoded data
+	memcpy(&s.filter4[0], &s.foct4[0], s.foct4.size());
+	meshopt_decodeFilterOct(&s.filter4[0], s.mesh->vertices.size(), 4);
+}
+
+static void benchDecodeFilterOct12(State& s)
+{
+	memcpy(&s.filter8[0], &s.foct8[0], s.foct8.size());
+	meshopt_decodeFilterOct(&s.filter8[0], s.mesh->vertices.size(), 8);
+}
+
+static void benchDecodeFilterQuat(State& s)
+{
+	memcpy(&s.filter8[0], &s.fquat8[0], s.fquat8.size());
+	meshopt_decodeFilterQuat(&s.filter8[0], s.mesh->vertices.size(), 8);
+}
+
+static void benchDecodeFilterExp(State& s)
+{
+	memcpy(&s.filter8[0], &s.fexp[0], s.fexp.size());
+	meshopt_decodeFilterExp(&s.filter8[0], s.mesh->vertices.size() * 3 / 2, 8);
+}
+
+static void benchDecodeVertexOct12(State& s)
+{
+	// separate decode and filter passes, for comparison with the fused variant below
+	int rc = meshopt_decodeVertexBuffer(&s.filter8[0], s.mesh->vertices.size(), 8, &s.foct8encoded[0], s.foct8encoded.size());
+	assert(rc == 0);
+	meshopt_decodeFilterOct(&s.filter8[0], s.mesh->vertices.size(), 8);
+	s.sink += rc;
+}
+
+static void benchDecodeVertexOct12Fused(State& s)
+{
+	int rc = meshopt_decodeVertexBufferFiltered(&s.filter8[0], s.mesh->vertices.size(), 8, &s.foct8encoded[0], s.foct8encoded.size(), meshopt_decodeFilterOct);
+	assert(rc == 0);
+	s.sink += rc;
+}
+
+static const Benchmark kBenchmarks[] = {
+    {"remap", benchRemap},
+    {"remap_parallel", benchRemapParallel},
+    {"shadow", benchShadow},
+    {"vcache", benchVertexCache},
+    {"vcache_strip", benchVertexCacheStrip},
+    {"vcache_fifo", benchVertexCacheFifo},
+    {"vcache_parallel", benchVertexCacheParallel},
+    {"vcache_incremental", benchVertexCacheIncremental},
+    {"overdraw", benchOverdraw},
+    {"vfetch", benchVertexFetch},
+    {"vfetch_multi", benchVertexFetchMulti},
+    {"analyze_vcache", benchAnalyzeVertexCache},
+    {"analyze_vfetch", benchAnalyzeVertexFetch},
+    {"analyze_overdraw", benchAnalyzeOverdraw},
+    {"analyze_mesh", benchAnalyzeMesh},
+    {"simplify", benchSimplify},
+    {"simplify_parallel", benchSimplifyParallel},
+    {"simplify_sloppy", benchSimplifySloppy},
+    {"simplify_sloppy_lods", benchSimplifySloppyLods},
+    {"simplify_points", benchSimplifyPoints},
+    {"stripify", benchStripify},
+    {"stripify_adjacency", benchStripifyAdjacency},
+    {"unstripify", benchUnstripify},
+    {"spatial_sort", benchSpatialSort},
+    {"spatial_sort_triangles", benchSpatialSortTriangles},
+    {"meshlets", benchMeshlets},
+    {"meshlets_scan", benchMeshletsScan},
+    {"meshlets_parallel", benchMeshletsParallel},
+    {"meshlet_bounds", benchMeshletBounds},
+    {"meshlet_bounds_batch", benchMeshletBoundsBatch},
+    {"meshlet_cull_data", benchMeshletCullData},
+    {"cluster_lod", benchClusterLod},
+    {"meshlet_encode", benchEncodeMeshlet},
+    {"meshlet_decode", benchDecodeMeshlet},
+    {"vertex_encode", benchEncodeVertex},
+    {"vertex_decode", benchDecodeVertex},
+    {"vertex_validate", benchValidateVertex},
+    {"vertex_encode_v2", benchEncodeVertexV2},
+    {"vertex_decode_v2", benchDecodeVertexV2},
+    {"index_encode", benchEncodeIndex},
+    {"index_decode", benchDecodeIndex},
+    {"index_validate", benchValidateIndex},
+    {"sequence_encode", benchEncodeIndexSequence},
+    {"sequence_decode", benchDecodeIndexSequence},
+    {"filter_encode_oct", benchEncodeFilterOct},
+    {"filter_encode_quat", benchEncodeFilterQuat},
+    {"filter_encode_exp", benchEncodeFilterExp},
+    {"filter_decode_oct8", benchDecodeFilterOct8},
+    {"filter_decode_oct12", benchDecodeFilterOct12},
+    {"filter_decode_quat", benchDecodeFilterQuat},
+    {"filter_decode_exp", benchDecodeFilterExp},
+    {"vertex_decode_oct12", benchDecodeVertexOct12},
+    {"vertex_decode_oct12_fused", benchDecodeVertexOct12Fused},
+};
+
+static void prepareState(State& s, const Mesh& m)
+{
+	s.mesh = &m;
+
+	s.unindexed.resize(m.indices.size());
+	for (size_t i = 0; i < m.indices.size(); ++i)
+		s.unindexed[i] = m.vertices[m.indices[i]];
+
+	size_t index_count = m.indices.size();
+	size_t vertex_count = m.vertices.size();
+
+	s.remap.resize(std::max(index_count, vertex_count));
+	s.ib.resize(index_count);
+	s.lods.resize(index_count * 4);
+	s.strip.resize(meshopt_stripifyBound(index_count));
+	s.vb.resize(vertex_count);
+
+	// simulates a local edit that touches 256 consecutive triangles in the middle of the mesh
+	for (size_t i = index_count / 6; i < index_count / 6 + 256 && i < index_count / 3; ++i)
+		s.dirty.push_back(unsigned(i));
+
+	s.vbuf.resize(meshopt_encodeVertexBufferBound(vertex_count, sizeof(Vertex)));
+	s.ibuf.resize(meshopt_encodeIndexBufferBound(index_count, vertex_count));
+	s.sbuf.resize(meshopt_encodeIndexSequenceBound(index_count, vertex_count));
+
+	s.vencoded.resize(meshopt_encodeVertexBuffer(&s.vbuf[0], s.vbuf.size(), &m.vertices[0], vertex_count, sizeof(Vertex)));
+	memcpy(&s.vencoded[0], &s.vbuf[0], s.vencoded.size());
+
+	meshopt_encodeVertexVersion(2);
+	s.vencoded2.resize(meshopt_encodeVertexBuffer(&s.vbuf[0], s.vbuf.size(), &m.vertices[0], vertex_count, sizeof(Vertex)));
+	memcpy(&s.vencoded2[0], &s.vbuf[0], s.vencoded2.size());
+	meshopt_encodeVertexVersion(0);
+
+	s.iencoded.resize(meshopt_encodeIndexBuffer(&s.ibuf[0], s.ibuf.size(), &m.indices[0], index_count));
+	memcpy(&s.iencoded[0], &s.ibuf[0], s.iencoded.size());
+
+	s.sencoded.resize(meshopt_encodeIndexSequence(&s.sbuf[0], s.sbuf.size(), &m.indices[0], index_count));
+	memcpy(&s.sencoded[0], &s.sbuf[0], s.sencoded.size());
+
+	size_t max_meshlets = std::max(meshopt_buildMeshletsBound(index_count, 64, 124), meshopt_buildMeshletsParallelBound(index_count, 64, 124));
+
+	s.meshlets.resize(max_meshlets);
+	s.meshlet_vertices.resize(max_meshlets * 64);
+	s.meshlet_triangles.resize(max_meshlets * 124 * 3);
+	s.meshlet_count = meshopt_buildMeshlets(&s.meshlets[0], &s.meshlet_vertices[0], &s.meshlet_triangles[0], &m.indices[0], index_count, &m.vertices[0].px, vertex_count, sizeof(Vertex), 64, 124, 0.25f);
+
+	s.meshlets_scratch = s.meshlets;
+	s.meshlet_vertices_scratch = s.meshlet_vertices;
+	s.meshlet_triangles_scratch = s.meshlet_triangles;
+
+	s.meshlet_bounds.resize(s.meshlet_count);
+	s.meshlet_cull.resize(s.meshlet_count);
+
+	s.meshlet_encoded.resize(s.meshlet_count * meshopt_encodeMeshletBound(64, 124));
+	s.meshlet_offsets.resize(s.meshlet_count + 1);
+
+	for (size_t i = 0; i < s.meshlet_count; ++i)
+	{
+		const meshopt_Meshlet& ml = s.meshlets[i];
+		size_t offset = s.meshlet_offsets[i];
+		size_t size = meshopt_encodeMeshlet(&s.meshlet_encoded[offset], s.meshlet_encoded.size() - offset, &s.meshlet_vertices[ml.vertex_offset], ml.vertex_count, &s.meshlet_triangles[ml.triangle_offset], ml.triangle_count);
+		assert(size > 0);
+
+		s.meshlet_offsets[i + 1] = offset + size;
+	}
+
+	size_t max_clusters = meshopt_buildClusterLodBound(index_count, 64, 124);
+
+	s.clusters.resize(max_clusters);
+	s.cluster_vertices.resize(max_clusters * 64);
+	s.cluster_triangles.resize(max_clusters * 124 * 3);
+
+	// filter inputs are derived from vertex attributes to get realistic value distributions
+	s.normals.resize(vertex_count * 4);
+	s.rotations.resize(vertex_count * 4);
+	s.positions.resize(vertex_count * 3);
+
+	for (size_t i = 0; i < vertex_count; ++i)
+	{
+		const Vertex& v = m.vertices[i];
+
+		float nl = sqrtf(v.nx * v.nx + v.ny * v.ny + v.nz * v.nz);
+		float ns = nl == 0.f ? 0.f : 1.f / nl;
+
+		s.normals[i * 4 + 0] = v.nx * ns;
+		s.normals[i * 4 + 1] = v.ny * ns;
+		s.normals[i * 4 + 2] = v.nz * ns;
+		s.normals[i * 4 + 3] = 1.f;
+
+		// rotation that maps +Z to the normal, with a twist derived from texture coordinates
+		float angle = v.tx * 3.1415926f;
+		float w = sqrtf(std::max(0.f, 1.f - s.normals[i * 4 + 0] * s.normals[i * 4 + 0] - s.normals[i * 4 + 1] * s.normals[i * 4 + 1]));
+		float ql = sqrtf(s.normals[i * 4 + 0] * s.normals[i * 4 + 0] + s.normals[i * 4 + 1] * s.normals[i * 4 + 1] + w * w + 1e-6f);
+
+		s.rotations[i * 4 + 0] = s.normals[i * 4 + 0] / ql * cosf(angle);
+		s.rotations[i * 4 + 1] = s.normals[i * 4 + 1] / ql * cosf(angle);
+		s.rotations[i * 4 + 2] = w / ql * cosf(angle);
+		s.rotations[i * 4 + 3] = sinf(angle);
+
+		s.positions[i * 3 + 0] = v.px;
+		s.positions[i * 3 + 1] = v.py;
+		s.positions[i * 3 + 2] = v.pz;
+	}
+
+	s.filter4.resize(vertex_count * 4);
+	s.filter8.resize(vertex_count * 3 / 2 * 8); // large enough for both oct/quat and exp outputs
+	s.foct4.resize(vertex_count * 4);
+	s.foct8.resize(vertex_count * 8);
+	s.fquat8.resize(vertex_count * 8);
+	s.fexp.resize(vertex_count * 3 / 2 * 8);
+
+	// exp filter encodes 2 float components per 8-byte element, so the 3-component positions are reinterpreted as vertex_count*3/2 pairs
+	meshopt_encodeFilterOct(&s.foct4[0], vertex_count, 4, 8, &s.normals[0]);
+	meshopt_encodeFilterOct(&s.foct8[0], vertex_count, 8, 12, &s.normals[0]);
+	meshopt_encodeFilterQuat(&s.fquat8[0], vertex_count, 8, 12, &s.rotations[0]);
+	meshopt_encodeFilterExp(&s.fexp[0], vertex_count * 3 / 2, 8, 15, &s.positions[0]);
+
+	s.foct8encoded.resize(meshopt_encodeVertexBufferBound(vertex_count, 8));
+	s.foct8encoded.resize(meshopt_encodeVertexBuffer(&s.foct8encoded[0], s.foct8encoded.size(), &s.foct8[0], vertex_count, 8));
+
+	s.sink = 0;
+}
+
+static Result runBenchmark(const Benchmark& bench, State& state, int warmup, int repeat)
+{
+	for (int i = 0; i < warmup; ++i)
+		bench.function(state);
+
+	std::vector<double> times(repeat);
+
+	for (int i = 0; i < repeat; ++i)
+	{
+		double t0 = timestamp();
+		bench.function(state);
+		double t1 = timestamp();
+
+		times[i] = t1 - t0;
+	}
+
+	std::sort(times.begin(), times.end());
+
+	double total = 0;
+	for (int i = 0; i < repeat; ++i)
+		total += times[i];
+
+	Result result;
+	result.name = bench.name;
+	result.min = times[0];
+	result.p50 = times[size_t(0.5 * (repeat - 1) + 0.5)];
+	result.p90 = times[size_t(0.9 * (repeat - 1) + 0.5)];
+	result.max = times[repeat - 1];
+	result.mean = total / double(repeat);
+
+	return result;
+}
+
+static bool loadMesh(Mesh& mesh, const char* path)
+{
+	fastObjMesh* obj = fast_obj_read(path);
+	if (!obj)
+		return false;
+
+	size_t total_indices = 0;
+
+	for (unsigned int i = 0; i < obj->face_count; ++i)
+		total_indices += 3 * (obj->face_vertices[i] - 2);
+
+	std::vector<Vertex> vertices(total_indices);
+
+	size_t vertex_offset = 0;
+	size_t index_offset = 0;
+
+	for (unsigned int i = 0; i < obj->face_count; ++i)
+	{
+		for (unsigned int j = 0; j < obj->face_vertices[i]; ++j)
+		{
+			fastObjIndex gi = obj->indices[index_offset + j];
+
+			Vertex v =
+			    {
+			        obj->positions[gi.p * 3 + 0],
+			        obj->positions[gi.p * 3 + 1],
+			        obj->positions[gi.p * 3 + 2],
+			        obj->normals[gi.n * 3 + 0],
+			        obj->normals[gi.n * 3 + 1],
+			        obj->normals[gi.n * 3 + 2],
+			        obj->texcoords[gi.t * 2 + 0],
+			        obj->texcoords[gi.t * 2 + 1],
+			    };
+
+			// triangulate polygon on the fly; offset-3 is always the first polygon vertex
+			if (j >= 3)
+			{
+				vertices[vertex_offset + 0] = vertices[vertex_offset - 3];
+				vertices[vertex_offset + 1] = vertices[vertex_offset - 1];
+				vertex_offset += 2;
+			}
+
+			vertices[vertex_offset] = v;
+			vertex_offset++;
+		}
+
+		index_offset += obj->face_vertices[i];
+	}
+
+	fast_obj_destroy(obj);
+
+	std::vector<unsigned int> remap(total_indices);
+	size_t vertex_count = meshopt_generateVertexRemap(&remap[0], NULL, total_indices, &vertices[0], total_indices, sizeof(Vertex));
+
+	mesh.name = path;
+	mesh.indices.resize(total_indices);
+	meshopt_remapIndexBuffer(&mesh.indices[0], NULL, total_indices, &remap[0]);
+
+	mesh.vertices.resize(vertex_count);
+	meshopt_remapVertexBuffer(&mesh.vertices[0], &vertices[0], total_indices, sizeof(Vertex), &remap[0]);
+
+	return !mesh.indices.empty();
+}
+
+static void generateGrid(Mesh& mesh, unsigned int size)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "grid%u", size);
+
+	mesh.name = name;
+
+	for (unsigned int y = 0; y <= size; ++y)
+		for (unsigned int x = 0; x <= size; ++x)
+		{
+			float u = float(x) / float(size), v = float(y) / float(size);
+			float h = sinf(u * 12.f) * cosf(v * 9.f) * 0.05f;
+
+			Vertex vtx = {u, v, h, 0, 0, 1, u, v};
+			mesh.vertices.push_back(vtx);
+		}
+
+	for (unsigned int y = 0; y < size; ++y)
+		for (unsigned int x = 0; x < size; ++x)
+		{
+			unsigned int i = y * (size + 1) + x;
+
+			mesh.indices.push_back(i);
+			mesh.indices.push_back(i + 1);
+			mesh.indices.push_back(i + size + 1);
+			mesh.indices.push_back(i + 1);
+			mesh.indices.push_back(i + size + 2);
+			mesh.indices.push_back(i + size + 1);
+		}
+}
+
+static void writeJsonString(FILE* file, const char* str)
+{
+	fputc('"', file);
+
+	for (const char* p = str; *p; ++p)
+	{
+		if (*p == '"' || *p == '\\')
+			fprintf(file, "\\%c", *p);
+		else if (unsigned(*p) < 32)
+			fprintf(file, "\\u%04x", unsigned(*p));
+		else
+			fputc(*p, file);
+	}
+
+	fputc('"', file);
+}
+
+static void writeJson(FILE* file, const std::vector<Mesh>& meshes, const std::vector<std::vector<Result> >& results, int warmup, int repeat)
+{
+	fprintf(file, "{\n\t\"version\": %d,\n\t\"warmup\": %d,\n\t\"repeat\": %d,\n\t\"meshes\": [\n", MESHOPTIMIZER_VERSION, warmup, repeat);
+
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		fprintf(file, "\t\t{\n\t\t\t\"name\": ");
+		writeJsonString(file, meshes[i].name.c_str());
+		fprintf(file, ",\n\t\t\t\"vertices\": %d,\n\t\t\t\"triangles\": %d,\n\t\t\t\"results\": [\n", int(meshes[i].vertices.size()), int(meshes[i].indices.size() / 3));
+
+		for (size_t j = 0; j < results[i].size(); ++j)
+		{
+			const Result& r = results[i][j];
+
+			fprintf(file, "\t\t\t\t{\"name\": \"%s\", \"min\": %.6f, \"p50\": %.6f, \"p90\": %.6f, \"max\": %.6f, \"mean\": %.6f}%s\n",
+			    r.name, r.min * 1000, r.p50 * 1000, r.p90 * 1000, r.max * 1000, r.mean * 1000, j + 1 < results[i].size() ? "," : "");
+		}
+
+		fprintf(file, "\t\t\t]\n\t\t}%s\n", i + 1 < meshes.size() ? "," : "");
+	}
+
+	fprintf(file, "\t]\n}\n");
+}
+
+static bool matchFilter(const char* name, const std::vector<const char*>& filters)
+{
+	if (filters.empty())
+		return true;
+
+	for (size_t i = 0; i < filters.size(); ++i)
+		if (strstr(name, filters[i]))
+			return true;
+
+	return false;
+}
+
+int main(int argc, char** argv)
+{
+	int warmup = 1;
+	int repeat = 10;
+	unsigned int grid = 0;
+	const char* json = NULL;
+
+	std::vector<const char*> filters;
+	std::vector<const char*> paths;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* arg = argv[i];
+
+		if (strcmp(arg, "-w") == 0 && i + 1 < argc)
+			warmup = std::max(0, atoi(argv[++i]));
+		else if (strcmp(arg, "-n") == 0 && i + 1 < argc)
+			repeat = std::max(1, atoi(argv[++i]));
+		else if (strcmp(arg, "-g") == 0 && i + 1 < argc)
+			grid = unsigned(std::max(1, atoi(argv[++i])));
+		else if (strcmp(arg, "-f") == 0 && i + 1 < argc)
+			filters.push_back(argv[++i]);
+		else if (strcmp(arg, "-json") == 0 && i + 1 < argc)
+			json = argv[++i];
+		else if (strcmp(arg, "-l") == 0)
+		{
+			for (size_t j = 0; j < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); ++j)
+				printf("%s\n", kBenchmarks[j].name);
+			return 0;
+		}
+		else if (arg[0] == '-')
+		{
+			fprintf(stderr, "Usage: %s [options] [mesh.obj...]\n", argv[0]);
+			fprintf(stderr, "\t-w N: run each benchmark N times before measuring (default: 1)\n");
+			fprintf(stderr, "\t-n N: measure each benchmark N times (default: 10)\n");
+			fprintf(stderr, "\t-g N: add a generated NxN grid to the corpus (default when no meshes are given: 512)\n");
+			fprintf(stderr, "\t-f S: only run benchmarks with names containing S; can be specified multiple times\n");
+			fprintf(stderr, "\t-l: list all benchmarks and exit\n");
+			fprintf(stderr, "\t-json file: write results to file in JSON format (times are in milliseconds)\n");
+			return 1;
+		}
+		else
+			paths.push_back(arg);
+	}
+
+	std::vector<Mesh> meshes;
+
+	for (size_t i = 0; i < paths.size(); ++i)
+	{
+		Mesh mesh;
+
+		if (!loadMesh(mesh, paths[i]))
+		{
+			fprintf(stderr, "Error loading %s\n", paths[i]);
+			return 2;
+		}
+
+		meshes.push_back(mesh);
+	}
+
+	if (grid || meshes.empty())
+	{
+		meshes.push_back(Mesh());
+		generateGrid(meshes.back(), grid ? grid : 512);
+	}
+
+	std::vector<std::vector<Result> > results(meshes.size());
+
+	for (size_t i = 0; i < meshes.size(); ++i)
+	{
+		const Mesh& mesh = meshes[i];
+
+		printf("%s: %d vertices, %d triangles\n", mesh.name.c_str(), int(mesh.vertices.size()), int(mesh.indices.size() / 3));
+		printf("%-24s %10s %10s %10s %10s %12s\n", "benchmark", "min ms", "p50 ms", "p90 ms", "max ms", "Mtri/s (p50)");
+
+		State state;
+		prepareState(state, mesh);
+
+		for (size_t j = 0; j < sizeof(kBenchmarks) / sizeof(kBenchmarks[0]); ++j)
+		{
+			const Benchmark& bench = kBenchmarks[j];
+
+			if (!matchFilter(bench.name, filters))
+				continue;
+
+			Result r = runBenchmark(bench, state, warmup, repeat);
+			results[i].push_back(r);
+
+			printf("%-24s %10.3f %10.3f %10.3f %10.3f %12.2f\n", r.name, r.min * 1000, r.p50 * 1000, r.p90 * 1000, r.max * 1000, double(mesh.indices.size() / 3) / r.p50 * 1e-6);
+		}
+
+		printf("\n");
+	}
+
+	if (json)
+	{
+		FILE* file = fopen(json, "w");
+		if (!file)
+		{
+			fprintf(stderr, "Error saving %s\n", json);
+			return 3;
+		}
+
+		writeJson(file, meshes, results, warmup, repeat);
+		fclose(file);
+	}
+
+	return 0;
+}
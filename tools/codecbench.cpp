@@ -54,10 +54,11 @@ uint32_t murmur3(uint32_t h)
 	return h;
 }
 
-void benchCodecs(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, double& bestvd, double& bestid, bool verbose)
+void benchCodecs(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices, double& bestvd, double& bestid, double& bestid16, bool verbose)
 {
 	std::vector<Vertex> vb(vertices.size());
 	std::vector<unsigned int> ib(indices.size());
+	std::vector<unsigned short> ib16(indices.size());
 
 	std::vector<unsigned char> vc(meshopt_encodeVertexBufferBound(vertices.size(), sizeof(Vertex)));
 	std::vector<unsigned char> ic(meshopt_encodeIndexBufferBound(indices.size(), vertices.size()));
@@ -99,17 +100,25 @@ void benchCodecs(const std::vector<Vertex>& vertices, const std::vector<unsigned
 
 			double t2 = timestamp();
 
+			int ri16 = meshopt_decodeIndexBuffer(&ib16[0], indices.size(), 2, &ic[0], ic.size());
+			assert(ri16 == 0);
+			(void)ri16;
+
+			double t3 = timestamp();
+
 			double GB = 1024 * 1024 * 1024;
 
 			if (verbose)
-				printf("decode: vertex %.2f ms (%.2f GB/sec), index %.2f ms (%.2f GB/sec)\n",
+				printf("decode: vertex %.2f ms (%.2f GB/sec), index %.2f ms (%.2f GB/sec), index16 %.2f ms (%.2f GB/sec)\n",
 				       (t1 - t0) * 1000, double(vertices.size() * sizeof(Vertex)) / GB / (t1 - t0),
-				       (t2 - t1) * 1000, double(indices.size() * 4) / GB / (t2 - t1));
+				       (t2 - t1) * 1000, double(indices.size() * 4) / GB / (t2 - t1),
+				       (t3 - t2) * 1000, double(indices.size() * 2) / GB / (t3 - t2));
 
 			if (pass == 0)
 			{
 				bestvd = std::max(bestvd, double(vertices.size() * sizeof(Vertex)) / GB / (t1 - t0));
 				bestid = std::max(bestid, double(indices.size() * 4) / GB / (t2 - t1));
+				bestid16 = std::max(bestid16, double(indices.size() * 2) / GB / (t3 - t2));
 			}
 		}
 	}
@@ -212,13 +221,13 @@ int main(int argc, char** argv)
 		}
 	}
 
-	double bestvd = 0, bestid = 0;
-	benchCodecs(vertices, indices, bestvd, bestid, verbose);
+	double bestvd = 0, bestid = 0, bestid16 = 0;
+	benchCodecs(vertices, indices, bestvd, bestid, bestid16, verbose);
 
 	double besto8 = 0, besto12 = 0, bestq12 = 0, bestexp = 0;
 	benchFilters(8 * N * N, besto8, besto12, bestq12, bestexp, verbose);
 
-	printf("Algorithm   :\tvtx\tidx\toct8\toct12\tquat12\texp\n");
-	printf("Score (GB/s):\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n",
-	       bestvd, bestid, besto8, besto12, bestq12, bestexp);
+	printf("Algorithm   :\tvtx\tidx\tidx16\toct8\toct12\tquat12\texp\n");
+	printf("Score (GB/s):\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\t%.2f\n",
+	       bestvd, bestid, bestid16, besto8, besto12, bestq12, bestexp);
 }
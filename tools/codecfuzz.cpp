@@ -3,7 +3,7 @@
 #include <stdint.h>
 #include <stdlib.h>
 
-void fuzzDecoder(const uint8_t* data, size_t size, size_t stride, int (*decode)(void*, size_t, size_t, const unsigned char*, size_t))
+int fuzzDecoder(const uint8_t* data, size_t size, size_t stride, int (*decode)(void*, size_t, size_t, const unsigned char*, size_t))
 {
 	size_t count = 66; // must be divisible by 3 for decodeIndexBuffer; should be >=64 to cover large vertex blocks
 
@@ -11,11 +11,105 @@ void fuzzDecoder(const uint8_t* data, size_t size, size_t stride, int (*decode)(
 	assert(destination);
 
 	int rc = decode(destination, count, stride, reinterpret_cast<const unsigned char*>(data), size);
+
+	free(destination);
+
+	return rc;
+}
+
+void fuzzIndexValidator(const uint8_t* data, size_t size, size_t stride)
+{
+	size_t count = 66; // must match fuzzDecoder
+
+	// validator must accept exactly the inputs that the decoder accepts, and report the same error
+	int rc = fuzzDecoder(data, size, stride, meshopt_decodeIndexBuffer);
+	int vrc = meshopt_validateIndexBuffer(count, reinterpret_cast<const unsigned char*>(data), size);
+
+	assert(rc == vrc);
+	(void)rc;
+	(void)vrc;
+}
+
+void fuzzVertexValidator(const uint8_t* data, size_t size, size_t stride)
+{
+	size_t count = 66; // must match fuzzDecoder
+
+	// validator must accept exactly the inputs that the decoder accepts, and report the same error
+	int rc = fuzzDecoder(data, size, stride, meshopt_decodeVertexBuffer);
+	int vrc = meshopt_validateVertexBuffer(count, stride, reinterpret_cast<const unsigned char*>(data), size);
+
+	assert(rc == vrc);
+	(void)rc;
+	(void)vrc;
+}
+
+void fuzzRangeDecoder(const uint8_t* data, size_t size, size_t stride, size_t offset, size_t range)
+{
+	size_t count = 66; // must match fuzzDecoder so that the range decoder sees the same streams
+
+	void* destination = malloc(range * stride);
+	assert(destination || range == 0);
+
+	int rc = meshopt_decodeVertexRange(destination, offset, range, count, stride, reinterpret_cast<const unsigned char*>(data), size);
 	(void)rc;
 
 	free(destination);
 }
 
+void fuzzStridedDecoder(const uint8_t* data, size_t size, size_t vertex_size, size_t destination_stride)
+{
+	size_t count = 66; // must match fuzzDecoder so that the strided decoder sees the same streams
+
+	// allocate exactly the documented size so that out of bounds writes past the last vertex are caught
+	void* destination = malloc((count - 1) * destination_stride + vertex_size);
+	assert(destination);
+
+	int rc = meshopt_decodeVertexBufferStrided(destination, count, vertex_size, destination_stride, reinterpret_cast<const unsigned char*>(data), size);
+	(void)rc;
+
+	free(destination);
+}
+
+void fuzzIndexRangeDecoder(const uint8_t* data, size_t size, size_t index_size, size_t count, size_t offset, size_t range)
+{
+	void* destination = malloc(range * index_size);
+	assert(destination || range == 0);
+
+	int rc = meshopt_decodeIndexRange(destination, offset, range, count, index_size, reinterpret_cast<const unsigned char*>(data), size);
+	(void)rc;
+
+	free(destination);
+}
+
+static void dispatchReverse(void* context, void (*task)(void* task_context, size_t task_index), void* task_context, size_t task_count)
+{
+	(void)context;
+
+	// tasks run in reverse order to check that blocks don't depend on each other's output
+	for (size_t i = task_count; i > 0; --i)
+		task(task_context, i - 1);
+}
+
+void fuzzIndexParallelDecoder(const uint8_t* data, size_t size, size_t index_size, size_t count)
+{
+	void* destination = malloc(count * index_size);
+	assert(destination);
+
+	int rc = meshopt_decodeIndexBufferParallel(destination, count, index_size, reinterpret_cast<const unsigned char*>(data), size, dispatchReverse, NULL);
+	(void)rc;
+
+	free(destination);
+}
+
+void fuzzMeshletDecoder(const uint8_t* data, size_t size, size_t vertex_count, size_t triangle_count)
+{
+	unsigned int vertices[256];
+	unsigned char triangles[512 * 3];
+
+	int rc = meshopt_decodeMeshlet(vertices, vertex_count, triangles, triangle_count, reinterpret_cast<const unsigned char*>(data), size);
+	(void)rc;
+}
+
 namespace meshopt
 {
 extern unsigned int cpuid;
@@ -23,9 +117,22 @@ extern unsigned int cpuid;
 
 extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
 {
-	// decodeIndexBuffer supports 2 and 4-byte indices
-	fuzzDecoder(data, size, 2, meshopt_decodeIndexBuffer);
-	fuzzDecoder(data, size, 4, meshopt_decodeIndexBuffer);
+	// decodeIndexBuffer supports 2 and 4-byte indices; validateIndexBuffer is checked against it for both
+	fuzzIndexValidator(data, size, 2);
+	fuzzIndexValidator(data, size, 4);
+
+	// decodeIndexRange and decodeIndexBufferParallel read block offsets from the input; 12294 indices span two blocks of version 2 data (inputs need to be >4 KB to pass the size check)
+	for (size_t index_size = 2; index_size <= 4; index_size += 2)
+	{
+		fuzzIndexRangeDecoder(data, size, index_size, 66, 0, 0);
+		fuzzIndexRangeDecoder(data, size, index_size, 66, 0, 66);
+		fuzzIndexRangeDecoder(data, size, index_size, 66, 27, 39);
+		fuzzIndexRangeDecoder(data, size, index_size, 12294, 12282, 12);
+		fuzzIndexRangeDecoder(data, size, index_size, 12294, 0, 12294);
+
+		fuzzIndexParallelDecoder(data, size, index_size, 66);
+		fuzzIndexParallelDecoder(data, size, index_size, 12294);
+	}
 
 	// decodeIndexSequence supports 2 and 4-byte indices
 	fuzzDecoder(data, size, 2, meshopt_decodeIndexSequence);
@@ -33,10 +140,33 @@ extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
 
 	// decodeVertexBuffer supports any strides divisible by 4 in 4-256 interval
 	// It's a waste of time to check all of them, so we'll just check a few with different alignment mod 16
-	fuzzDecoder(data, size, 4, meshopt_decodeVertexBuffer);
-	fuzzDecoder(data, size, 16, meshopt_decodeVertexBuffer);
-	fuzzDecoder(data, size, 24, meshopt_decodeVertexBuffer);
-	fuzzDecoder(data, size, 32, meshopt_decodeVertexBuffer);
+	// validateVertexBuffer is checked against the decoder for each of them
+	fuzzVertexValidator(data, size, 4);
+	fuzzVertexValidator(data, size, 16);
+	fuzzVertexValidator(data, size, 24);
+	fuzzVertexValidator(data, size, 32);
+
+	// decodeVertexRange decodes a subrange of the same stream; check an empty range, ranges that start mid-block and a range that ends at the last vertex
+	const size_t vertex_strides[] = {4, 16, 24, 32};
+
+	for (size_t i = 0; i < sizeof(vertex_strides) / sizeof(vertex_strides[0]); ++i)
+	{
+		fuzzRangeDecoder(data, size, vertex_strides[i], 0, 0);
+		fuzzRangeDecoder(data, size, vertex_strides[i], 0, 66);
+		fuzzRangeDecoder(data, size, vertex_strides[i], 17, 30);
+		fuzzRangeDecoder(data, size, vertex_strides[i], 40, 26);
+		fuzzRangeDecoder(data, size, vertex_strides[i], 65, 1);
+	}
+
+	// decodeVertexBufferStrided scatters vertices into a larger interleaved destination
+	fuzzStridedDecoder(data, size, 4, 12);
+	fuzzStridedDecoder(data, size, 16, 20);
+	fuzzStridedDecoder(data, size, 24, 64);
+
+	// decodeMeshlet supports up to 256 vertices; check a few sizes that cover small and typical meshlets
+	fuzzMeshletDecoder(data, size, 3, 1);
+	fuzzMeshletDecoder(data, size, 64, 124);
+	fuzzMeshletDecoder(data, size, 255, 512);
 
 	return 0;
 }
@@ -5,7 +5,10 @@
 #include "../extern/sdefl.h"
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <thread>
 #include <vector>
 
 #include <cmath>
@@ -16,17 +19,6 @@
 const int kCacheSizeMax = 16;
 const int kValenceMax = 8;
 
-namespace meshopt
-{
-	struct VertexScoreTable
-	{
-		float cache[1 + kCacheSizeMax];
-		float live[1 + kValenceMax];
-	};
-} // namespace meshopt
-
-void meshopt_optimizeVertexCacheTable(unsigned int* destination, const unsigned int* indices, size_t index_count, size_t vertex_count, const meshopt::VertexScoreTable* table);
-
 struct Profile
 {
 	float weight;
@@ -77,6 +69,51 @@ uint32_t rand32()
 	return pcg32_random_r(&rngstate);
 }
 
+// Runs body(i) for every i in [0, count) on all hardware threads
+// Each worker starts with its own contiguous slice and steals items from other slices once it runs out, so uneven item costs don't leave threads idle
+template <typename Body>
+void parallel_for(size_t count, const Body& body)
+{
+	struct Slice
+	{
+		std::atomic<size_t> next;
+		size_t end;
+	};
+
+	size_t worker_count = std::max(1u, std::thread::hardware_concurrency());
+	worker_count = std::min(worker_count, std::max(count, size_t(1)));
+
+	std::unique_ptr<Slice[]> slices(new Slice[worker_count]);
+
+	for (size_t i = 0; i < worker_count; ++i)
+	{
+		slices[i].next = count * i / worker_count;
+		slices[i].end = count * (i + 1) / worker_count;
+	}
+
+	auto worker = [&](size_t self)
+	{
+		for (size_t k = 0; k < worker_count; ++k)
+		{
+			Slice& slice = slices[(self + k) % worker_count];
+
+			// owner and thieves both take items from the front, so a single atomic increment is enough to claim an item
+			for (size_t i; (i = slice.next.fetch_add(1)) < slice.end;)
+				body(i);
+		}
+	};
+
+	std::vector<std::thread> threads;
+
+	for (size_t i = 1; i < worker_count; ++i)
+		threads.emplace_back(worker, i);
+
+	worker(0);
+
+	for (auto& thread : threads)
+		thread.join();
+}
+
 struct State
 {
 	float cache[kCacheSizeMax];
@@ -209,9 +246,9 @@ void compute_metric(const State* state, const Mesh& mesh, float result[Profile_C
 
 	if (state)
 	{
-		meshopt::VertexScoreTable table = {};
-		memcpy(table.cache + 1, state->cache, kCacheSizeMax * sizeof(float));
-		memcpy(table.live + 1, state->live, kValenceMax * sizeof(float));
+		meshopt_VertexScoreTable table = {};
+		memcpy(table.cache, state->cache, kCacheSizeMax * sizeof(float));
+		memcpy(table.live, state->live, kValenceMax * sizeof(float));
 		meshopt_optimizeVertexCacheTable(&indices[0], &mesh.indices[0], mesh.indices.size(), mesh.vertex_count, &table);
 	}
 	else
@@ -283,11 +320,12 @@ std::vector<State> gen0(size_t count, const std::vector<Mesh>& meshes)
 		for (int j = 0; j < kValenceMax; ++j)
 			state.live[j] = rand01();
 
-		state.fitness = fitness_score(state, meshes);
-
 		result.push_back(state);
 	}
 
+	parallel_for(result.size(), [&](size_t i)
+	    { result[i].fitness = fitness_score(result[i], meshes); });
+
 	return result;
 }
 
@@ -335,11 +373,8 @@ std::pair<State, float> genN(std::vector<State>& seed, const std::vector<Mesh>&
 		}
 	}
 
-	#pragma omp parallel for
-	for (size_t i = 0; i < seed.size(); ++i)
-	{
-		result[i].fitness = fitness_score(result[i], meshes);
-	}
+	parallel_for(seed.size(), [&](size_t i)
+	    { result[i].fitness = fitness_score(result[i], meshes); });
 
 	State best = {};
 	float bestfit = 0;